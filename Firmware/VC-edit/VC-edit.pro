@@ -71,6 +71,9 @@ SOURCES += main.cpp\
     devices/kpa.cpp \
     vcmidiswitchsettings.cpp \
     vcdevices.cpp \
+    vcbackupfile.cpp \
+    vcbinaryfile.cpp \
+    vcsimulator.cpp \
     devices/svl.cpp \
     custompatchlistwidget.cpp \
     devices/sy1000.cpp \
@@ -119,6 +122,9 @@ HEADERS  += RtMidi.h \
     devices/kpa.h \
     vcmidiswitchsettings.h \
     vcdevices.h \
+    vcbackupfile.h \
+    vcbinaryfile.h \
+    vcsimulator.h \
     devices/svl.h \
     custompatchlistwidget.h \
     devices/sy1000.h \
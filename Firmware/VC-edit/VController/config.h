@@ -72,7 +72,7 @@ struct Cmd_struct
 #define SWITCH_TYPE_MASK 0xE0
 
 // Common command types
-#define NUMBER_OF_COMMON_TYPES 13 // Only the one that can be selected in the command builder
+#define NUMBER_OF_COMMON_TYPES 14 // Only the one that can be selected in the command builder
 #define NOTHING 0           // Example: {<PAGE>, <SWITCH>, NOTHING, COMMON}
 #define PAGE 1              // Example: {<PAGE>, <SWITCH>, PAGE, COMMON, SELECT, PAGE_COMBO1}
 #define TAP_TEMPO 2         // Example: {<PAGE>, <SWITCH>, TAP_TEMPO, COMMON}
@@ -86,10 +86,11 @@ struct Cmd_struct
 #define SONG 10              // Example: {<PAGE>, <SWITCH>, SONG, COMMON, NEXT}
 #define MODE 11              // Example: {<PAGE>, <SWITCH>, MODE, COMMON, SELECT, 0}
 #define MIDI_MORE 12         // Example: {<PAGE>, <SWITCH>, MIDI_PC, COMMON, START}
+#define MODULATION 13        // Example: {<PAGE>, <SWITCH>, MODULATION, COMMON, MOD_CMD_START_STOP, Lane, Pattern, Phase, Min, Max}
 
 // Common functions that can not be selected in the command builder
 #define NUMBER_OF_COMMON_TYPES_NOT_SELECTABLE 1
-#define MENU 13             // Example: {<PAGE>, <SWITCH>, MENU, COMMON, 1} - to display first menu item
+#define MENU 14             // Example: {<PAGE>, <SWITCH>, MENU, COMMON, 1} - to display first menu item
 
 // Device command types
 #define NUMBER_OF_DEVICE_TYPES 10
@@ -166,6 +167,16 @@ struct Cmd_struct
 #define MIDI_STOP 1
 #define MIDI_START_STOP 2
 
+// MODULATION options
+#define MOD_CMD_START 0       // Example: {<PAGE>, <SWITCH>, MODULATION, COMMON, MOD_CMD_START, Lane, Pattern, Phase, Min, Max}
+#define MOD_CMD_STOP 1        // Example: {<PAGE>, <SWITCH>, MODULATION, COMMON, MOD_CMD_STOP, Lane}
+#define MOD_CMD_START_STOP 2  // Example: {<PAGE>, <SWITCH>, MODULATION, COMMON, MOD_CMD_START_STOP, Lane, Pattern, Phase, Min, Max}
+#define MOD_CMD_TARGET_CC 3   // Example: {<PAGE>, <SWITCH>, MODULATION, COMMON, MOD_CMD_TARGET_CC, Lane, CC, Channel, Port}
+#define MOD_CMD_TARGET_NRPN 4 // Example: {<PAGE>, <SWITCH>, MODULATION, COMMON, MOD_CMD_TARGET_NRPN, Lane, MSB, LSB, Channel, Port}
+#define MOD_CMD_TARGET_PAR 5  // Example: {<PAGE>, <SWITCH>, MODULATION, COMMON, MOD_CMD_TARGET_PAR, Lane, Device, Parameter}
+#define MOD_NUMBER_OF_LANES 4 // Same as in Devices.ino of the VController
+#define MOD_NUMBER_OF_FIXED_PATTERNS 8 // Number of patterns in MOD_fixed_pattern in Devices.ino of the VController
+
 // Setlist command types
 #define SL_SELECT 0
 #define SL_BANKSELECT 1
@@ -60,6 +60,12 @@ Setting_struct Setting = {  // Default values for global settings
   false, // 50W version of Katana
   5,     // Main_display_top_line_mode
   0,     // Block_identity_messages
+  0,     // Bass_mode_priority: low and high string
+  6,     // Bass_mode_number_of_strings
+  0,     // Bass_mode_hold_time
+  0,     // Song_part_change_timing: immediately
+  false, // Exp_pedal_high_res_CC
+  20,    // Cmd_execute_time_budget: 2 ms
 };
 
 MIDI_switch_settings_struct MIDI_switch[NUMBER_OF_MIDI_SWITCHES] = { // Default settings for MIDI_switch settings
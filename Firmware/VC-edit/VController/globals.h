@@ -70,6 +70,12 @@ struct Setting_struct { // All the global settings in one place.
   uint8_t Is_katana50; // 50W version of Katana
   uint8_t Main_display_top_line_mode;
   uint8_t Block_identity_messages; // To block sysex messages as it messes with certain devices
+  uint8_t Bass_mode_priority; // Low and high string, low string only, high string only or chord
+  uint8_t Bass_mode_number_of_strings; // 6 or 7 strings
+  uint8_t Bass_mode_hold_time; // Minimum time a string keeps priority after it is released (in steps of 10 ms)
+  uint8_t Song_part_change_timing; // Song parts change immediately, on the next beat or on the next bar
+  uint8_t Exp_pedal_high_res_CC; // Expression pedals send 14 bit CC messages (MSB on CC 0 - 31, LSB on CC 32 - 63)
+  uint8_t Cmd_execute_time_budget; // Time that switch commands may be executed in one loop cycle (in steps of 100 us, 0 is one command per loop cycle)
 };
 
 extern Setting_struct Setting;
@@ -0,0 +1,14 @@
+#include "vceditcli.h"
+#include <QCoreApplication>
+
+// Entry point of VC-edit-cli, the command line version of VC-edit. See vceditcli.h
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    QCoreApplication::setOrganizationName("Sixeight Sound Control");
+    QCoreApplication::setApplicationName("VC-edit"); // Use the same settings as VC-edit
+
+    VCeditCli cli;
+    return cli.run(a.arguments());
+}
@@ -24,6 +24,7 @@ uint8_t Device_class::get_setting(uint8_t variable)
         case 9: return my_device_page4;
         case 10: return enabled;
         case 11: return dev_type;
+        case 12: return PC_echo_port;
       }
       return 0;
 }
@@ -43,6 +44,7 @@ void Device_class::set_setting(uint8_t variable, uint8_t value)
       case 9: my_device_page4 = value; break;
       case 10: enabled = value; break;
       case 11: dev_type = value; break;
+      case 12: PC_echo_port = value; break;
     }
 }
 
@@ -70,7 +72,8 @@ QString Device_class::get_setting_name(uint8_t variable) // Setting names for js
         "my_device_page3",  // 8
         "my_device_page4",  // 9
         "enabled",          // 10
-        "dev_type"          // 11
+        "dev_type",         // 11
+        "PC_echo_port"      // 12
     };
     if (variable < setting_names.size()) return setting_names.at(variable);
     return "";
@@ -70,11 +70,12 @@ public:
     uint8_t my_device_page4;
     uint8_t enabled;
     uint8_t dev_type = 0;
+    uint8_t PC_echo_port = 0;
 
 protected:
     uint8_t MIDI_port_number(uint8_t port);
 
-#define NUMBER_OF_DEVICE_SETTINGS 12
+#define NUMBER_OF_DEVICE_SETTINGS 13
 };
 
 #endif // DEVICE_H
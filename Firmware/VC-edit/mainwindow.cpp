@@ -80,6 +80,9 @@ MainWindow::MainWindow(QWidget *parent) :
     MyVCuserDevice = new VCuserdevices();
     MyVCcommands = new VCcommands();
     connect(MyVCcommands, SIGNAL(updateCommandScreens(bool)), this, SLOT(updateCommandScreens(bool)));
+    MyVCbackupFile = new VCbackupFile(MyVCsettings, MyVCmidiSwitches, MyVCseqPatterns, MyVCdevices, MyVCuserDevice, MyVCcommands);
+    MyVCbinaryFile = new VCbinaryFile(MyVCcommands);
+    setupSimulator();
 
     loadAppSettings();
     MyVCdevices->setup_devices();
@@ -120,7 +123,12 @@ MainWindow::MainWindow(QWidget *parent) :
 MainWindow::~MainWindow()
 {
     saveAppSettings();
-    if (RemoteControlActive) MyMidi->sendSysexCommand(2, VC_REMOTE_CONTROL_ENABLE, 0);
+    if (RemoteControlActive) {
+        MyMidi->sendSysexCommand(2, VC_REMOTE_CONTROL_ENABLE, 0);
+        MyMidi->sendSysexCommand(2, VC_REQUEST_PROFILE_TELEMETRY, 0);
+    }
+    simulatorThread->quit();
+    simulatorThread->wait();
     delete ui;
 }
 
@@ -190,6 +198,8 @@ void MainWindow::loadAppSettings() {
     MyMidi->openMidiOut(MyMidiOutPort);
     MyMidi->send_universal_identity_request(); //See if we can connect
     MyMidiSlowMode = appSettings.value("midiSlowMode").toBool();
+    remoteRefreshRate = appSettings.value("remoteRefreshRate", MyMidiSlowMode ? REMOTE_DEFAULT_REFRESH_RATE / 2 : REMOTE_DEFAULT_REFRESH_RATE).toInt();
+    remoteRefreshRate = qBound(1, remoteRefreshRate, 100);
     appSettings.endGroup();
 
     if (newType != VC_type) {
@@ -710,7 +720,11 @@ void MainWindow::updatePatchListBox()
 void MainWindow::on_actionOpen_triggered()
 {
     // File Open
-    QString MyFile = QFileDialog::getOpenFileName(this, "Open VC-edit file", QFileInfo(MyFullBackupFile).filePath(), tr("VC-edit data (*.vcd)"));
+    QString MyFile = QFileDialog::getOpenFileName(this, "Open VC-edit file", QFileInfo(MyFullBackupFile).filePath(), tr("VC-edit data (*.vcd *.vcb)"));
+    if (VCbinaryFile::isBinaryFileName(MyFile)) {
+        openBinaryFile(MyFile);
+        return;
+    }
     QFile loadFile(MyFile);
 
     if (!loadFile.open(QIODevice::ReadOnly)) {
@@ -722,13 +736,13 @@ void MainWindow::on_actionOpen_triggered()
     QJsonDocument loadDoc(QJsonDocument::fromJson(saveData));
     fileLoaded = true;
 
-    QString jsonType = readHeader(loadDoc.object());
+    QString jsonType = VCbackupFile::readHeader(loadDoc.object());
     if (jsonType == "") {
         ui->statusbar->showMessage("Couldn't read selected. No VC-edit settings file", STATUS_BAR_MESSAGE_TIME);
         return;
     }
 
-    QString file_VCtype = checkHeaderContainsRightVCtype(loadDoc.object());
+    QString file_VCtype = VCbackupFile::checkHeaderContainsRightVCtype(loadDoc.object());
     if (file_VCtype != "") {
         if (QMessageBox::No == QMessageBox(QMessageBox::Warning, "Loading full backup", "File contains data for " + file_VCtype +" and VC-edit is set for " + VC_name + ". Are you sure you want to load this data?",
                                         QMessageBox::Yes|QMessageBox::No).exec()) return;
@@ -739,15 +753,7 @@ void MainWindow::on_actionOpen_triggered()
             if (QMessageBox::No == QMessageBox(QMessageBox::Warning, "Loading full backup", "All current data will be lost! Are you sure you want to proceed?",
                                             QMessageBox::Yes|QMessageBox::No).exec()) return;
         }
-        MyVCsettings->read(loadDoc.object());
-        MyVCmidiSwitches->read(loadDoc.object());
-        MyVCseqPatterns->read(loadDoc.object());
-        MyVCdevices->read(loadDoc.object());
-        MyVCuserDevice->readAll(loadDoc.object());
-        MyVCcommands->readAll(loadDoc.object());
-        //MyVCdevices->readAll(loadDoc.object());
-        readAllPatchData(loadDoc.object());
-        MyVCdevices->readAllLegacyKatana(loadDoc.object());
+        MyVCbackupFile->readFullBackup(loadDoc.object());
         updateTreeWidget(ui->treeWidget); // Will refresh the settings in the widget
         updateCommandScreens(false);
         fillPatchListBox(ui->patchListWidget);
@@ -780,7 +786,16 @@ void MainWindow::on_actionOpen_triggered()
 void MainWindow::on_actionSave_triggered()
 {
     // File Save
-    MyFullBackupFile = QFileDialog::getSaveFileName(this, "Save VC-edit file:", MyFullBackupFile, tr("VC-edit data (*.vcd)"));
+    MyFullBackupFile = QFileDialog::getSaveFileName(this, "Save VC-edit file:", MyFullBackupFile, tr("VC-edit data (*.vcd);;VC-edit binary data (*.vcb)"));
+    if (VCbinaryFile::isBinaryFileName(MyFullBackupFile)) {
+        if (!MyVCbinaryFile->save(MyFullBackupFile)) {
+            ui->statusbar->showMessage(MyVCbinaryFile->errorString(), STATUS_BAR_MESSAGE_TIME);
+            return;
+        }
+        ui->statusbar->showMessage(MyFullBackupFile + " saved", STATUS_BAR_MESSAGE_TIME);
+        dataEdited = false;
+        return;
+    }
     QFile saveFile(MyFullBackupFile);
 
     if (!saveFile.open(QIODevice::WriteOnly)) {
@@ -789,88 +804,45 @@ void MainWindow::on_actionSave_triggered()
     }
 
     QJsonObject saveObject;
-    writeHeader(saveObject, "FullBackup");
-    MyVCsettings->write(saveObject);
-    MyVCmidiSwitches->write(saveObject);
-    MyVCseqPatterns->write(saveObject);
-    MyVCdevices->write(saveObject);
-    MyVCcommands->writeAll(saveObject);
-    MyVCuserDevice->writeAll(saveObject);
-    writeAllPatchData(saveObject);
-    //MyVCdevices->writeAll(saveObject);
+    MyVCbackupFile->writeFullBackup(saveObject);
     QJsonDocument saveDoc(saveObject);
     saveFile.write(saveDoc.toJson());
     ui->statusbar->showMessage(MyFullBackupFile + " saved", STATUS_BAR_MESSAGE_TIME);
     dataEdited = false;
 }
 
-void MainWindow::writeHeader(QJsonObject &json, QString type)
-{
-    QJsonObject headerObject;
-    headerObject["Source"] = "VC-edit";
-    headerObject["Version"] = QString::number(VCMINI_FIRMWARE_VERSION_MAJOR) + "." + QString::number(VCMINI_FIRMWARE_VERSION_MINOR) + "." + QString::number(VCMINI_FIRMWARE_VERSION_BUILD);
-    headerObject["Type"] = type;
-    headerObject["VC_type"] = VC_type;
-    headerObject["VC_name"] = VC_name;
-    json["Header"] = headerObject;
-}
-
-void MainWindow::writeAllPatchData(QJsonObject &json) const
+void MainWindow::openBinaryFile(QString fileName)
 {
-    QJsonObject allPatches;
-    for (int p = 0; p < MAX_NUMBER_OF_DEVICE_PRESETS; p++) {
-        uint8_t my_type = Device_patches[p][0];
-        int patch_no = (Device_patches[p][1] << 8) + Device_patches[p][2];
-        if (my_type > 0) {
-            QJsonObject patchObject;
-            patchObject["Device type"] = my_type;
-            patchObject["Device patch number"] = patch_no;
-            if ((my_type > 0) && (my_type <= NUMBER_OF_DEVICES)) MyVCdevices->writePatchData(p, patchObject);
-            if (my_type == EXT_SETLIST_TYPE) setlistEditDialog::writeSetlistData(p, patchObject);
-            if (my_type == EXT_SONG_TYPE) songEditDialog::writeSongData(p, patchObject);
-            allPatches["Patch_" + QString::number(p)] = patchObject;
-        }
-        //patchArray.append(patchObject);
+    if (!MyVCbinaryFile->open(fileName)) {
+        ui->statusbar->showMessage(MyVCbinaryFile->errorString(), STATUS_BAR_MESSAGE_TIME);
+        return;
     }
-    json["Device Patches"] = allPatches;
-}
-
-QString MainWindow::readHeader(const QJsonObject &json)
-{
-    if (!(json.contains("Header"))) return "";
-    QJsonObject headerObject = json["Header"].toObject();
-    if (!(headerObject["Source"].toString() == "VC-edit")) return "";
-    return headerObject["Type"].toString();
-}
+    fileLoaded = true;
 
-void MainWindow::readAllPatchData(const QJsonObject &json)
-{
-    int my_type, patch_no;
-    QJsonObject allPatches = json["Device Patches"].toObject();
-    for (int p = 0; p < MAX_NUMBER_OF_DEVICE_PRESETS; p++) {
-        QJsonObject patchObject = allPatches["Patch_" + QString::number(p)].toObject();
-        if (!patchObject.isEmpty()) {
-            my_type = patchObject["Device type"].toInt();
-            patch_no = patchObject["Device patch number"].toInt();
-            int index = MyVCdevices->findIndex(my_type, patch_no);
-            if (index == PATCH_INDEX_NOT_FOUND) index = MyVCdevices->newIndex();
-            if (index != PATCH_INDEX_NOT_FOUND) { // Not out of memory
-                if ((my_type > 0) && (my_type <= NUMBER_OF_DEVICES)) MyVCdevices->readPatchData(patch_no, patchObject, my_type);
-                if (my_type == EXT_SETLIST_TYPE) setlistEditDialog::readSetlistData(patch_no, patchObject, my_type, index);
-                if (my_type == EXT_SONG_TYPE) songEditDialog::readSongData(patch_no, patchObject, my_type, index);
-                allPatches["Patch_" + QString::number(p)] = patchObject;
-            }
-        }
+    if (MyVCbinaryFile->fileVCtype() != VC_type) {
+        QString file_VCtype = "another VController type";
+        if (MyVCbinaryFile->fileVCtype() == VCONTROLLER) file_VCtype = "VController";
+        if (MyVCbinaryFile->fileVCtype() == VCMINI) file_VCtype = "VC-mini";
+        if (MyVCbinaryFile->fileVCtype() == VCTOUCH) file_VCtype = "VC-touch";
+        if (QMessageBox::No == QMessageBox(QMessageBox::Warning, "Loading full backup", "File contains data for " + file_VCtype +" and VC-edit is set for " + VC_name + ". Are you sure you want to load this data?",
+                                        QMessageBox::Yes|QMessageBox::No).exec()) return;
+    }
+    if (dataEdited) {
+        if (QMessageBox::No == QMessageBox(QMessageBox::Warning, "Loading full backup", "All current data will be lost! Are you sure you want to proceed?",
+                                        QMessageBox::Yes|QMessageBox::No).exec()) return;
     }
-}
 
-QString MainWindow::checkHeaderContainsRightVCtype(const QJsonObject &json)
-{
-    if (!(json.contains("Header"))) return "";
-    QJsonObject headerObject = json["Header"].toObject();
-    if (!headerObject.contains("VC_type")) return ""; // Older versions of VC-edit files do not contain this data
-    if (headerObject["VC_type"].toInt() != VC_type) return headerObject["VC_name"].toString();
-    return "";
+    bool ok = MyVCbinaryFile->loadAll(); // Leaves the current data unchanged if the file is damaged
+    MyVCbinaryFile->close();
+    if (!ok) {
+        ui->statusbar->showMessage(MyVCbinaryFile->errorString(), STATUS_BAR_MESSAGE_TIME);
+        return;
+    }
+    updateTreeWidget(ui->treeWidget); // Will refresh the settings in the widget
+    updateCommandScreens(false);
+    fillPatchListBox(ui->patchListWidget);
+    updateUserDeviceTab();
+    ui->statusbar->showMessage(fileName + " opened", STATUS_BAR_MESSAGE_TIME);
 }
 
 void MainWindow::try_reconnect_MIDI()
@@ -889,50 +861,89 @@ QString MainWindow::addNonBreakingSpaces(QString text)
     return output;
 }
 
+void MainWindow::setupSimulator()
+{
+    // The simulator runs in its own thread, so the timestamps of the MIDI messages are not affected by the GUI
+    MyVCsimulator = new VCsimulator();
+    simulatorThread = new QThread(this);
+    MyVCsimulator->moveToThread(simulatorThread);
+    connect(simulatorThread, SIGNAL(finished()), MyVCsimulator, SLOT(deleteLater()));
+    connect(MyVCsimulator, SIGNAL(updateLcdDisplay(int, QString, QString)), this, SLOT(updateLcdDisplay(int, QString, QString)));
+    connect(MyVCsimulator, SIGNAL(setButtonColour(int,int)), this, SLOT(setButtonColour(int,int)));
+    connect(MyVCsimulator, SIGNAL(midiMessageSent(qint64, QString, QByteArray, QString)), this, SLOT(simulatorMidiMessageSent(qint64, QString, QByteArray, QString)));
+    connect(MyVCsimulator, SIGNAL(actionExecuted(qint64, QString)), this, SLOT(simulatorActionExecuted(qint64, QString)));
+    connect(MyVCsimulator, SIGNAL(switchLatency(int, qint64, qint64, int)), this, SLOT(simulatorSwitchLatency(int, qint64, qint64, int)));
+    connect(MyVCsimulator, SIGNAL(firmwareTimeEstimate(int, int, qint64, qint64)), this, SLOT(simulatorFirmwareTimeEstimate(int, int, qint64, qint64)));
+    simulatorThread->start();
+
+    simulatorLog = new QPlainTextEdit(this);
+    simulatorLog->setReadOnly(true);
+    simulatorLog->setMaximumBlockCount(500);
+    simulatorLog->setMaximumHeight(120);
+    simulatorLog->setStyleSheet("QPlainTextEdit {background-color: rgb(6, 19, 59); color: white; font-family: monospace; }");
+    simulatorLog->hide();
+    ui->tab_RemoteControl->layout()->addWidget(simulatorLog);
+
+    // The loop profiler statistics of a connected VController are shown on the remote control tab as well
+    profileLog = new QPlainTextEdit(this);
+    profileLog->setReadOnly(true);
+    profileLog->setMaximumHeight(200);
+    profileLog->setStyleSheet("QPlainTextEdit {background-color: rgb(6, 19, 59); color: white; font-family: monospace; }");
+    profileLog->hide();
+    ui->tab_RemoteControl->layout()->addWidget(profileLog);
+    connect(MyMidi, SIGNAL(profileTelemetry(QString)), this, SLOT(updateProfileTelemetry(QString)));
+}
+
 void MainWindow::startOfflineRemoteControl()
 {
-    ui->lcd0->setText("<html><head/><body><p style=\"line-height:.6\"><span>   Connect to   </span></p><p style=\"line-height:1\"><span>  " + VC_name + "  </p></span></body></html>");
     resetRemoteControlButtons();
-
-    if (VC_type == VCMINI) remoteBankSize = 3;
-    else remoteBankSize = 10;
-    for (uint8_t d = 0; d < remoteBankSize; d++) updateLcdDisplay(d + 1, centerLabel(Device[remoteDevice]->number_format(d)), centerLabel(Device[remoteDevice]->device_name + " Patch"));
-    setButtonColour(remotePatchNumber + 1, Device[remoteDevice]->my_LED_colour);
-    updateLcdDisplay(remoteBankSize + 1, centerLabel("<BANK DOWN>"), centerLabel(Device[remoteDevice]->device_name));
-    setButtonColour(remoteBankSize + 1, Device[remoteDevice]->my_LED_colour + 16);
-    updateLcdDisplay(remoteBankSize + 2, centerLabel("<BANK UP>"), centerLabel(Device[remoteDevice]->device_name));
-    setButtonColour(remoteBankSize + 2, Device[remoteDevice]->my_LED_colour + 16);
-    uint8_t next_device = remoteDevice + 1;
-    if (next_device >= NUMBER_OF_DEVICES) next_device = 0;
-    updateLcdDisplay(remoteBankSize + 3, centerLabel("<NEXT DEVICE>"), centerLabel(Device[next_device]->device_name));
-    setButtonColour(remoteBankSize + 3, Device[next_device]->my_LED_colour + 16);
+    MyVCsimulator->loadCommands(MyVCcommands, myLCDs.count()); // Read the commands here, as VCcommands is not thread safe
+    simulatorLog->clear();
+    simulatorLog->appendPlainText("Simulator started - connect to " + VC_name + " for remote control");
+    simulatorLog->show();
+    profileLog->hide();
+    QMetaObject::invokeMethod(MyVCsimulator, "start", Qt::QueuedConnection);
 }
 
 void MainWindow::offlineRemoteSwitchPressed(uint8_t sw)
 {
-   if (sw <= remoteBankSize) {
-     setButtonColour(remotePatchNumber + 1, 0);
-     remotePatchNumber = sw - 1;
-     setButtonColour(remotePatchNumber + 1, Device[remoteDevice]->my_LED_colour);
-   }
-   if (sw == remoteBankSize + 3) {
-       remoteDevice++;
-       if (remoteDevice >= NUMBER_OF_DEVICES) remoteDevice = 0;
-       startOfflineRemoteControl();
-   }
-   if ((sw >= remoteBankSize + 1) && (sw <= remoteBankSize + 3))
-       setButtonColour(sw, Device[remoteDevice]->my_LED_colour);
+    QMetaObject::invokeMethod(MyVCsimulator, "switchPressed", Qt::QueuedConnection, Q_ARG(int, sw));
 }
 
 void MainWindow::offlineRemoteSwitchReleased(uint8_t sw)
 {
-    if ((sw >= remoteBankSize + 1) && (sw <= remoteBankSize + 2))
-        setButtonColour(sw, Device[remoteDevice]->my_LED_colour + 16);
-    if (sw == remoteBankSize + 3) {
-        uint8_t next_device = remoteDevice + 1;
-        if (next_device >= NUMBER_OF_DEVICES) next_device = 0;
-        setButtonColour(remoteBankSize + 3, Device[next_device]->my_LED_colour + 16);
-    }
+    QMetaObject::invokeMethod(MyVCsimulator, "switchReleased", Qt::QueuedConnection, Q_ARG(int, sw));
+}
+
+void MainWindow::simulatorMidiMessageSent(qint64 time_us, QString port, QByteArray message, QString description)
+{
+    QString hex = "";
+    for (int b = 0; b < message.size(); b++) hex += QString("%1 ").arg((uint8_t)message[b], 2, 16, QChar('0')).toUpper();
+    simulatorLog->appendPlainText(QString("%1 ms  %2  %3 %4").arg(time_us / 1000.0, 10, 'f', 3).arg(port, -12).arg(hex, -10).arg(description));
+}
+
+void MainWindow::simulatorActionExecuted(qint64 time_us, QString description)
+{
+    simulatorLog->appendPlainText(QString("%1 ms  %2").arg(time_us / 1000.0, 10, 'f', 3).arg(description));
+}
+
+void MainWindow::simulatorSwitchLatency(int sw, qint64 first_latency_us, qint64 latency_us, int number_of_messages)
+{
+    if (number_of_messages == 0) return;
+    simulatorLog->appendPlainText("Switch " + QString::number(sw) + ": " + QString::number(number_of_messages) + " MIDI message(s) in " + QString::number(latency_us) + " us, first after " + QString::number(first_latency_us) + " us");
+}
+
+void MainWindow::simulatorFirmwareTimeEstimate(int sw, int number_of_commands, qint64 one_per_loop_us, qint64 batched_us)
+{
+    simulatorLog->appendPlainText("Switch " + QString::number(sw) + ": " + QString::number(number_of_commands) + " commands, estimated " + QString::number(batched_us) + " us on the " + VC_name
+                                  + " (" + QString::number(one_per_loop_us) + " us at one command per loop). Not measured: based on estimated loop and command times.");
+}
+
+void MainWindow::updateProfileTelemetry(QString report)
+{
+    if (!RemoteControlActive) return;
+    profileLog->setPlainText(report);
+    profileLog->show();
 }
 
 QString MainWindow::centerLabel(QString lbl)
@@ -1019,13 +1030,20 @@ void MainWindow::on_tabWidget_currentChanged(int index)
 {
     if (ui->tabWidget->tabText(index) == "Remote control") {
         RemoteControlActive = true;
-        if (VControllerConnected) MyMidi->sendSysexCommand(2, VC_REMOTE_CONTROL_ENABLE, 1);
+        if (VControllerConnected) {
+            MyMidi->sendSysexCommand(3, VC_REMOTE_CONTROL_ENABLE, 1, remoteRefreshRate);
+            MyMidi->sendSysexCommand(2, VC_REQUEST_PROFILE_TELEMETRY, 1);
+        }
         else startOfflineRemoteControl();
         qDebug() << "Remote control enabled";
     }
     else {
         RemoteControlActive = false;
-        if (VControllerConnected) MyMidi->sendSysexCommand(2, VC_REMOTE_CONTROL_ENABLE, 0);
+        if (VControllerConnected) {
+            MyMidi->sendSysexCommand(2, VC_REMOTE_CONTROL_ENABLE, 0);
+            MyMidi->sendSysexCommand(2, VC_REQUEST_PROFILE_TELEMETRY, 0);
+        }
+        profileLog->hide();
         qDebug() << "Remote control disabled";
     }
 
@@ -1170,7 +1188,7 @@ void MainWindow::on_actionSavePage_triggered()
     }
 
     QJsonObject saveObject;
-    writeHeader(saveObject, "PageData");
+    VCbackupFile::writeHeader(saveObject, "PageData");
     MyVCcommands->writePage(currentPage, saveObject);
     QJsonDocument saveDoc(saveObject);
     saveFile.write(saveDoc.toJson());
@@ -1373,9 +1391,11 @@ void MainWindow::VControllerDetected(int type, int versionMajor, int versionMino
     }
     VControllerConnected = true;
     updateStatusLabel();
+    simulatorLog->hide();
     if (RemoteControlActive) {
         // Bring the remote control online
-        MyMidi->sendSysexCommand(2, VC_REMOTE_CONTROL_ENABLE, 1);
+        MyMidi->sendSysexCommand(3, VC_REMOTE_CONTROL_ENABLE, 1, remoteRefreshRate);
+        MyMidi->sendSysexCommand(2, VC_REQUEST_PROFILE_TELEMETRY, 1);
     }
     MyMidi->MIDI_editor_request_hardware_version();
 }
@@ -1609,17 +1629,17 @@ void MainWindow::on_actionExport_triggered()
     QString patchHeader;
     if (type == EXT_SETLIST_TYPE) {
         patchHeader = "Setlist";
-        writeHeader(saveObject, patchHeader);
+        VCbackupFile::writeHeader(saveObject, patchHeader);
         setlistEditDialog::writeSetlistData(index, saveObject);
     }
     if (type == EXT_SONG_TYPE) {
         patchHeader = "Song";
-        writeHeader(saveObject, patchHeader);
+        VCbackupFile::writeHeader(saveObject, patchHeader);
         songEditDialog::writeSongData(index, saveObject);
     }
     if (type <= NUMBER_OF_DEVICES) {
         patchHeader = Device[dev]->patchFileHeader() + "Patch";
-        writeHeader(saveObject, patchHeader);
+        VCbackupFile::writeHeader(saveObject, patchHeader);
         MyVCdevices->writePatchData(index, saveObject);
     }
     QJsonDocument saveDoc(saveObject);
@@ -1647,7 +1667,7 @@ void MainWindow::on_actionImport_triggered()
     QByteArray saveData = loadFile.readAll();
     QJsonDocument loadDoc(QJsonDocument::fromJson(saveData));
     fileLoaded = true;
-    QString jsonType = readHeader(loadDoc.object());
+    QString jsonType = VCbackupFile::readHeader(loadDoc.object());
 
     int index = MyVCdevices->findIndex(currentDevicePatchType, patch_no);
     if (index == PATCH_INDEX_NOT_FOUND) index = MyVCdevices->newIndex();
@@ -2262,7 +2282,7 @@ void MainWindow::on_actionImport_Device_triggered()
     QByteArray saveData = loadFile.readAll();
     QJsonDocument loadDoc(QJsonDocument::fromJson(saveData));
     fileLoaded = true;
-    QString jsonType = readHeader(loadDoc.object());
+    QString jsonType = VCbackupFile::readHeader(loadDoc.object());
 
 
     if (jsonType == "User Device Data") {
@@ -2297,7 +2317,7 @@ void MainWindow::on_actionExport_Device_triggered()
     MyVCuserDevice->cleanUpUserDeviceNameItems();
 
     QJsonObject saveObject;
-    writeHeader(saveObject, "User Device Data");
+    VCbackupFile::writeHeader(saveObject, "User Device Data");
     //MyVCcommands->writePage(currentPage, saveObject);
     MyVCuserDevice->write(saveObject, current_instance, true);
     QJsonDocument saveDoc(saveObject);
@@ -9,6 +9,8 @@
 #include <QLabel>
 #include <QTimer>
 #include <QVBoxLayout>
+#include <QPlainTextEdit>
+#include <QThread>
 #include "midi.h"
 #include "vcsettings.h"
 #include "vcmidiswitchsettings.h"
@@ -16,17 +18,14 @@
 #include "vcdevices.h"
 #include "vccommands.h"
 #include "vcuserdevices.h"
+#include "vcbackupfile.h"
+#include "vcbinaryfile.h"
+#include "vcsimulator.h"
 #include "customlistwidget.h"
 #include "customswitch.h"
 #include "customled.h"
 #include "customdisplaylabel.h"
 
-// This version number is shown in the about dialog and also appears in all files created by VC-edit.
-// Version should be the same as the version shown on the VController of VC-mini
-#define VCMINI_FIRMWARE_VERSION_MAJOR 3
-#define VCMINI_FIRMWARE_VERSION_MINOR 12
-#define VCMINI_FIRMWARE_VERSION_BUILD 1
-
 #define STATUS_BAR_MESSAGE_TIME 2000
 #define EXIT_CODE_REBOOT 777
 
@@ -57,6 +56,11 @@ public slots:
     void updateUserDeviceTab();
     void updateUserDeviceNameWidget();
     void updateUserDeviceFullName();
+    void simulatorMidiMessageSent(qint64 time_us, QString port, QByteArray message, QString description);
+    void simulatorActionExecuted(qint64 time_us, QString description);
+    void simulatorSwitchLatency(int sw, qint64 first_latency_us, qint64 latency_us, int number_of_messages);
+    void simulatorFirmwareTimeEstimate(int sw, int number_of_commands, qint64 one_per_loop_us, qint64 batched_us);
+    void updateProfileTelemetry(QString report);
 
     // Menu actions - also appear in submenus (right click)
     void checkMenuItems();
@@ -202,14 +206,7 @@ private:
     void fillPatchTypeComboBox(QComboBox *my_combobox);
     void updateStatusLabel();
     void disconnect_VC();
-
-    // Loading and saving files
-    void writeHeader(QJsonObject &json, QString type);
-    void writeAllPatchData(QJsonObject &json) const;
-    QString readHeader(const QJsonObject &json);
-    void readAllPatchData(const QJsonObject &json);
-
-    QString checkHeaderContainsRightVCtype(const QJsonObject &json);
+    void openBinaryFile(QString fileName);
 
     void try_reconnect_MIDI();
     QString addNonBreakingSpaces(QString text);
@@ -219,6 +216,7 @@ private:
     void offlineRemoteSwitchPressed(uint8_t sw);
     void offlineRemoteSwitchReleased(uint8_t sw);
     QString centerLabel(QString lbl);
+    void setupSimulator();
 
     Ui::MainWindow *ui;
     bool booted = false;
@@ -229,6 +227,7 @@ private:
     QString MySaveUserDeviceFile;
     QString MyMidiInPort, MyMidiOutPort;
     bool MyMidiSlowMode;
+    int remoteRefreshRate; // Frames per second for the remote displays - sent to the VController when remote control is enabled
     Midi *MyMidi;
     QTimer *timer;
     VCsettings *MyVCsettings;
@@ -237,6 +236,8 @@ private:
     VCdevices *MyVCdevices;
     VCuserdevices * MyVCuserDevice;
     VCcommands *MyVCcommands;
+    VCbackupFile *MyVCbackupFile;
+    VCbinaryFile *MyVCbinaryFile;
     int currentPage = 0;
     int previousPage = 0;
     int currentSwitch = -1;
@@ -257,9 +258,10 @@ private:
     QVector< CustomLED * > myLEDs;
     QVector< customDisplayLabel * > myLCDs;
 
-    uint8_t remoteDevice = KTN;
-    uint8_t remotePatchNumber = 0;
-    uint8_t remoteBankSize;
+    VCsimulator *MyVCsimulator;
+    QThread *simulatorThread;
+    QPlainTextEdit *simulatorLog;
+    QPlainTextEdit *profileLog; // Shows the loop profiler statistics of the VController during remote control
 };
 
 #endif // MAINWINDOW_H
@@ -60,6 +60,22 @@ void Midi::closeMidiOut()
     _midiOut->closePort();
 }
 
+void Midi::openVirtualMidiPorts(QString name)
+{
+    // Virtual ports are only supported on Mac and Linux. Used by VC-edit-cli for loopback testing.
+    try {
+        _midiIn->closePort();
+        _midiIn->openVirtualPort(name.toStdString());
+        _midiIn->ignoreTypes( false, true, true ); // Ignore timing and active sensing, but not sysex
+        _midiOut->closePort();
+        _midiOut->openVirtualPort(name.toStdString());
+        std::cout << "Opened virtual MIDI ports " << name.toStdString() << std::endl;
+    }
+    catch ( RtMidiError &error ) {
+        error.printMessage();
+    }
+}
+
 void Midi::checkForVCmidi()
 {
     std::string portName;
@@ -193,7 +209,7 @@ void Midi::sendSysexCommand(int size, ...) {
     for(int i = 0; i < size; i++)
         message.push_back( va_arg(data, int ));
     message.push_back( 0xF7 );
-    _midiOut->sendMessage(&message);
+    sendMessage(&message);
 }
 
 void Midi::staticMidiCallback(double, std::vector<unsigned char> *message, void *userData) // Static member!
@@ -211,6 +227,9 @@ void Midi::checkMidiIn(std::vector<unsigned char> *message)
 
     //MIDI_debug_data(message, true);
 
+    _messagesReceived++;
+    _bytesReceived += message->size();
+
     if (message->size() < 7) return;
 
     // Check if it is a universal response message from the VController
@@ -235,11 +254,21 @@ void Midi::checkMidiIn(std::vector<unsigned char> *message)
             for (int i = 0; i < dsize; i++) { // Read line 1
                 line1.append(addChar(message->at(index++)));
             }
-            for (int i = 0; i < 16; i++) { // Read line 2
+            for (int i = 0; i < dsize; i++) { // Read line 2
                 line2.append(addChar(message->at(index++)));
             }
+            if (message->at(6) < REMOTE_MAX_NUMBER_OF_DISPLAYS) {
+                remoteDisplayLine[message->at(6)][0] = line1;
+                remoteDisplayLine[message->at(6)][1] = line2;
+            }
             emit updateLcdDisplay(message->at(6), line1, line2);
             break;
+        case VC_REMOTE_UPDATE_FRAME:
+            MIDI_editor_receive_remote_frame(message);
+            break;
+        case VC_PROFILE_TELEMETRY:
+            MIDI_editor_receive_profile_telemetry(message);
+            break;
         case VC_REMOTE_UPDATE_LEDS:
             number_of_leds = message->at(6);
             for (int i = 0; i < number_of_leds; i++) {
@@ -279,6 +308,7 @@ void Midi::checkMidiIn(std::vector<unsigned char> *message)
         case VC_REQUEST_HARDWARE_VERSION:
             VC_hardware_version = message->at(6);
             qDebug() << "Hardware version:" << VC_hardware_version;
+            emit hardwareVersionReceived(VC_hardware_version);
             break;
         case VC_SAVE_USER_DEVICE_SETTINGS:
             MIDI_editor_receive_user_device_settings(message);
@@ -385,7 +415,7 @@ void Midi::MIDI_editor_send_finish_commands_dump()
     message.push_back((uint8_t)((Commands.size() >> 7) & 0x7F));
     message.push_back((uint8_t)(Commands.size() & 0x7F));
     message.push_back( 0xF7 );
-    _midiOut->sendMessage(&message);
+    sendMessage(&message);
     MIDI_debug_data(&message, false);
 }
 
@@ -443,7 +473,7 @@ void Midi::send_7_bit_overflow_data(QByteArray data, uint16_t datalen, uint8_t c
       }
     }
     message.push_back( 0xF7 );
-    _midiOut->sendMessage(&message);
+    sendMessage(&message);
     MIDI_debug_data(&message, false);
     QThread::msleep(10);
 }
@@ -463,7 +493,7 @@ void Midi::MIDI_send_initialize_device_patch(uint16_t patch_no)
     message.push_back( patch_no >> 7 );
     message.push_back( patch_no & 0x7F );
     message.push_back( 0xF7 );
-    _midiOut->sendMessage(&message);
+    sendMessage(&message);
     MIDI_debug_data(&message, false);
     QThread::msleep(1);
 }
@@ -525,7 +555,7 @@ void Midi::send_universal_identity_request()
     message.push_back( 0x06 );
     message.push_back( 0x01 );
     message.push_back( 0xF7 );
-    _midiOut->sendMessage(&message);
+    sendMessage(&message);
 
     qDebug() << "Sent Universal Identity Request";
 }
@@ -537,6 +567,21 @@ void Midi::MIDI_select_patch_on_device(uint8_t dev, uint16_t patch)
     MIDI_send_data(VC_SELECT_PATCH_FROM_EDITOR, data, 4);
 }
 
+void Midi::resetTransferCounters()
+{
+    _messagesSent = 0;
+    _messagesReceived = 0;
+    _bytesSent = 0;
+    _bytesReceived = 0;
+}
+
+void Midi::sendMessage(std::vector<unsigned char> *message)
+{
+    _midiOut->sendMessage(message);
+    _messagesSent++;
+    _bytesSent += message->size();
+}
+
 QString Midi::addChar(unsigned char c) {
     switch ((int)c) {
       case 5: return "^";
@@ -563,7 +608,7 @@ void Midi::MIDI_send_data(uint8_t cmd, uint8_t *my_data, uint16_t my_len)
         message.push_back(my_data[i] & 0x7F);
     }
     message.push_back( 0xF7 );
-    _midiOut->sendMessage(&message);
+    sendMessage(&message);
     MIDI_debug_data(&message, false);
     QThread::msleep(10);
 }
@@ -765,6 +810,95 @@ void Midi::MIDI_editor_receive_user_name_item(std::vector<unsigned char> *messag
     emit updateProgressBar(NUMBER_OF_USER_DEVICES + User_device_data_item.size());
 }
 
+void Midi::MIDI_editor_receive_remote_frame(std::vector<unsigned char> *message)
+{
+    // A frame contains only the changed characters and LEDs. Every display that changed is redrawn once per frame.
+    bool display_changed[REMOTE_MAX_NUMBER_OF_DISPLAYS] = { false };
+    unsigned int index = 6;
+    while (index + 1 < message->size()) {
+        uint8_t record = message->at(index);
+        if (record == REMOTE_FRAME_LED_RECORD) {
+            if (index + 2 >= message->size()) break;
+            emit updateLED(message->at(index + 1) + 1, message->at(index + 2));
+            index += 3;
+        }
+        else if (record == REMOTE_FRAME_DISPLAY_RECORD) {
+            if (index + 4 >= message->size()) break;
+            uint8_t number = message->at(index + 1);
+            uint8_t line = message->at(index + 2) & 1;
+            uint8_t first = message->at(index + 3);
+            uint8_t len = message->at(index + 4);
+            index += 5;
+            if (index + len >= message->size()) break;
+            if (number < REMOTE_MAX_NUMBER_OF_DISPLAYS) {
+                QString &text = remoteDisplayLine[number][line];
+                if (text.size() < first + len) text = text.leftJustified(first + len, ' ');
+                for (uint8_t c = 0; c < len; c++) text[first + c] = addChar(message->at(index + c)).at(0);
+                display_changed[number] = true;
+            }
+            index += len;
+        }
+        else break; // Unknown record or end of message
+    }
+
+    for (uint8_t d = 0; d < REMOTE_MAX_NUMBER_OF_DISPLAYS; d++) {
+        if (display_changed[d]) emit updateLcdDisplay(d, remoteDisplayLine[d][0], remoteDisplayLine[d][1]);
+    }
+}
+
+void Midi::MIDI_editor_receive_profile_telemetry(std::vector<unsigned char> *message)
+{
+    // Values are sent as three 7-bit bytes, except for the queue depth, batch size and the numbers of subsystems and bins
+    const QStringList subsystem_names = { "Switch check", "Switch control", "LED control", "LCD control", "MIDI common", "Page", "Devices", "EEPROM" };
+    unsigned int index = 6;
+    auto read_value = [&]() -> uint32_t {
+        if (index + 3 > message->size()) return 0;
+        uint32_t value = (message->at(index) << 14) | (message->at(index + 1) << 7) | message->at(index + 2);
+        index += 3;
+        return value;
+    };
+    auto read_byte = [&]() -> uint8_t {
+        if (index >= message->size()) return 0;
+        return message->at(index++);
+    };
+
+    uint32_t time_ms = read_value();
+    uint32_t loops = read_value();
+    uint8_t queue_depth = read_byte();
+    uint32_t events_lost = read_value();
+    uint8_t batch_size = read_byte();
+    uint8_t number_of_subsystems = read_byte();
+    if (time_ms == 0) return;
+
+    QString report = QString("Loop rate: %1 loops/s (%2 loops in %3 ms)\n").arg(loops * 1000 / time_ms).arg(loops).arg(time_ms);
+    report += QString("Switch event queue: max depth %1, %2 events lost. Max commands per batch: %3\n").arg(queue_depth).arg(events_lost).arg(batch_size);
+    report += QString("%1 %2 %3 %4 %5 (us)").arg("Subsystem", -16).arg("min", 8).arg("avg", 8).arg("max", 8).arg("p99", 8);
+    for (uint8_t s = 0; s < number_of_subsystems; s++) {
+        QString name = (s < subsystem_names.size()) ? subsystem_names[s] : "Subsystem " + QString::number(s + 1);
+        uint32_t min = read_value();
+        uint32_t avg = read_value();
+        uint32_t max = read_value();
+        uint32_t p99 = read_value();
+        report += QString("\n%1 %2 %3 %4 %5").arg(name, -16).arg(min, 8).arg(avg, 8).arg(max, 8).arg(p99, 8);
+    }
+
+    // Switch latency histogram (from the switch edge to the first MIDI message) with bins of one ms. Older firmware does not send it.
+    if (index + 4 <= message->size()) {
+        uint32_t latency_count = read_value();
+        uint8_t number_of_bins = read_byte();
+        report += QString("\nSwitch latency (edge to first MIDI message) of %1 switch events:").arg(latency_count);
+        QString bins = "";
+        for (uint8_t b = 0; b < number_of_bins; b++) {
+            uint32_t count = read_value();
+            if (count == 0) continue;
+            if (b == number_of_bins - 1) bins += QString(" >=%1 ms: %2").arg(b).arg(count);
+            else bins += QString(" %1 ms: %2").arg(b).arg(count);
+        }
+        report += "\n" + bins;
+    }
+    emit profileTelemetry(report);
+}
+
 bool Midi::receive_7_bit_overflow_data(QByteArray *data, uint16_t datalen, std::vector<unsigned char> *message)
 {
     if (!data || !message || message->size() < 9) {
@@ -44,6 +44,16 @@
 #define VC_REQUEST_ALL_USER_DEVICE_SETTINGS 25
 #define VC_INITIALIZE_USER_DEVICE_DATA 26
 #define VC_SELECT_PATCH_FROM_EDITOR 27
+#define VC_REMOTE_UPDATE_FRAME 28
+
+// Records in the VC_REMOTE_UPDATE_FRAME message
+#define REMOTE_FRAME_DISPLAY_RECORD 1 // Followed by: display number, line, first character, number of characters, characters
+#define REMOTE_FRAME_LED_RECORD 2 // Followed by: LED number, colour
+#define REMOTE_MAX_NUMBER_OF_DISPLAYS 16
+#define REMOTE_DEFAULT_REFRESH_RATE 25 // Frames per second the VController sends remote display updates at
+
+#define VC_REQUEST_PROFILE_TELEMETRY 29 // Followed by: on/off
+#define VC_PROFILE_TELEMETRY 30 // Statistics of the loop profiler of the VController, sent every 500 ms while requested
 
 class Midi : public QObject
 {
@@ -55,6 +65,7 @@ public:
     void openMidiOut(QString port);
     void closeMidiIn();
     void closeMidiOut();
+    void openVirtualMidiPorts(QString name);
     void checkForVCmidi();
     bool checkMidiPortStillAvailable(QString inPort, QString outPort);
     QStringList fillMidiInPortItems();
@@ -82,6 +93,11 @@ public:
     void MIDI_editor_send_all_user_device_data();
     void send_universal_identity_request();
     void MIDI_select_patch_on_device(uint8_t dev, uint16_t patch);
+    void resetTransferCounters();
+    int messagesSent() { return _messagesSent; }
+    int messagesReceived() { return _messagesReceived; }
+    qint64 bytesSent() { return _bytesSent; }
+    qint64 bytesReceived() { return _bytesReceived; }
 
 signals:
     void updateSettings();
@@ -94,11 +110,18 @@ signals:
     void VControllerDetected(int type, int versionMajor, int versionMinor, int versionBuild);
     void updatePatchListBox();
     void updateUserDeviceTab();
+    void profileTelemetry(QString report);
+    void hardwareVersionReceived(int version);
 
 private:
     static void staticMidiCallback(double, std::vector< unsigned char > *message, void *userData);
     RtMidiIn* _midiIn = 0;
     RtMidiOut* _midiOut = 0;
+    int _messagesSent = 0;
+    int _messagesReceived = 0;
+    qint64 _bytesSent = 0;
+    qint64 _bytesReceived = 0;
+    void sendMessage(std::vector<unsigned char> *message);
     //QString sysxBuffer;
     QString addChar(unsigned char c);
     void MIDI_read_data(std::vector< unsigned char > *message, uint8_t *my_data, uint16_t my_len);
@@ -116,6 +139,9 @@ private:
     void MIDI_editor_receive_finish_device_patch_dump(std::vector< unsigned char > *message);
     void MIDI_editor_receive_user_device_settings(std::vector< unsigned char > *message);
     void MIDI_editor_receive_user_name_item(std::vector< unsigned char > *message);
+    void MIDI_editor_receive_remote_frame(std::vector< unsigned char > *message);
+    void MIDI_editor_receive_profile_telemetry(std::vector< unsigned char > *message);
+    QString remoteDisplayLine[REMOTE_MAX_NUMBER_OF_DISPLAYS][2]; // What is on the remote displays - frames only contain the changes
     bool receive_7_bit_overflow_data(QByteArray *data, uint16_t datalen, std::vector<unsigned char> *message);
     QByteArray ReadPatch(int number);
     void WritePatch(int number, QByteArray patch);
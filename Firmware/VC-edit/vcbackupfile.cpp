@@ -0,0 +1,140 @@
+#include "vcbackupfile.h"
+#include "VController/config.h"
+#include "VController/globals.h"
+#include "VController/globaldevices.h"
+#include "setlisteditdialog.h"
+#include "songeditdialog.h"
+
+#include <QFile>
+#include <QJsonDocument>
+
+VCbackupFile::VCbackupFile(VCsettings *settings, VCmidiSwitches *midiSwitches, VCseqPattern *seqPatterns,
+                           VCdevices *devices, VCuserdevices *userDevices, VCcommands *commands, QObject *parent) : QObject(parent),
+    MyVCsettings(settings), MyVCmidiSwitches(midiSwitches), MyVCseqPatterns(seqPatterns),
+    MyVCdevices(devices), MyVCuserDevice(userDevices), MyVCcommands(commands)
+{
+
+}
+
+void VCbackupFile::writeHeader(QJsonObject &json, QString type)
+{
+    QJsonObject headerObject;
+    headerObject["Source"] = "VC-edit";
+    headerObject["Version"] = QString::number(VCMINI_FIRMWARE_VERSION_MAJOR) + "." + QString::number(VCMINI_FIRMWARE_VERSION_MINOR) + "." + QString::number(VCMINI_FIRMWARE_VERSION_BUILD);
+    headerObject["Type"] = type;
+    headerObject["VC_type"] = VC_type;
+    headerObject["VC_name"] = VC_name;
+    json["Header"] = headerObject;
+}
+
+QString VCbackupFile::readHeader(const QJsonObject &json)
+{
+    if (!(json.contains("Header"))) return "";
+    QJsonObject headerObject = json["Header"].toObject();
+    if (!(headerObject["Source"].toString() == "VC-edit")) return "";
+    return headerObject["Type"].toString();
+}
+
+QString VCbackupFile::checkHeaderContainsRightVCtype(const QJsonObject &json)
+{
+    if (!(json.contains("Header"))) return "";
+    QJsonObject headerObject = json["Header"].toObject();
+    if (!headerObject.contains("VC_type")) return ""; // Older versions of VC-edit files do not contain this data
+    if (headerObject["VC_type"].toInt() != VC_type) return headerObject["VC_name"].toString();
+    return "";
+}
+
+int VCbackupFile::headerVCtype(const QJsonObject &json)
+{
+    QJsonObject headerObject = json["Header"].toObject();
+    if (!headerObject.contains("VC_type")) return -1;
+    return headerObject["VC_type"].toInt();
+}
+
+void VCbackupFile::readFullBackup(const QJsonObject &json)
+{
+    MyVCsettings->read(json);
+    MyVCmidiSwitches->read(json);
+    MyVCseqPatterns->read(json);
+    MyVCdevices->read(json);
+    MyVCuserDevice->readAll(json);
+    MyVCcommands->readAll(json);
+    //MyVCdevices->readAll(json);
+    readAllPatchData(json);
+    MyVCdevices->readAllLegacyKatana(json);
+}
+
+void VCbackupFile::writeFullBackup(QJsonObject &json)
+{
+    writeHeader(json, "FullBackup");
+    MyVCsettings->write(json);
+    MyVCmidiSwitches->write(json);
+    MyVCseqPatterns->write(json);
+    MyVCdevices->write(json);
+    MyVCcommands->writeAll(json);
+    MyVCuserDevice->writeAll(json);
+    writeAllPatchData(json);
+    //MyVCdevices->writeAll(json);
+}
+
+void VCbackupFile::writeAllPatchData(QJsonObject &json) const
+{
+    QJsonObject allPatches;
+    for (int p = 0; p < MAX_NUMBER_OF_DEVICE_PRESETS; p++) {
+        uint8_t my_type = Device_patches[p][0];
+        int patch_no = (Device_patches[p][1] << 8) + Device_patches[p][2];
+        if (my_type > 0) {
+            QJsonObject patchObject;
+            patchObject["Device type"] = my_type;
+            patchObject["Device patch number"] = patch_no;
+            if ((my_type > 0) && (my_type <= NUMBER_OF_DEVICES)) MyVCdevices->writePatchData(p, patchObject);
+            if (my_type == EXT_SETLIST_TYPE) setlistEditDialog::writeSetlistData(p, patchObject);
+            if (my_type == EXT_SONG_TYPE) songEditDialog::writeSongData(p, patchObject);
+            allPatches["Patch_" + QString::number(p)] = patchObject;
+        }
+        //patchArray.append(patchObject);
+    }
+    json["Device Patches"] = allPatches;
+}
+
+void VCbackupFile::readAllPatchData(const QJsonObject &json)
+{
+    int my_type, patch_no;
+    QJsonObject allPatches = json["Device Patches"].toObject();
+    for (int p = 0; p < MAX_NUMBER_OF_DEVICE_PRESETS; p++) {
+        QJsonObject patchObject = allPatches["Patch_" + QString::number(p)].toObject();
+        if (!patchObject.isEmpty()) {
+            my_type = patchObject["Device type"].toInt();
+            patch_no = patchObject["Device patch number"].toInt();
+            int index = MyVCdevices->findIndex(my_type, patch_no);
+            if (index == PATCH_INDEX_NOT_FOUND) index = MyVCdevices->newIndex();
+            if (index != PATCH_INDEX_NOT_FOUND) { // Not out of memory
+                if ((my_type > 0) && (my_type <= NUMBER_OF_DEVICES)) MyVCdevices->readPatchData(patch_no, patchObject, my_type);
+                if (my_type == EXT_SETLIST_TYPE) setlistEditDialog::readSetlistData(patch_no, patchObject, my_type, index);
+                if (my_type == EXT_SONG_TYPE) songEditDialog::readSongData(patch_no, patchObject, my_type, index);
+                allPatches["Patch_" + QString::number(p)] = patchObject;
+            }
+        }
+    }
+}
+
+bool VCbackupFile::loadJsonFile(QString fileName, QJsonObject &json)
+{
+    QFile loadFile(fileName);
+    if (!loadFile.open(QIODevice::ReadOnly)) return false;
+
+    QByteArray saveData = loadFile.readAll();
+    QJsonDocument loadDoc(QJsonDocument::fromJson(saveData));
+    json = loadDoc.object();
+    return true;
+}
+
+bool VCbackupFile::saveJsonFile(QString fileName, const QJsonObject &json)
+{
+    QFile saveFile(fileName);
+    if (!saveFile.open(QIODevice::WriteOnly)) return false;
+
+    QJsonDocument saveDoc(json);
+    saveFile.write(saveDoc.toJson());
+    return true;
+}
@@ -0,0 +1,56 @@
+#ifndef VCBACKUPFILE_H
+#define VCBACKUPFILE_H
+
+// VCbackupFile reads and writes the VC-edit data files (*.vcd).
+// It is shared between the main window of VC-edit and the command line tool VC-edit-cli, so it must not depend on any window.
+
+#include "vcsettings.h"
+#include "vcmidiswitchsettings.h"
+#include "vcseqpattern.h"
+#include "vcdevices.h"
+#include "vccommands.h"
+#include "vcuserdevices.h"
+
+#include <QObject>
+#include <QString>
+#include <QJsonObject>
+
+// This version number is shown in the about dialog and also appears in all files created by VC-edit.
+// Version should be the same as the version shown on the VController of VC-mini
+#define VCMINI_FIRMWARE_VERSION_MAJOR 3
+#define VCMINI_FIRMWARE_VERSION_MINOR 12
+#define VCMINI_FIRMWARE_VERSION_BUILD 1
+
+class VCbackupFile : public QObject
+{
+    Q_OBJECT
+public:
+    explicit VCbackupFile(VCsettings *settings, VCmidiSwitches *midiSwitches, VCseqPattern *seqPatterns,
+                          VCdevices *devices, VCuserdevices *userDevices, VCcommands *commands, QObject *parent = nullptr);
+
+    // Header
+    static void writeHeader(QJsonObject &json, QString type);
+    static QString readHeader(const QJsonObject &json);
+    static QString checkHeaderContainsRightVCtype(const QJsonObject &json);
+    static int headerVCtype(const QJsonObject &json);
+
+    // Full backup
+    void readFullBackup(const QJsonObject &json);
+    void writeFullBackup(QJsonObject &json);
+    void readAllPatchData(const QJsonObject &json);
+    void writeAllPatchData(QJsonObject &json) const;
+
+    // File access
+    static bool loadJsonFile(QString fileName, QJsonObject &json);
+    static bool saveJsonFile(QString fileName, const QJsonObject &json);
+
+private:
+    VCsettings *MyVCsettings;
+    VCmidiSwitches *MyVCmidiSwitches;
+    VCseqPattern *MyVCseqPatterns;
+    VCdevices *MyVCdevices;
+    VCuserdevices *MyVCuserDevice;
+    VCcommands *MyVCcommands;
+};
+
+#endif // VCBACKUPFILE_H
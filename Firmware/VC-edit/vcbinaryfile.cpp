@@ -0,0 +1,310 @@
+#include "vcbinaryfile.h"
+#include "vcbackupfile.h"
+#include "VController/config.h"
+#include "VController/globals.h"
+#include "VController/globaldevices.h"
+
+#include <QDataStream>
+#include <QFileInfo>
+#include <QDebug>
+#include <cstring>
+
+#define VCB_MAGIC "VCB1"
+#define VCB_HEADER_SIZE 12
+#define VCB_DIRECTORY_ENTRY_SIZE 16
+
+VCbinaryFile::VCbinaryFile(VCcommands *commands, QObject *parent) : QObject(parent), MyVCcommands(commands)
+{
+
+}
+
+VCbinaryFile::~VCbinaryFile()
+{
+    close();
+}
+
+bool VCbinaryFile::isBinaryFileName(QString fileName)
+{
+    return (QFileInfo(fileName).suffix().toLower() == "vcb");
+}
+
+// ********************************* Writing *********************************
+
+bool VCbinaryFile::save(QString fileName)
+{
+    const QStringList ids = { VCB_CHUNK_SETTINGS, VCB_CHUNK_DEVICE_SETTINGS, VCB_CHUNK_MIDI_SWITCHES, VCB_CHUNK_SEQ_PATTERNS,
+                              VCB_CHUNK_COMMANDS, VCB_CHUNK_DEVICE_PATCHES, VCB_CHUNK_USER_DEVICES, VCB_CHUNK_USER_DEVICE_ITEMS };
+
+    QVector<QByteArray> chunk_data;
+    QVector<quint32> item_sizes;
+    QVector<quint32> item_counts;
+    for (const QString &id : ids) {
+        quint32 item_size, item_count;
+        chunk_data.append(getChunkData(id, item_size, item_count));
+        item_sizes.append(item_size);
+        item_counts.append(item_count);
+    }
+
+    close(); // In case we are saving to the file we have open
+    QFile saveFile(fileName);
+    if (!saveFile.open(QIODevice::WriteOnly)) {
+        error = "Couldn't open " + fileName;
+        return false;
+    }
+
+    QDataStream out(&saveFile);
+    out.setByteOrder(QDataStream::LittleEndian);
+    out.writeRawData(VCB_MAGIC, 4);
+    out << (quint16) VCB_FORMAT_VERSION;
+    out << (quint8) VC_type;
+    out << (quint8) VCMINI_FIRMWARE_VERSION_MAJOR << (quint8) VCMINI_FIRMWARE_VERSION_MINOR << (quint8) VCMINI_FIRMWARE_VERSION_BUILD;
+    out << (quint16) ids.size();
+
+    quint32 offset = VCB_HEADER_SIZE + (ids.size() * VCB_DIRECTORY_ENTRY_SIZE);
+    for (int c = 0; c < ids.size(); c++) {
+        out.writeRawData(ids[c].toLatin1().constData(), 4);
+        out << offset << item_sizes[c] << item_counts[c];
+        offset += chunk_data[c].size();
+    }
+    for (int c = 0; c < ids.size(); c++) {
+        out.writeRawData(chunk_data[c].constData(), chunk_data[c].size());
+    }
+    return (out.status() == QDataStream::Ok);
+}
+
+QByteArray VCbinaryFile::getChunkData(QString chunkId, quint32 &item_size, quint32 &item_count)
+{
+    QByteArray data;
+    item_size = expectedItemSize(chunkId);
+    item_count = 0;
+
+    if (chunkId == VCB_CHUNK_SETTINGS) {
+        data.append((const char*)&Setting, sizeof(Setting));
+        item_count = 1;
+    }
+    if (chunkId == VCB_CHUNK_DEVICE_SETTINGS) {
+        for (int d = 0; d < NUMBER_OF_DEVICES; d++) {
+            for (int i = 0; i < NUMBER_OF_DEVICE_SETTINGS; i++) data.append(Device[d]->get_setting(i));
+        }
+        item_count = NUMBER_OF_DEVICES;
+    }
+    if (chunkId == VCB_CHUNK_MIDI_SWITCHES) {
+        data.append((const char*)MIDI_switch, sizeof(MIDI_switch));
+        item_count = NUMBER_OF_MIDI_SWITCHES;
+    }
+    if (chunkId == VCB_CHUNK_SEQ_PATTERNS) {
+        data.append((const char*)MIDI_seq_pattern, NUMBER_OF_SEQ_PATTERNS * EEPROM_SEQ_PATTERN_SIZE);
+        item_count = NUMBER_OF_SEQ_PATTERNS;
+    }
+    if (chunkId == VCB_CHUNK_COMMANDS) {
+        data.append((const char*)Commands.constData(), Commands.size() * sizeof(Cmd_struct));
+        item_count = Commands.size();
+    }
+    if (chunkId == VCB_CHUNK_DEVICE_PATCHES) {
+        data.append((const char*)Device_patches, MAX_NUMBER_OF_DEVICE_PRESETS * VC_PATCH_SIZE);
+        item_count = MAX_NUMBER_OF_DEVICE_PRESETS;
+    }
+    if (chunkId == VCB_CHUNK_USER_DEVICES) {
+        for (int d = 0; d < NUMBER_OF_USER_DEVICES; d++) {
+            User_device_struct userdata = USER_device[d]->get_device_data();
+            data.append((const char*)&userdata, sizeof(userdata));
+        }
+        item_count = NUMBER_OF_USER_DEVICES;
+    }
+    if (chunkId == VCB_CHUNK_USER_DEVICE_ITEMS) {
+        data.append((const char*)User_device_data_item.constData(), User_device_data_item.size() * sizeof(User_device_name_struct));
+        item_count = User_device_data_item.size();
+    }
+    return data;
+}
+
+quint32 VCbinaryFile::expectedItemSize(QString chunkId)
+{
+    if (chunkId == VCB_CHUNK_SETTINGS) return sizeof(Setting);
+    if (chunkId == VCB_CHUNK_DEVICE_SETTINGS) return NUMBER_OF_DEVICE_SETTINGS;
+    if (chunkId == VCB_CHUNK_MIDI_SWITCHES) return sizeof(MIDI_switch_settings_struct);
+    if (chunkId == VCB_CHUNK_SEQ_PATTERNS) return EEPROM_SEQ_PATTERN_SIZE;
+    if (chunkId == VCB_CHUNK_COMMANDS) return sizeof(Cmd_struct);
+    if (chunkId == VCB_CHUNK_DEVICE_PATCHES) return VC_PATCH_SIZE;
+    if (chunkId == VCB_CHUNK_USER_DEVICES) return sizeof(User_device_struct);
+    if (chunkId == VCB_CHUNK_USER_DEVICE_ITEMS) return sizeof(User_device_name_struct);
+    return 0;
+}
+
+// ********************************* Reading *********************************
+
+bool VCbinaryFile::open(QString fileName)
+{
+    close();
+    file.setFileName(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        error = "Couldn't open " + fileName;
+        return false;
+    }
+
+    QDataStream in(&file);
+    in.setByteOrder(QDataStream::LittleEndian);
+    char magic[4];
+    quint16 format_version, number_of_chunks;
+    quint8 type, major, minor, build;
+    in.readRawData(magic, 4);
+    in >> format_version >> type >> major >> minor >> build >> number_of_chunks;
+    if ((in.status() != QDataStream::Ok) || (memcmp(magic, VCB_MAGIC, 4) != 0)) {
+        error = fileName + " is not a VC-edit binary file";
+        close();
+        return false;
+    }
+    if (format_version > VCB_FORMAT_VERSION) {
+        error = fileName + " was made with a newer version of VC-edit";
+        close();
+        return false;
+    }
+    file_VC_type = type;
+    file_version = QString::number(major) + "." + QString::number(minor) + "." + QString::number(build);
+
+    for (int c = 0; c < number_of_chunks; c++) {
+        char id[4];
+        Chunk_struct chunk;
+        in.readRawData(id, 4);
+        in >> chunk.offset >> chunk.item_size >> chunk.item_count;
+        chunk.id = QString::fromLatin1(id, 4);
+        chunk.loaded = false;
+        chunks.append(chunk);
+    }
+    if (in.status() != QDataStream::Ok) {
+        error = fileName + " is damaged";
+        close();
+        return false;
+    }
+    return true;
+}
+
+void VCbinaryFile::close()
+{
+    if (file.isOpen()) file.close();
+    chunks.clear();
+}
+
+bool VCbinaryFile::loadChunk(QString chunkId)
+{
+    int c = findChunk(chunkId);
+    if (c < 0) return false; // Chunk not in file - data remains unchanged
+    if (chunks[c].loaded) return true;
+
+    QByteArray data;
+    if (!readChunk(c, data)) return false;
+    putChunkData(chunkId, data, chunks[c].item_size, chunks[c].item_count);
+    chunks[c].loaded = true;
+    return true;
+}
+
+bool VCbinaryFile::loadAll()
+{
+    // All chunks are read and checked before any of them is applied, so a damaged file leaves the current data unchanged
+    QVector<QByteArray> chunk_data(chunks.size());
+    for (int c = 0; c < chunks.size(); c++) {
+        if ((!chunks[c].loaded) && (!readChunk(c, chunk_data[c]))) return false;
+    }
+    for (int c = 0; c < chunks.size(); c++) {
+        if (chunks[c].loaded) continue;
+        putChunkData(chunks[c].id, chunk_data[c], chunks[c].item_size, chunks[c].item_count);
+        chunks[c].loaded = true;
+    }
+    return true;
+}
+
+bool VCbinaryFile::readChunk(int c, QByteArray &data)
+{
+    QString chunkId = chunks[c].id;
+    bool older_settings = ((chunkId == VCB_CHUNK_SETTINGS) && (chunks[c].item_size < sizeof(Setting))); // New settings are added at the end of the settings struct
+    bool older_device_settings = ((chunkId == VCB_CHUNK_DEVICE_SETTINGS) && (chunks[c].item_size > 0) && (chunks[c].item_size < expectedItemSize(chunkId))); // New device settings are added at the end
+    if ((chunks[c].item_size != expectedItemSize(chunkId)) && (!older_settings) && (!older_device_settings)) {
+        error = "Chunk " + chunkId + " has an incompatible format";
+        return false;
+    }
+    qint64 size = (qint64) chunks[c].item_size * chunks[c].item_count;
+    if ((!file.seek(chunks[c].offset)) || (chunks[c].offset + size > file.size())) {
+        error = "Chunk " + chunkId + " is damaged";
+        return false;
+    }
+    data = file.read(size);
+    if (data.size() != size) {
+        error = "Chunk " + chunkId + " is damaged";
+        return false;
+    }
+    return true;
+}
+
+bool VCbinaryFile::isChunkLoaded(QString chunkId)
+{
+    int c = findChunk(chunkId);
+    if (c < 0) return false;
+    return chunks[c].loaded;
+}
+
+QStringList VCbinaryFile::chunkIds()
+{
+    QStringList ids;
+    for (const Chunk_struct &chunk : chunks) ids.append(chunk.id);
+    return ids;
+}
+
+int VCbinaryFile::chunkItemCount(QString chunkId)
+{
+    int c = findChunk(chunkId);
+    if (c < 0) return 0;
+    return chunks[c].item_count;
+}
+
+int VCbinaryFile::findChunk(QString chunkId)
+{
+    for (int c = 0; c < chunks.size(); c++) {
+        if (chunks[c].id == chunkId) return c;
+    }
+    return -1;
+}
+
+void VCbinaryFile::putChunkData(QString chunkId, const QByteArray &data, quint32 item_size, quint32 item_count)
+{
+    const char *bytes = data.constData();
+
+    if (chunkId == VCB_CHUNK_SETTINGS) {
+        memcpy(&Setting, bytes, qMin(item_size, (quint32) sizeof(Setting))); // Settings that are not in older files keep their current value
+    }
+    if (chunkId == VCB_CHUNK_DEVICE_SETTINGS) {
+        quint32 number_of_devices = qMin(item_count, (quint32) NUMBER_OF_DEVICES);
+        quint32 number_of_settings = qMin(item_size, (quint32) NUMBER_OF_DEVICE_SETTINGS); // Settings that are not in older files keep their current value
+        for (quint32 d = 0; d < number_of_devices; d++) {
+            for (quint32 i = 0; i < number_of_settings; i++) Device[d]->set_setting(i, (uint8_t) bytes[(d * item_size) + i]);
+        }
+    }
+    if (chunkId == VCB_CHUNK_MIDI_SWITCHES) {
+        quint32 number_of_switches = qMin(item_count, (quint32) NUMBER_OF_MIDI_SWITCHES);
+        memcpy(MIDI_switch, bytes, number_of_switches * item_size);
+    }
+    if (chunkId == VCB_CHUNK_SEQ_PATTERNS) {
+        quint32 number_of_patterns = qMin(item_count, (quint32) NUMBER_OF_SEQ_PATTERNS);
+        memcpy(MIDI_seq_pattern, bytes, number_of_patterns * item_size);
+    }
+    if (chunkId == VCB_CHUNK_COMMANDS) {
+        Commands.resize(item_count);
+        memcpy(Commands.data(), bytes, item_count * item_size);
+        MyVCcommands->recreate_indexes();
+    }
+    if (chunkId == VCB_CHUNK_DEVICE_PATCHES) {
+        quint32 number_of_patches = qMin(item_count, (quint32) MAX_NUMBER_OF_DEVICE_PRESETS);
+        memcpy(Device_patches, bytes, number_of_patches * item_size);
+    }
+    if (chunkId == VCB_CHUNK_USER_DEVICES) {
+        quint32 number_of_user_devices = qMin(item_count, (quint32) NUMBER_OF_USER_DEVICES);
+        for (quint32 d = 0; d < number_of_user_devices; d++) {
+            User_device_struct userdata;
+            memcpy(&userdata, bytes + (d * item_size), sizeof(userdata));
+            USER_device[d]->set_device_data(&userdata);
+        }
+    }
+    if (chunkId == VCB_CHUNK_USER_DEVICE_ITEMS) {
+        User_device_data_item.resize(item_count);
+        memcpy(User_device_data_item.data(), bytes, item_count * item_size);
+    }
+}
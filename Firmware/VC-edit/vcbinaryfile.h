@@ -0,0 +1,80 @@
+#ifndef VCBINARYFILE_H
+#define VCBINARYFILE_H
+
+// VCbinaryFile reads and writes the binary VC-edit data files (*.vcb).
+// The data is stored in chunks that contain the same bytes as the EEPROM of the VController.
+// The chunk directory is read when the file is opened, the chunks themselves are read when they are needed.
+// Data can be converted to and from the JSON format (*.vcd) without loss, as both formats are read into the same data structures.
+//
+// File layout (all numbers little endian):
+//   Header:    "VCB1" | format version (2) | VC_type (1) | version major, minor, build (3) | number of chunks (2)
+//   Directory: per chunk: chunk ID (4) | offset (4) | item size (4) | number of items (4)
+//   Data:      the chunks
+
+#include "vccommands.h"
+
+#include <QObject>
+#include <QString>
+#include <QFile>
+#include <QVector>
+
+#define VCB_FORMAT_VERSION 1
+
+// Chunk IDs
+#define VCB_CHUNK_SETTINGS "SETG"
+#define VCB_CHUNK_DEVICE_SETTINGS "DEVS"
+#define VCB_CHUNK_MIDI_SWITCHES "MSWI"
+#define VCB_CHUNK_SEQ_PATTERNS "SEQP"
+#define VCB_CHUNK_COMMANDS "CMDS"
+#define VCB_CHUNK_DEVICE_PATCHES "PTCH"
+#define VCB_CHUNK_USER_DEVICES "UDEV"
+#define VCB_CHUNK_USER_DEVICE_ITEMS "UITM"
+
+class VCbinaryFile : public QObject
+{
+    Q_OBJECT
+public:
+    explicit VCbinaryFile(VCcommands *commands, QObject *parent = nullptr);
+    ~VCbinaryFile();
+
+    // Writing
+    bool save(QString fileName);
+
+    // Reading
+    bool open(QString fileName);
+    void close();
+    bool loadChunk(QString chunkId);
+    bool loadAll();
+    bool isChunkLoaded(QString chunkId);
+    QStringList chunkIds();
+    int chunkItemCount(QString chunkId);
+    int fileVCtype() { return file_VC_type; }
+    QString fileVersion() { return file_version; }
+    QString errorString() { return error; }
+
+    static bool isBinaryFileName(QString fileName);
+
+private:
+    struct Chunk_struct {
+        QString id;
+        quint32 offset;
+        quint32 item_size;
+        quint32 item_count;
+        bool loaded;
+    };
+    QVector<Chunk_struct> chunks;
+    QFile file;
+    int file_VC_type = -1;
+    QString file_version;
+    QString error;
+
+    bool readChunk(int c, QByteArray &data);
+    QByteArray getChunkData(QString chunkId, quint32 &item_size, quint32 &item_count);
+    void putChunkData(QString chunkId, const QByteArray &data, quint32 item_size, quint32 item_count);
+    int findChunk(QString chunkId);
+    quint32 expectedItemSize(QString chunkId);
+
+    VCcommands *MyVCcommands;
+};
+
+#endif // VCBINARYFILE_H
@@ -307,6 +307,29 @@ QString VCcommands::create_cmd_string(uint16_t number) // Strings shown on main
         else if (cmd.Data1 == MIDI_STOP) cmdString.append("STOP");
         else if (cmd.Data1 == MIDI_START_STOP) cmdString.append("START/STOP");
         break;
+    case MODULATION:
+        if (cmd.Data1 <= MOD_CMD_TARGET_PAR) cmdString.append(cmd_sublist.at(cmd.Data1 + INDEX_MOD_TYPE - 1));
+        cmdString.append(" LANE ");
+        cmdString.append(QString::number(cmd.Data2));
+        if ((cmd.Data1 == MOD_CMD_START) || (cmd.Data1 == MOD_CMD_START_STOP)) {
+            cmdString.append(" PAT ");
+            cmdString.append(QString::number(cmd.Value1));
+        }
+        if (cmd.Data1 == MOD_CMD_TARGET_CC) {
+            cmdString.append(" #");
+            cmdString.append(QString::number(cmd.Value1));
+        }
+        if (cmd.Data1 == MOD_CMD_TARGET_NRPN) {
+            cmdString.append(" #");
+            cmdString.append(QString::number((cmd.Value1 << 7) + cmd.Value2));
+        }
+        if ((cmd.Data1 == MOD_CMD_TARGET_PAR) && (cmd.Value1 < NUMBER_OF_DEVICES)) {
+            cmdString.append(" ");
+            cmdString.append(Device[cmd.Value1]->device_name);
+            cmdString.append(":");
+            cmdString.append(Device[cmd.Value1]->read_parameter_name(cmd.Value2));
+        }
+        break;
     case MENU:
         if (cmd.Data1 == MENU_SELECT) cmdString.append("SELECT");
         else if (cmd.Data1 == MENU_BACK) cmdString.append("BACK");
@@ -485,6 +508,7 @@ void VCcommands::fillCommandTableWidget(QTableWidget *table, uint8_t pg, uint8_t
         uint8_t max = cmdtype[cmd_type].Max;
         if (cmdtype[cmd_type].Sublist == SUBLIST_PAGE) max = last_fixed_cmd_page;
         if (cmdtype[cmd_type].Sublist == SUBLIST_MIDI_PORT) max = number_of_midi_ports;
+        if (cmdtype[cmd_type].Sublist == SUBLIST_MOD_PATTERN) max = NUMBER_OF_SEQ_PATTERNS + MOD_NUMBER_OF_FIXED_PATTERNS + 1;
         cmdbyte[i].Max = max;
     }
 
@@ -948,6 +972,24 @@ bool VCcommands::switchShowsDefaultItems(int pg, int sw)
     return (count_cmds(pg, sw) == 0);
 }
 
+QVector<Cmd_struct> VCcommands::switchCommands(uint8_t pg, uint8_t sw) // Returns the commands the VController executes for this switch - read from the default page if the switch is empty
+{
+    QVector<Cmd_struct> cmds;
+    if ((sw & SWITCH_MASK) == 0) return cmds;
+    if (count_cmds(pg, sw) == 0) pg = page_default;
+    uint16_t number_of_cmds = count_cmds(pg, sw);
+    for (uint16_t c = 0; c < number_of_cmds; c++) cmds.append(get_cmd(get_cmd_number(pg, sw, c)));
+    return cmds;
+}
+
+QString VCcommands::switchCommandString(uint8_t pg, uint8_t sw) // Returns the string of the first command of the switch
+{
+    if ((sw & SWITCH_MASK) == 0) return "";
+    if (count_cmds(pg, sw) == 0) pg = page_default;
+    if (count_cmds(pg, sw) == 0) return "";
+    return create_cmd_string(get_cmd_number(pg, sw, 0));
+}
+
 //******************************************************************************
 
 void VCcommands::create_indexes()
@@ -1203,6 +1245,7 @@ void VCcommands::set_type_and_value(uint8_t number, uint8_t type, uint8_t index,
     uint8_t max = cmdtype[type].Max;
     if (cmdtype[type].Sublist == SUBLIST_PAGE) max = last_fixed_cmd_page;
     if (cmdtype[type].Sublist == SUBLIST_MIDI_PORT) max = number_of_midi_ports;
+    if (cmdtype[type].Sublist == SUBLIST_MOD_PATTERN) max = NUMBER_OF_SEQ_PATTERNS + MOD_NUMBER_OF_FIXED_PATTERNS + 1;
     cmdbyte[number].Max = max;
     cmdbyte[number].Min = cmdtype[type].Min;
     if (in_edit_mode) {
@@ -1332,6 +1375,15 @@ void VCcommands::build_command_structure(uint8_t cmd_byte_no, uint8_t cmd_type,
             set_type_and_value(CB_DATA2, TYPE_MIDI_PORT, 0, in_edit_mode);
             clear_cmd_bytes(CB_VAL1, in_edit_mode); // Clear bytes 3-7
             break;
+          case MODULATION:
+            // Command: COMMON, MODULATION, START/STOP, LANE, PATTERN, PHASE, MIN, MAX
+            set_type_and_value(CB_DATA1, TYPE_MOD_TYPE, MOD_CMD_START_STOP, in_edit_mode);
+            set_type_and_value(CB_DATA2, TYPE_MOD_LANE, 1, in_edit_mode);
+            set_type_and_value(CB_VAL1, TYPE_MOD_PATTERN, 1, in_edit_mode);
+            set_type_and_value(CB_VAL2, TYPE_MOD_PHASE, 0, in_edit_mode);
+            set_type_and_value(CB_VAL3, TYPE_MIN, 0, in_edit_mode);
+            set_type_and_value(CB_VAL4, TYPE_MAX, 127, in_edit_mode);
+            break;
           default:
             // For all two byte commands
             clear_cmd_bytes(CB_DATA1, in_edit_mode); // Clear bytes 2-7
@@ -1604,6 +1656,42 @@ void VCcommands::build_command_structure(uint8_t cmd_byte_no, uint8_t cmd_type,
       }
     }
 
+    // *****************************************
+    // * BYTE3: Modulation command type updated *
+    // *****************************************
+    if (cmd_type == TYPE_MOD_TYPE) {
+      set_type_and_value(CB_DATA2, TYPE_MOD_LANE, 1, in_edit_mode);
+      switch (cmdbyte[cmd_byte_no].Value) {
+        case MOD_CMD_START:
+        case MOD_CMD_START_STOP:
+          set_type_and_value(CB_VAL1, TYPE_MOD_PATTERN, 1, in_edit_mode);
+          set_type_and_value(CB_VAL2, TYPE_MOD_PHASE, 0, in_edit_mode);
+          set_type_and_value(CB_VAL3, TYPE_MIN, 0, in_edit_mode);
+          set_type_and_value(CB_VAL4, TYPE_MAX, 127, in_edit_mode);
+          break;
+        case MOD_CMD_STOP:
+          clear_cmd_bytes(CB_VAL1, in_edit_mode);
+          break;
+        case MOD_CMD_TARGET_CC:
+          set_type_and_value(CB_VAL1, TYPE_CC_NUMBER, 0, in_edit_mode);
+          set_type_and_value(CB_VAL2, TYPE_MIDI_CHANNEL, 1, in_edit_mode);
+          set_type_and_value(CB_VAL3, TYPE_MIDI_PORT, 0, in_edit_mode);
+          clear_cmd_bytes(CB_VAL4, in_edit_mode);
+          break;
+        case MOD_CMD_TARGET_NRPN:
+          set_type_and_value(CB_VAL1, TYPE_NRPN_MSB, 0, in_edit_mode);
+          set_type_and_value(CB_VAL2, TYPE_NRPN_LSB, 0, in_edit_mode);
+          set_type_and_value(CB_VAL3, TYPE_MIDI_CHANNEL, 1, in_edit_mode);
+          set_type_and_value(CB_VAL4, TYPE_MIDI_PORT, 0, in_edit_mode);
+          break;
+        case MOD_CMD_TARGET_PAR:
+          set_type_and_value(CB_VAL1, TYPE_MOD_DEVICE, 0, in_edit_mode);
+          set_type_and_value(CB_VAL2, TYPE_MOD_PARAMETER, 0, in_edit_mode);
+          clear_cmd_bytes(CB_VAL3, in_edit_mode);
+          break;
+      }
+    }
+
     // *****************************************
     // * BYTE3: Parameter byte updated            *
     // *****************************************
@@ -1736,6 +1824,15 @@ void VCcommands::build_command_structure(uint8_t cmd_byte_no, uint8_t cmd_type,
           cmdbyte[CB_VAL1].Value = my_trigger;
         }
       }
+
+      // *****************************************
+      // * BYTE4+: Modulation device updated     *
+      // *****************************************
+
+      if (cmd_type == TYPE_MOD_DEVICE) { // The parameter list follows the device of the modulation lane
+        uint8_t dev = cmdbyte[cmd_byte_no].Value;
+        if (dev < NUMBER_OF_DEVICES) cmdbyte[CB_VAL2].Max = Device[dev]->number_of_parameters() - 1;
+      }
     }
 }
 
@@ -1963,6 +2060,20 @@ QString VCcommands::read_cmd_sublist(uint8_t cmd_byte_no, uint16_t value)
     case SUBLIST_SONG:
         msg = "SONG " + QString::number(value);
         break;
+    case SUBLIST_MOD_PATTERN:
+        value += cmdbyte[cmd_byte_no].Min; // The combo box lists the patterns from the minimum value
+        if (value <= NUMBER_OF_SEQ_PATTERNS) msg = "USER " + QString::number(value);
+        else if (value <= NUMBER_OF_SEQ_PATTERNS + MOD_NUMBER_OF_FIXED_PATTERNS + 1) msg = cmd_sublist[value - NUMBER_OF_SEQ_PATTERNS + INDEX_MOD_FIXED_PATTERN - 2];
+        break;
+    case SUBLIST_MOD_DEVICE:
+        if (value < NUMBER_OF_DEVICES) msg = Device[value]->full_device_name;
+        else msg = QString::number(value);
+        break;
+    case SUBLIST_MOD_PARAMETER: // Copy the parameter name from the device in the first value byte
+        dev = cmdbyte[CB_VAL1].Value;
+        if (dev < NUMBER_OF_DEVICES) msg = Device[dev]->read_parameter_name(value);
+        else msg = QString::number(value);
+        break;
     default: // Static sublist - read it from the cmd_sublist array
         index = indexFromValue(cmd_type, value) + cmdtype[cmd_type].Sublist;
         if (index > 0) msg = cmd_sublist[index - 1];
@@ -65,6 +65,8 @@ public:
     bool switchShowsDefaultItems(int pg, int sw);
     void copyItemsToBuffer(customListWidget *widget);
     void pasteItem(int sw);
+    QVector<Cmd_struct> switchCommands(uint8_t pg, uint8_t sw);
+    QString switchCommandString(uint8_t pg, uint8_t sw);
 
 signals:
     void updateCommandScreens(bool);
@@ -182,6 +184,14 @@ private:
     #define TYPE_MODE 40
     #define TYPE_MIDI_MORE 41
     #define TYPE_MUTE 42
+    #define TYPE_MOD_TYPE 43
+    #define TYPE_MOD_LANE 44
+    #define TYPE_MOD_PATTERN 45
+    #define TYPE_MOD_PHASE 46
+    #define TYPE_NRPN_MSB 47
+    #define TYPE_NRPN_LSB 48
+    #define TYPE_MOD_DEVICE 49
+    #define TYPE_MOD_PARAMETER 50
 
     // Some of the data for the sublists below is not fixed, but must be read from a Device class or from EEPROM
     // Here we define these sublists
@@ -198,6 +208,9 @@ private:
     #define SUBLIST_MIDI_PORT 245
     #define SUBLIST_SETLIST 244 // To show the setlist name
     #define SUBLIST_SONG 243 // To show the song name
+    #define SUBLIST_MOD_PATTERN 242 // To show the modulation pattern
+    #define SUBLIST_MOD_DEVICE 241 // To show the device of a modulation lane
+    #define SUBLIST_MOD_PARAMETER 240 // To show the parameter name of the device of a modulation lane
 
     #define SWITCH_MAX_NUMBER 24
 
@@ -246,12 +259,20 @@ private:
         { "MODE", 157, 0, 2 }, // TYPE_MODE
         { "COMMAND", 160, 0, 2 }, // TYPE_MIDI_MORE
         { "MUTE TYPE", 163, 0, 3 }, // TYPE_MUTE
+        { "MOD COMMAND", 167, 0, 5 }, // TYPE_MOD_TYPE 43
+        { "LANE", 0, 1, MOD_NUMBER_OF_LANES }, // TYPE_MOD_LANE 44
+        { "PATTERN", SUBLIST_MOD_PATTERN, 1, 255 }, // TYPE_MOD_PATTERN 45
+        { "PHASE", 0, 0, 127 }, // TYPE_MOD_PHASE 46
+        { "NRPN MSB", 0, 0, 127 }, // TYPE_NRPN_MSB 47
+        { "NRPN LSB", 0, 0, 127 }, // TYPE_NRPN_LSB 48
+        { "DEVICE", SUBLIST_MOD_DEVICE, 0, NUMBER_OF_DEVICES - 1 }, // TYPE_MOD_DEVICE 49
+        { "PARAMETER", SUBLIST_MOD_PARAMETER, 0, 255 }, // TYPE_MOD_PARAMETER 50
     };
 
     const QStringList cmd_sublist = {
 
         // Sublist 1 - 17: Common Command Types
-        "NO COMMAND", "PAGE", "TAP TEMPO", "SET TEMPO", "GLOBAL TUNER", "MIDI PC", "MIDI CC", "MIDI NOTE", "NEXT DEVICE", "SETLIST", "SONG", "MODE", "MIDI MORE", "MENU", "", "", "",
+        "NO COMMAND", "PAGE", "TAP TEMPO", "SET TEMPO", "GLOBAL TUNER", "MIDI PC", "MIDI CC", "MIDI NOTE", "NEXT DEVICE", "SETLIST", "SONG", "MODE", "MIDI MORE", "MODULATION", "MENU", "", "",
 
         // Sublist 18 - 39: Device Command Types
         "PATCH", "PARAMETER", "ASSIGN", "SNAP/SCENE", "LOOPER", "MUTE", "SEL DEVICE PAGE", "SEL NEXT PAGE", "MASTER EXP PEDAL", "TOGGL MASTER EXP",
@@ -303,10 +324,18 @@ private:
 
         // Sublist 163 - 166: Mute types
         "ON", "OFF", "OFF/ALWAYS ON", "TOGGLE",
+
+        // Sublist 167 - 172: Modulation command types
+        "START", "STOP", "START/STOP", "TARGET CC", "TARGET NRPN", "TARGET PARAM",
+
+        // Sublist 173 - 181: Fixed modulation patterns
+        "SINE", "BLOCK", "TRIANGLE", "SAW TOOTH", "SINGLE 8TH", "BEAT 1", "BEAT 2", "BEAT 3", "RANDOM",
     };
 
 #define INDEX_PAR_TOGGLE_TYPE 50
 #define INDEX_CC_TOGGLE_TYPE 85
+#define INDEX_MOD_TYPE 167
+#define INDEX_MOD_FIXED_PATTERN 173
 
     struct cmdbyte_struct {
       uint8_t Type;
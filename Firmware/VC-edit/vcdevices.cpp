@@ -32,6 +32,7 @@ void VCdevices::fillTreeWidget(QTreeWidget *my_tree, VCcommands *VCd)
             //QProgressBar *slider = new QProgressBar(my_tree);
             uint8_t max = VCdeviceMenu[i].max;
             if (VCdeviceMenu[i].sublist == MIDI_PORT_SUBLIST1) max = number_of_midi_ports;
+            if (VCdeviceMenu[i].sublist == MIDI_PORT_SUBLIST2) max = number_of_midi_ports + 1;
             slider->setRange( VCdeviceMenu[i].min, max);
             slider->setValue(Device[d]->get_setting(VCdeviceMenu[i].parameter));
             my_tree->setItemWidget(child, 4, slider);
@@ -58,6 +59,15 @@ void VCdevices::fillTreeWidget(QTreeWidget *my_tree, VCcommands *VCd)
                         slider->setRange(0, number_of_midi_ports - 1);
                         slider->setValue(Device[d]->get_setting(VCdeviceMenu[i].parameter));
                     }
+                    else if (VCdeviceMenu[i].sublist == MIDI_PORT_SUBLIST2) {
+                        comboBox->addItem("OFF");
+                        for (int p = 0; p <= number_of_midi_ports; p++)
+                            comboBox->addItem(midi_port_names[p]);
+                        comboBox->setCurrentIndex(Device[d]->get_setting(VCdeviceMenu[i].parameter));
+                        connect(comboBox, SIGNAL(new_value(int, int, int)), this, SLOT(deviceSettingChanged(int, int, int)));
+                        slider->setRange(0, number_of_midi_ports + 1);
+                        slider->setValue(Device[d]->get_setting(VCdeviceMenu[i].parameter));
+                    }
                     else if (VCdeviceMenu[i].sublist == TYPE_MODE_SUBLIST) {
                         for(int j = 0; j < Device[d]->get_number_of_dev_types(); j++) {
                             comboBox->addItem(Device[d]->get_dev_type_name(j));
@@ -110,6 +120,7 @@ void VCdevices::updateTreeWidget(QTreeWidget *my_tree, VCcommands *VCd)
                 if (slider) {
                     uint8_t max = VCdeviceMenu[i].max;
                     if (VCdeviceMenu[i].sublist == MIDI_PORT_SUBLIST1) max = number_of_midi_ports;
+                    if (VCdeviceMenu[i].sublist == MIDI_PORT_SUBLIST2) max = number_of_midi_ports + 1;
                     slider->setRange(VCdeviceMenu[i].min, max);
                     slider->setValue(Device[d]->get_setting(VCdeviceMenu[i].parameter));
                 }
@@ -135,6 +146,14 @@ void VCdevices::updateTreeWidget(QTreeWidget *my_tree, VCcommands *VCd)
                             slider->setRange(0, number_of_midi_ports - 1);
                             slider->setValue(Device[d]->get_setting(VCdeviceMenu[i].parameter));
                         }
+                        else if (VCdeviceMenu[i].sublist == MIDI_PORT_SUBLIST2) {
+                            comboBox->addItem("OFF");
+                            for (int p = 0; p <= number_of_midi_ports; p++)
+                                comboBox->addItem(midi_port_names[p]);
+                            comboBox->setCurrentIndex(Device[d]->get_setting(VCdeviceMenu[i].parameter));
+                            slider->setRange(0, number_of_midi_ports + 1);
+                            slider->setValue(Device[d]->get_setting(VCdeviceMenu[i].parameter));
+                        }
                         else if (VCdeviceMenu[i].sublist == TYPE_MODE_SUBLIST) {
                             for(int j = 0; j < Device[d]->get_number_of_dev_types(); j++) {
                                 comboBox->addItem(Device[d]->get_dev_type_name(j));
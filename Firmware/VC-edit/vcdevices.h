@@ -79,6 +79,7 @@ private:
 #define PAGE_SUBLIST 254
 #define MIDI_PORT_SUBLIST1 253
 #define TYPE_MODE_SUBLIST 252
+#define MIDI_PORT_SUBLIST2 251 // Same as MIDI_PORT_SUBLIST1, but starts with OFF and ends with all ports
 #define LAST_FIXED_CMD_PAGE_MAX 255 //!!!
 
     const QVector<Device_menu_struct> VCdeviceMenu
@@ -92,6 +93,7 @@ private:
         { "Device page #2", OPTION, PAGE_SUBLIST, 0, LAST_FIXED_CMD_PAGE_MAX, 7 }, // Switch 6
         { "Device page #3", OPTION, PAGE_SUBLIST, 0, LAST_FIXED_CMD_PAGE_MAX, 8 }, // Switch 7
         { "Device page #4", OPTION, PAGE_SUBLIST, 0, LAST_FIXED_CMD_PAGE_MAX, 9 }, // Switch 8
+        { "PC echo port", OPTION, MIDI_PORT_SUBLIST2, 0, 1, 12 }, // Switch 14
     };
 
     const uint16_t NUMBER_OF_DEVICE_MENU_ITEMS = VCdeviceMenu.size();
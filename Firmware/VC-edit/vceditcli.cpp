@@ -0,0 +1,612 @@
+#include "vceditcli.h"
+#include "VController/config.h"
+#include "VController/globals.h"
+#include "VController/globaldevices.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QSettings>
+#include <QEventLoop>
+#include <QTimer>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QThread>
+#include <QFile>
+#include <QFileInfo>
+#include <iostream>
+
+VCeditCli::VCeditCli(QObject *parent) : QObject(parent)
+{
+    MyMidi = new Midi(this);
+    MyVCsettings = new VCsettings(this);
+    MyVCmidiSwitches = new VCmidiSwitches(this);
+    MyVCseqPatterns = new VCseqPattern(this);
+    MyVCdevices = new VCdevices(this);
+    MyVCuserDevice = new VCuserdevices(this);
+    MyVCcommands = new VCcommands(this);
+    MyVCbackupFile = new VCbackupFile(MyVCsettings, MyVCmidiSwitches, MyVCseqPatterns, MyVCdevices, MyVCuserDevice, MyVCcommands, this);
+    MyVCbinaryFile = new VCbinaryFile(MyVCcommands, this);
+}
+
+int VCeditCli::run(const QStringList &arguments)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Command line version of VC-edit.\n\n"
+                                     "Commands:\n"
+                                     "  ports                  List the available MIDI ports\n"
+                                     "  validate <file>        Check if a VC-edit file will fit the VController\n"
+                                     "  info <file>            Show the contents of a VC-edit file\n"
+                                     "  convert <in> <out>     Read and rewrite a VC-edit file (*.vcd is JSON, *.vcb is binary)\n"
+                                     "  diff <file1> <file2>   Show the differences between two VC-edit files\n"
+                                     "  download <file>        Read all data from the VController and save it to file\n"
+                                     "  upload <file>          Write all data from file to the VController\n"
+                                     "  bench <file>           Compare load and save times of the JSON and the binary format");
+    parser.addHelpOption();
+    parser.addPositionalArgument("command", "ports, info, validate, convert, diff, download, upload or bench");
+    parser.addPositionalArgument("files", "Input and/or output files", "[files...]");
+    QCommandLineOption typeOption(QStringList() << "t" << "type", "Set the hardware type (VController, VC-mini or VC-touch). Default is the type stored in the file or the type set in VC-edit.", "type");
+    QCommandLineOption inPortOption(QStringList() << "i" << "in", "MIDI in port. Default is the port set in VC-edit.", "port");
+    QCommandLineOption outPortOption(QStringList() << "o" << "out", "MIDI out port. Default is the port set in VC-edit.", "port");
+    QCommandLineOption virtualOption("virtual", "Open virtual MIDI ports with the given name instead of the in and out port (Mac and Linux only).", "name");
+    QCommandLineOption timeoutOption("timeout", "Time in ms without MIDI data before a download is aborted. Default is 5000.", "ms");
+    QCommandLineOption repeatOption("repeat", "Number of runs for the file benchmark. Default is 10.", "count");
+    QCommandLineOption slowOption("slow", "Use slow MIDI mode for uploading patches (same as in VC-edit).");
+    QCommandLineOption benchOption(QStringList() << "b" << "bench", "Show the timing of every phase of a transfer.");
+    QCommandLineOption verboseOption(QStringList() << "V" << "verbose", "Show extra information.");
+    parser.addOption(typeOption);
+    parser.addOption(inPortOption);
+    parser.addOption(outPortOption);
+    parser.addOption(virtualOption);
+    parser.addOption(timeoutOption);
+    parser.addOption(repeatOption);
+    parser.addOption(slowOption);
+    parser.addOption(benchOption);
+    parser.addOption(verboseOption);
+    parser.process(arguments);
+
+    // Take the defaults from the settings of VC-edit
+    QSettings appSettings;
+    appSettings.beginGroup("MainWindow");
+    VC_type = appSettings.value("VC_type").toUInt();
+    appSettings.endGroup();
+    appSettings.beginGroup("Midi");
+    MyMidiInPort = appSettings.value("midiInPort").toString();
+    MyMidiOutPort = appSettings.value("midiOutPort").toString();
+    MyMidiSlowMode = appSettings.value("midiSlowMode").toBool();
+    appSettings.endGroup();
+
+    if (parser.isSet(typeOption)) {
+        if (!setVCtype(parser.value(typeOption))) {
+            std::cerr << "Unknown type: " << parser.value(typeOption).toStdString() << std::endl;
+            return CLI_EXIT_ERROR;
+        }
+        typeSetFromCommandLine = true;
+    }
+    if (parser.isSet(inPortOption)) MyMidiInPort = parser.value(inPortOption);
+    if (parser.isSet(outPortOption)) MyMidiOutPort = parser.value(outPortOption);
+    if (parser.isSet(virtualOption)) virtualPortName = parser.value(virtualOption);
+    if (parser.isSet(timeoutOption)) midiTimeout = parser.value(timeoutOption).toInt();
+    if (parser.isSet(repeatOption)) repeatCount = qMax(1, parser.value(repeatOption).toInt());
+    if (parser.isSet(slowOption)) MyMidiSlowMode = true;
+    verbose = parser.isSet(verboseOption);
+
+    const QStringList args = parser.positionalArguments();
+    if (args.isEmpty()) parser.showHelp(CLI_EXIT_ERROR);
+    QString command = args.at(0);
+
+    int result = CLI_EXIT_ERROR;
+    if (command == "ports") result = listPorts();
+    else if ((command == "info") && (args.size() == 2)) result = showFileInfo(args.at(1));
+    else if ((command == "bench") && (args.size() == 2)) result = benchmarkFile(args.at(1));
+    else if ((command == "validate") && (args.size() == 2)) result = validateFile(args.at(1));
+    else if ((command == "convert") && (args.size() == 3)) result = convertFile(args.at(1), args.at(2));
+    else if ((command == "diff") && (args.size() == 3)) result = diffFiles(args.at(1), args.at(2));
+    else if ((command == "download") && (args.size() == 2)) result = downloadToFile(args.at(1));
+    else if ((command == "upload") && (args.size() == 2)) result = uploadFromFile(args.at(1));
+    else parser.showHelp(CLI_EXIT_ERROR);
+
+    if (parser.isSet(benchOption)) showBenchmarkReport();
+    return result;
+}
+
+// ********************************* Commands *********************************
+
+int VCeditCli::listPorts()
+{
+    QStringList inPorts = MyMidi->fillMidiInPortItems();
+    QStringList outPorts = MyMidi->fillMidiOutPortItems();
+    std::cout << "MIDI in ports:" << std::endl;
+    for (int i = 0; i < inPorts.size(); i++) std::cout << "  " << inPorts.at(i).toStdString() << std::endl;
+    std::cout << "MIDI out ports:" << std::endl;
+    for (int i = 0; i < outPorts.size(); i++) std::cout << "  " << outPorts.at(i).toStdString() << std::endl;
+    return CLI_EXIT_OK;
+}
+
+int VCeditCli::validateFile(QString fileName)
+{
+    // Binary files only need the chunks that are checked here
+    if (!loadBackup(fileName, QStringList() << VCB_CHUNK_COMMANDS << VCB_CHUNK_DEVICE_PATCHES << VCB_CHUNK_USER_DEVICE_ITEMS)) return CLI_EXIT_ERROR;
+    return checkLoadedData() ? CLI_EXIT_OK : CLI_EXIT_ERROR;
+}
+
+int VCeditCli::convertFile(QString inFile, QString outFile)
+{
+    if (!loadBackup(inFile)) return CLI_EXIT_ERROR;
+
+    if (!saveBackup(outFile)) return CLI_EXIT_ERROR;
+    std::cout << outFile.toStdString() << " saved" << std::endl;
+    return CLI_EXIT_OK;
+}
+
+int VCeditCli::diffFiles(QString fileA, QString fileB)
+{
+    // Binary files are compared through their JSON representation
+    QJsonObject jsonA, jsonB;
+    if (VCbinaryFile::isBinaryFileName(fileA)) {
+        if (!loadBackup(fileA)) return CLI_EXIT_ERROR;
+        MyVCbackupFile->writeFullBackup(jsonA);
+    }
+    else if (!VCbackupFile::loadJsonFile(fileA, jsonA)) {
+        std::cerr << "Couldn't open " << fileA.toStdString() << std::endl;
+        return CLI_EXIT_ERROR;
+    }
+    if (VCbinaryFile::isBinaryFileName(fileB)) {
+        if (!loadBackup(fileB)) return CLI_EXIT_ERROR;
+        MyVCbackupFile->writeFullBackup(jsonB);
+    }
+    else if (!VCbackupFile::loadJsonFile(fileB, jsonB)) {
+        std::cerr << "Couldn't open " << fileB.toStdString() << std::endl;
+        return CLI_EXIT_ERROR;
+    }
+
+    // The header contains the version of VC-edit, which is not relevant for the data
+    jsonA.remove("Header");
+    jsonB.remove("Header");
+    int differences = diffJsonValue("", jsonA, jsonB);
+    std::cout << differences << " difference(s) found" << std::endl;
+    return (differences == 0) ? CLI_EXIT_OK : CLI_EXIT_DIFFERENT;
+}
+
+int VCeditCli::downloadToFile(QString fileName)
+{
+    setupVCconfig();
+    if (!openMidiPorts()) return CLI_EXIT_ERROR;
+    bool ok = true;
+
+    startPhase("Download commands");
+    MyMidi->MIDI_editor_request_all_commands();
+    ok &= waitForMidi(SIGNAL(updateCommands(int,int)));
+    finishPhase(ok);
+
+    startPhase("Download patches");
+    MyMidi->MIDI_editor_request_all_patches();
+    ok &= waitForMidi(SIGNAL(closeProgressBar(QString)));
+    finishPhase(ok);
+
+    startPhase("Download user devices");
+    User_device_data_item.clear();
+    MyMidi->MIDI_editor_request_all_user_device_settings();
+    ok &= waitForMidi(nullptr); // There is no finish message for user device data
+    finishPhase(ok);
+
+    startPhase("Download settings");
+    MyMidi->MIDI_editor_request_settings();
+    ok &= waitForMidi(SIGNAL(updateSettings()));
+    finishPhase(ok);
+
+    if (!ok) {
+        std::cerr << "Download from " << VC_name.toStdString() << " failed" << std::endl;
+        return CLI_EXIT_ERROR;
+    }
+
+    if (!saveBackup(fileName)) return CLI_EXIT_ERROR;
+    std::cout << fileName.toStdString() << " saved" << std::endl;
+    return CLI_EXIT_OK;
+}
+
+int VCeditCli::uploadFromFile(QString fileName)
+{
+    if (!loadBackup(fileName)) return CLI_EXIT_ERROR;
+    if (!checkLoadedData()) return CLI_EXIT_ERROR;
+    if (!openMidiPorts()) return CLI_EXIT_ERROR;
+
+    bool ok = uploadSettings();
+    if (ok) ok = uploadPatterns();
+    if (ok) ok = uploadCommands();
+    if (ok) ok = uploadPatches();
+    if (ok) ok = uploadUserDevices();
+    if (!ok) {
+        std::cerr << "Upload to " << VC_name.toStdString() << " failed: no reply from " << VC_name.toStdString() << std::endl;
+        return CLI_EXIT_ERROR;
+    }
+    std::cout << "Upload to " << VC_name.toStdString() << " complete" << std::endl;
+    return CLI_EXIT_OK;
+}
+
+int VCeditCli::showFileInfo(QString fileName)
+{
+    if (VCbinaryFile::isBinaryFileName(fileName)) {
+        // Only the chunk directory is read
+        if (!MyVCbinaryFile->open(fileName)) {
+            std::cerr << MyVCbinaryFile->errorString().toStdString() << std::endl;
+            return CLI_EXIT_ERROR;
+        }
+        std::cout << "Binary VC-edit file, version " << MyVCbinaryFile->fileVersion().toStdString() << ", type " << MyVCbinaryFile->fileVCtype() << std::endl;
+        for (const QString &id : MyVCbinaryFile->chunkIds()) {
+            std::cout << "  " << id.toStdString() << ": " << MyVCbinaryFile->chunkItemCount(id) << " items" << std::endl;
+        }
+        MyVCbinaryFile->close();
+        return CLI_EXIT_OK;
+    }
+    return validateFile(fileName);
+}
+
+int VCeditCli::benchmarkFile(QString fileName)
+{
+    // Compares the JSON and binary format on the data in fileName and checks the binary format is lossless
+    if (!loadBackup(fileName)) return CLI_EXIT_ERROR;
+    QString jsonFile = fileName + ".bench.vcd";
+    QString binaryFile = fileName + ".bench.vcb";
+
+    QJsonObject original;
+    MyVCbackupFile->writeFullBackup(original);
+
+    qint64 json_save = 0, json_load = 0, binary_save = 0, binary_load = 0, binary_load_commands = 0;
+    QElapsedTimer timer;
+    for (int r = 0; r < repeatCount; r++) {
+        timer.start();
+        QJsonObject saveObject;
+        MyVCbackupFile->writeFullBackup(saveObject);
+        VCbackupFile::saveJsonFile(jsonFile, saveObject);
+        json_save += timer.nsecsElapsed();
+
+        timer.start();
+        QJsonObject loadObject;
+        VCbackupFile::loadJsonFile(jsonFile, loadObject);
+        MyVCbackupFile->readFullBackup(loadObject);
+        json_load += timer.nsecsElapsed();
+
+        timer.start();
+        MyVCbinaryFile->save(binaryFile);
+        binary_save += timer.nsecsElapsed();
+
+        timer.start();
+        MyVCbinaryFile->open(binaryFile);
+        MyVCbinaryFile->loadAll();
+        MyVCbinaryFile->close();
+        binary_load += timer.nsecsElapsed();
+
+        timer.start();
+        MyVCbinaryFile->open(binaryFile);
+        MyVCbinaryFile->loadChunk(VCB_CHUNK_COMMANDS);
+        MyVCbinaryFile->close();
+        binary_load_commands += timer.nsecsElapsed();
+    }
+
+    QJsonObject roundTrip;
+    MyVCbackupFile->writeFullBackup(roundTrip);
+    original.remove("Header");
+    roundTrip.remove("Header");
+    int differences = diffJsonValue("", original, roundTrip);
+
+    std::cout << "Average of " << repeatCount << " runs:" << std::endl;
+    std::cout << QString("  JSON save:            %1 ms (%2 bytes)").arg(json_save / repeatCount / 1000000.0, 0, 'f', 2).arg(QFileInfo(jsonFile).size()).toStdString() << std::endl;
+    std::cout << QString("  JSON load:            %1 ms").arg(json_load / repeatCount / 1000000.0, 0, 'f', 2).toStdString() << std::endl;
+    std::cout << QString("  Binary save:          %1 ms (%2 bytes)").arg(binary_save / repeatCount / 1000000.0, 0, 'f', 2).arg(QFileInfo(binaryFile).size()).toStdString() << std::endl;
+    std::cout << QString("  Binary load:          %1 ms").arg(binary_load / repeatCount / 1000000.0, 0, 'f', 2).toStdString() << std::endl;
+    std::cout << QString("  Binary load commands: %1 ms").arg(binary_load_commands / repeatCount / 1000000.0, 0, 'f', 2).toStdString() << std::endl;
+    std::cout << "  Round trip: " << ((differences == 0) ? "lossless" : "data differs!") << std::endl;
+
+    QFile::remove(jsonFile);
+    QFile::remove(binaryFile);
+    return (differences == 0) ? CLI_EXIT_OK : CLI_EXIT_DIFFERENT;
+}
+
+// ********************************* Setup *********************************
+
+bool VCeditCli::setVCtype(QString typeName)
+{
+    QString type = typeName.toLower();
+    if ((type == "vcontroller") || (type == "vc")) VC_type = VCONTROLLER;
+    else if ((type == "vc-mini") || (type == "vcmini")) VC_type = VCMINI;
+    else if ((type == "vc-touch") || (type == "vctouch")) VC_type = VCTOUCH;
+    else return false;
+    return true;
+}
+
+void VCeditCli::setupVCconfig()
+{
+    if (VC_type == VCONTROLLER) VC_name = "VController";
+    if (VC_type == VCMINI) VC_name = "VC-mini";
+    if (VC_type == VCTOUCH) VC_name = "VC-touch";
+    MyVCdevices->setup_devices();
+    MyVCcommands->setup_VC_config();
+}
+
+bool VCeditCli::loadBackup(QString fileName, QStringList chunks)
+{
+    // For binary files only the given chunks are loaded. If chunks is empty, all data is loaded.
+    startPhase("Read file");
+    if (VCbinaryFile::isBinaryFileName(fileName)) {
+        if (!MyVCbinaryFile->open(fileName)) {
+            finishPhase(false);
+            std::cerr << MyVCbinaryFile->errorString().toStdString() << std::endl;
+            return false;
+        }
+        if (!typeSetFromCommandLine) VC_type = MyVCbinaryFile->fileVCtype();
+        setupVCconfig();
+        bool ok = true;
+        if (chunks.isEmpty()) ok = MyVCbinaryFile->loadAll();
+        else for (const QString &chunk : chunks) ok &= MyVCbinaryFile->loadChunk(chunk);
+        MyVCbinaryFile->close();
+        finishPhase(ok);
+        if (!ok) std::cerr << MyVCbinaryFile->errorString().toStdString() << std::endl;
+        return ok;
+    }
+
+    QJsonObject json;
+    if (!VCbackupFile::loadJsonFile(fileName, json)) {
+        finishPhase(false);
+        std::cerr << "Couldn't open " << fileName.toStdString() << std::endl;
+        return false;
+    }
+
+    if (VCbackupFile::readHeader(json) != "FullBackup") {
+        finishPhase(false);
+        std::cerr << fileName.toStdString() << " is not a VC-edit full backup file" << std::endl;
+        return false;
+    }
+
+    // Use the type from the file, unless it was set on the command line
+    int file_type = VCbackupFile::headerVCtype(json);
+    if ((!typeSetFromCommandLine) && (file_type >= 0)) VC_type = file_type;
+    setupVCconfig();
+
+    QString file_VCtype = VCbackupFile::checkHeaderContainsRightVCtype(json);
+    if (file_VCtype != "") std::cout << "Warning: file contains data for " << file_VCtype.toStdString() << ", loading it as " << VC_name.toStdString() << std::endl;
+
+    MyVCbackupFile->readFullBackup(json);
+    finishPhase(true);
+    return true;
+}
+
+bool VCeditCli::saveBackup(QString fileName)
+{
+    startPhase("Write file");
+    bool ok;
+    if (VCbinaryFile::isBinaryFileName(fileName)) {
+        ok = MyVCbinaryFile->save(fileName);
+    }
+    else {
+        QJsonObject saveObject;
+        MyVCbackupFile->writeFullBackup(saveObject);
+        ok = VCbackupFile::saveJsonFile(fileName, saveObject);
+    }
+    finishPhase(ok);
+    if (!ok) std::cerr << "Couldn't write " << fileName.toStdString() << std::endl;
+    return ok;
+}
+
+bool VCeditCli::openMidiPorts()
+{
+    if (virtualPortName != "") {
+        MyMidi->openVirtualMidiPorts(virtualPortName);
+        std::cout << "Connect " << VC_name.toStdString() << " to virtual port " << virtualPortName.toStdString() << " and press enter" << std::endl;
+        std::cin.get();
+        return true;
+    }
+    MyMidi->openMidiIn(MyMidiInPort);
+    MyMidi->openMidiOut(MyMidiOutPort);
+    if (!MyMidi->checkMidiPortStillAvailable(MyMidiInPort, MyMidiOutPort)) {
+        std::cerr << "MIDI ports " << MyMidiInPort.toStdString() << " / " << MyMidiOutPort.toStdString() << " not available" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool VCeditCli::checkLoadedData()
+{
+    // Checks if the data that has been loaded will fit the VController
+    bool ok = true;
+    std::cout << VC_name.toStdString() << " backup: " << Number_of_pages << " pages, " << Commands.size() << " commands, "
+              << MyVCdevices->numberOfPatches() << " songs/setlists/patches, " << User_device_data_item.size() << " user device items" << std::endl;
+
+    if (Commands.size() > EXT_EEP_MAX_NUMBER_OF_COMMANDS) {
+        std::cout << "Error: too many commands (" << Commands.size() << " > " << EXT_EEP_MAX_NUMBER_OF_COMMANDS << ")" << std::endl;
+        ok = false;
+    }
+    if (Number_of_pages >= first_fixed_cmd_page) {
+        std::cout << "Error: too many pages (" << Number_of_pages << " >= " << first_fixed_cmd_page << ")" << std::endl;
+        ok = false;
+    }
+    if (User_device_data_item.size() > MAX_NUMBER_OF_USER_DATA_ITEMS) {
+        std::cout << "Error: too many user device items (" << User_device_data_item.size() << " > " << MAX_NUMBER_OF_USER_DATA_ITEMS << ")" << std::endl;
+        ok = false;
+    }
+    if (ok) std::cout << "File is valid" << std::endl;
+    return ok;
+}
+
+// ********************************* Transfer phases *********************************
+// The upload phases follow the same order as the buttons in VC-edit.
+
+bool VCeditCli::uploadSettings()
+{
+    startPhase("Upload settings");
+    MyMidi->MIDI_editor_send_settings();
+    for (int d = 0; d < NUMBER_OF_DEVICES; d++) MyMidi->MIDI_editor_send_device_settings(d);
+    for (int s = 0; s < NUMBER_OF_MIDI_SWITCHES; s++) MyMidi->MIDI_editor_send_midi_switch_settings(s);
+    MyMidi->MIDI_editor_send_save_settings();
+    bool ok = waitForVController();
+    finishPhase(ok);
+    return ok;
+}
+
+bool VCeditCli::uploadPatterns()
+{
+    startPhase("Upload patterns");
+    for (int p = 0; p < NUMBER_OF_SEQ_PATTERNS; p++) MyMidi->MIDI_editor_send_seq_pattern(p);
+    bool ok = waitForVController();
+    finishPhase(ok);
+    return ok;
+}
+
+bool VCeditCli::uploadCommands()
+{
+    startPhase("Upload commands");
+    MyMidi->MIDI_editor_send_start_commands_dump();
+    for (uint16_t c = 0; c < Commands.size(); c++) MyMidi->MIDI_editor_send_command(c);
+    MyMidi->MIDI_editor_send_finish_commands_dump();
+    bool ok = waitForVController();
+    finishPhase(ok);
+    return ok;
+}
+
+bool VCeditCli::uploadPatches()
+{
+    startPhase("Upload patches");
+    for (uint16_t p = 0; p < MAX_NUMBER_OF_DEVICE_PRESETS; p++) {
+        if (Device_patches[p][0] != 0) {
+            MyMidi->MIDI_send_device_patch(p);
+            if (MyMidiSlowMode) QThread().msleep(100);
+        }
+        else {
+            MyMidi->MIDI_send_initialize_device_patch(p);
+        }
+    }
+    MyMidi->MIDI_editor_finish_device_patch_dump();
+    bool ok = waitForVController();
+    finishPhase(ok);
+    return ok;
+}
+
+bool VCeditCli::uploadUserDevices()
+{
+    startPhase("Upload user devices");
+    MyVCuserDevice->cleanUpUserDeviceNameItems();
+    MyMidi->MIDI_editor_send_all_user_device_data();
+    bool ok = waitForVController();
+    finishPhase(ok);
+    return ok;
+}
+
+bool VCeditCli::waitForMidi(const char *finishSignal)
+{
+    // Waits until finishSignal is emitted by MyMidi. Every received message restarts the timeout.
+    // If finishSignal is nullptr, we wait until no more data has been received for a second.
+    QEventLoop loop;
+    QTimer timeoutTimer;
+    timeoutTimer.setSingleShot(true);
+    bool finished = false;
+    bool data_received = false;
+
+    if (finishSignal != nullptr) {
+        connect(MyMidi, finishSignal, &loop, SLOT(quit()));
+    }
+    connect(MyMidi, &Midi::updateProgressBar, &loop, [&]() {
+        data_received = true;
+        timeoutTimer.start((finishSignal == nullptr) ? 1000 : midiTimeout);
+    });
+    connect(&timeoutTimer, &QTimer::timeout, &loop, [&]() {
+        finished = (finishSignal == nullptr) && data_received;
+        loop.exit(1);
+    });
+
+    timeoutTimer.start(midiTimeout);
+    if (loop.exec() == 0) finished = true;
+    disconnect(MyMidi, nullptr, &loop, nullptr);
+    if ((!finished) && (verbose)) std::cout << "Timeout waiting for MIDI data" << std::endl;
+    return finished;
+}
+
+bool VCeditCli::waitForVController()
+{
+    // The VController does not acknowledge the data of an upload. It handles the messages from the editor in order,
+    // so when it answers a hardware version request, all the data sent before the request has been processed.
+    MyMidi->MIDI_editor_request_hardware_version();
+    return waitForMidi(SIGNAL(hardwareVersionReceived(int)));
+}
+
+// ********************************* Benchmarking *********************************
+
+void VCeditCli::startPhase(QString name)
+{
+    Phase_struct phase;
+    phase.name = name;
+    phase.time_ms = 0;
+    phase.ok = false;
+    phases.append(phase);
+    if (verbose) std::cout << name.toStdString() << "..." << std::endl;
+    MyMidi->resetTransferCounters();
+    phaseTimer.start();
+}
+
+void VCeditCli::finishPhase(bool ok)
+{
+    if (phases.isEmpty()) return;
+    Phase_struct &phase = phases.last();
+    phase.time_ms = phaseTimer.elapsed();
+    phase.messages_sent = MyMidi->messagesSent();
+    phase.messages_received = MyMidi->messagesReceived();
+    phase.bytes_sent = MyMidi->bytesSent();
+    phase.bytes_received = MyMidi->bytesReceived();
+    phase.ok = ok;
+}
+
+void VCeditCli::showBenchmarkReport()
+{
+    qint64 total_time = 0;
+    std::cout << std::endl << "Phase                     Time (ms)  Msg out  Msg in   Bytes out  Bytes in   kB/s" << std::endl;
+    for (const Phase_struct &phase : phases) {
+        qint64 bytes = phase.bytes_sent + phase.bytes_received;
+        double speed = (phase.time_ms > 0) ? (double)bytes / phase.time_ms : 0.0;
+        std::cout << QString("%1 %2 %3 %4 %5 %6 %7%8")
+                     .arg(phase.name, -25)
+                     .arg(phase.time_ms, 9)
+                     .arg(phase.messages_sent, 8)
+                     .arg(phase.messages_received, 7)
+                     .arg(phase.bytes_sent, 11)
+                     .arg(phase.bytes_received, 9)
+                     .arg(speed, 7, 'f', 1)
+                     .arg(phase.ok ? "" : "  FAILED").toStdString() << std::endl;
+        total_time += phase.time_ms;
+    }
+    std::cout << QString("%1 %2").arg("Total", -25).arg(total_time, 9).toStdString() << std::endl;
+}
+
+// ********************************* Diff *********************************
+
+int VCeditCli::diffJsonValue(QString path, const QJsonValue &a, const QJsonValue &b)
+{
+    if (a == b) return 0;
+
+    if (a.isObject() && b.isObject()) {
+        QJsonObject objA = a.toObject();
+        QJsonObject objB = b.toObject();
+        QStringList keys = objA.keys();
+        for (const QString &key : objB.keys()) {
+            if (!objA.contains(key)) keys.append(key);
+        }
+        int differences = 0;
+        for (const QString &key : keys) {
+            differences += diffJsonValue(path + "/" + key, objA.value(key), objB.value(key));
+        }
+        return differences;
+    }
+
+    if (a.isArray() && b.isArray()) {
+        QJsonArray arrA = a.toArray();
+        QJsonArray arrB = b.toArray();
+        int differences = 0;
+        int size = qMax(arrA.size(), arrB.size());
+        for (int i = 0; i < size; i++) {
+            differences += diffJsonValue(path + "[" + QString::number(i) + "]", arrA.at(i), arrB.at(i));
+        }
+        return differences;
+    }
+
+    if (a.isUndefined()) std::cout << "+ " << path.toStdString() << std::endl;
+    else if (b.isUndefined()) std::cout << "- " << path.toStdString() << std::endl;
+    else std::cout << "~ " << path.toStdString() << ": " << a.toVariant().toString().toStdString() << " -> " << b.toVariant().toString().toStdString() << std::endl;
+    return 1;
+}
@@ -0,0 +1,103 @@
+#ifndef VCEDITCLI_H
+#define VCEDITCLI_H
+
+// VCeditCli is the headless version of VC-edit. It is built as a separate target (VC-edit-cli.pro)
+// and uses the same data classes and MIDI code as VC-edit, but without the main window.
+// It can convert (between the JSON *.vcd and the binary *.vcb format), validate and compare VC-edit files and upload or download a full backup to/from the VController.
+// Every phase of a transfer is timed, so transfer speed can be measured without using the GUI.
+
+#include "midi.h"
+#include "vcsettings.h"
+#include "vcmidiswitchsettings.h"
+#include "vcseqpattern.h"
+#include "vcdevices.h"
+#include "vccommands.h"
+#include "vcuserdevices.h"
+#include "vcbackupfile.h"
+#include "vcbinaryfile.h"
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QJsonValue>
+#include <QElapsedTimer>
+
+#define CLI_EXIT_OK 0
+#define CLI_EXIT_ERROR 1
+#define CLI_EXIT_DIFFERENT 2
+
+class VCeditCli : public QObject
+{
+    Q_OBJECT
+public:
+    explicit VCeditCli(QObject *parent = nullptr);
+    int run(const QStringList &arguments);
+
+private:
+    // Commands
+    int listPorts();
+    int validateFile(QString fileName);
+    int convertFile(QString inFile, QString outFile);
+    int diffFiles(QString fileA, QString fileB);
+    int downloadToFile(QString fileName);
+    int uploadFromFile(QString fileName);
+    int showFileInfo(QString fileName);
+    int benchmarkFile(QString fileName);
+
+    // Setup
+    bool setVCtype(QString typeName);
+    void setupVCconfig();
+    bool loadBackup(QString fileName, QStringList chunks = QStringList());
+    bool saveBackup(QString fileName);
+    bool openMidiPorts();
+    bool checkLoadedData();
+
+    // Transfer phases
+    bool uploadSettings();
+    bool uploadCommands();
+    bool uploadPatches();
+    bool uploadPatterns();
+    bool uploadUserDevices();
+    bool waitForMidi(const char *finishSignal);
+    bool waitForVController();
+
+    // Benchmarking
+    void startPhase(QString name);
+    void finishPhase(bool ok);
+    void showBenchmarkReport();
+
+    // Diff
+    int diffJsonValue(QString path, const QJsonValue &a, const QJsonValue &b);
+
+    Midi *MyMidi;
+    VCsettings *MyVCsettings;
+    VCmidiSwitches *MyVCmidiSwitches;
+    VCseqPattern *MyVCseqPatterns;
+    VCdevices *MyVCdevices;
+    VCuserdevices *MyVCuserDevice;
+    VCcommands *MyVCcommands;
+    VCbackupFile *MyVCbackupFile;
+    VCbinaryFile *MyVCbinaryFile;
+
+    QString MyMidiInPort, MyMidiOutPort;
+    QString virtualPortName;
+    bool typeSetFromCommandLine = false;
+    bool MyMidiSlowMode = false;
+    bool verbose = false;
+    int midiTimeout = 5000; // Time in ms without MIDI data before a download phase is aborted
+    int repeatCount = 10; // Number of runs for the file benchmark
+
+    struct Phase_struct {
+        QString name;
+        qint64 time_ms;
+        int messages_sent;
+        int messages_received;
+        qint64 bytes_sent;
+        qint64 bytes_received;
+        bool ok;
+    };
+    QVector<Phase_struct> phases;
+    QElapsedTimer phaseTimer;
+};
+
+#endif // VCEDITCLI_H
@@ -57,6 +57,8 @@ private:
     {
         { "Beat divider",  VALUE, 0, 1, 32, 1 },
         { "Number of steps", VALUE, 0, 1, 32, 2 },
+        { "Sync", OPTION, 48, 0, 2, 3 }, // With sync FREE the beat divider sets the time of a pattern in steps of 100 ms
+        { "Smoothing", VALUE, 0, 0, 100, 4 },
         { "STEP 1",  VALUE, 0, 0, 127, 5 },
         { "STEP 2",  VALUE, 0, 0, 127, 6 },
         { "STEP 3",  VALUE, 0, 0, 127, 7 },
@@ -114,6 +116,9 @@ private:
 
           // Sublist 40 - 47: MIDI switch types
           "OFF", "CC MOMENTARY", "CC TOGGLE", "CC RANGE", "PC", "", "", "",
+
+          // Sublist 48 - 50: Sequencer pattern sync
+          "TEMPO", "BEAT", "FREE",
     };
 };
 
@@ -63,6 +63,7 @@ private:
       { "Glob.tempo on PC", OPTION, 1, 0, 1, &Setting.Send_global_tempo_after_patch_change }, // Switch 6
       { "Hide tempo LED", OPTION, 1, 0, 1, &Setting.Hide_tap_tempo_LED }, // Switch 7
       { "Backlight Type", OPTION, 51, 0, 1, &Setting.RGB_Backlight_scheme }, // Switch 8
+      { "Song part change at", OPTION, 96, 0, 2, &Setting.Song_part_change_timing }, // Switch 10
 
       { "LED Settings", HEADER, 0, 0, 0, 0 }, // Menu title
       { "LED Brightness", VALUE, 0, 0, 100, &Setting.LED_brightness }, // Switch 1
@@ -101,7 +102,12 @@ private:
       { "Bass mode CC number", VALUE, 0, 0, 127, &Setting.Bass_mode_cc_number }, // Switch 7
       { "Bass mode min velocity", VALUE, 0, 0, 127, &Setting.Bass_mode_min_velocity}, // Switch 8
       { "HighNotePriotyCC", VALUE, 0, 0, 127, &Setting.HNP_mode_cc_number }, // Switch 9
+      { "Bass mode priority", OPTION, 92, 0, 3, &Setting.Bass_mode_priority }, // Bass mode menu switch 1
+      { "Bass mode number of strings", VALUE, 0, 6, 7, &Setting.Bass_mode_number_of_strings }, // Bass mode menu switch 2
+      { "Bass mode hold time (x10 ms)", VALUE, 0, 0, 50, &Setting.Bass_mode_hold_time }, // Bass mode menu switch 3
+      { "Command time per loop (x0.1 ms)", VALUE, 0, 0, 100, &Setting.Cmd_execute_time_budget }, // Bass mode menu switch 4
       { "Follow tempo from Guitar2MIDI", OPTION, 79, 0, 2, &Setting.Follow_tempo_from_G2M}, // Switch 10
+      { "Expression pedal high resolution CC", OPTION, 1, 0, 1, &Setting.Exp_pedal_high_res_CC }, // Calibration menu switch 5
 
       { "MIDI Forwarding Settings", HEADER }, // Menu title
       { "Rule 1: Source port", OPTION, MIDI_PORT_SUBLIST, 0, 0, &Setting.MIDI_forward_source_port[0] }, // Switch 1
@@ -170,6 +176,12 @@ private:
 
           // Sublist 90 - 91: Katana type
           "Katana100 (8 CH)", "Katana50 (4 CH)",
+
+          // Sublist 92 - 95: Bass mode priority types
+          "LOW + HIGH", "LOW STRING", "HIGH STRING", "CHORD",
+
+          // Sublist 96 - 98: Song part change timing
+          "IMMEDIATELY", "NEXT BEAT", "NEXT BAR",
     };
 };
 
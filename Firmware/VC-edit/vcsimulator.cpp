@@ -0,0 +1,353 @@
+#include "vcsimulator.h"
+#include "VController/config.h"
+#include "VController/globals.h"
+#include "VController/globaldevices.h"
+
+VCsimulator::VCsimulator(QObject *parent) : QObject(parent)
+{
+
+}
+
+void VCsimulator::loadCommands(VCcommands *commands, int switches)
+{
+    QMutexLocker locker(&mutex);
+    switchCmds.clear();
+    switchLabels.clear();
+    pageNames.clear();
+    switchState.clear();
+
+    numberOfSwitches = switches;
+    if (numberOfSwitches > NUMBER_OF_SWITCHES + NUMBER_OF_EXTERNAL_SWITCHES) numberOfSwitches = NUMBER_OF_SWITCHES + NUMBER_OF_EXTERNAL_SWITCHES;
+    numberOfUserPages = Number_of_pages;
+    for (int pg = 0; pg < MAX_NUMBER_OF_PAGES; pg++) {
+        if ((pg >= Number_of_pages) && (pg < first_fixed_cmd_page)) continue; // Skip the gap between user and fixed pages
+        pageNames[pg] = commands->getPageName(pg);
+        for (int sw = 1; sw <= numberOfSwitches; sw++) {
+            switchCmds[key(pg, sw)] = commands->switchCommands(pg, sw);
+            QString label = commands->customLabelString(pg, sw);
+            if (label.trimmed().isEmpty()) label = commands->switchCommandString(pg, sw);
+            switchLabels[key(pg, sw)] = label;
+        }
+    }
+
+    portNames = midi_port_names;
+    deviceNames.clear();
+    deviceColours.clear();
+    for (int d = 0; d < NUMBER_OF_DEVICES; d++) {
+        deviceNames.append(Device[d]->device_name);
+        deviceColours.append(Device[d]->my_LED_colour);
+    }
+    globalColour = Setting.LED_global_colour;
+    if (currentPage >= numberOfUserPages) currentPage = (numberOfUserPages > 1) ? 1 : 0;
+}
+
+void VCsimulator::start()
+{
+    if (longPressTimer == nullptr) { // Create the timer here, so it lives in the simulator thread
+        longPressTimer = new QTimer(this);
+        longPressTimer->setSingleShot(true);
+        connect(longPressTimer, SIGNAL(timeout()), this, SLOT(longPressTimerExpired()));
+    }
+    QMutexLocker locker(&mutex);
+    clock.start();
+    lastTapTime = -1;
+    selectPage(currentPage);
+}
+
+// ********************************* Switches *********************************
+
+void VCsimulator::switchPressed(int sw)
+{
+    if (longPressTimer == nullptr) return; // Not started yet
+    QMutexLocker locker(&mutex);
+    if ((sw < 1) || (sw > numberOfSwitches)) return;
+    pressedSwitch = sw;
+    longPressExecuted = false;
+    pressTime = clock.nsecsElapsed() / 1000;
+    messagesSinceLastPress = 0;
+    firstMessageTime = pressTime;
+    lastMessageTime = pressTime;
+
+    estimateFirmwareTime(sw, switchCmds.value(key(currentPage, sw)).size());
+    executeCommands(sw, 0);
+    if (pressedSwitch == sw) longPressTimer->start(SIM_LONG_PRESS_TIME); // Page may have changed
+
+    emit switchLatency(sw, firstMessageTime - pressTime, lastMessageTime - pressTime, messagesSinceLastPress);
+}
+
+void VCsimulator::switchReleased(int sw)
+{
+    if (longPressTimer == nullptr) return; // Not started yet
+    QMutexLocker locker(&mutex);
+    if ((sw < 1) || (sw > numberOfSwitches)) return;
+    longPressTimer->stop();
+    if (sw != pressedSwitch) return; // Page was changed by this switch - skip release commands like the VController does
+    pressedSwitch = 0;
+    if (!longPressExecuted) executeCommands(sw, ON_RELEASE);
+    updateSwitchLED(sw);
+}
+
+void VCsimulator::longPressTimerExpired()
+{
+    QMutexLocker locker(&mutex);
+    if (pressedSwitch == 0) return;
+    if (switchCmds.value(key(currentPage, pressedSwitch)).isEmpty()) return;
+    bool has_long_press_cmds = false;
+    for (const Cmd_struct &cmd : switchCmds[key(currentPage, pressedSwitch)]) {
+        if ((cmd.Switch & SWITCH_TYPE_MASK) == ON_LONG_PRESS) has_long_press_cmds = true;
+    }
+    if (!has_long_press_cmds) return;
+    longPressExecuted = true;
+    executeCommands(pressedSwitch, ON_LONG_PRESS);
+}
+
+void VCsimulator::executeCommands(uint8_t sw, uint8_t trigger)
+{
+    const QVector<Cmd_struct> cmds = switchCmds.value(key(currentPage, sw));
+    uint8_t pg = currentPage;
+    bool first_cmd = true;
+    for (const Cmd_struct &cmd : cmds) {
+        if (currentPage != pg) break; // Stop when a command selected another page
+        uint8_t cmd_trigger = cmd.Switch & SWITCH_TYPE_MASK;
+        if (cmd_trigger & ON_DUAL_PRESS) continue; // Dual press is not simulated
+        if (cmd_trigger == trigger) {
+            executeCommandPress(sw, cmd, first_cmd);
+            first_cmd = false;
+        }
+        else if ((trigger == ON_RELEASE) && (cmd_trigger == 0)) {
+            executeCommandRelease(sw, cmd, first_cmd);
+        }
+    }
+    if (currentPage == pg) updateSwitchLED(sw);
+}
+
+void VCsimulator::executeCommandPress(uint8_t sw, const Cmd_struct &cmd, bool first_cmd)
+{
+    if (cmd.Device != COMMON) {
+        reportAction(deviceName(cmd.Device) + ": command type " + QString::number(cmd.Type) + " (" + switchLabels.value(key(currentPage, sw)).trimmed() + ")");
+        return;
+    }
+
+    uint8_t val;
+    switch (cmd.Type) {
+    case PAGE:
+        if (cmd.Data1 == SELECT) selectPage(cmd.Data2);
+        else if (cmd.Data1 == NEXT) selectPage((currentPage + 1 < numberOfUserPages) ? currentPage + 1 : 1);
+        else if (cmd.Data1 == PREV) selectPage((currentPage > 1) ? currentPage - 1 : numberOfUserPages - 1);
+        else reportAction("Page bank select");
+        break;
+    case TAP_TEMPO:
+        tapTempo();
+        break;
+    case SET_TEMPO:
+        bpm = cmd.Data1;
+        showMainDisplay("Tempo " + QString::number(bpm) + " BPM");
+        reportAction("Tempo set to " + QString::number(bpm) + " BPM");
+        break;
+    case GLOBAL_TUNER:
+        reportAction("Global tuner");
+        break;
+    case MIDI_PC:
+        if (cmd.Data1 == SELECT) sendPC(cmd.Data2, cmd.Value1, cmd.Value2);
+        else reportAction("MIDI PC bank/next/prev");
+        break;
+    case MIDI_CC:
+        switch (cmd.Data2) {
+        case CC_ONE_SHOT:
+        case CC_MOMENTARY:
+            sendCC(cmd.Data1, cmd.Value1, cmd.Value3, cmd.Value4);
+            break;
+        case CC_TOGGLE:
+        case CC_TOGGLE_ON:
+            if (first_cmd) switchState[key(currentPage, sw)] = (switchState.value(key(currentPage, sw)) == 0) ? 1 : 0;
+            val = (switchState.value(key(currentPage, sw)) == 0) ? cmd.Value1 : cmd.Value2;
+            if (cmd.Data2 == CC_TOGGLE_ON) val = (switchState.value(key(currentPage, sw)) == 0) ? cmd.Value2 : cmd.Value1;
+            sendCC(cmd.Data1, val, cmd.Value3, cmd.Value4);
+            break;
+        default:
+            reportAction("MIDI CC range/step/updown");
+            break;
+        }
+        break;
+    case MIDI_NOTE:
+        sendNoteOn(cmd.Data1, cmd.Data2, cmd.Value1, cmd.Value2);
+        break;
+    case SELECT_NEXT_DEVICE:
+        reportAction("Select next device");
+        break;
+    case SETLIST:
+        reportAction("Setlist");
+        break;
+    case SONG:
+        reportAction("Song");
+        break;
+    case MODE:
+        reportAction("Mode select");
+        break;
+    case MIDI_MORE:
+        reportAction("MIDI start/stop");
+        break;
+    }
+}
+
+void VCsimulator::executeCommandRelease(uint8_t sw, const Cmd_struct &cmd, bool first_cmd)
+{
+    Q_UNUSED(sw);
+    Q_UNUSED(first_cmd);
+    if (cmd.Device != COMMON) return;
+    switch (cmd.Type) {
+    case MIDI_NOTE:
+        sendNoteOff(cmd.Data1, cmd.Data2, cmd.Value1, cmd.Value2);
+        break;
+    case MIDI_CC:
+        if (cmd.Data2 == CC_MOMENTARY) sendCC(cmd.Data1, cmd.Value2, cmd.Value3, cmd.Value4);
+        break;
+    }
+}
+
+void VCsimulator::tapTempo()
+{
+    qint64 now = clock.elapsed();
+    if (lastTapTime >= 0) {
+        qint64 interval = now - lastTapTime;
+        if ((interval > 0) && (interval < 3000)) { // Ignore taps that are far apart
+            uint16_t new_bpm = 60000 / interval;
+            if ((new_bpm >= 40) && (new_bpm <= 250)) bpm = new_bpm;
+        }
+    }
+    lastTapTime = now;
+    showMainDisplay("Tempo " + QString::number(bpm) + " BPM");
+    reportAction("Tap tempo: " + QString::number(bpm) + " BPM");
+}
+
+// ********************************* Display and LEDs *********************************
+
+void VCsimulator::selectPage(uint8_t pg)
+{
+    if (!pageNames.contains(pg)) return;
+    currentPage = pg;
+    pressedSwitch = 0; // No release or long press commands on the new page
+    longPressTimer->stop();
+    reportAction("Page " + QString::number(pg) + " selected: " + pageNames.value(pg).trimmed());
+    showPage();
+}
+
+void VCsimulator::showPage()
+{
+    showMainDisplay("");
+    for (int sw = 1; sw <= numberOfSwitches; sw++) {
+        emit updateLcdDisplay(sw, centerLabel(switchLabels.value(key(currentPage, sw)).trimmed()), centerLabel(pageNames.value(currentPage).trimmed()));
+        updateSwitchLED(sw);
+    }
+}
+
+void VCsimulator::showMainDisplay(QString line2)
+{
+    QString line1 = pageNames.value(currentPage).trimmed();
+    if (line1.isEmpty()) line1 = "Page " + QString::number(currentPage);
+    if (line2.isEmpty()) line2 = "Simulator";
+    emit updateLcdDisplay(0, centerLabel(line1), centerLabel(line2));
+}
+
+void VCsimulator::updateSwitchLED(uint8_t sw)
+{
+    const QVector<Cmd_struct> cmds = switchCmds.value(key(currentPage, sw));
+    if (cmds.isEmpty()) {
+        emit setButtonColour(sw, 0);
+        return;
+    }
+    uint8_t colour = commandColour(cmds[0]);
+    bool on = (sw == pressedSwitch) || (switchState.value(key(currentPage, sw)) != 0);
+    emit setButtonColour(sw, on ? colour : colour + 16); // Colour + 16 is the dimmed version
+}
+
+uint8_t VCsimulator::commandColour(const Cmd_struct &cmd)
+{
+    if ((cmd.Device < deviceColours.size()) && (cmd.Type != NOTHING)) return deviceColours[cmd.Device];
+    if (cmd.Type == NOTHING) return 0;
+    return globalColour;
+}
+
+// ********************************* MIDI *********************************
+
+void VCsimulator::sendPC(uint8_t program, uint8_t channel, uint8_t port)
+{
+    QByteArray message;
+    message.append((char)(0xC0 | ((channel - 1) & 0x0F)));
+    message.append((char)(program & 0x7F));
+    sendMidi(port, message, "PC #" + QString::number(program) + " on channel " + QString::number(channel));
+}
+
+void VCsimulator::sendCC(uint8_t controller, uint8_t value, uint8_t channel, uint8_t port)
+{
+    QByteArray message;
+    message.append((char)(0xB0 | ((channel - 1) & 0x0F)));
+    message.append((char)(controller & 0x7F));
+    message.append((char)(value & 0x7F));
+    sendMidi(port, message, "CC #" + QString::number(controller) + " with value " + QString::number(value) + " on channel " + QString::number(channel));
+}
+
+void VCsimulator::sendNoteOn(uint8_t note, uint8_t velocity, uint8_t channel, uint8_t port)
+{
+    QByteArray message;
+    message.append((char)(0x90 | ((channel - 1) & 0x0F)));
+    message.append((char)(note & 0x7F));
+    message.append((char)(velocity & 0x7F));
+    sendMidi(port, message, "NoteOn #" + QString::number(note) + " with velocity " + QString::number(velocity) + " on channel " + QString::number(channel));
+}
+
+void VCsimulator::sendNoteOff(uint8_t note, uint8_t velocity, uint8_t channel, uint8_t port)
+{
+    QByteArray message;
+    message.append((char)(0x80 | ((channel - 1) & 0x0F)));
+    message.append((char)(note & 0x7F));
+    message.append((char)(velocity & 0x7F));
+    sendMidi(port, message, "NoteOff #" + QString::number(note) + " on channel " + QString::number(channel));
+}
+
+void VCsimulator::sendMidi(uint8_t port, QByteArray message, QString description)
+{
+    lastMessageTime = clock.nsecsElapsed() / 1000;
+    if (messagesSinceLastPress == 0) firstMessageTime = lastMessageTime;
+    messagesSinceLastPress++;
+    emit midiMessageSent(lastMessageTime, portName(port), message, description);
+}
+
+void VCsimulator::estimateFirmwareTime(int sw, int number_of_commands)
+{
+    // The VController walks through all the commands of a switch, also the ones that are not for this trigger
+    if (number_of_commands < 2) return;
+    qint64 one_per_loop = ((number_of_commands - 1) * (SIM_LOOP_TIME + SIM_CMD_TIME)) + SIM_CMD_TIME;
+    int commands_per_batch = ((Setting.Cmd_execute_time_budget * SIM_CMD_EXECUTE_TIME_STEP) + SIM_CMD_TIME - 1) / SIM_CMD_TIME;
+    if (commands_per_batch < 1) commands_per_batch = 1; // A budget of zero executes one command per loop cycle
+    int full_batches = (number_of_commands - 1) / commands_per_batch;
+    qint64 batched = (full_batches * (SIM_LOOP_TIME + (commands_per_batch * SIM_CMD_TIME))) + ((number_of_commands - (full_batches * commands_per_batch)) * SIM_CMD_TIME);
+    emit firmwareTimeEstimate(sw, number_of_commands, one_per_loop, batched);
+}
+
+void VCsimulator::reportAction(QString description)
+{
+    emit actionExecuted(clock.nsecsElapsed() / 1000, description);
+}
+
+QString VCsimulator::portName(uint8_t port)
+{
+    if (port < portNames.size()) return portNames[port];
+    return "Port " + QString::number(port + 1);
+}
+
+QString VCsimulator::deviceName(uint8_t dev)
+{
+    if (dev == CURRENT) return "Current device";
+    if (dev < deviceNames.size()) return deviceNames[dev];
+    return "Device " + QString::number(dev);
+}
+
+QString VCsimulator::centerLabel(QString lbl)
+{
+    int msg_length = lbl.length();
+    if (msg_length >= LCD_DISPLAY_SIZE) return lbl.left(LCD_DISPLAY_SIZE);
+    int spaces_right = (LCD_DISPLAY_SIZE - msg_length) / 2;
+    int spaces_left = LCD_DISPLAY_SIZE - spaces_right - msg_length;
+    return QString(spaces_left, ' ') + lbl + QString(spaces_right, ' ');
+}
@@ -0,0 +1,105 @@
+#ifndef VCSIMULATOR_H
+#define VCSIMULATOR_H
+
+// VCsimulator runs the commands of the current configuration when VC-edit is not connected to a VController.
+// It runs in its own thread, so timing is not affected by the GUI. The commands are copied from VCcommands when the simulator is loaded,
+// so the simulator never reads the command data while it is being edited.
+// The simulator follows the command handling of SW_functions.ino for pages, tempo and MIDI commands. Device commands are only reported.
+// Every MIDI message that would be sent is reported with a timestamp in microseconds. The time between the switch press and the first and last message
+// of that press is reported as well. This is the time the simulator takes on the computer, not the latency of the VController.
+// The real switch latency is measured by the VController firmware and shown with the profiler telemetry during remote control.
+// For switches with more than one command, the simulator also estimates how long the VController takes to execute all the commands
+// when it executes one command per loop cycle and when it executes commands in batches within Setting.Cmd_execute_time_budget.
+// This is arithmetic on the estimated loop and command times below, not a measurement. Use the profiler telemetry for real figures.
+
+#include "vccommands.h"
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QVector>
+#include <QHash>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QMutex>
+
+#define SIM_LONG_PRESS_TIME 1000 // Same as LONG_PRESS_TIMER_LENGTH in the VController firmware
+#define SIM_DEFAULT_TEMPO 120
+#define SIM_LOOP_TIME 1500 // Estimated time in microseconds of one VController loop cycle with LED and display updates
+#define SIM_CMD_TIME 200 // Estimated time in microseconds to execute one command
+#define SIM_CMD_EXECUTE_TIME_STEP 100 // Same as CMD_EXECUTE_TIME_STEP in the VController firmware
+
+class VCsimulator : public QObject
+{
+    Q_OBJECT
+public:
+    explicit VCsimulator(QObject *parent = nullptr);
+    void loadCommands(VCcommands *commands, int numberOfSwitches); // Call from the main thread before starting
+
+public slots:
+    void start();
+    void switchPressed(int sw);
+    void switchReleased(int sw);
+
+signals:
+    void updateLcdDisplay(int, QString, QString);
+    void setButtonColour(int, int);
+    void midiMessageSent(qint64 time_us, QString port, QByteArray message, QString description);
+    void actionExecuted(qint64 time_us, QString description);
+    void switchLatency(int sw, qint64 first_latency_us, qint64 latency_us, int number_of_messages);
+    void firmwareTimeEstimate(int sw, int number_of_commands, qint64 one_per_loop_us, qint64 batched_us);
+
+private slots:
+    void longPressTimerExpired();
+
+private:
+    void selectPage(uint8_t pg);
+    void showPage();
+    void showMainDisplay(QString line2);
+    void updateSwitchLED(uint8_t sw);
+    void executeCommands(uint8_t sw, uint8_t trigger);
+    void executeCommandPress(uint8_t sw, const Cmd_struct &cmd, bool first_cmd);
+    void executeCommandRelease(uint8_t sw, const Cmd_struct &cmd, bool first_cmd);
+    void sendPC(uint8_t program, uint8_t channel, uint8_t port);
+    void sendCC(uint8_t controller, uint8_t value, uint8_t channel, uint8_t port);
+    void sendNoteOn(uint8_t note, uint8_t velocity, uint8_t channel, uint8_t port);
+    void sendNoteOff(uint8_t note, uint8_t velocity, uint8_t channel, uint8_t port);
+    void sendMidi(uint8_t port, QByteArray message, QString description);
+    void reportAction(QString description);
+    void tapTempo();
+    void estimateFirmwareTime(int sw, int number_of_commands);
+    QString portName(uint8_t port);
+    QString deviceName(uint8_t dev);
+    uint8_t commandColour(const Cmd_struct &cmd);
+    QString centerLabel(QString lbl);
+    int key(uint8_t pg, uint8_t sw) { return (pg << 8) | (sw & SWITCH_MASK); }
+
+    // Copy of the configuration
+    QMutex mutex; // loadCommands() is called from the main thread
+    QHash<int, QVector<Cmd_struct> > switchCmds;
+    QHash<int, QString> switchLabels;
+    QHash<int, QString> pageNames;
+    QStringList portNames;
+    QStringList deviceNames;
+    QVector<uint8_t> deviceColours;
+    uint8_t globalColour = 1;
+    uint8_t numberOfUserPages = 1;
+    int numberOfSwitches = NUMBER_OF_SWITCHES;
+
+    // State
+    uint8_t currentPage = 1;
+    QHash<int, uint8_t> switchState; // Toggle state of switches with CC_TOGGLE commands
+    uint8_t pressedSwitch = 0;
+    bool longPressExecuted = false;
+    uint16_t bpm = SIM_DEFAULT_TEMPO;
+    qint64 lastTapTime = -1;
+    QElapsedTimer clock;
+    QTimer *longPressTimer = nullptr;
+    qint64 pressTime = 0;
+    int messagesSinceLastPress = 0;
+    qint64 firstMessageTime = 0;
+    qint64 lastMessageTime = 0;
+};
+
+#endif // VCSIMULATOR_H
@@ -28,7 +28,7 @@
 
 // ********************************* Section 1: MD_base_class declaration (base) ********************************************
 
-#define NUMBER_OF_DEVICE_SETTINGS 12
+#define NUMBER_OF_DEVICE_SETTINGS 13
 
 class MD_base_class
 { // Base class for midi devices
@@ -48,6 +48,7 @@ class MD_base_class
 
     // Midi in procedures
     virtual void check_SYSEX_in(const unsigned char* sxdata, short unsigned int sxlength, uint8_t port);
+    virtual bool check_SYSEX_in_realtime(const unsigned char* sxdata, short unsigned int sxlength, uint8_t port);
     virtual void forward_MIDI_message(const unsigned char* sxdata, short unsigned int sxlength);
     virtual void check_PC_in(uint8_t program, uint8_t channel, uint8_t port);
     virtual void forward_PC_message(uint8_t program, uint8_t channel);
@@ -69,10 +70,16 @@ class MD_base_class
     // Midi out procedures
     void check_sysex_delay();
     uint8_t calc_Roland_checksum(uint16_t sum);
+    void Roland_scene_write_clear();
+    void Roland_scene_write_add(uint32_t address, uint8_t value);
+    void Roland_scene_write_send();
+    virtual void write_sysex_block(uint32_t address, uint8_t *data, uint8_t len);
+    virtual uint8_t max_sysex_block_size();
     virtual void set_bpm();
     virtual void bpm_tap();
     virtual void start_tuner();
     virtual void stop_tuner();
+    virtual bool get_tuner_title(String &Output);
 
     // Patch selection procedures
     virtual void select_patch(uint16_t new_patch);
@@ -102,6 +109,8 @@ class MD_base_class
     virtual uint16_t setlist_song_get_number_of_items();
     virtual void setlist_song_full_item_format(uint16_t item, String &Output);
     virtual void setlist_song_short_item_format(uint16_t item, String &Output);
+    virtual uint16_t setlist_song_get_load_time(uint16_t item);
+    virtual uint16_t setlist_song_get_vc_memory_patch(uint16_t item);
     uint16_t patch_number_in_current_setlist(uint16_t number);
 
     // Direct select procedures
@@ -127,6 +136,7 @@ class MD_base_class
     virtual void parameter_press(uint8_t Sw, Cmd_struct *cmd, uint16_t number);
     virtual void parameter_release(uint8_t Sw, Cmd_struct *cmd, uint16_t number);
     virtual bool request_parameter(uint8_t sw, uint16_t number);
+    virtual void cancel_pending_request();
     virtual uint16_t number_of_parameters();
     virtual uint8_t number_of_values(uint16_t parameter);
     virtual uint16_t number_of_parbank_parameters();
@@ -243,6 +253,7 @@ class MD_base_class
     uint32_t  current_loop_length;
     uint32_t  max_looper_length;
     uint8_t dev_type = 0; // Variable no.11
+    uint8_t PC_echo_port = 0; // Variable no.12 - port for messages learned after a patch change (0 = off)
 
     // Default pages
     uint8_t my_device_page1 = 0;  // Variable no.4
@@ -357,6 +368,7 @@ class MD_GP10_class : public MD_base_class
     void read_complete_assign_area(uint8_t sw, uint32_t  address, const unsigned char* sxdata, short unsigned int sxlength);
     void assign_request(uint8_t sw);
     bool target_lookup(uint8_t sw, uint16_t target);
+    void build_target_index();
 
     // Master expression pedal procedures
     virtual void move_expression_pedal(uint8_t sw, uint8_t value, uint8_t exp_pedal);
@@ -367,7 +379,8 @@ class MD_GP10_class : public MD_base_class
     // Variables:
     uint8_t COSM_onoff;
     uint8_t nrml_pu_onoff;
-    uint8_t assign_read = false; // Assigns are read in three steps on the GP10 1) Read first 64 bytes, 2) Read last 64 bytes, 3) Read targets
+    uint8_t assign_read = false; // True when assign_mem contains the assign area of the current patch
+    bool assign_area_requested = false; // True while waiting for the assign area
     uint8_t assign_mem[0x80]; // Memory space for the data from the assigns
     uint8_t exp_type;
     uint8_t exp_on_type;
@@ -397,6 +410,7 @@ class MD_GR55_class : public MD_base_class
     void write_sysex(uint32_t  address, uint8_t value);
     void write_sysex(uint32_t  address, uint8_t value1, uint8_t value2);
     void write_sysex(uint32_t  address, uint8_t value1, uint8_t value2, uint8_t value3);
+    virtual void write_sysex_block(uint32_t address, uint8_t *data, uint8_t len);
     void request_sysex(uint32_t  address, uint8_t no_of_bytes);
     virtual void set_bpm();
     virtual void start_tuner();
@@ -450,9 +464,11 @@ class MD_GR55_class : public MD_base_class
     virtual void assign_release(uint8_t Sw);
     virtual void assign_load(uint8_t sw, uint8_t assign_number, uint8_t cc_number);
     virtual void request_current_assign(uint8_t sw);
+    void update_assign_cache(uint32_t address, const unsigned char* sxdata, short unsigned int sxlength);
     void read_current_assign(uint8_t sw, uint32_t  address, const unsigned char* sxdata, short unsigned int sxlength);
     void assign_request(uint8_t sw);
     bool ctl_target_lookup(uint8_t sw, uint8_t target);
+    void build_target_index();
     void set_tone_state(uint8_t state);
 
     // read full assign area
@@ -489,6 +505,8 @@ class MD_GR55_class : public MD_base_class
     virtual void show_snapscene(uint8_t number);
     //void set_snapscene_number_and_LED(uint8_t number);
     bool load_scene(uint8_t prev_scene, uint8_t new_scene);
+    void compile_scene_plans();
+    uint8_t scene_plan_data(uint8_t parameter, uint8_t value);
     uint8_t get_scene_index(uint8_t scene);
     uint8_t read_scene_data(uint8_t scene, uint8_t parameter);
     uint8_t read_temp_scene_data(uint8_t parameter);
@@ -514,6 +532,7 @@ class MD_GR55_class : public MD_base_class
     bool insert_patch(uint16_t number);
     bool initialize_patch(uint16_t number);
     void load_patch(uint16_t number);
+    uint16_t setlist_song_get_vc_memory_patch(uint16_t item);
     void initialize_patch_space();
     void save_pc_after_patch_save();
     void request_pc_after_patch_load();
@@ -544,6 +563,9 @@ class MD_GR55_class : public MD_base_class
     uint8_t read_full_assign_number = GR55_NUMBER_OF_ASSIGNS;
 
 #define GR55_NUMBER_OF_CONTROL_PEDALS 4
+#define GR55_CTL_PEDAL_ASSIGN_SIZE 13 // Number of bytes read for every control pedal
+    uint8_t ctl_assign_cache[GR55_NUMBER_OF_CONTROL_PEDALS][GR55_CTL_PEDAL_ASSIGN_SIZE];
+    uint8_t ctl_assign_cache_valid = 0; // One bit for every control pedal in ctl_assign_cache
 #define GR55_NUMBER_OF_SCENE_ASSIGNS 8
     bool scene_assign_state[GR55_NUMBER_OF_SCENE_ASSIGNS];
     uint8_t scene_momentary_inst_state = 0;
@@ -552,6 +574,9 @@ class MD_GR55_class : public MD_base_class
     uint8_t last_loaded_scene = 0;
 #define GR55_SCENE_DATA_BUFFER_SIZE 15
     uint8_t scene_data_buffer[GR55_SCENE_DATA_BUFFER_SIZE];
+#define GR55_SCENE_PLAN_SIZE 49 // GR55_TOTAL_NUMBER_OF_SCENE_PARAMETERS
+    uint8_t scene_plan[8][GR55_SCENE_PLAN_SIZE]; // The decoded parameter values of every scene
+    bool scene_plan_valid = false;
     char scene_label_buffer[8];
     bool mute_during_scene_change;
     uint16_t read_scene_parameter_number;
@@ -648,9 +673,12 @@ class MD_VG99_class : public MD_base_class
     void fix_reverse_pedals();
     virtual void assign_load(uint8_t sw, uint8_t assign_number, uint8_t cc_number);
     virtual void request_current_assign(uint8_t sw);
+    void get_assign_block(uint8_t index, uint32_t &address, uint8_t &size);
+    void update_assign_cache(uint32_t address, const unsigned char* sxdata, short unsigned int sxlength);
     void read_current_assign(uint8_t sw, uint32_t  address, const unsigned char* sxdata, short unsigned int sxlength);
     void assign_request(uint8_t sw);
     bool target_lookup(uint8_t sw, uint16_t target);
+    void build_target_index();
     //virtual uint8_t number_of_assigns();
 
     // Master expression pedal procedures
@@ -662,6 +690,7 @@ class MD_VG99_class : public MD_base_class
     uint8_t COSM_A_onoff;
     uint8_t COSM_B_onoff;
     uint8_t FC300_device_id;
+    uint64_t assign_cache_valid = 0; // One bit for every assign in VG99_assign_cache
     bool edit_mode = false;
     uint32_t  edit_mode_return_timer = 0;
 #define VG99_EDIT_MODE_RETURN_TIME 100
@@ -746,7 +775,8 @@ class MD_ZMS_class : public MD_base_class
 
     // Midi in procedures
     virtual void check_SYSEX_in(const unsigned char* sxdata, short unsigned int sxlength, uint8_t port);
-    uint16_t FXtypeMangler(uint8_t byte1, uint8_t byte2, uint8_t byte4);
+    void read_patch_name(const uint8_t *patch_data, uint16_t len, char *name);
+    uint16_t FXtypeMangler(const uint8_t *fx_slot);
     //virtual void check_PC_in(uint8_t program, uint8_t channel, uint8_t port);
 
     // Device connection procedures
@@ -894,9 +924,9 @@ class MD_HLX_class : public MD_base_class
     // Device connection procedures
     virtual void identity_check(const unsigned char* sxdata, short unsigned int sxlength, uint8_t in_port, uint8_t out_port);
     virtual void do_after_connect();
+    virtual void do_after_disconnect();
 
     // Midi out procedures
-    virtual void set_bpm();
     virtual void bpm_tap();
     virtual void start_tuner();
     virtual void stop_tuner();
@@ -954,7 +984,6 @@ class MD_HLX_class : public MD_base_class
     void set_sequence(uint8_t pattern);
     void stop_sequence();
     void set_sequence_beats(uint8_t beats);
-    void send_sequence_step_CC();
 
     // MIDI forwarding
     void PC_forwarding(uint8_t Program, uint8_t Channel, uint8_t Port);
@@ -968,12 +997,6 @@ class MD_HLX_class : public MD_base_class
     uint8_t MIDI_Helix_received_msg_no = 0;
     uint8_t MIDI_Helix_sent_msg_no = 0;
     uint8_t MIDI_Helix_current_program = 0;
-    uint8_t current_sequence = 0;
-    uint8_t beat_divider = 1;
-    uint8_t number_of_sequence_steps;
-    uint8_t current_sequence_step = 0;
-    uint8_t previous_sequence_value = 0;
-    bool update_sequencer = false;
     uint8_t number_of_snapshots = 8;
 
 #define TYPE_HELIX_01A 0
@@ -999,6 +1022,12 @@ class MD_FAS_class : public MD_base_class
 
     // Midi in procedures
     virtual void check_SYSEX_in(const unsigned char* sxdata, short unsigned int sxlength, uint8_t port);
+    virtual bool check_SYSEX_in_realtime(const unsigned char* sxdata, short unsigned int sxlength, uint8_t port);
+    void read_preset_number(const unsigned char* sxdata, short unsigned int sxlength);
+    void read_preset_name(const unsigned char* sxdata, short unsigned int sxlength);
+    void read_preset_name_by_number(const unsigned char* sxdata, short unsigned int sxlength);
+    void read_scene_status(const unsigned char* sxdata, short unsigned int sxlength);
+    void read_fx_block_states(const unsigned char* sxdata, short unsigned int sxlength);
     virtual void check_PC_in(uint8_t program, uint8_t channel, uint8_t port);
 
     // Device connection procedures
@@ -1008,6 +1037,8 @@ class MD_FAS_class : public MD_base_class
     virtual void check_still_connected();
 
     // Midi out procedures
+    void set_sysex_template();
+    void write_sysex_data(const uint8_t *data, uint8_t data_length);
     void write_sysex(uint8_t byte1);
     void write_sysex(uint8_t byte1, uint8_t byte2);
     void write_sysex(uint8_t byte1, uint8_t byte2, uint8_t byte3);
@@ -1016,6 +1047,8 @@ class MD_FAS_class : public MD_base_class
     virtual void set_bpm();
     virtual void start_tuner();
     virtual void stop_tuner();
+    void read_realtime_tuner(uint8_t note, uint8_t data);
+    virtual bool get_tuner_title(String &Output);
 
     // Patch selection procedures
     virtual void select_patch(uint16_t new_patch);
@@ -1072,6 +1105,11 @@ class MD_FAS_class : public MD_base_class
     uint8_t current_scene;
     uint8_t number_of_active_blocks;
     bool looper_block_detected;
+    uint8_t sysex_header_checksum;
+    uint8_t tuner_function;
+    uint8_t tuner_note;
+    uint8_t tuner_pointer;
+    uint32_t tuner_data_timer;
 };
 
 // ********************************* Section 10: MD_KTN_class declaration (derived) ********************************************
@@ -1103,7 +1141,8 @@ class MD_KTN_class : public MD_base_class
     void write_sysex(uint32_t  address, uint8_t value);
     void write_sysex(uint32_t  address, uint8_t value1, uint8_t value2);
     void request_sysex(uint32_t  address, uint8_t no_of_bytes);
-    void write_patch_data(uint32_t  address, uint8_t index, uint8_t len);
+    virtual void write_sysex_block(uint32_t address, uint8_t *data, uint8_t len);
+    virtual uint8_t max_sysex_block_size();
     virtual void set_bpm();
 
     // Patch selection procedures
@@ -1124,6 +1163,8 @@ class MD_KTN_class : public MD_base_class
     virtual void direct_select_press(uint8_t number);
 
     // Patch loading and saving
+    uint16_t setlist_song_get_load_time(uint16_t item);
+    uint16_t setlist_song_get_vc_memory_patch(uint16_t item);
     void load_patch(uint8_t number);
     void save_patch();
     void update_patch(uint8_t version, uint16_t number);
@@ -1133,6 +1174,10 @@ class MD_KTN_class : public MD_base_class
     void read_patch_message(uint8_t number, const unsigned char* sxdata, short unsigned int sxlength, bool checksum_ok);
     void skip_patch_message(uint8_t number, uint8_t start_index, uint8_t data_length);
     bool FX_chain_changed();
+    bool get_shadow_block(uint8_t block, uint8_t type, uint32_t &address, uint8_t &index, uint8_t &len);
+    void write_patch_block(uint8_t block, uint8_t type);
+    void update_shadow(uint32_t address, const uint8_t *data, uint16_t len);
+    void clear_shadow();
     void read_patch_name_from_buffer(String &txt);
     void store_patch_name_to_buffer(String txt);
     void load_patch_buffer_with_default_patch();
@@ -1173,6 +1218,11 @@ class MD_KTN_class : public MD_base_class
     uint8_t KTN_patch_buffer[VC_PATCH_SIZE];
 #define KTN_FX_CHAIN_SIZE 20
     uint8_t KTN_FX_chain[KTN_FX_CHAIN_SIZE];
+    uint8_t KTN_shadow_buffer[VC_PATCH_SIZE]; // What we know of the temporary patch on the Katana
+    uint32_t shadow_valid_blocks = 0; // One bit for every block of the shadow buffer
+    uint8_t shadow_type[4]; // Type of the MOD, FX, pedal and EQ data in the shadow buffer
+    uint8_t recall_messages; // Number of messages sent on the last patch recall
+    uint16_t recall_bytes;
     bool mod_enabled = false;
     uint8_t current_mod_type = 0;
     bool fx_enabled = false;
@@ -1218,6 +1268,7 @@ class MD_KPA_class : public MD_base_class
     void write_sysex(uint16_t address, uint16_t value);
     void write_sysex_string(uint16_t address, char *str);
     void send_beacon(uint8_t setNum, uint8_t flags, uint8_t timeLease);
+    void beacon_timer_check();
     void request_single_parameter(uint16_t address);
     void request_current_rig_name();
     void request_performance_name(uint8_t number);
@@ -1233,8 +1284,15 @@ class MD_KPA_class : public MD_base_class
     //void preselect_performance(uint16_t number);
     virtual bool request_patch_name(uint8_t sw, uint16_t number);
     virtual void request_current_patch_name();
+    void show_rig_name(String rname, bool complete);
+    void show_performance_name(String pname);
+    void show_slot_name(uint8_t sw, uint8_t slot, String pname);
     virtual void number_format(uint16_t number, String &Output);
     void page_update_timer_check();
+    uint8_t get_name_page(uint16_t page_number, bool create);
+    void write_back_name_page(uint8_t slot);
+    void name_cache_timer_check();
+    void clear_name_cache();
     void check_write_performance_name(uint16_t number, String pname);
     void clear_performance_name(uint16_t number);
     bool read_performance_name(uint16_t number, String &pname);
@@ -1270,10 +1328,12 @@ class MD_KPA_class : public MD_base_class
     virtual void read_parameter_value_name(uint16_t number, uint16_t value, String &Output);
     void clear_FX_states();
     void set_FX_state(uint8_t index, bool state);
+    void update_fx_mirror(uint16_t address, uint16_t value, bool requested);
     void set_mode(uint8_t mode);
     virtual void parameter_press(uint8_t Sw, Cmd_struct *cmd, uint16_t number);
     virtual void parameter_release(uint8_t Sw, Cmd_struct *cmd, uint16_t number);
     virtual bool request_parameter(uint8_t sw, uint16_t number);
+    virtual void cancel_pending_request();
     void read_FX_type(uint8_t sw, uint8_t type);
     void read_parameter(uint8_t sw, uint8_t byte1, uint8_t byte2);
     void check_update_label(uint8_t Sw, uint8_t value);
@@ -1305,8 +1365,16 @@ class MD_KPA_class : public MD_base_class
     bool send_morph_message;
     uint32_t page_update_timer;
 #define KPA_PAGE_UPDATE_TIME 500
-    uint8_t KPA_name_buffer[VC_PATCH_SIZE];
-    uint16_t current_buffer_number = 0;
+#define KPA_NAME_CACHE_PAGES 6
+#define KPA_NAME_CACHE_WRITE_BACK_TIME 2000
+    uint8_t name_cache[KPA_NAME_CACHE_PAGES][VC_PATCH_SIZE]; // Pages with eight performance or rig names
+    uint16_t name_cache_page[KPA_NAME_CACHE_PAGES]; // Patch number of the page in the slot. Zero if the slot is empty
+    uint32_t name_cache_last_used[KPA_NAME_CACHE_PAGES];
+    bool name_cache_dirty[KPA_NAME_CACHE_PAGES];
+    uint32_t name_cache_use_counter = 0;
+    uint32_t name_cache_write_back_timer = 0;
+    uint32_t name_cache_hits = 0;
+    uint32_t name_cache_misses = 0;
 #define KPA_SLOT_COLOUR LED_BLUE
     uint32_t pc_change_timeout = 0;
 #define PC_CHANGE_TIME 1500
@@ -1316,6 +1384,20 @@ class MD_KPA_class : public MD_base_class
     uint8_t last_checked_rig_number = 255;
 #define KPA_RIG_BASE_NUMBER 200
     bool rig_browsing = false;
+    bool patch_name_received = false;
+#define KPA_NUMBER_OF_FX_SLOTS 8
+    uint8_t fx_type_mirror[KPA_NUMBER_OF_FX_SLOTS];
+    uint8_t fx_state_mirror[KPA_NUMBER_OF_FX_SLOTS];
+    uint16_t fx_mirror_valid = 0; // Bit 0-7: type of stomp slot received, bit 8-15: state of stomp slot received
+#define KPA_NAME_MIRROR_PERFORMANCE 0
+#define KPA_NAME_MIRROR_RIG 6
+#define KPA_NUMBER_OF_NAME_MIRRORS 7
+    String name_mirror[KPA_NUMBER_OF_NAME_MIRRORS]; // 0: performance name, 1-5: slot names, 6: rig name
+    uint8_t name_mirror_valid = 0; // Bit 0-6: name received
+    bool beacon_active = false; // True while the KPA sends its active sensing signal
+    uint32_t beacon_timer = 0;
+    uint32_t beacon_data_timer = 0;
+    bool request_pending = false; // True while a switch on the page waits for a reply from the KPA
 };
 
 // ********************************* Section 12: MD_SVL_class declaration (derived) ********************************************
@@ -1405,6 +1487,7 @@ class MD_SY1000_class : public MD_base_class
     void write_sysex(uint32_t  address, uint8_t value1, uint8_t value2);
     void write_sysex(uint32_t  address, uint8_t value1, uint8_t value2, uint8_t value3, uint8_t value4);
     void write_sysex(uint32_t  address, uint8_t value1, uint8_t value2, uint8_t value3, uint8_t value4, uint8_t value5, uint8_t value6, uint8_t value7, uint8_t value8);
+    virtual void write_sysex_block(uint32_t address, uint8_t *data, uint8_t len);
     void request_sysex(uint32_t  address, uint8_t no_of_bytes);
     void control_edit_mode();
     void check_edit_mode_return_timer();
@@ -1480,6 +1563,7 @@ class MD_SY1000_class : public MD_base_class
     void assign_request(uint8_t sw);
     bool ctl_target_lookup(uint8_t sw, uint16_t target);
     bool target_lookup(uint8_t sw, uint16_t target);
+    void build_target_index();
     void request_full_assign(uint8_t number);
     void read_full_assign(uint8_t number, uint32_t  address, const unsigned char* sxdata, short unsigned int sxlength);
     void change_active_assign_sources(uint8_t from_value, uint8_t to_value);
@@ -1504,13 +1588,17 @@ class MD_SY1000_class : public MD_base_class
     virtual void show_snapscene(uint8_t number);
     void set_snapscene_number_and_LED(uint8_t number);
     bool load_scene(uint8_t prev_scene, uint8_t new_scene);
+    void compile_scene_plans();
     uint8_t get_scene_index(uint8_t scene);
     uint8_t read_scene_data(uint8_t scene, uint8_t parameter);
     uint8_t read_temp_scene_data(uint8_t parameter);
     void save_scene();
-    void request_scene_message(uint8_t number);
+    uint32_t get_scene_read_address(uint8_t parameter);
+    void plan_scene_read();
+    void start_scene_read();
+    void request_scene_message(uint8_t block);
     void check_read_scene_midi_timer();
-    void read_scene_message(uint8_t number, uint8_t data);
+    void read_scene_message(uint32_t address, const unsigned char* sxdata, uint16_t sxlen, uint8_t data3);
     void store_scene();
     void update_change_on_all_scenes();
     void check_delta_and_update_scenes();
@@ -1528,6 +1616,7 @@ class MD_SY1000_class : public MD_base_class
     bool insert_patch(uint16_t number);
     bool initialize_patch(uint16_t number);
     void load_patch(uint16_t number);
+    uint16_t setlist_song_get_vc_memory_patch(uint16_t item);
     void initialize_patch_space();
 
     // Master expression pedal procedures
@@ -1577,10 +1666,22 @@ class MD_SY1000_class : public MD_base_class
     uint8_t last_loaded_scene = 0;
 #define SY1000_SCENE_DATA_BUFFER_SIZE 15
     uint8_t scene_data_buffer[SY1000_SCENE_DATA_BUFFER_SIZE];
+#define SY1000_SCENE_PLAN_SIZE 72 // SY1000_TOTAL_NUMBER_OF_SCENE_PARAMETERS
+    uint8_t scene_plan[8][SY1000_SCENE_PLAN_SIZE]; // The decoded parameter values of every scene
+    bool scene_plan_valid = false;
     char scene_label_buffer[8];
     bool mute_during_scene_change;
-    uint16_t read_scene_parameter_number;
-    uint32_t  read_scene_parameter_address;
+    bool reading_scene = false;
+#define SY1000_SCENE_READ_MAX_BLOCK_SIZE 48 // Maximum number of bytes requested in one RQ1 message when reading a scene
+#define SY1000_SCENE_READ_WINDOW 4 // Number of blocks that are requested at the same time
+    uint8_t read_scene_block_of_parameter[SY1000_SCENE_PLAN_SIZE];
+    uint8_t read_scene_offset_of_parameter[SY1000_SCENE_PLAN_SIZE];
+    uint32_t read_scene_block_start[SY1000_SCENE_PLAN_SIZE];
+    uint8_t read_scene_block_size[SY1000_SCENE_PLAN_SIZE];
+    bool read_scene_block_received[SY1000_SCENE_PLAN_SIZE];
+    uint8_t read_scene_number_of_blocks = 0;
+    uint8_t read_scene_next_block = 0;
+    uint8_t read_scene_blocks_received = 0;
     uint32_t  read_scene_midi_timer;
     uint32_t  check_ample_time_between_pc_messages_timer = 0;
 #define CHECK_AMPLE_TIME_BETWEEN_PC_MESSAGES_TIME 1000
@@ -60,7 +60,7 @@
 // Example:  {<PAGE>, <SWITCH> | LABEL, 'P', 'A', 'T', 'C', 'H', ' ', ' ', ' ' }
 
 // Common command types
-#define NUMBER_OF_COMMON_TYPES 13 // Only the one that can be selected in the command builder
+#define NUMBER_OF_COMMON_TYPES 14 // Only the one that can be selected in the command builder
 #define NOTHING 0            // Example: {<PAGE>, <SWITCH>, NOTHING, COMMON}
 #define PAGE 1               // Example: {<PAGE>, <SWITCH>, PAGE, COMMON, SELECT, PAGE_COMBO1}
 #define TAP_TEMPO 2          // Example: {<PAGE>, <SWITCH>, TAP_TEMPO, COMMON}
@@ -74,10 +74,11 @@
 #define SONG 10              // Example: {<PAGE>, <SWITCH>, SONG, COMMON, NEXT}
 #define MODE 11              // Example: {<PAGE>, <SWITCH>, MODE, COMMON, SELECT, 0}
 #define MIDI_MORE 12         // Example: {<PAGE>, <SWITCH>, MIDI_PC, COMMON, START}
+#define MODULATION 13        // Example: {<PAGE>, <SWITCH>, MODULATION, COMMON, MOD_CMD_START_STOP, Lane, Pattern, Phase, Min, Max}
 
 // Common functions that can not be selected in the command builder
 #define NUMBER_OF_COMMON_TYPES_NOT_SELECTABLE 1
-#define MENU 13             // Example: {<PAGE>, <SWITCH>, MENU, COMMON, 1} - to display first menu item
+#define MENU 14             // Example: {<PAGE>, <SWITCH>, MENU, COMMON, 1} - to display first menu item
 
 // Device command types
 #define NUMBER_OF_DEVICE_TYPES 10
@@ -154,6 +155,14 @@
 #define MIDI_STOP 1
 #define MIDI_START_STOP 2
 
+// MODULATION options
+#define MOD_CMD_START 0       // Example: {<PAGE>, <SWITCH>, MODULATION, COMMON, MOD_CMD_START, Lane, Pattern, Phase, Min, Max}
+#define MOD_CMD_STOP 1        // Example: {<PAGE>, <SWITCH>, MODULATION, COMMON, MOD_CMD_STOP, Lane}
+#define MOD_CMD_START_STOP 2  // Example: {<PAGE>, <SWITCH>, MODULATION, COMMON, MOD_CMD_START_STOP, Lane, Pattern, Phase, Min, Max}
+#define MOD_CMD_TARGET_CC 3   // Example: {<PAGE>, <SWITCH>, MODULATION, COMMON, MOD_CMD_TARGET_CC, Lane, CC, Channel, Port}
+#define MOD_CMD_TARGET_NRPN 4 // Example: {<PAGE>, <SWITCH>, MODULATION, COMMON, MOD_CMD_TARGET_NRPN, Lane, MSB, LSB, Channel, Port}
+#define MOD_CMD_TARGET_PAR 5  // Example: {<PAGE>, <SWITCH>, MODULATION, COMMON, MOD_CMD_TARGET_PAR, Lane, Device, Parameter}
+
 // Setlist command types
 #define SL_SELECT 0
 #define SL_BANKSELECT 1
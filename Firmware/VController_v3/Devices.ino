@@ -124,6 +124,12 @@ DMAMEM uint8_t Current_song_buffer[VC_PATCH_SIZE];
 uint16_t Current_song_item[NUMBER_OF_SONG_TARGETS] = { 0 };
 uint8_t Current_song_midi_port[NUMBER_OF_SONG_TARGETS] = { 0 };
 uint8_t Current_song_midi_channel[NUMBER_OF_SONG_TARGETS] = { 1 };
+uint32_t song_prefetch_timer = 0;
+#define SONG_PREFETCH_DELAY 50 // Time after a song or part change before the next song and part are read into the patch cache
+int8_t song_prefetch_direction = 1; // Direction of the last song/part up/down command
+uint8_t part_change_pending = 0; // Bit for every song target that is waiting for its scheduled time
+uint16_t part_change_item[NUMBER_OF_SONG_TARGETS];
+uint32_t part_change_time[NUMBER_OF_SONG_TARGETS];
 
 #define SETLIST_ID 255
 #define SONG_ID 254
@@ -173,6 +179,7 @@ uint32_t last_looper_cmd_sent_timer = 0;
 
 bool on_looper_page = false;
 uint8_t Expr_ped_value = 0;
+uint16_t Expr_ped_value_14bit = 0; // Used for high resolution CC messages
 
 // ********************************* Section 2: Common device settings ********************************************
 // Default values have been moved to the device classes. All values should be set in the VController menu or VC-edit
@@ -216,13 +223,14 @@ void setup_devices() { // Trigger the initialization of  the devices
     Device[d]->init();
   }
   setup_random_number_generator();
-  device_sequencer_start();
+  setup_modulation();
 }
 
 void main_devices() {
   for (uint8_t d = 0; d < NUMBER_OF_DEVICES; d++) {
     Device[d]->update();
   }
+  MOD_update();
 }
 
 void check_all_devices_for_manual_connection() { // Trigger the manual connection of all devices
@@ -259,28 +267,443 @@ uint8_t get_programmed_device_number(uint8_t device_number) {
   return 0;
 }*/
 
-IntervalTimer Sequencer_timer;
+// Modulation engine
+// A modulation lane sends the steps of a pattern to a CC, an NRPN or a device parameter. There are three ways a lane can run:
+// MOD_SYNC_TEMPO: the cycle of the pattern takes Rate beats of the current tempo.
+// MOD_SYNC_BEAT: as MOD_SYNC_TEMPO, but the lane starts on the next beat of the clock. The lane waits at the end of a beat until the clock
+//   reaches the next beat and moves forward when the beat comes early, so it stays in sync with the received MIDI clock.
+// MOD_SYNC_FREE: the cycle of the pattern takes Rate milliseconds.
+// The modulation timer advances the phase of every lane and adds an event to the queue when a lane reaches a new step,
+// or a new substep when smoothing is on. MOD_update() is called from main_devices(). It reads the queue, calculates the values and sends them.
+// A value that is the same as the last value sent is not sent again. Every port type has a budget of bytes per second for modulation messages.
+// When the budget is used up, the newest value of a lane waits until the port has room again.
+// The MIDI sequencer of the Line6 Helix runs on a modulation lane.
+
+#define MOD_NUMBER_OF_LANES 4
+#define MOD_MAX_NUMBER_OF_STEPS 32
+#define MOD_TIMER_INTERVAL 1000 // Time between updates of the lanes in microseconds
+#define MOD_SUBSTEPS 8 // Number of values per step when smoothing is on
+#define MOD_NO_POSITION 0xFFFF
+
+#define MOD_TARGET_OFF 0
+#define MOD_TARGET_CC 1
+#define MOD_TARGET_NRPN 2
+#define MOD_TARGET_PARAMETER 3
+
+#define MOD_SYNC_TEMPO 0
+#define MOD_SYNC_BEAT 1
+#define MOD_SYNC_FREE 2
+
+// Bandwidth budget per port type
+#define MOD_SERIAL_US_PER_BYTE 1000 // Modulation may use 1000 bytes per second of a serial MIDI port (about a third of 31250 baud)
+#define MOD_USB_US_PER_BYTE 100 // and 10000 bytes per second of a USB MIDI port
+#define MOD_MAX_BURST_TIME 20000 // Budget that has not been used is saved up to this time (in microseconds)
+#define MOD_CC_MESSAGE_SIZE 3
+#define MOD_NRPN_MESSAGE_SIZE 9
+#define MOD_PARAMETER_MESSAGE_SIZE 16 // Estimated size of a parameter message - most devices use sysex
+
+struct MOD_lane_struct {
+  // Settings
+  uint8_t Target_type;
+  uint8_t Device;      // Device of MOD_TARGET_PARAMETER
+  uint16_t Number;     // CC number, NRPN number or parameter number
+  uint8_t Channel;
+  uint8_t Port;
+  uint8_t Min;         // Value sent for step value 0
+  uint8_t Max;         // Value sent for step value 127
+  uint8_t Sync;
+  uint16_t Rate;       // Number of beats per cycle (MOD_SYNC_TEMPO and MOD_SYNC_BEAT) or cycle time in milliseconds (MOD_SYNC_FREE)
+  uint8_t Phase;       // Start position in the cycle (0 - 127)
+  uint8_t Smoothing;   // Part of a step (0 - 100%) that glides from the value of the previous step
+  bool Random;         // A new random value is made for every step
+  uint8_t Number_of_steps;
+  uint8_t Steps[MOD_MAX_NUMBER_OF_STEPS];
+
+  // State
+  volatile bool Running;
+  volatile bool Wait_for_beat;
+  volatile uint32_t Phase_acc; // One cycle is 2^32
+  volatile uint32_t Increment; // Added to Phase_acc on every timer interrupt
+  volatile uint16_t Position;  // Step * substeps + substep
+  volatile uint32_t Beat_acc;  // Phase since the last beat (MOD_SYNC_BEAT)
+  uint32_t Start_beat;
+  uint32_t Last_beat;
+  bool Last_value_valid;
+  uint16_t Last_value_sent; // In the range of the target
+  bool Pending;
+  uint16_t Pending_value;
+};
+
+MOD_lane_struct MOD_lane[MOD_NUMBER_OF_LANES];
+
+struct MOD_event_struct {
+  uint32_t time; // Time of the step in microseconds
+  uint8_t lane;
+  uint16_t position;
+};
+
+#define MOD_EVENT_QUEUE_SIZE 32 // Must be a power of two
+MOD_event_struct MOD_event_queue[MOD_EVENT_QUEUE_SIZE];
+volatile uint8_t MOD_event_head = 0; // Only changed by MOD_timer_expired()
+volatile uint8_t MOD_event_tail = 0; // Only changed by MOD_update()
+uint16_t MOD_events_lost = 0;
+uint16_t MOD_current_bpm_x10 = 0;
+uint32_t MOD_port_budget_time[16]; // Per port type: the time until which the budget has been used
+
+IntervalTimer Modulation_timer;
+
+void setup_modulation() {
+  for (uint8_t l = 0; l < MOD_NUMBER_OF_LANES; l++) MOD_lane[l].Max = 127;
+  Modulation_timer.begin(MOD_timer_expired, MOD_TIMER_INTERVAL);
+  DEBUGMAIN("Modulation timer started at " + String(MOD_TIMER_INTERVAL));
+}
+
+// Lane settings
+
+void MOD_set_target_CC(uint8_t lane, uint8_t cc, uint8_t channel, uint8_t port) {
+  if (lane >= MOD_NUMBER_OF_LANES) return;
+  MOD_set_target(lane, MOD_TARGET_CC, 0, cc, channel, port);
+}
+
+void MOD_set_target_NRPN(uint8_t lane, uint16_t number, uint8_t channel, uint8_t port) {
+  if (lane >= MOD_NUMBER_OF_LANES) return;
+  MOD_set_target(lane, MOD_TARGET_NRPN, 0, number, channel, port);
+}
+
+void MOD_set_target_parameter(uint8_t lane, uint8_t dev, uint16_t parameter) {
+  if ((lane >= MOD_NUMBER_OF_LANES) || (dev >= NUMBER_OF_DEVICES)) return;
+  MOD_set_target(lane, MOD_TARGET_PARAMETER, dev, parameter, 0, 0);
+}
+
+void MOD_set_target(uint8_t lane, uint8_t type, uint8_t dev, uint16_t number, uint8_t channel, uint8_t port) {
+  bool same_target = (MOD_lane[lane].Target_type == type) && (MOD_lane[lane].Device == dev) && (MOD_lane[lane].Number == number)
+                     && (MOD_lane[lane].Channel == channel) && (MOD_lane[lane].Port == port);
+  if (same_target) return;
+  MOD_lane[lane].Target_type = type;
+  MOD_lane[lane].Device = dev;
+  MOD_lane[lane].Number = number;
+  MOD_lane[lane].Channel = channel;
+  MOD_lane[lane].Port = port;
+  MOD_lane[lane].Last_value_valid = false; // The new target does not have the last value
+  MOD_lane[lane].Pending = false;
+}
+
+void MOD_set_range(uint8_t lane, uint8_t min, uint8_t max) {
+  if (lane >= MOD_NUMBER_OF_LANES) return;
+  MOD_lane[lane].Min = min;
+  MOD_lane[lane].Max = max;
+}
+
+void MOD_set_pattern(uint8_t lane, const uint8_t *steps, uint8_t number_of_steps) {
+  if (lane >= MOD_NUMBER_OF_LANES) return;
+  if (number_of_steps > MOD_MAX_NUMBER_OF_STEPS) number_of_steps = MOD_MAX_NUMBER_OF_STEPS;
+  __disable_irq();
+  memcpy(MOD_lane[lane].Steps, steps, number_of_steps);
+  MOD_lane[lane].Number_of_steps = number_of_steps;
+  MOD_lane[lane].Random = false;
+  __enable_irq();
+}
+
+void MOD_set_random_pattern(uint8_t lane, uint8_t number_of_steps) {
+  if (lane >= MOD_NUMBER_OF_LANES) return;
+  if (number_of_steps > MOD_MAX_NUMBER_OF_STEPS) number_of_steps = MOD_MAX_NUMBER_OF_STEPS;
+  __disable_irq();
+  memset(MOD_lane[lane].Steps, 0, MOD_MAX_NUMBER_OF_STEPS);
+  MOD_lane[lane].Number_of_steps = number_of_steps;
+  MOD_lane[lane].Random = true;
+  __enable_irq();
+}
 
-void device_sequencer_start() {
-  long timer_interval = 60000000 / (24 * 120);
-  Sequencer_timer.begin(device_sequencer_timer_expired, timer_interval);
-  DEBUGMAIN("device sequencer started at " + String(timer_interval));
+void MOD_set_rate(uint8_t lane, uint8_t sync, uint16_t rate) {
+  if (lane >= MOD_NUMBER_OF_LANES) return;
+  if (rate == 0) rate = 1;
+  MOD_lane[lane].Sync = sync;
+  MOD_lane[lane].Rate = rate;
+  MOD_calculate_increment(lane);
 }
 
-void device_sequencer_update(uint8_t steps, uint8_t divider) {
-  if (steps == 0) return;
-  if (divider == 0) return;
-  long timer_interval = 60000000 * divider / (steps * Setting.Bpm);
-  Sequencer_timer.update(timer_interval);
-  DEBUGMSG("Sequence timer update: " + String(timer_interval));
+void MOD_set_phase(uint8_t lane, uint8_t phase) {
+  if (lane >= MOD_NUMBER_OF_LANES) return;
+  MOD_lane[lane].Phase = phase & 0x7F;
 }
 
-void device_sequencer_timer_expired() {
+void MOD_set_smoothing(uint8_t lane, uint8_t smoothing) {
+  if (lane >= MOD_NUMBER_OF_LANES) return;
+  if (smoothing > 100) smoothing = 100;
   __disable_irq();
-  My_HLX.update_sequencer = true;
+  MOD_lane[lane].Smoothing = smoothing;
+  MOD_lane[lane].Position = MOD_NO_POSITION; // The number of positions per step has changed
   __enable_irq();
 }
 
+void MOD_start(uint8_t lane) {
+  if (lane >= MOD_NUMBER_OF_LANES) return;
+  if ((MOD_lane[lane].Target_type == MOD_TARGET_OFF) || (MOD_lane[lane].Number_of_steps == 0)) return;
+  MOD_calculate_increment(lane);
+  __disable_irq();
+  MOD_lane[lane].Phase_acc = 0 - MOD_lane[lane].Increment; // The next timer interrupt moves the lane to the start of the cycle
+  MOD_lane[lane].Position = MOD_NO_POSITION;
+  MOD_lane[lane].Beat_acc = 0;
+  MOD_lane[lane].Last_beat = SCO_get_clock_beat_number();
+  MOD_lane[lane].Wait_for_beat = (MOD_lane[lane].Sync == MOD_SYNC_BEAT);
+  MOD_lane[lane].Running = true;
+  __enable_irq();
+  DEBUGMSG("Modulation lane " + String(lane) + " started with " + String(MOD_lane[lane].Number_of_steps) + " steps");
+}
+
+void MOD_stop(uint8_t lane) {
+  if (lane >= MOD_NUMBER_OF_LANES) return;
+  MOD_lane[lane].Running = false;
+  MOD_lane[lane].Pending = false;
+}
+
+bool MOD_running(uint8_t lane) {
+  if (lane >= MOD_NUMBER_OF_LANES) return false;
+  return MOD_lane[lane].Running;
+}
+
+void MOD_calculate_increment(uint8_t lane) {
+  uint32_t cycle_time; // in microseconds
+  if (MOD_lane[lane].Sync == MOD_SYNC_FREE) cycle_time = MOD_lane[lane].Rate * 1000;
+  else cycle_time = (600000000 / SCO_get_bpm_x10()) * MOD_lane[lane].Rate;
+  if (cycle_time <= MOD_TIMER_INTERVAL) cycle_time = MOD_TIMER_INTERVAL + 1;
+  MOD_lane[lane].Increment = ((uint64_t)MOD_TIMER_INTERVAL << 32) / cycle_time;
+}
+
+// Timer interrupt
+
+void MOD_timer_expired() {
+  uint32_t now = micros();
+  uint32_t beat_number = SCO_get_clock_beat_number();
+  for (uint8_t l = 0; l < MOD_NUMBER_OF_LANES; l++) {
+    MOD_lane_struct *lane = &MOD_lane[l];
+    if (!lane->Running) continue;
+
+    if ((lane->Sync == MOD_SYNC_BEAT) && (beat_number != lane->Last_beat)) {
+      lane->Last_beat = beat_number;
+      if (lane->Wait_for_beat) { // Start the lane on this beat
+        lane->Wait_for_beat = false;
+        lane->Start_beat = beat_number;
+        lane->Phase_acc = 0;
+      }
+      else { // Move the lane to the start of this beat
+        uint32_t beat_in_cycle = (beat_number - lane->Start_beat) % lane->Rate;
+        lane->Phase_acc = ((uint64_t)beat_in_cycle << 32) / lane->Rate;
+      }
+      lane->Beat_acc = 0;
+    }
+    else {
+      if (lane->Wait_for_beat) continue;
+      if (lane->Sync == MOD_SYNC_BEAT) {
+        uint32_t beat_length = 0xFFFFFFFF / lane->Rate;
+        if (lane->Increment >= beat_length - lane->Beat_acc) continue; // Wait for the next beat
+        lane->Beat_acc += lane->Increment;
+      }
+      lane->Phase_acc += lane->Increment;
+    }
+
+    uint16_t position = MOD_calculate_position(l);
+    if (position != lane->Position) {
+      lane->Position = position;
+      MOD_add_event(l, position, now);
+    }
+  }
+}
+
+uint16_t MOD_calculate_position(uint8_t l) { // Called from the timer interrupt
+  uint32_t phase = MOD_lane[l].Phase_acc + ((uint32_t)MOD_lane[l].Phase << 25); // Phase 0 - 127 covers the cycle
+  uint16_t number_of_positions = MOD_lane[l].Number_of_steps;
+  if (MOD_lane[l].Smoothing > 0) number_of_positions *= MOD_SUBSTEPS;
+  return ((phase >> 16) * number_of_positions) >> 16;
+}
+
+void MOD_add_event(uint8_t lane, uint16_t position, uint32_t time) { // Called from the timer interrupt
+  uint8_t head = MOD_event_head;
+  uint8_t next = (head + 1) & (MOD_EVENT_QUEUE_SIZE - 1);
+  if (next == MOD_event_tail) { // Queue is full
+    MOD_events_lost++;
+    return;
+  }
+  MOD_event_queue[head].time = time;
+  MOD_event_queue[head].lane = lane;
+  MOD_event_queue[head].position = position;
+  MOD_event_head = next; // The event is complete before the head moves
+}
+
+// Main loop
+
+void MOD_update() { // Called from main_devices()
+  if (MOD_current_bpm_x10 != SCO_get_bpm_x10()) { // The lanes follow the tempo
+    MOD_current_bpm_x10 = SCO_get_bpm_x10();
+    for (uint8_t l = 0; l < MOD_NUMBER_OF_LANES; l++) MOD_calculate_increment(l);
+  }
+
+  while (MOD_event_tail != MOD_event_head) {
+    MOD_event_struct event = MOD_event_queue[MOD_event_tail];
+    MOD_event_tail = (MOD_event_tail + 1) & (MOD_EVENT_QUEUE_SIZE - 1);
+    MOD_read_event(event.lane, event.position);
+  }
+
+  uint32_t now = micros();
+  for (uint8_t l = 0; l < MOD_NUMBER_OF_LANES; l++) {
+    if (MOD_lane[l].Pending) MOD_send_pending_value(l, now);
+  }
+}
+
+void MOD_read_event(uint8_t l, uint16_t position) {
+  MOD_lane_struct *lane = &MOD_lane[l];
+  if (!lane->Running) return; // Event from before the lane was stopped
+  uint8_t substeps = (lane->Smoothing > 0) ? MOD_SUBSTEPS : 1;
+  uint8_t step = position / substeps;
+  uint8_t substep = position % substeps;
+  if (step >= lane->Number_of_steps) return;
+
+  if ((lane->Random) && (substep == 0)) lane->Steps[step] = generate_random_number();
+  int16_t value = lane->Steps[step];
+  uint8_t glide_substeps = ((lane->Smoothing * MOD_SUBSTEPS) + 99) / 100;
+  if (substep < glide_substeps) { // Glide from the value of the previous step
+    int16_t prev_value = lane->Steps[(step > 0) ? step - 1 : lane->Number_of_steps - 1];
+    value = prev_value + (((value - prev_value) * (substep + 1)) / glide_substeps);
+  }
+  value = lane->Min + ((((int16_t)lane->Max - lane->Min) * value) / 127);
+  uint16_t target_value = MOD_scale_to_target(l, value);
+
+  if ((lane->Last_value_valid) && (target_value == lane->Last_value_sent)) { // Value is already on the target
+    lane->Pending = false;
+    return;
+  }
+  lane->Pending_value = target_value;
+  lane->Pending = true;
+}
+
+uint16_t MOD_scale_to_target(uint8_t l, uint8_t value) {
+  // Values for a device parameter are scaled to the range of the parameter, the same way SCO_update_parameter_state() does for an expression pedal
+  if (MOD_lane[l].Target_type != MOD_TARGET_PARAMETER) return value;
+  uint8_t max = Device[MOD_lane[l].Device]->number_of_values(MOD_lane[l].Number) - 1;
+  uint16_t _max = SCO_find_max_value(max);
+  uint16_t _min = 0;
+  if ((max + 1) == RPT_600) _min = 40;
+  return map(value, 0, 127, _min, _max);
+}
+
+void MOD_send_pending_value(uint8_t l, uint32_t now) {
+  MOD_lane_struct *lane = &MOD_lane[l];
+  uint16_t value = lane->Pending_value;
+  switch (lane->Target_type) {
+    case MOD_TARGET_CC:
+      if (!MOD_use_port_budget(lane->Port, MOD_CC_MESSAGE_SIZE, now)) return;
+      MIDI_send_CC(lane->Number, value, lane->Channel, lane->Port);
+      break;
+    case MOD_TARGET_NRPN:
+      if (!MOD_use_port_budget(lane->Port, MOD_NRPN_MESSAGE_SIZE, now)) return;
+      MIDI_send_NRPN(lane->Number, value, lane->Channel, lane->Port);
+      break;
+    case MOD_TARGET_PARAMETER:
+      if (Device[lane->Device]->connected) {
+        if (!MOD_use_port_budget(Device[lane->Device]->MIDI_out_port, MOD_PARAMETER_MESSAGE_SIZE, now)) return;
+        MOD_send_parameter(lane->Device, lane->Number, value);
+      }
+      break;
+  }
+  lane->Last_value_sent = value;
+  lane->Last_value_valid = true;
+  lane->Pending = false;
+}
+
+bool MOD_use_port_budget(uint8_t port, uint8_t number_of_bytes, uint32_t now) {
+  uint8_t port_type = port >> 4;
+  bool usb_port = ((port & 0xF0) == USBMIDI_PORT) || ((port & 0xF0) == USBHMIDI_PORT); // ALL_MIDI_PORTS includes the serial ports
+  uint32_t budget_time = MOD_port_budget_time[port_type];
+  if ((int32_t)(now - budget_time) > MOD_MAX_BURST_TIME) budget_time = now - MOD_MAX_BURST_TIME;
+  if ((int32_t)(budget_time - now) > 0) return false; // Budget is used up
+  MOD_port_budget_time[port_type] = budget_time + (number_of_bytes * (usb_port ? MOD_USB_US_PER_BYTE : MOD_SERIAL_US_PER_BYTE));
+  return true;
+}
+
+void MOD_send_parameter(uint8_t dev, uint16_t parameter, uint16_t value) {
+  // Device parameters are set through parameter_press() of the device, like an expression pedal does. Switch 0 is used as the switch of the pedal.
+  // The value is already scaled to the range of the parameter by MOD_scale_to_target().
+  SP_struct saved_switch = SP[0];
+  uint8_t saved_update_page = update_page;
+  uint8_t max = Device[dev]->number_of_values(parameter) - 1;
+  SP[0].Type = PARAMETER;
+  SP[0].Device = dev;
+  SP[0].Latch = RANGE;
+  SP[0].PP_number = parameter;
+  if (SCO_find_max_value(max) >= 128) { // Dual byte parameter
+    SP[0].Target_byte1 = value / 128;
+    SP[0].Target_byte2 = value % 128;
+  }
+  else {
+    SP[0].Target_byte1 = value;
+    SP[0].Target_byte2 = 0;
+  }
+  SP[0].Has_custom_label = false;
+  Cmd_struct cmd = { 0, 0, PARAMETER, dev, (uint8_t)parameter, 0, 0, max, 0, 0 };
+  Device[dev]->parameter_press(0, &cmd, parameter);
+  SP[0] = saved_switch;
+  update_page = saved_update_page; // Do not refresh the page on every step
+}
+
+// Modulation patterns
+// Every pattern consists of 36 bytes. The patterns in EEPROM (H_MEMORY.ino section 9) have the same layout.
+// Byte 01: The beat divider: the number of beats of one cycle. With sync FREE the cycle time in steps of 100 ms.
+// Byte 02: The number of steps in this sequence
+// Byte 03: Sync: 0 = follow the tempo, 1 = start on the beat and stay in sync with the MIDI clock, 2 = free running
+// Byte 04: Smoothing: the part of every step that glides from the previous value (0 - 100%)
+// Byte 05 - 36: The steps of the sequence.
+// The fixed patterns follow the patterns in EEPROM. The last pattern number is the random pattern.
+
+const PROGMEM uint8_t MOD_fixed_pattern[][36] = {
+  // First value is the beat divider for this pattern.
+  { 1, 24, 0, 0, 64, 80, 95, 108, 118, 125, 127, 125, 118, 108, 95, 80, 64, 47, 32, 19, 9, 2, 0, 2, 9, 19, 32, 47 },   // Sine wave
+  { 1, 24, 0, 0, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },     // Block wave
+  { 1, 24, 0, 0, 11, 21, 32, 42, 53, 64, 74, 85, 95, 106, 116, 127, 116, 106, 95, 85, 74, 64, 53, 42, 32, 21, 11, 0 }, // Triangle wave
+  { 1, 24, 0, 0, 0, 6, 11, 17, 22, 28, 33, 39, 44, 50, 55, 61, 66, 72, 77, 83, 88, 94, 99, 105, 110, 116, 121, 127 },  // Saw tooth
+  { 1, 24, 0, 0, 127, 127, 127, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },                       // Single 8th beat
+  { 2, 24, 0, 0, 127, 127, 0, 32, 32, 0, 32, 0, 0, 127, 64, 0, 127, 127, 0, 32, 32, 0, 32, 32, 0, 32, 32, 0 },         // Beat 1
+  { 4, 24, 0, 0, 127, 0, 0, 64, 0, 0, 64, 0, 0, 127, 127, 127, 127, 0, 0, 64, 0, 0, 64, 0, 0, 64, 0, 0 },              // Beat 2
+  { 1, 24, 0, 0, 127, 127, 127, 127, 127, 127, 0, 0, 32, 32, 32, 32, 32, 32, 0, 0, 95, 95, 95, 95, 95, 95, 0, 0 },     // Beat 3
+};
+
+#define MOD_NUMBER_OF_FIXED_PATTERNS (sizeof(MOD_fixed_pattern) / sizeof(MOD_fixed_pattern[0]))
+#define MOD_NUMBER_OF_PATTERNS (EXT_MAX_NUMBER_OF_SEQ_PATTERNS + MOD_NUMBER_OF_FIXED_PATTERNS + 1) // Including the random pattern. EXT_MAX_NUMBER_OF_SEQ_PATTERNS is defined in H_MEMORY.ino
+#define MOD_RANDOM_PATTERN_STEPS 24
+#define MOD_RANDOM_PATTERN_BEATS 12
+
+// Parameter lookup index
+// The Roland devices look up a parameter by the target or the control function of an assign. The parameter tables are not sorted on these numbers,
+// so the devices build an index at startup: a list of keys in ascending order with the number of the parameter that belongs to every key.
+// PAR_index_lookup() then finds a key with a binary search. If a key is used by more than one parameter, the first parameter in the table is found.
+
+void PAR_index_sort(uint16_t *keys, uint16_t *index, uint16_t size) { // The device fills keys[] and index[] with the key and number of every parameter
+  // Insertion sort - parameters with the same key keep their order
+  for (uint16_t i = 1; i < size; i++) {
+    uint16_t key = keys[i];
+    uint16_t number = index[i];
+    uint16_t j = i;
+    while ((j > 0) && (keys[j - 1] > key)) {
+      keys[j] = keys[j - 1];
+      index[j] = index[j - 1];
+      j--;
+    }
+    keys[j] = key;
+    index[j] = number;
+  }
+}
+
+uint16_t PAR_index_lookup(const uint16_t *keys, const uint16_t *index, uint16_t size, uint16_t key) { // Returns the parameter number or NO_RESULT
+  uint16_t low = 0;
+  uint16_t high = size;
+  while (low < high) { // Find the first key that is not smaller than the key we are looking for
+    uint16_t mid = (low + high) >> 1;
+    if (keys[mid] < key) low = mid + 1;
+    else high = mid;
+  }
+  if ((low < size) && (keys[low] == key)) return index[low];
+  return NO_RESULT;
+}
+
 // Random number generator
 
 // T3.6/T3.5 Random Number Generator
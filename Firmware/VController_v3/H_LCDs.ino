@@ -483,7 +483,11 @@ void LCD_update_top_line() {
   }
 
   if (global_tuner_active) { // Show tuner message if active
-    LCD_main_set_title("Tuner active");
+    String tuner_msg = "Tuner active";
+    for (uint8_t d = 0; d < NUMBER_OF_DEVICES; d++) {
+      if (Device[d]->get_tuner_title(tuner_msg)) break; // Show the tuner data of the first device that streams it
+    }
+    LCD_main_set_title(tuner_msg);
     return;
   }
 
@@ -555,7 +559,7 @@ void LCD_update_top_line() {
   if (Setting.Main_display_show_top_right == MDT_CURRENT_TEMPO) {
     top_right = char(CHAR_QUARTER_NOTE);
     top_right += "=";
-    top_right += String(Setting.Bpm);
+    top_right += SCO_get_bpm_string();
   }
 
   if (Setting.Main_display_show_top_right == MDT_SCENE_NAME) {
@@ -908,7 +912,7 @@ void LCD_load_short_message(uint8_t sw, String & msg) {
         msg = "TUNER";
         break;
       case TAP_TEMPO:
-        msg = char(CHAR_QUARTER_NOTE) + String(Setting.Bpm);
+        msg = char(CHAR_QUARTER_NOTE) + SCO_get_bpm_string();
         break;
       case SET_TEMPO:
         msg = char(CHAR_QUARTER_NOTE) + String(SP[sw].PP_number);
@@ -996,6 +1000,13 @@ void LCD_load_short_message(uint8_t sw, String & msg) {
           else msg = "START";
         }
         break;
+      case MODULATION:
+        if (SP[sw].PP_number == MOD_CMD_STOP) msg = "STOP";
+        else if ((SP[sw].PP_number == MOD_CMD_START_STOP) && (MOD_running(SP[sw].Value1 - 1))) msg = "STOP";
+        else if (SP[sw].PP_number >= MOD_CMD_TARGET_CC) msg = "TGT";
+        else msg = "MOD";
+        msg += String(SP[sw].Value1);
+        break;
     }
   }
 }
@@ -1690,6 +1701,18 @@ void LCD_update(uint8_t sw, bool do_show) {
         }
         LCD_add_label(SP[sw].Label);
 
+        break;
+      case MODULATION:
+        if (SP[sw].PP_number == MOD_CMD_START) LCD_add_title("MOD START");
+        if (SP[sw].PP_number == MOD_CMD_STOP) LCD_add_title("MOD STOP");
+        if (SP[sw].PP_number == MOD_CMD_START_STOP) {
+          if (MOD_running(SP[sw].Value1 - 1)) LCD_add_title("[START] STOP ");
+          else LCD_add_title(" START [STOP]");
+        }
+        if (SP[sw].PP_number == MOD_CMD_TARGET_CC) LCD_add_title("MOD TARGET CC");
+        if (SP[sw].PP_number == MOD_CMD_TARGET_NRPN) LCD_add_title("MOD TARGET NRPN");
+        if (SP[sw].PP_number == MOD_CMD_TARGET_PAR) LCD_add_title("MOD TARGET PAR");
+        LCD_add_label(SP[sw].Label);
         break;
       default:
         //LCD_print_lcd_txt(sw);
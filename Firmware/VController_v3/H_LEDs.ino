@@ -437,6 +437,17 @@ void LED_update() {
           else LED_show_colour(s, LED_OFF);
           Backlight_show_colour(s, SP[sw].Colour);
           break;
+        case MODULATION:
+          if (SP[sw].PP_number == MOD_CMD_START_STOP) { // Show the state of the lane
+            if (MOD_running(SP[sw].Value1 - 1)) LED_show_colour(s, SP[sw].Colour);
+            else LED_show_dimmed(s, SP[sw].Colour);
+          }
+          else {
+            if (SP[sw].Pressed) LED_show_colour(s, SP[sw].Colour);
+            else LED_show_colour(s, LED_OFF);
+          }
+          Backlight_show_colour(s, SP[sw].Colour);
+          break;
         case MIDI_CC:
           //DEBUGMAIN("CC latch:" + String(SP[sw].Latch));
           if ((SP[sw].Latch == CC_TOGGLE) || (SP[sw].Latch == CC_TOGGLE_ON)) {
@@ -11,7 +11,8 @@
 // Section 8: MG300 effect type storage
 // Section 9: Sequencer patterns storage
 // Section 10: User device data storage
-// Section 11: Memory test
+// Section 11: Patch change echo storage
+// Section 12: Memory test
 
 // Fo debuggng purposes
 //#define LOW_LEVEL_INITIALIZE_MEMORY
@@ -41,6 +42,7 @@ extEEPROM eep(kbits_512, 2, 128);
 #define CURRENT_EXT_EEPROM_MG300_DATA_VERSION 2 // Increase this value whenever there is an update of the MG300 EEPROM structure - data will be overwritten!!!!
 #define CURRENT_EXP_EEPROM_SEQ_PATTERNS_VERSION 1 // Increase this value whenever there is an update of the sequencer patterns structure - data will be overwritten!!!!
 #define CURRENT_EXP_EEPROM_USER_DEVICE_DATA_VERSION 1 // Increase this value whenever there is an update of the user device data structure - data will be overwritten!!!!
+#define CURRENT_EXT_EEPROM_PC_ECHO_DATA_VERSION 1 // Increase this value whenever there is an update of the patch change echo structure - data will be overwritten!!!!
 
 // ************************ Internal EEPROM data addresses ***********************
 // Total size: 2048 bytes (Teensy 3.2), 4096 bytes (Teensy 3.6)
@@ -75,7 +77,7 @@ extEEPROM eep(kbits_512, 2, 128);
 #define EEPROM_DEVICE_PATCH_MSB 0
 #define EEPROM_DEVICE_PATCH_LSB 1
 #define EEPROM_DEVICE_SETLIST 2
-#define EEPROM_DEVICE_SETTINGS 8 // The rest of the device settings - currently 10 - total of 13 bytes. There is space for 32.
+#define EEPROM_DEVICE_SETTINGS 8 // The rest of the device settings - currently 13 - total of 21 bytes. There is space for 32.
 
 // ************************ External EEPROM data addresses ***********************
 
@@ -87,6 +89,7 @@ extEEPROM eep(kbits_512, 2, 128);
 // Page 375 - 390 Helix messages
 // Page 391 - 399 Sequencer patterns
 // Page 400 - 499 User device settings
+// Page 500 - 509 Patch change echo messages
 
 // Vc-touch has two chips = 1000 pages
 // Page 0 - 269:  Commands (3225)
@@ -95,6 +98,7 @@ extEEPROM eep(kbits_512, 2, 128);
 // Page 725 - 740 Helix messages
 // Page 741 - 759 Sequencer patterns
 // Page 760 - 999 User device settings
+// Page 1000 - 1019 Patch change echo messages
 
 #define EEPROM_ADDRESS 0x50    // i2c address of 24LC512 eeprom chip
 #define EEPROM_DELAY_LENGTH 5  // time between EEPROM writes (usually 5 ms is OK)
@@ -111,6 +115,7 @@ unsigned long WriteDelay = 0;
 #define EXT_EEP_MG300_DATA_VERSION_ADDR 6
 #define EXP_EEP_SEQ_PATTERNS_ADDR 7
 #define EXP_EEP_USER_DEVICE_DATA_ADDR 8
+#define EXT_EEP_PC_ECHO_DATA_VERSION_ADDR 9
 
 #ifndef IS_VCTOUCH
 // ****** 24LC512 memory structure for VController and VC-mini ***********
@@ -139,6 +144,9 @@ unsigned long WriteDelay = 0;
 #define EXT_EEP_USER_DATA_ADDRESS 52480            // User data items are stored from address 52480 - 64000 (720 items of 16 bytes)
 #define EXT_MAX_NUMBER_OF_USER_DATA_ITEMS 720
 
+#define EXT_EEP_PC_ECHO_BASE_ADDRESS 64000 // Patch change echo messages are stored from address 64000 - 65279 (80 records of 16 bytes)
+#define EXT_MAX_NUMBER_OF_PC_ECHO_RECORDS 80
+
 #else // IS_VCTOUCH
 // ****** Dual 24LC512 memory structure for VC-touch - double memory chip ***********
 #define NUMBER_OF_MEMORY_PAGES 1000
@@ -166,6 +174,9 @@ unsigned long WriteDelay = 0;
 #define EXT_EEP_USER_DATA_ADDRESS 103680            // User data items are stored from address 103680 - 128000 (1520 items of 16 bytes)
 #define EXT_MAX_NUMBER_OF_USER_DATA_ITEMS 1520
 
+#define EXT_EEP_PC_ECHO_BASE_ADDRESS 128000 // Patch change echo messages are stored from address 128000 - 130559 (160 records of 16 bytes)
+#define EXT_MAX_NUMBER_OF_PC_ECHO_RECORDS 160
+
 #endif
 
 #define EXT_SETLIST_TYPE 254
@@ -187,6 +198,21 @@ uint8_t HLX_message_setlist;
 #define EEPROM_SEQ_PATTERN_SIZE 36
 uint8_t EEPROM_seq_pattern[EEPROM_SEQ_PATTERN_SIZE]; // Space to store the sequencer pattern
 
+// A patch change echo record is 16 bytes: device, patch number MSB, patch number LSB, number of message bytes and 12 bytes of messages.
+// A PC message takes two bytes (status, program) and a CC message takes three (status, controller, value).
+#define PC_ECHO_RECORD_SIZE 16
+#define PC_ECHO_HEADER_SIZE 4
+#define PC_ECHO_DATA_SIZE (PC_ECHO_RECORD_SIZE - PC_ECHO_HEADER_SIZE)
+#define PC_ECHO_EMPTY_RECORD 0xFF
+
+struct PC_echo_index_struct {
+  uint8_t Device;
+  uint16_t Patch_number;
+};
+
+PC_echo_index_struct PC_echo_index[EXT_MAX_NUMBER_OF_PC_ECHO_RECORDS];
+uint16_t PC_echo_next_record = 0; // Record that is overwritten when there is no empty record left
+
 uint32_t EEPROM_update_timer = 0;
 #define EEPROM_UPDATE_TIMER_LENGTH 2000 // Time between reading the display boards
 
@@ -199,9 +225,42 @@ patch_data_index_struct patch_data_index[EXT_MAX_NUMBER_OF_PATCH_PRESETS];
 
 #define PATCH_INDEX_NOT_FOUND 0xFFFF
 
+// Patch cache: the song prefetcher reads the song and device patches that are likely to be selected next into these slots.
+// EEPROM_load_device_patch() and the name readers take the data from here, so selecting the next song or part does not wait for the external EEPROM.
+#define EEPROM_PATCH_CACHE_SIZE 8
+DMAMEM uint8_t patch_cache_data[EEPROM_PATCH_CACHE_SIZE][VC_PATCH_SIZE];
+uint16_t patch_cache_index[EEPROM_PATCH_CACHE_SIZE]; // Index of the patch in the slot. Set to PATCH_INDEX_NOT_FOUND in setup_eeprom()
+uint8_t patch_cache_next_slot = 0;
+
+// Page plans: the commands of every switch on a page are read from EEPROM once and stored in RAM in the order of the switches.
+// Loading the page again and pressing its switches takes the commands from the plan, so it does not have to wait for the external EEPROM.
+// The plans are cleared whenever a command is written or the command indexes are rebuilt.
+#if defined(__IMXRT1062__) // Teensy 4.0 and 4.1
+#define PAGE_PLAN_CACHE_SIZE 4
+#else
+#define PAGE_PLAN_CACHE_SIZE 2
+#endif
+#define PAGE_PLAN_MAX_CMDS 128
+#define PAGE_PLAN_EMPTY 255 // Page number of an unused plan
+#define PAGE_PLAN_NOT_PLANNED 255 // Command count of a switch that did not fit in the plan
+
+struct Page_plan_struct {
+  uint8_t Page;
+  uint8_t First[TOTAL_NUMBER_OF_SWITCHES + 1]; // Position of the first command of every switch in Cmd[]
+  uint8_t Count[TOTAL_NUMBER_OF_SWITCHES + 1]; // Number of commands of every switch
+  uint8_t Triggers[TOTAL_NUMBER_OF_SWITCHES + 1]; // Bit (switch_type >> 5) is set for every trigger type the switch has commands for
+  uint16_t Index[PAGE_PLAN_MAX_CMDS]; // The EEPROM index of every command
+  Cmd_struct Cmd[PAGE_PLAN_MAX_CMDS];
+};
+
+DMAMEM Page_plan_struct page_plan[PAGE_PLAN_CACHE_SIZE];
+uint8_t page_plan_next_slot = 0;
+
 void setup_eeprom()
 {
   DEBUGMAIN("Starting EEPROM");
+  EEPROM_clear_patch_cache();
+  EEPROM_clear_page_plans();
 #if defined(__IMXRT1062__) // Teensy 4.0 and 4.1
 #ifdef USE_SPI_MEMORY_CHIP
   eep_t4.begin(1);
@@ -226,6 +285,7 @@ void setup_eeprom()
   if (read_ext_EEPROM(EXP_EEP_HELIX_FORWARD_MESSAGING_ADDR) != CURRENT_EXP_EEPROM_HELIX_FORWARD_MESSAGING_VERSION) EEP_initialize_Helix_data();
   if (read_ext_EEPROM(EXT_EEP_MG300_DATA_VERSION_ADDR) != CURRENT_EXT_EEPROM_MG300_DATA_VERSION) EEP_initialize_MG300_data();
   if (read_ext_EEPROM(EXP_EEP_SEQ_PATTERNS_ADDR) != CURRENT_EXP_EEPROM_SEQ_PATTERNS_VERSION) EEP_initialize_seq_patterns_data();
+  if (read_ext_EEPROM(EXT_EEP_PC_ECHO_DATA_VERSION_ADDR) != CURRENT_EXT_EEPROM_PC_ECHO_DATA_VERSION) EEP_initialize_PC_echo_data();
 
   DEBUGMAIN("EEPROM initialization done");
 
@@ -238,6 +298,7 @@ void setup_eeprom()
   EEPROM_create_command_indexes();
   EEPROM_create_patch_data_index();
   EEPROM_create_user_data_index();
+  EEPROM_create_PC_echo_index();
 
   SCO_select_setlist(EEPROM.read(EEPROM_CURRENT_SETLIST_ADDR));
   if (Current_mode == SONG_MODE) {
@@ -260,6 +321,8 @@ void EEPROM_init_settings_from_menu() {
   EEP_initialize_MG300_data();
   delay(700);
   EEP_initialize_seq_patterns_data();
+  delay(700);
+  EEP_initialize_PC_echo_data();
 }
 
 void main_eeprom()
@@ -482,6 +545,7 @@ void write_cmd_EEPROM(uint16_t memloc, const Cmd_struct* cmd ) // Write a comman
     if (changed) {
       cmdbytes = (const byte*)cmd; // Reset the pointer
       EEP_write_ext_data(eeaddress, cmdbytes, cmdsize);
+      EEPROM_clear_page_plans();
     }
   }
 }
@@ -554,6 +618,7 @@ void EEP_write_number_of_commands(uint16_t number) {
 }
 
 void EEPROM_create_command_indexes() {
+  EEPROM_clear_page_plans();
   memset(First_cmd_index, 0, sizeof(First_cmd_index));
   memset(Next_cmd_index, 0, sizeof(Next_cmd_index));
   memset(Next_internal_cmd_index, 0, sizeof(Next_internal_cmd_index));
@@ -703,6 +768,12 @@ uint16_t EEPROM_next_cmd(uint16_t cmd) { // Find the next command - called when
 
 bool EEPROM_read_cmd(uint8_t pg, uint8_t sw, uint8_t number, Cmd_struct *cmd) { // Reads the command from EEPROM
   sw &= SWITCH_MASK;
+  Page_plan_struct *plan = EEPROM_find_page_plan(pg);
+  if ((plan != NULL) && (number < plan->Count[sw]) && (plan->Count[sw] != PAGE_PLAN_NOT_PLANNED)) {
+    copy_cmd(&plan->Cmd[plan->First[sw] + number], cmd);
+    return (number + 1 < plan->Count[sw]);
+  }
+
   uint16_t i = First_cmd_index[pg][sw];
   uint16_t prev_i = i;
   if (i == 0) i = First_cmd_index[PAGE_DEFAULT][sw]; // Read from default page if no command is found for this switch
@@ -785,6 +856,70 @@ void EEPROM_clear_switch(uint8_t pg, uint8_t sw) { // Will delete all commands f
   }
 }
 
+// Page plans
+
+void EEPROM_clear_page_plans() {
+  for (uint8_t s = 0; s < PAGE_PLAN_CACHE_SIZE; s++) page_plan[s].Page = PAGE_PLAN_EMPTY;
+}
+
+Page_plan_struct *EEPROM_find_page_plan(uint8_t pg) {
+  if (pg == PAGE_PLAN_EMPTY) return NULL;
+  for (uint8_t s = 0; s < PAGE_PLAN_CACHE_SIZE; s++) {
+    if (page_plan[s].Page == pg) return &page_plan[s];
+  }
+  return NULL;
+}
+
+Page_plan_struct *EEPROM_get_page_plan(uint8_t pg) { // Returns the plan for this page. Builds it if it does not exist yet.
+  Page_plan_struct *plan = EEPROM_find_page_plan(pg);
+  if ((plan != NULL) || (pg == PAGE_PLAN_EMPTY)) return plan;
+
+  plan = &page_plan[page_plan_next_slot]; // Replace the oldest plan
+  page_plan_next_slot = (page_plan_next_slot + 1) % PAGE_PLAN_CACHE_SIZE;
+  uint8_t number_of_cmds_in_plan = 0;
+  for (uint8_t sw = 0; sw < (TOTAL_NUMBER_OF_SWITCHES + 1); sw++) {
+    plan->First[sw] = number_of_cmds_in_plan;
+    plan->Count[sw] = 0;
+    plan->Triggers[sw] = 0;
+    uint16_t i = EEPROM_first_cmd(pg, sw);
+    while (i != 0) {
+      if (number_of_cmds_in_plan >= PAGE_PLAN_MAX_CMDS) { // Plan is full - the remaining commands of this switch are read from EEPROM
+        plan->Count[sw] = PAGE_PLAN_NOT_PLANNED;
+        break;
+      }
+      read_cmd_EEPROM(i, &plan->Cmd[number_of_cmds_in_plan]);
+      plan->Index[number_of_cmds_in_plan] = i;
+      plan->Triggers[sw] |= 1 << ((plan->Cmd[number_of_cmds_in_plan].Switch & SWITCH_TYPE_MASK) >> 5);
+      number_of_cmds_in_plan++;
+      plan->Count[sw]++;
+      i = EEPROM_next_cmd(i);
+    }
+  }
+  plan->Page = pg;
+  DEBUGMSG("Created plan for page " + String(pg) + " with " + String(number_of_cmds_in_plan) + " commands");
+  return plan;
+}
+
+void EEPROM_read_planned_cmd(uint8_t pg, uint8_t sw, uint8_t number, uint16_t memloc, Cmd_struct *cmd) { // Read command number of this switch from the plan or from EEPROM
+  sw &= SWITCH_MASK;
+  Page_plan_struct *plan = EEPROM_find_page_plan(pg);
+  if ((plan != NULL) && (plan->Count[sw] != PAGE_PLAN_NOT_PLANNED) && (number < plan->Count[sw])) {
+    uint8_t c = plan->First[sw] + number;
+    if (plan->Index[c] == memloc) { // Check we have the right command
+      copy_cmd(&plan->Cmd[c], cmd);
+      return;
+    }
+  }
+  read_cmd_EEPROM(memloc, cmd);
+}
+
+bool EEPROM_switch_has_trigger(uint8_t pg, uint8_t sw, uint8_t switch_type) { // Returns false if the plan shows the switch has no commands for this trigger type
+  sw &= SWITCH_MASK;
+  Page_plan_struct *plan = EEPROM_find_page_plan(pg);
+  if ((plan == NULL) || (plan->Count[sw] == PAGE_PLAN_NOT_PLANNED)) return true; // We do not know
+  return (plan->Triggers[sw] & (1 << ((switch_type & SWITCH_TYPE_MASK) >> 5)));
+}
+
 // ********************************* Section 5: Reading/writing titles to EEPROM ********************************************
 
 bool EEPROM_check4label(uint8_t pg, uint8_t sw) { // Checks if a label exists for this switch
@@ -926,7 +1061,9 @@ void EEPROM_read_KTN_title(uint8_t type, uint16_t number, String &title) {
   DEBUGMSG("Reading patch name for number " + String(number) + " at Addr1:" + String(part1_address));
 
   uint8_t data[16] = { 0 };
-  EEP_read_ext_data(part1_address, data, 16);
+  const uint8_t *cached = EEPROM_find_cached_patch(index);
+  if (cached != NULL) memcpy(data, &cached[7], 16);
+  else EEP_read_ext_data(part1_address, data, 16);
 
   for (uint8_t c = 0; c < 16; c++) {
     uint8_t newbyte = data[c];
@@ -972,7 +1109,9 @@ bool EEPROM_read_song_name(uint8_t type, uint16_t number, String &title) {
   uint32_t part1_address = base_address + ((index % 2) * 128) + 3; // Point to the first or second page
 
   uint8_t data[16] = { 0 };
-  EEP_read_ext_data(part1_address, data, 16);
+  const uint8_t *cached = EEPROM_find_cached_patch(index);
+  if (cached != NULL) memcpy(data, &cached[3], 16);
+  else EEP_read_ext_data(part1_address, data, 16);
 
   for (uint8_t c = 0; c < 16; c++) {
     uint8_t newbyte = data[c];
@@ -1019,6 +1158,11 @@ bool EEPROM_load_device_patch(uint8_t type, uint16_t number, uint8_t *patch_data
 }
 
 void EEPROM_load_device_patch_by_index(uint16_t index, uint8_t *patch_data, uint8_t data_length) {
+  uint8_t *cached = EEPROM_find_cached_patch(index);
+  if (cached != NULL) {
+    memcpy(patch_data, cached, data_length);
+    return;
+  }
 
   // Data is stored on pages of 128 bytes. We use 3 pages for 2 patches.
   // Page 1 contains the first 128 bytes of patch 1
@@ -1034,6 +1178,41 @@ void EEPROM_load_device_patch_by_index(uint16_t index, uint8_t *patch_data, uint
   EEP_read_ext_data(part2_address, &patch_data[128], data_length - 128);
 }
 
+// Patch cache
+
+void EEPROM_clear_patch_cache() {
+  for (uint8_t s = 0; s < EEPROM_PATCH_CACHE_SIZE; s++) patch_cache_index[s] = PATCH_INDEX_NOT_FOUND;
+}
+
+uint8_t *EEPROM_find_cached_patch(uint16_t index) {
+  if (index == PATCH_INDEX_NOT_FOUND) return NULL;
+  for (uint8_t s = 0; s < EEPROM_PATCH_CACHE_SIZE; s++) {
+    if (patch_cache_index[s] == index) return patch_cache_data[s];
+  }
+  return NULL;
+}
+
+const uint8_t *EEPROM_prefetch_device_patch(uint8_t type, uint16_t number) { // Read patch into the cache. Returns NULL if the patch is not stored
+  uint16_t index = EEPROM_find_patch_data_index(type, number);
+  if (index == PATCH_INDEX_NOT_FOUND) return NULL;
+  uint8_t *cached = EEPROM_find_cached_patch(index);
+  if (cached != NULL) return cached;
+
+  uint8_t s = patch_cache_next_slot; // Replace the oldest slot
+  patch_cache_next_slot = (s + 1) % EEPROM_PATCH_CACHE_SIZE;
+  patch_cache_index[s] = PATCH_INDEX_NOT_FOUND; // So the read below does not find the old data
+  EEPROM_load_device_patch_by_index(index, patch_cache_data[s], VC_PATCH_SIZE);
+  patch_cache_index[s] = index;
+  DEBUGMSG("Prefetched patch index " + String(index) + " in cache slot " + String(s));
+  return patch_cache_data[s];
+}
+
+void EEPROM_invalidate_cached_patch(uint16_t index) {
+  for (uint8_t s = 0; s < EEPROM_PATCH_CACHE_SIZE; s++) {
+    if (patch_cache_index[s] == index) patch_cache_index[s] = PATCH_INDEX_NOT_FOUND;
+  }
+}
+
 bool EEPROM_save_device_patch(uint8_t type, uint16_t number, uint8_t *patch_data, uint8_t data_length) {
   // Look for index
   uint16_t index = EEPROM_find_patch_data_index(type, number);
@@ -1066,6 +1245,7 @@ void EEPROM_save_device_patch_by_index(uint32_t index, uint8_t *patch_data, uint
   uint32_t part1_address = base_address + ((index % 2) * 128); // Point to the first or second page
   uint32_t part2_address = base_address + 256 + ((index % 2) * 64); // Point to the first or second half of the third page
 
+  EEPROM_invalidate_cached_patch(index);
   DEBUGMSG("Storing patch index " + String(index) + " at Addr1:" + String(part1_address) + ", Addr2:" + String(part2_address));
 
   EEP_write_ext_data(part1_address, patch_data, 128);
@@ -1503,7 +1683,89 @@ uint16_t EEPROM_find_new_user_data_index() {
 }
 
 
-// ********************************* Section 11: memory test ********************************************
+// ********************************* Section 11: Patch change echo storage ********************************************
+// Messages that a device sends after a patch change are stored per device and patch number. See the patch change echo learner in H_MIDI.ino.
+// An index of the records is kept in RAM, so finding a record does not read the external EEPROM.
+
+void EEPROM_create_PC_echo_index() {
+  PC_echo_next_record = 0;
+  for (uint16_t i = 0; i < EXT_MAX_NUMBER_OF_PC_ECHO_RECORDS; i++) {
+    uint32_t eeaddress = EXT_EEP_PC_ECHO_BASE_ADDRESS + (i * PC_ECHO_RECORD_SIZE);
+    uint8_t data[3] = { 0 };
+    EEP_read_ext_data(eeaddress, data, 3);
+    PC_echo_index[i].Device = data[0];
+    PC_echo_index[i].Patch_number = (data[1] << 8) + data[2];
+  }
+}
+
+uint16_t EEPROM_find_PC_echo_record(uint8_t dev, uint16_t patch) {
+  for (uint16_t i = 0; i < EXT_MAX_NUMBER_OF_PC_ECHO_RECORDS; i++) {
+    if ((PC_echo_index[i].Device == dev) && (PC_echo_index[i].Patch_number == patch)) return i;
+  }
+  return PATCH_INDEX_NOT_FOUND;
+}
+
+uint8_t EEPROM_load_PC_echo(uint8_t dev, uint16_t patch, uint8_t *data) { // Returns the number of message bytes
+  uint16_t record = EEPROM_find_PC_echo_record(dev, patch);
+  if (record == PATCH_INDEX_NOT_FOUND) return 0;
+  uint8_t buf[PC_ECHO_RECORD_SIZE];
+  EEP_read_ext_data(EXT_EEP_PC_ECHO_BASE_ADDRESS + (record * PC_ECHO_RECORD_SIZE), buf, PC_ECHO_RECORD_SIZE);
+  uint8_t length = buf[3];
+  if (length > PC_ECHO_DATA_SIZE) return 0;
+  memcpy(data, &buf[PC_ECHO_HEADER_SIZE], length);
+  return length;
+}
+
+void EEPROM_store_PC_echo(uint8_t dev, uint16_t patch, const uint8_t *data, uint8_t length) { // A length of zero deletes the record
+  if (length > PC_ECHO_DATA_SIZE) length = PC_ECHO_DATA_SIZE;
+  uint16_t record = EEPROM_find_PC_echo_record(dev, patch);
+  if (length == 0) {
+    if (record == PATCH_INDEX_NOT_FOUND) return;
+    uint8_t empty = PC_ECHO_EMPTY_RECORD;
+    EEP_write_ext_data(EXT_EEP_PC_ECHO_BASE_ADDRESS + (record * PC_ECHO_RECORD_SIZE), &empty, 1);
+    PC_echo_index[record].Device = PC_ECHO_EMPTY_RECORD;
+    DEBUGMSG("EEPROM: Deleted patch change echo of device " + String(dev) + ", patch " + String(patch));
+    return;
+  }
+
+  if (record == PATCH_INDEX_NOT_FOUND) {
+    for (uint16_t i = 0; i < EXT_MAX_NUMBER_OF_PC_ECHO_RECORDS; i++) {
+      if (PC_echo_index[i].Device == PC_ECHO_EMPTY_RECORD) {
+        record = i;
+        break;
+      }
+    }
+  }
+  if (record == PATCH_INDEX_NOT_FOUND) { // Memory is full - overwrite the records in turn
+    record = PC_echo_next_record;
+    PC_echo_next_record++;
+    if (PC_echo_next_record >= EXT_MAX_NUMBER_OF_PC_ECHO_RECORDS) PC_echo_next_record = 0;
+  }
+
+  uint8_t buf[PC_ECHO_RECORD_SIZE];
+  buf[0] = dev;
+  buf[1] = patch >> 8;
+  buf[2] = patch & 0xFF;
+  buf[3] = length;
+  memcpy(&buf[PC_ECHO_HEADER_SIZE], data, length);
+  EEP_write_ext_data(EXT_EEP_PC_ECHO_BASE_ADDRESS + (record * PC_ECHO_RECORD_SIZE), buf, PC_ECHO_HEADER_SIZE + length);
+  PC_echo_index[record].Device = dev;
+  PC_echo_index[record].Patch_number = patch;
+  DEBUGMSG("EEPROM: Wrote patch change echo of device " + String(dev) + ", patch " + String(patch) + " to record " + String(record) + ", size: " + String(length));
+}
+
+void EEP_initialize_PC_echo_data() {
+  LED_show_initializing_data();
+  DEBUGMAIN("Init PC echo data");
+  write_ext_EEPROM(EXT_EEP_PC_ECHO_DATA_VERSION_ADDR, CURRENT_EXT_EEPROM_PC_ECHO_DATA_VERSION); // Save the current eeprom version
+  uint8_t empty = PC_ECHO_EMPTY_RECORD;
+  for (uint16_t i = 0; i < EXT_MAX_NUMBER_OF_PC_ECHO_RECORDS; i++) {
+    EEP_write_ext_data(EXT_EEP_PC_ECHO_BASE_ADDRESS + (i * PC_ECHO_RECORD_SIZE), &empty, 1);
+    PC_echo_index[i].Device = PC_ECHO_EMPTY_RECORD;
+  }
+}
+
+// ********************************* Section 12: memory test ********************************************
 void EEPROM_memory_test() {
   // Test memory chip #1
   const uint32_t addr1 = 65535;
@@ -76,6 +76,15 @@
 #define VC_REQUEST_ALL_USER_DEVICE_SETTINGS 25
 #define VC_INITIALIZE_USER_DEVICE_DATA 26
 #define VC_SELECT_PATCH_FROM_EDITOR 27
+#define VC_REMOTE_UPDATE_FRAME 28
+
+// Records in the VC_REMOTE_UPDATE_FRAME message
+#define REMOTE_FRAME_DISPLAY_RECORD 1 // Followed by: display number, line, first character, number of characters, characters
+#define REMOTE_FRAME_LED_RECORD 2 // Followed by: LED number, colour
+
+#define VC_REQUEST_PROFILE_TELEMETRY 29 // Followed by: on/off
+#define VC_PROFILE_TELEMETRY 30
+#define PROFILE_TELEMETRY_INTERVAL 500 // Time in ms between telemetry messages
 
 // Communication between VC devices
 #define VC_SET_PATCH_NUMBER 101
@@ -110,6 +119,16 @@ bool VC_device_connected = false;
 uint8_t VC_device_port;
 
 bool remote_control_active = false;
+uint8_t remote_frame_interval = 0; // Time in ms between remote display frames. When zero, full displays and LEDs are sent directly (older versions of VC-edit)
+#define REMOTE_FRAME_MAX_SIZE 240 // Maximum size of the frame message. Changes that do not fit are sent with the next frame
+#define REMOTE_MAX_DISPLAY_SIZE (MAIN_LCD_DISPLAY_SIZE > LCD_DISPLAY_SIZE ? MAIN_LCD_DISPLAY_SIZE : LCD_DISPLAY_SIZE)
+
+char remote_display[NUMBER_OF_DISPLAYS + 1][2][REMOTE_MAX_DISPLAY_SIZE]; // What should be shown on the remote displays
+char remote_display_sent[NUMBER_OF_DISPLAYS + 1][2][REMOTE_MAX_DISPLAY_SIZE]; // What was sent to the remote displays
+uint8_t remote_LEDs_sent[NUMBER_OF_LEDS];
+uint32_t remote_frame_timer = 0;
+uint32_t profile_telemetry_timer = 0;
+
 uint8_t VCedit_port;
 uint16_t editor_dump_size = 0;
 bool MIDI_learn_mode = false;
@@ -363,6 +382,9 @@ void main_MIDI_common()
 
   MIDI_check_for_devices();  // Check actively if any devices are out there
   PAGE_check_sysex_watchdog(); // check if the watchdog has not expired
+  PC_echo_check_timers(); // Store the messages that were learned after a patch change
+  MIDI_remote_update_frame(); // Send changes of the displays and LEDs to VC-edit
+  MIDI_send_profile_telemetry(); // Send the loop profiler statistics to VC-edit
 }
 
 void MIDI_check_USBHMIDI()
@@ -421,6 +443,7 @@ void OnProgramChange(byte channel, byte program)
     if (Current_MIDI_in_port == USBMIDI_PORT) Device[d]->forward_PC_message(program, channel);
   }
   MIDI_check_switch_pc(program, channel, Current_MIDI_in_port);
+  PC_echo_check_PC_in(program, channel, Current_MIDI_in_port | VCbridge_in_port[VCbridge_index]);
   MIDI_check_PC_forwarding(program, channel, Current_MIDI_in_port);
   MIDI_update_PC_ledger(program, channel, Current_MIDI_in_port, false);
 }
@@ -445,10 +468,20 @@ void OnControlChange(byte channel, byte control, byte value)
     MIDI_check_switch_cc(control, value, channel, Current_MIDI_in_port);
   }
 
+  PC_echo_check_CC_in(control, value, channel, Current_MIDI_in_port | VCbridge_in_port[VCbridge_index]);
   MIDI_check_CC_forwarding(control, value, channel, Current_MIDI_in_port);
   MIDI_update_CC_ledger(control, value, channel, Current_MIDI_in_port, false);
 }
 
+bool MIDI_check_SYSEX_in_realtime(const unsigned char* sxdata, short unsigned int sxlength, uint8_t port) {
+  // Devices that stream sysex (like the tuner and tempo messages of the AxeFX) handle these messages here,
+  // so they do not have to pass all the devices and the editor checks
+  for (uint8_t d = 0; d < NUMBER_OF_DEVICES; d++) {
+    if (Device[d]->check_SYSEX_in_realtime(sxdata, sxlength, port)) return true;
+  }
+  return false;
+}
+
 void OnSysEx(const unsigned char* sxdata, short unsigned int sxlength, bool sx_comp)
 {
   uint8_t VCbridge_index = Current_MIDI_in_port >> 4;
@@ -459,7 +492,7 @@ void OnSysEx(const unsigned char* sxdata, short unsigned int sxlength, bool sx_c
   if (sxdata[1] == 0x7E) { //Check if it is a Universal Non-Real Time message
     MIDI_check_SYSEX_in_universal(sxdata, sxlength, Current_MIDI_in_port | VCbridge_in_port[VCbridge_index]);
   }
-  else {
+  else if (!MIDI_check_SYSEX_in_realtime(sxdata, sxlength, Current_MIDI_in_port | VCbridge_in_port[VCbridge_index])) {
     for (uint8_t d = 0; d < NUMBER_OF_DEVICES; d++) {
       Device[d]->check_SYSEX_in(sxdata, sxlength, Current_MIDI_in_port | VCbridge_in_port[VCbridge_index]);
     }
@@ -485,7 +518,7 @@ void OnSerialSysEx(byte *sxdata, unsigned sxlength)
   if (sxdata[1] == 0x7E) { //Check if it is a Universal Non-Real Time message
     MIDI_check_SYSEX_in_universal(sxdata, sxlength, Current_MIDI_in_port | VCbridge_in_port[VCbridge_index]);
   }
-  else {
+  else if (!MIDI_check_SYSEX_in_realtime(sxdata, sxlength, Current_MIDI_in_port | VCbridge_in_port[VCbridge_index])) {
     for (uint8_t d = 0; d < NUMBER_OF_DEVICES; d++) {
       Device[d]->check_SYSEX_in(sxdata, sxlength, Current_MIDI_in_port | VCbridge_in_port[VCbridge_index]);
     }
@@ -653,6 +686,12 @@ void MIDI_send_CC(uint8_t Controller, uint8_t Value, uint8_t Channel, uint8_t Po
   }
 }
 
+void MIDI_send_NRPN(uint16_t Number, uint8_t Value, uint8_t Channel, uint8_t Port) {
+  MIDI_send_CC(99, Number >> 7, Channel, Port); // NRPN MSB
+  MIDI_send_CC(98, Number & 0x7F, Channel, Port); // NRPN LSB
+  MIDI_send_CC(6, Value, Channel, Port); // Data entry MSB
+}
+
 void MIDI_forward_CC_to_all_ports_but_mine(uint8_t Controller, uint8_t Value, uint8_t Channel, uint8_t Exclude_port) {
   for (uint8_t p = 0; p < NUMBER_OF_MIDI_PORTS; p++) {
     if (MIDI_set_port_number_from_menu(p) != Exclude_port) {
@@ -878,8 +917,19 @@ void MIDI_send_sysex(const unsigned char* sxdata, short unsigned int sxlength, u
   MIDI_debug_sysex(sxdata, sxlength, Port, true);
 }
 
+void MIDI_send_now() { // Send buffered USB MIDI messages right away instead of waiting for the USB packet to fill up or time out
+  usbMIDI.send_now();
+#ifdef MIDI_T36_HOST_PORT_ENABLED
+  for (uint8_t p = 0; p < NUMBER_OF_USB_HOST_MIDI_PORTS; p++) {
+    usbhMIDI[p]->send_now();
+  }
+#endif
+}
+
 void MIDI_check_port_message(uint8_t Port) { // Check if we need to tell the VCbridge on the RPi what port to use
 
+  if (Port != VCedit_port) PROFILE_check_switch_latency(); // Every message that is not MIDI clock passes here. Messages to VC-edit are not caused by the switch.
+
   uint8_t VCbridge_index = Port >> 4; // First nibble is MIDI port number
   uint8_t new_port_number = Port & 0x0F;
 
@@ -1445,6 +1495,8 @@ void MIDI_check_SYSEX_in_editor(const unsigned char* sxdata, short unsigned int
     switch (sxdata[5]) {
       case VC_REMOTE_CONTROL_ENABLE:
         remote_control_active = sxdata[6];
+        if (sxlength > 8) MIDI_remote_set_refresh_rate(sxdata[7]); // Newer versions of VC-edit send the refresh rate they want
+        else MIDI_remote_set_refresh_rate(0);
         if (remote_control_active) {
           LCD_clear_memory();
           update_main_lcd = true;
@@ -1452,6 +1504,10 @@ void MIDI_check_SYSEX_in_editor(const unsigned char* sxdata, short unsigned int
           LED_start_remote_control();
         }
         break;
+      case VC_REQUEST_PROFILE_TELEMETRY:
+        profile_requested = sxdata[6];
+        profile_telemetry_timer = millis() + PROFILE_TELEMETRY_INTERVAL;
+        break;
       case VC_REMOTE_CONTROL_SWITCH_PRESSED:
         SC_remote_switch_pressed(sxdata[6], true);
         break;
@@ -1621,6 +1677,12 @@ void MIDI_remote_update_display(uint8_t number, const char *line1, const char *l
   uint8_t dsize;
   if (number == 0) dsize = MAIN_LCD_DISPLAY_SIZE;
   else dsize = LCD_DISPLAY_SIZE;
+  if (remote_frame_interval > 0) { // Store the data - it will be sent with the next frame
+    if (number > NUMBER_OF_DISPLAYS) return;
+    memcpy(remote_display[number][0], line1, dsize);
+    memcpy(remote_display[number][1], line2, dsize);
+    return;
+  }
   uint8_t sysexmessage[8 + (dsize * 2)] = { 0xF0, VC_MANUFACTURING_ID, VC_FAMILY_CODE, VC_MODEL_NUMBER, VC_DEVICE_ID, VC_REMOTE_UPDATE_DISPLAY, number};
   uint8_t index = 7;
   for (uint8_t i = 0; i < dsize; i++) sysexmessage[index++] = line1[i];
@@ -1632,6 +1694,7 @@ void MIDI_remote_update_display(uint8_t number, const char *line1, const char *l
 
 void MIDI_update_LEDs(uint8_t *MIDI_LEDs, uint8_t number_of_leds) {
   if (!remote_control_active) return;
+  if (remote_frame_interval > 0) return; // Changed LEDs will be sent with the next frame
   uint8_t messagesize = number_of_leds + 8;
   uint8_t sysexmessage[messagesize] = { 0xF0, VC_MANUFACTURING_ID, VC_FAMILY_CODE, VC_MODEL_NUMBER, VC_DEVICE_ID, VC_REMOTE_UPDATE_LEDS, number_of_leds};
   for (uint8_t i = 0; i < number_of_leds; i++) sysexmessage[i + 7] = MIDI_LEDs[i];
@@ -1639,6 +1702,122 @@ void MIDI_update_LEDs(uint8_t *MIDI_LEDs, uint8_t number_of_leds) {
   MIDI_editor_send_sysex(sysexmessage, messagesize, VCedit_port);
 }
 
+// Remote display frames
+// VC-edit sends the refresh rate it wants when it enables remote control. The displays and LEDs are then stored in remote_display[] and MIDI_LEDs[]
+// and every frame only the characters and LEDs that differ from what was sent before are sent in one VC_REMOTE_UPDATE_FRAME message.
+// Per line one run of characters is sent: from the first to the last character that changed.
+// A frame is skipped while the editor port is still busy with the previous message, so remote control never delays other MIDI traffic.
+
+void MIDI_remote_set_refresh_rate(uint8_t frames_per_second) {
+  if (frames_per_second == 0) remote_frame_interval = 0;
+  else if (frames_per_second > 100) remote_frame_interval = 10;
+  else remote_frame_interval = 1000 / frames_per_second;
+  MIDI_remote_resend_all();
+}
+
+void MIDI_remote_resend_all() { // Make sure everything is sent with the next frame
+  memset(remote_display, ' ', sizeof(remote_display));
+  memset(remote_display_sent, 0, sizeof(remote_display_sent));
+  memset(remote_LEDs_sent, 0xFF, sizeof(remote_LEDs_sent));
+}
+
+void MIDI_remote_update_frame() { // Called from main_MIDI_common()
+  if ((!remote_control_active) || (remote_frame_interval == 0)) return;
+  if (millis() < remote_frame_timer) return;
+  if (millis() < MIDI_editor_delay_time) return; // Port is still busy - try again later
+  remote_frame_timer = millis() + remote_frame_interval;
+
+  uint8_t sysexmessage[REMOTE_FRAME_MAX_SIZE] = { 0xF0, VC_MANUFACTURING_ID, VC_FAMILY_CODE, VC_MODEL_NUMBER, VC_DEVICE_ID, VC_REMOTE_UPDATE_FRAME };
+  uint8_t index = 6;
+
+  // Add the LEDs first - they are small and show state changes
+  for (uint8_t l = 0; l < NUMBER_OF_LEDS; l++) {
+    if (MIDI_LEDs[l] != remote_LEDs_sent[l]) {
+      if (index + 4 > REMOTE_FRAME_MAX_SIZE) break;
+      sysexmessage[index++] = REMOTE_FRAME_LED_RECORD;
+      sysexmessage[index++] = l;
+      sysexmessage[index++] = MIDI_LEDs[l] & 0x7F;
+      remote_LEDs_sent[l] = MIDI_LEDs[l];
+    }
+  }
+
+  // Add the changed characters of the displays
+  for (uint8_t d = 0; d <= NUMBER_OF_DISPLAYS; d++) {
+    uint8_t dsize = (d == 0) ? MAIN_LCD_DISPLAY_SIZE : LCD_DISPLAY_SIZE;
+    for (uint8_t line = 0; line < 2; line++) {
+      char *target = remote_display[d][line];
+      char *sent = remote_display_sent[d][line];
+      uint8_t first = 0;
+      while ((first < dsize) && (target[first] == sent[first])) first++;
+      if (first == dsize) continue; // Line has not changed
+      uint8_t last = dsize - 1;
+      while (target[last] == sent[last]) last--;
+      uint8_t len = last - first + 1;
+      if (index + len + 6 > REMOTE_FRAME_MAX_SIZE) continue; // Does not fit - will be sent with the next frame
+      sysexmessage[index++] = REMOTE_FRAME_DISPLAY_RECORD;
+      sysexmessage[index++] = d;
+      sysexmessage[index++] = line;
+      sysexmessage[index++] = first;
+      sysexmessage[index++] = len;
+      for (uint8_t c = first; c <= last; c++) sysexmessage[index++] = target[c] & 0x7F;
+      memcpy(&sent[first], &target[first], len);
+    }
+  }
+
+  if (index == 6) return; // Nothing has changed
+  sysexmessage[index++] = 0xF7;
+  MIDI_editor_send_sysex(sysexmessage, index, VCedit_port);
+}
+
+// Loop profiler telemetry
+// The statistics of the loop profiler (in debug.h) are sent to VC-edit every PROFILE_TELEMETRY_INTERVAL ms while VC-edit asks for them.
+// The message contains: the measured time in ms, the number of loops, the maximum depth of the switch event queue, the number of switch events lost since startup,
+// the maximum number of commands in one batch and the number of subsystems, followed by min, avg, max and p99 in us for every subsystem.
+// The switch latency follows: the number of measured switch events, the number of bins and the count of every bin.
+// Values are sent as three 7-bit bytes, except for the queue depth, batch size and the numbers of subsystems and bins.
+
+#define PROFILE_TELEMETRY_SIZE (6 + 12 + (NUMBER_OF_PROFILE_SUBSYSTEMS * 12) + 4 + (PROFILE_LATENCY_BINS * 3) + 1)
+
+void MIDI_send_profile_telemetry() { // Called from main_MIDI_common()
+  if (!profile_active) return;
+  if (millis() < profile_telemetry_timer) return;
+  if (millis() < MIDI_editor_delay_time) return; // Port is still busy - try again later
+  profile_telemetry_timer = millis() + PROFILE_TELEMETRY_INTERVAL;
+
+  uint8_t sysexmessage[PROFILE_TELEMETRY_SIZE] = { 0xF0, VC_MANUFACTURING_ID, VC_FAMILY_CODE, VC_MODEL_NUMBER, VC_DEVICE_ID, VC_PROFILE_TELEMETRY };
+  uint8_t index = 6;
+  MIDI_add_21_bit_value(sysexmessage, index, millis() - profile_start_time);
+  MIDI_add_21_bit_value(sysexmessage, index, profile_loop_count);
+  sysexmessage[index++] = profile_max_event_queue_depth & 0x7F;
+  MIDI_add_21_bit_value(sysexmessage, index, profile_events_lost);
+  sysexmessage[index++] = (profile_max_cmd_batch < 0x7F) ? profile_max_cmd_batch : 0x7F;
+  sysexmessage[index++] = NUMBER_OF_PROFILE_SUBSYSTEMS;
+  for (uint8_t s = 0; s < NUMBER_OF_PROFILE_SUBSYSTEMS; s++) {
+    Profile_struct &p = Profile[s];
+    if (p.count == 0) {
+      for (uint8_t i = 0; i < 4; i++) MIDI_add_21_bit_value(sysexmessage, index, 0);
+      continue;
+    }
+    MIDI_add_21_bit_value(sysexmessage, index, p.min_time);
+    MIDI_add_21_bit_value(sysexmessage, index, p.total_time / p.count);
+    MIDI_add_21_bit_value(sysexmessage, index, p.max_time);
+    MIDI_add_21_bit_value(sysexmessage, index, PROFILE_percentile_99(s));
+  }
+  MIDI_add_21_bit_value(sysexmessage, index, profile_latency_count);
+  sysexmessage[index++] = PROFILE_LATENCY_BINS;
+  for (uint8_t b = 0; b < PROFILE_LATENCY_BINS; b++) MIDI_add_21_bit_value(sysexmessage, index, profile_latency_histogram[b]);
+  sysexmessage[index++] = 0xF7;
+  PROFILE_clear();
+  MIDI_editor_send_sysex(sysexmessage, index, VCedit_port);
+}
+
+void MIDI_add_21_bit_value(uint8_t *message, uint8_t &index, uint32_t value) {
+  if (value > 0x1FFFFF) value = 0x1FFFFF;
+  message[index++] = (value >> 14) & 0x7F;
+  message[index++] = (value >> 7) & 0x7F;
+  message[index++] = value & 0x7F;
+}
+
 void MIDI_send_data(uint8_t cmd, uint8_t *my_data, uint16_t my_len, uint8_t port) {
   // We will send the data per 7 bits, because any sysex data has to be smaller than 128
   uint16_t messagesize = (my_len * 2) + 7;
@@ -2087,12 +2266,12 @@ void MIDI_check_PC_forwarding(uint8_t program, uint8_t channel, uint8_t port) {
           //case MIDI_FORWARD_SYSEX_ONLY:
           forward = true;
       }
-      if ((forward) && (dest_port != ALL_MIDI_PORTS)) {
+      if ((forward) && (dest_port != ALL_MIDI_PORTS) && (!PC_echo_already_sent(dest_port))) {
         MIDI_send_PC(program, channel, dest_port);
       }
       if ((forward) && (dest_port == ALL_MIDI_PORTS)) {
         for (uint8_t p = 0; p < NUMBER_OF_MIDI_PORTS; p++) {
-          if ((p + 1) != Setting.MIDI_forward_source_port[i]) MIDI_send_PC(program, channel, MIDI_set_port_number_from_menu(p));
+          if (((p + 1) != Setting.MIDI_forward_source_port[i]) && (!PC_echo_already_sent(MIDI_set_port_number_from_menu(p)))) MIDI_send_PC(program, channel, MIDI_set_port_number_from_menu(p));
         }
       }
     }
@@ -2115,12 +2294,12 @@ void MIDI_check_CC_forwarding(uint8_t control, uint8_t value, uint8_t channel, u
         case MIDI_FORWARD_PC_ONLY:
           if ((control == 0) || (control == 32)) forward = true; // Also forward bank messages for PC only
       }
-      if ((forward) && (dest_port != ALL_MIDI_PORTS)) {
+      if ((forward) && (dest_port != ALL_MIDI_PORTS) && (!PC_echo_already_sent(dest_port))) {
         MIDI_send_CC(control, value, channel, dest_port);
       }
       if ((forward) && (dest_port == ALL_MIDI_PORTS)) {
         for (uint8_t p = 0; p < NUMBER_OF_MIDI_PORTS; p++) {
-          if ((p + 1) != Setting.MIDI_forward_source_port[i]) MIDI_send_CC(control, value, channel, MIDI_set_port_number_from_menu(p));
+          if (((p + 1) != Setting.MIDI_forward_source_port[i]) && (!PC_echo_already_sent(MIDI_set_port_number_from_menu(p)))) MIDI_send_CC(control, value, channel, MIDI_set_port_number_from_menu(p));
         }
       }
     }
@@ -2226,6 +2405,185 @@ uint8_t MIDI_forward_dest_port(uint8_t instance, uint8_t port) {
   return DO_NOT_FORWARD;
 }
 
+// Patch change echo learner
+// Some devices send MIDI messages after a patch change, like the instant commands of the Line6 Helix. These messages are only sent after the device has loaded the patch,
+// so a second device that is controlled by them changes after the first one, which gives a double gap in the sound.
+// When "PC echo port" is set for a device, the messages that the device sends within PC_ECHO_TIME after a patch change are learned and stored in EEPROM.
+// On the next patch change of the device, the stored messages are sent to the echo port straight away. When the device sends them again, they are not forwarded
+// to the echo port a second time. New messages are forwarded to the echo port when they come in. Differences are stored when the learning time has passed,
+// so the stored messages follow changes on the device.
+// Only PC and CC messages are learned. A CC or PC that is sent more than once is stored once with its last value.
+// The Helix has its own version of this system (see MD_HLX.ino).
+
+#define PC_ECHO_TIME 200 // Time in msec after a patch change in which messages from the device are learned
+#define PC_ECHO_NUMBER_OF_SLOTS 4 // Number of devices that can learn at the same time
+#define PC_ECHO_FREE_SLOT 255
+#define PC_ECHO_NO_PORT 0xFF
+#define PC_ECHO_NOT_FOUND 255
+
+struct PC_echo_slot_struct {
+  uint8_t Device;
+  uint16_t Patch_number;
+  uint32_t Timer;
+  uint8_t Sent_length;
+  uint8_t Sent[PC_ECHO_DATA_SIZE]; // The messages that were sent to the echo port since the patch change
+  uint8_t Learned_length;
+  uint8_t Learned[PC_ECHO_DATA_SIZE]; // The messages that have been received since the patch change
+};
+
+PC_echo_slot_struct PC_echo_slot[PC_ECHO_NUMBER_OF_SLOTS] = {
+  { PC_ECHO_FREE_SLOT }, { PC_ECHO_FREE_SLOT }, { PC_ECHO_FREE_SLOT }, { PC_ECHO_FREE_SLOT }
+};
+uint8_t PC_echo_skip_port = PC_ECHO_NO_PORT; // Set when the last received message has already been sent to this port from memory
+uint16_t PC_echo_last_patch[NUMBER_OF_DEVICES]; // The last patch change of every device
+bool PC_echo_last_patch_valid[NUMBER_OF_DEVICES] = { false };
+
+uint8_t PC_echo_target_port(uint8_t dev) {
+  uint8_t port = Device[dev]->PC_echo_port;
+  if (port == 0) return PC_ECHO_NO_PORT;
+  return MIDI_set_port_number_from_menu(port - 1);
+}
+
+void PC_echo_patch_change(uint8_t dev, uint16_t patch) { // Called from MD_base_class::set_patch_number()
+  if (dev >= NUMBER_OF_DEVICES) return;
+  uint8_t port = PC_echo_target_port(dev);
+  if (port == PC_ECHO_NO_PORT) return;
+
+  // The same patch change reported again must not restart learning or send the messages again
+  // The last patch is kept per device, so patch changes of other devices in between do not matter
+  if ((PC_echo_last_patch_valid[dev]) && (patch == PC_echo_last_patch[dev])) return;
+  for (uint8_t i = 0; i < PC_ECHO_NUMBER_OF_SLOTS; i++) {
+    if ((PC_echo_slot[i].Device == dev) && (PC_echo_slot[i].Patch_number == patch)) return; // Still learning this patch
+  }
+  PC_echo_last_patch[dev] = patch;
+  PC_echo_last_patch_valid[dev] = true;
+
+  // Find a slot for the device
+  uint8_t s = 0;
+  while ((s < PC_ECHO_NUMBER_OF_SLOTS) && (PC_echo_slot[s].Device != dev)) s++;
+  if (s == PC_ECHO_NUMBER_OF_SLOTS) {
+    s = 0;
+    while ((s < PC_ECHO_NUMBER_OF_SLOTS) && (PC_echo_slot[s].Device != PC_ECHO_FREE_SLOT)) s++;
+  }
+  if (s == PC_ECHO_NUMBER_OF_SLOTS) { // All slots are learning - take the one that finishes first
+    s = 0;
+    for (uint8_t i = 1; i < PC_ECHO_NUMBER_OF_SLOTS; i++) {
+      if ((int32_t)(PC_echo_slot[i].Timer - PC_echo_slot[s].Timer) < 0) s = i;
+    }
+  }
+  // A slot that is still learning is cut short. Its messages are not stored, as some may not have been received yet.
+
+  PC_echo_slot_struct *slot = &PC_echo_slot[s];
+  slot->Device = dev;
+  slot->Patch_number = patch;
+  slot->Sent_length = EEPROM_load_PC_echo(dev, patch, slot->Sent);
+  slot->Learned_length = 0;
+  slot->Timer = millis() + PC_ECHO_TIME;
+  PC_echo_send(dev, slot->Sent, slot->Sent_length, port);
+  DEBUGMSG("PC echo: sent " + String(slot->Sent_length) + " bytes from memory for device " + String(dev) + ", patch " + String(patch));
+}
+
+void PC_echo_send(uint8_t dev, const uint8_t *data, uint8_t length, uint8_t port) {
+  uint8_t i = 0;
+  while (i < length) {
+    uint8_t status = data[i];
+    uint8_t channel = (status & 0x0F) + 1;
+    if ((status & 0xF0) == 0xC0) {
+      if (port == ALL_MIDI_PORTS) MIDI_forward_PC_to_all_ports_but_mine(data[i + 1], channel, Device[dev]->MIDI_out_port);
+      else MIDI_send_PC(data[i + 1], channel, port);
+      i += 2;
+    }
+    else {
+      if (port == ALL_MIDI_PORTS) MIDI_forward_CC_to_all_ports_but_mine(data[i + 1], data[i + 2], channel, Device[dev]->MIDI_out_port);
+      else MIDI_send_CC(data[i + 1], data[i + 2], channel, port);
+      i += 3;
+    }
+  }
+}
+
+void PC_echo_check_PC_in(uint8_t program, uint8_t channel, uint8_t port) {
+  PC_echo_check_message_in(0xC0 | ((channel - 1) & 0x0F), program, 0, port);
+}
+
+void PC_echo_check_CC_in(uint8_t control, uint8_t value, uint8_t channel, uint8_t port) {
+  PC_echo_check_message_in(0xB0 | ((channel - 1) & 0x0F), control, value, port);
+}
+
+void PC_echo_check_message_in(uint8_t status, uint8_t data1, uint8_t data2, uint8_t port) {
+  PC_echo_skip_port = PC_ECHO_NO_PORT;
+  uint8_t size = ((status & 0xF0) == 0xC0) ? 2 : 3;
+  for (uint8_t s = 0; s < PC_ECHO_NUMBER_OF_SLOTS; s++) {
+    PC_echo_slot_struct *slot = &PC_echo_slot[s];
+    if (slot->Device == PC_ECHO_FREE_SLOT) continue;
+    MD_base_class *dev = Device[slot->Device];
+    if (port != dev->MIDI_in_port) continue;
+    if ((int32_t)(millis() - slot->Timer) >= 0) continue; // Learning time has passed
+    if ((size == 2) && ((status & 0x0F) == ((dev->MIDI_channel - 1) & 0x0F))) continue; // Patch change of the device itself
+
+    // Store the message. A message for the same PC channel or CC number replaces the earlier one.
+    uint8_t pos = PC_echo_find_message(slot->Learned, slot->Learned_length, status, data1);
+    if (pos == PC_ECHO_NOT_FOUND) {
+      if (slot->Learned_length + size > PC_ECHO_DATA_SIZE) continue; // No space left
+      pos = slot->Learned_length;
+      slot->Learned_length += size;
+    }
+    slot->Learned[pos] = status;
+    slot->Learned[pos + 1] = data1;
+    if (size == 3) slot->Learned[pos + 2] = data2;
+
+    // Forward the message to the echo port, unless it has already been sent from memory
+    uint8_t echo_port = PC_echo_target_port(slot->Device);
+    uint8_t sent_pos = PC_echo_find_message(slot->Sent, slot->Sent_length, status, data1);
+    bool already_sent = (sent_pos != PC_ECHO_NOT_FOUND) && ((size == 2) || (slot->Sent[sent_pos + 2] == data2));
+    if (!already_sent) {
+      PC_echo_send(slot->Device, &slot->Learned[pos], size, echo_port);
+      if (sent_pos == PC_ECHO_NOT_FOUND) { // Remember the message, so it is not sent again when the device repeats it
+        if (slot->Sent_length + size <= PC_ECHO_DATA_SIZE) {
+          sent_pos = slot->Sent_length;
+          slot->Sent_length += size;
+        }
+      }
+      if (sent_pos != PC_ECHO_NOT_FOUND) memcpy(&slot->Sent[sent_pos], &slot->Learned[pos], size);
+    }
+    PC_echo_skip_port = echo_port; // The MIDI forwarding rules do not send it again
+  }
+}
+
+uint8_t PC_echo_find_message(const uint8_t *data, uint8_t length, uint8_t status, uint8_t data1) { // Returns the position of a message with the same PC channel or CC number
+  uint8_t i = 0;
+  while (i < length) {
+    if ((data[i] & 0xF0) == 0xC0) {
+      if (data[i] == status) return i;
+      i += 2;
+    }
+    else {
+      if ((data[i] == status) && (data[i + 1] == data1)) return i;
+      i += 3;
+    }
+  }
+  return PC_ECHO_NOT_FOUND;
+}
+
+bool PC_echo_already_sent(uint8_t port) { // Called from the forwarding functions for the message that was checked last
+  if (PC_echo_skip_port == PC_ECHO_NO_PORT) return false;
+  return ((PC_echo_skip_port == ALL_MIDI_PORTS) || (PC_echo_skip_port == port));
+}
+
+void PC_echo_check_timers() {
+  for (uint8_t s = 0; s < PC_ECHO_NUMBER_OF_SLOTS; s++) {
+    PC_echo_slot_struct *slot = &PC_echo_slot[s];
+    if (slot->Device == PC_ECHO_FREE_SLOT) continue;
+    if ((int32_t)(millis() - slot->Timer) < 0) continue;
+    // Learning time has passed - only write to EEPROM when the messages have changed
+    uint8_t stored[PC_ECHO_DATA_SIZE];
+    uint8_t stored_length = EEPROM_load_PC_echo(slot->Device, slot->Patch_number, stored);
+    if ((slot->Learned_length != stored_length) || (memcmp(slot->Learned, stored, stored_length) != 0)) {
+      EEPROM_store_PC_echo(slot->Device, slot->Patch_number, slot->Learned, slot->Learned_length);
+    }
+    slot->Device = PC_ECHO_FREE_SLOT;
+  }
+}
+
 // ********************************* Section 9: MIDI communication with wireless module ********************************************
 uint8_t selected_ssid = 0;
 uint8_t number_of_scanned_ssids = 0;
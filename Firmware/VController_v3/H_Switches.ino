@@ -15,6 +15,7 @@
 // Check for switch pressed and output the result in the switch_pressed, switch_released, switch_long_pressed and switch_long_pressed variable.
 // Internal switches can be connected in a keypad or to dedicated display boards controlled by an MCP23017.
 // Keypad switches are triggered by interrupts.
+// All switches, encoders and pedals add their events to a queue with the time of the edge. main_switch_check() handles one event on every loop.
 // Display board switches are triggered through an interrupt from the MCP23017 (int a). Because reading of the MCP23017 over i2c is time consuming (around 12 ms),
 // we keep track of the last read display board.
 // External switches can be of type normally open, normally closed or an expression pedal.
@@ -84,12 +85,37 @@ ClickEncoder enc2 = ClickEncoder(ENCODER2_B_PIN, ENCODER2_A_PIN, -1, 2);
 Bounce enc2_switch = Bounce(ENCODER2_SWITCH_PIN, SWITCH_BOUNCE_TIME);
 #endif
 
+// Switch event queue
+// Direct connected switches are read from the 1 ms encoder timer interrupt. Display board and switchpad switches are read in the main loop,
+// but get the time of their pin interrupt. Because every event has its own entry, a press is not lost or delayed to the next loop when the loop is slow.
+// The queue is lock-free for the timer interrupt: events from the main loop are added with interrupts disabled.
+#define SW_EVENT_PRESS 1
+#define SW_EVENT_RELEASE 2
+
+struct SC_event_struct {
+  uint32_t time; // Time of the edge in microseconds
+  uint8_t sw;
+  uint8_t action; // SW_EVENT_PRESS or SW_EVENT_RELEASE
+  uint8_t type; // SW_TYPE_SWITCH, SW_TYPE_ENCODER, etc.
+  int16_t value; // Encoder steps, 14 bit expression pedal value or program number
+};
+
+#define SW_EVENT_QUEUE_SIZE 32 // Must be a power of two
+SC_event_struct SW_event_queue[SW_EVENT_QUEUE_SIZE];
+volatile uint8_t SW_event_head = 0; // Only changed by SC_add_event()
+volatile uint8_t SW_event_tail = 0; // Only changed by SC_read_next_event()
+uint16_t SW_events_lost = 0;
+#define SW_EDGE_MAX_AGE 100000 // Interrupt times older than this are not from the current edge
+
+volatile uint32_t inta_interrupt_time = 0;
+
 #ifdef ENCODER1_A_PIN
 void timerIsr() {
   enc1.service();
 #ifdef ENCODER2_A_PIN
   enc2.service();
 #endif
+  SC_check_direct_switches();
 }
 #endif
 
@@ -174,7 +200,7 @@ uint32_t encoder_timer = 0;
 // ********************************* Section 2: Internal Switch Reading ********************************************
 
 void inta_pin_interrupt() {
-  time_switch_pressed = micros(); // Store the time switch was pressed. It will be used for tap tempo if the switch is programmed that way.
+  inta_interrupt_time = micros(); // Store the time switch was pressed. It will be the time of the switch event, which is also used for tap tempo.
 }
 
 void setup_switch_check() {
@@ -257,84 +283,36 @@ void setup_switch_check() {
 }
 
 void main_switch_check() {
-  // Reset switch variables
-
+  // Read the switches that are not read from the timer interrupt. They add their events to the queue.
 #ifdef INTA_PIN
   SC_check_display_board_switch();
 #endif
 
-  // check direct connected switches
-#ifdef NUMBER_OF_CONNECTED_SWITCHES
-  for (uint8_t s = 0; s < NUMBER_OF_CONNECTED_SWITCHES; s++) {
-    switch_direct[s].update();
-    if (switch_direct[s].fallingEdge()) { // Check if switch is pressed
-#ifdef CUSTOM_SWITCH_NUMBERS
-      switch_pressed = switch_number[s];
-#else
-      switch_pressed = s + 1;
-#endif
-      switch_type = SW_TYPE_SWITCH;
-    }
-    if (switch_direct[s].risingEdge()) { // Check if switch is released
-#ifdef CUSTOM_SWITCH_NUMBERS
-      switch_released = switch_number[s];
-#else
-      switch_released = s + 1;
-#endif
-      switch_type = SW_TYPE_SWITCH;
-    }
-  }
+#ifndef ENCODER1_A_PIN
+  __disable_irq();
+  SC_check_direct_switches(); // No timer interrupt available
+  __enable_irq();
 #endif
 
-
 #ifdef ROWPINS
   // Check for switch pressed on switchpad
   if (switchpad.update() ) {
-    switch_pressed = switchpad.pressed();
-    switch_released = switchpad.released();
-    switch_type = SW_TYPE_SWITCH;
+    uint32_t edge_time = SC_edge_time(SwitchPadInterruptTime);
+    uint8_t sw = switchpad.pressed();
+    if (sw > 0) SC_add_event_from_loop(SW_EVENT_PRESS, sw, SW_TYPE_SWITCH, 0, edge_time);
+    sw = switchpad.released();
+    if (sw > 0) SC_add_event_from_loop(SW_EVENT_RELEASE, sw, SW_TYPE_SWITCH, 0, edge_time);
   }
 #endif
 
   // Check encoders
-  Enc_value = 0;
 #ifdef ENCODER1_A_PIN
   int16_t new_reading = enc1.getValue();
-  if (new_reading != 0) {
-    Enc_value = new_reading;
-    switch_pressed = NUMBER_OF_SWITCHES + 1;
-    switch_type = SW_TYPE_ENCODER;
-  }
-#endif
-#ifdef ENCODER1_SWITCH_PIN
-  enc1_switch.update();
-  if (enc1_switch.fallingEdge()) { // Check if power switch is pressed
-    switch_pressed = NUMBER_OF_SWITCHES + 2;
-    switch_type = SW_TYPE_SWITCH;
-  }
-  if (enc1_switch.risingEdge()) { // Check if power switch is released
-    switch_released = NUMBER_OF_SWITCHES + 2;
-    switch_type = SW_TYPE_SWITCH;
-  }
+  if (new_reading != 0) SC_add_event_from_loop(SW_EVENT_PRESS, NUMBER_OF_SWITCHES + 1, SW_TYPE_ENCODER, new_reading, micros());
 #endif
 #ifdef ENCODER2_A_PIN
   new_reading = enc2.getValue();
-  if (new_reading != 0) {
-    Enc_value = new_reading;
-    switch_pressed = NUMBER_OF_SWITCHES + 3;
-    switch_type = SW_TYPE_ENCODER;
-  }
-#endif
-#ifdef ENCODER2_SWITCH_PIN
-  enc2_switch.update();
-  if (enc2_switch.fallingEdge()) { // Check if power switch is pressed
-    switch_pressed = NUMBER_OF_SWITCHES + 4;
-    switch_type = SW_TYPE_SWITCH;
-  }
-  if (enc2_switch.risingEdge()) { // Check if power switch is released
-    switch_released = NUMBER_OF_SWITCHES + 4;
-    switch_type = SW_TYPE_SWITCH;
-  }
+  if (new_reading != 0) SC_add_event_from_loop(SW_EVENT_PRESS, NUMBER_OF_SWITCHES + 3, SW_TYPE_ENCODER, new_reading, micros());
 #endif
 
 #ifdef JACK1_PINS
@@ -345,22 +323,125 @@ void main_switch_check() {
   SC_update_power_switch();
 #endif
 
+  SC_read_next_event();
   SC_update_long_presses_and_hold();
+}
 
+void SC_check_direct_switches() { // Called from the timer interrupt
+  uint32_t now = micros();
+
+  // check direct connected switches
+#ifdef NUMBER_OF_CONNECTED_SWITCHES
+  for (uint8_t s = 0; s < NUMBER_OF_CONNECTED_SWITCHES; s++) {
+#ifdef CUSTOM_SWITCH_NUMBERS
+    uint8_t sw = switch_number[s];
+#else
+    uint8_t sw = s + 1;
+#endif
+    switch_direct[s].update();
+    if (switch_direct[s].fallingEdge()) SC_add_event(SW_EVENT_PRESS, sw, SW_TYPE_SWITCH, 0, now); // Check if switch is pressed
+    if (switch_direct[s].risingEdge()) SC_add_event(SW_EVENT_RELEASE, sw, SW_TYPE_SWITCH, 0, now); // Check if switch is released
+  }
+#endif
+
+#ifdef ENCODER1_SWITCH_PIN
+  enc1_switch.update();
+  if (enc1_switch.fallingEdge()) SC_add_event(SW_EVENT_PRESS, NUMBER_OF_SWITCHES + 2, SW_TYPE_SWITCH, 0, now); // Check if encoder switch is pressed
+  if (enc1_switch.risingEdge()) SC_add_event(SW_EVENT_RELEASE, NUMBER_OF_SWITCHES + 2, SW_TYPE_SWITCH, 0, now); // Check if encoder switch is released
+#endif
+#ifdef ENCODER2_SWITCH_PIN
+  enc2_switch.update();
+  if (enc2_switch.fallingEdge()) SC_add_event(SW_EVENT_PRESS, NUMBER_OF_SWITCHES + 4, SW_TYPE_SWITCH, 0, now); // Check if encoder switch is pressed
+  if (enc2_switch.risingEdge()) SC_add_event(SW_EVENT_RELEASE, NUMBER_OF_SWITCHES + 4, SW_TYPE_SWITCH, 0, now); // Check if encoder switch is released
+#endif
+}
+
+// Expression pedal and encoder events are coalesced with the last queued event of the same switch: the latest pedal value wins and encoder steps are added.
+// They may not use the last SW_EVENT_RESERVED_SLOTS places in the queue, so press and release events always fit.
+#define SW_EVENT_RESERVED_SLOTS 8
+
+void SC_add_event(uint8_t action, uint8_t sw, uint8_t type, int16_t value, uint32_t time) { // Called from the timer interrupt or with interrupts disabled
+  uint8_t head = SW_event_head;
+  bool coalesce = ((action == SW_EVENT_PRESS) && ((type == SW_TYPE_EXPRESSION_PEDAL) || (type == SW_TYPE_ENCODER)));
+  if (coalesce) {
+    uint8_t i = head;
+    while (i != SW_event_tail) {
+      i = (i - 1) & (SW_EVENT_QUEUE_SIZE - 1);
+      if (SW_event_queue[i].sw != sw) continue;
+      if ((SW_event_queue[i].action != SW_EVENT_PRESS) || (SW_event_queue[i].type != type)) break;
+      if (type == SW_TYPE_ENCODER) {
+        int32_t sum = SW_event_queue[i].value + value;
+        if (sum > INT16_MAX) sum = INT16_MAX;
+        if (sum < INT16_MIN) sum = INT16_MIN;
+        SW_event_queue[i].value = sum;
+      }
+      else SW_event_queue[i].value = value;
+      return; // The time of the queued event is kept, so the latency measurement starts at the first edge
+    }
+  }
+
+  uint8_t used = (head - SW_event_tail) & (SW_EVENT_QUEUE_SIZE - 1);
+  uint8_t max_used = coalesce ? SW_EVENT_QUEUE_SIZE - 1 - SW_EVENT_RESERVED_SLOTS : SW_EVENT_QUEUE_SIZE - 1;
+  if (used >= max_used) { // Queue is full
+    SW_events_lost++;
+    return;
+  }
+  uint8_t next = (head + 1) & (SW_EVENT_QUEUE_SIZE - 1);
+  SW_event_queue[head].time = time;
+  SW_event_queue[head].sw = sw;
+  SW_event_queue[head].action = action;
+  SW_event_queue[head].type = type;
+  SW_event_queue[head].value = value;
+  SW_event_head = next; // The event is complete before the head moves
+}
+
+void SC_add_event_from_loop(uint8_t action, uint8_t sw, uint8_t type, int16_t value, uint32_t time) {
+  __disable_irq();
+  SC_add_event(action, sw, type, value, time);
+  __enable_irq();
+}
+
+void SC_read_next_event() {
+  Enc_value = 0;
+  if (SW_event_tail == SW_event_head) return; // Queue is empty
+  PROFILE_check_event_queue((SW_event_head - SW_event_tail) & (SW_EVENT_QUEUE_SIZE - 1), SW_events_lost);
+
+  __disable_irq(); // The timer interrupt may coalesce a new value into this event
+  SC_event_struct event = SW_event_queue[SW_event_tail];
+  SW_event_tail = (SW_event_tail + 1) & (SW_EVENT_QUEUE_SIZE - 1);
+  __enable_irq();
+
+  switch_type = event.type;
+  time_switch_pressed = event.time;
+  if (event.action == SW_EVENT_RELEASE) {
+    switch_released = event.sw;
+    return;
+  }
+  switch_pressed = event.sw;
+  if (switch_type == SW_TYPE_ENCODER) Enc_value = event.value;
+  if (switch_type == SW_TYPE_EXPRESSION_PEDAL) {
+    Expr_ped_value_14bit = event.value;
+    Expr_ped_value = event.value >> 7;
+  }
+  if (switch_type == SW_TYPE_MIDI_PC) PC_value = event.value;
+  PROFILE_start_switch_latency(event.time);
+}
+
+uint32_t SC_edge_time(uint32_t interrupt_time) { // Returns the interrupt time if it belongs to the current edge
+  uint32_t now = micros();
+  if (now - interrupt_time > SW_EDGE_MAX_AGE) return now;
+  return interrupt_time;
+}
+
+uint32_t SC_event_millis() { // Returns the time of the current event on the millis() clock
+  return millis() - ((micros() - time_switch_pressed) / 1000);
 }
 
 #ifdef POWER_SWITCH_PIN
 void SC_update_power_switch() {
   power_switch.update();
-  if (power_switch.fallingEdge()) { // Check if power switch is pressed
-    switch_pressed = POWER_SWITCH_NUMBER;
-    switch_type = SW_TYPE_SWITCH;
-  }
-
-  if (power_switch.risingEdge()) { // Check if power switch is released
-    switch_released = POWER_SWITCH_NUMBER;
-    switch_type = SW_TYPE_SWITCH;
-  }
+  if (power_switch.fallingEdge()) SC_add_event_from_loop(SW_EVENT_PRESS, POWER_SWITCH_NUMBER, SW_TYPE_SWITCH, 0, micros()); // Check if power switch is pressed
+  if (power_switch.risingEdge()) SC_add_event_from_loop(SW_EVENT_RELEASE, POWER_SWITCH_NUMBER, SW_TYPE_SWITCH, 0, micros()); // Check if power switch is released
 }
 #endif
 
@@ -403,8 +484,7 @@ void check_switches_on_current_board(bool check_interrupt_state) {
 
     if (new_switch_pressed != previous_switch_pressed) { // Check for state change
       previous_switch_pressed = new_switch_pressed; // Need to store the previous version, because switch_pressed can only be active for one cycle!
-      switch_pressed = new_switch_pressed;
-      switch_type = SW_TYPE_SWITCH;
+      if (new_switch_pressed > 0) SC_add_event_from_loop(SW_EVENT_PRESS, new_switch_pressed, SW_TYPE_SWITCH, 0, SC_edge_time(inta_interrupt_time));
     }
 
     button_state = lcd[Current_board].buttonReleased();
@@ -416,8 +496,7 @@ void check_switches_on_current_board(bool check_interrupt_state) {
 
     if (new_switch_released != previous_switch_released) { // Check for state change
       previous_switch_released = new_switch_released; // Need to store the previous version, because switch_released can only be active for one cycle!
-      switch_released = new_switch_released;
-      switch_type = SW_TYPE_SWITCH;
+      if (new_switch_released > 0) SC_add_event_from_loop(SW_EVENT_RELEASE, new_switch_released, SW_TYPE_SWITCH, 0, SC_edge_time(inta_interrupt_time));
     }
   }
   //DEBUGMSG("******* Switches read on board " + String(Current_board) + " at " + String(micros() - time_switch_pressed) + "!!! ********");
@@ -434,16 +513,19 @@ void Select_next_board() {
 #ifdef JACK1_PINS
 void SC_check_external_switches() {
   for (uint8_t j = 0; j < NUMBER_OF_CTL_JACKS; j++) {
+    ctl_jack[j].set_high_resolution(Setting.Exp_pedal_high_res_CC);
     if (ctl_jack[j].update()) {
-      uint8_t my_press = ctl_jack[j].pressed();
-      if (my_press > 0) switch_pressed = NUMBER_OF_SWITCHES + (NUMBER_OF_ENCODERS * 2) + (j * 2) + my_press;
-      uint8_t my_release = ctl_jack[j].released();
-      if (my_release > 0) switch_released = NUMBER_OF_SWITCHES + (NUMBER_OF_ENCODERS * 2) + (j * 2) + my_release;
+      uint32_t now = micros();
+      uint8_t type = SW_TYPE_SWITCH;
+      int16_t value = 0;
       if (ctl_jack[j].check_expr_pedal()) {
-        switch_type = SW_TYPE_EXPRESSION_PEDAL;
-        Expr_ped_value = ctl_jack[j].pedal_value();
+        type = SW_TYPE_EXPRESSION_PEDAL;
+        value = ctl_jack[j].pedal_value_14bit();
       }
-      else switch_type = SW_TYPE_SWITCH;
+      uint8_t my_press = ctl_jack[j].pressed();
+      if (my_press > 0) SC_add_event_from_loop(SW_EVENT_PRESS, NUMBER_OF_SWITCHES + (NUMBER_OF_ENCODERS * 2) + (j * 2) + my_press, type, value, now);
+      uint8_t my_release = ctl_jack[j].released();
+      if (my_release > 0) SC_add_event_from_loop(SW_EVENT_RELEASE, NUMBER_OF_SWITCHES + (NUMBER_OF_ENCODERS * 2) + (j * 2) + my_release, type, value, now);
     }
   }
 }
@@ -633,9 +715,10 @@ void SC_update_long_presses_and_hold() {
         break;
     };
     switch_was_long_pressed = false;
-    Long_press_timer = millis(); // Set timer on switch pressed
-    Extra_long_press_timer = millis(); // Set timer on switch extra long pressed
-    Hold_timer = millis(); // Set timer on switch held
+    uint32_t press_time = SC_event_millis(); // Timers start at the time of the edge, not at the time the event was read
+    Long_press_timer = press_time; // Set timer on switch pressed
+    Extra_long_press_timer = press_time; // Set timer on switch extra long pressed
+    Hold_timer = press_time; // Set timer on switch held
     Hold_time = 700;
     switch_held_times_triggered = 0;
     last_switch_pressed = switch_pressed; // Remember the button that was pressed
@@ -681,49 +764,35 @@ void SC_update_long_presses_and_hold() {
 void SC_remote_switch_pressed(uint8_t sw, bool from_editor) {
   DEBUGMAIN("Remote press SW " + String(sw));
   if (SC_check_valid_switch(sw)) {
-    time_switch_pressed = micros();
-    switch_pressed = sw;
-    if (from_editor) switch_type = SW_TYPE_SWITCH;
-    else switch_type = SW_TYPE_MIDI_CC;
+    SC_add_event_from_loop(SW_EVENT_PRESS, sw, from_editor ? SW_TYPE_SWITCH : SW_TYPE_MIDI_CC, 0, micros());
   }
 }
 
 void SC_remote_switch_released(uint8_t sw, bool from_editor) {
   DEBUGMAIN("Remote release SW " + String(sw));
   if (SC_check_valid_switch(sw)) {
-    time_switch_pressed = micros();
-    switch_released = sw;
-    if (from_editor) switch_type = SW_TYPE_SWITCH;
-    else switch_type = SW_TYPE_MIDI_CC;
+    SC_add_event_from_loop(SW_EVENT_RELEASE, sw, from_editor ? SW_TYPE_SWITCH : SW_TYPE_MIDI_CC, 0, micros());
   }
 }
 
 void SC_remote_switch_pressed_no_release(uint8_t sw) {
   if (SC_check_valid_switch(sw)) {
     DEBUGMAIN("Remote cc switch " + String(sw) + " triggered (no release)");
-    time_switch_pressed = micros();
-    switch_pressed = sw;
-    switch_type = SW_TYPE_MIDI_CC_NO_RELEASE;
+    SC_add_event_from_loop(SW_EVENT_PRESS, sw, SW_TYPE_MIDI_CC_NO_RELEASE, 0, micros());
   }
 }
 
 void SC_remote_expr_pedal(uint8_t sw, uint8_t value) {
   if (SC_check_valid_switch(sw)) {
     DEBUGMAIN("Remote cc pedal " + String(sw) + " triggered with valuem " + String(value));
-    time_switch_pressed = micros();
-    switch_type = SW_TYPE_EXPRESSION_PEDAL;
-    Expr_ped_value = value;
-    switch_pressed = sw;
+    SC_add_event_from_loop(SW_EVENT_PRESS, sw, SW_TYPE_EXPRESSION_PEDAL, (value << 7) | value, micros()); // Scale to 14 bit
   }
 }
 
 void SC_remote_switch_select_program(uint8_t sw, uint8_t program) {
   if (SC_check_valid_switch(sw)) {
     DEBUGMAIN("Remote pc switch " + String(sw) + " triggered with program " + String(program));
-    time_switch_pressed = micros();
-    switch_type = SW_TYPE_MIDI_PC;
-    PC_value = program;
-    switch_pressed = sw;
+    SC_add_event_from_loop(SW_EVENT_PRESS, sw, SW_TYPE_MIDI_PC, program, micros());
   }
 }
 
@@ -57,6 +57,7 @@ uint8_t MD_base_class::get_setting(uint8_t variable) {
     case 9: return my_device_page4;
     case 10: return enabled;
     case 11: return dev_type;
+    case 12: return PC_echo_port;
   }
   return 0;
 }
@@ -75,6 +76,7 @@ void MD_base_class::set_setting(uint8_t variable, uint8_t value) {
     case 9: my_device_page4 = value; break;
     case 10: enabled = value; break;
     case 11: dev_type = value; break;
+    case 12: PC_echo_port = (value <= NUMBER_OF_MIDI_PORTS + 1) ? value : 0; break;
   }
 }
 
@@ -92,6 +94,10 @@ void MD_base_class::do_after_dev_type_update() {}
 
 void MD_base_class::check_SYSEX_in(const unsigned char* sxdata, short unsigned int sxlength, uint8_t port) {}
 
+bool MD_base_class::check_SYSEX_in_realtime(const unsigned char* sxdata, short unsigned int sxlength, uint8_t port) { // Returns true if the message is a realtime message from this device that needs no further processing
+  return false;
+}
+
 void MD_base_class::forward_MIDI_message(const unsigned char* sxdata, short unsigned int sxlength) {}
 
 void MD_base_class::check_PC_in(uint8_t program, uint8_t channel, uint8_t port) {
@@ -182,6 +188,7 @@ void MD_base_class::set_patch_number(uint16_t number) {
   prev_patch_number = patch_number;
   patch_number = number;
   setlist_item_number = SCO_find_number_in_setlist(my_device_number, number);
+  PC_echo_patch_change(my_device_number, number);
 }
 
 // ********************************* Section 3: Device common MIDI out functions ********************************************
@@ -200,12 +207,88 @@ uint8_t MD_base_class::calc_Roland_checksum(uint16_t sum) {
   return checksum & 0x7F;
 }
 
+// Roland scene writes
+// A scene change on the SY1000 or GR55 or a patch recall on the Katana writes a number of parameters. The writes are collected here, sorted by address and parameters
+// with consecutive addresses are sent together in one DT1 message, so a scene change only takes a few messages.
+// Every call to Roland_scene_write_send() sends the writes it has collected, so "turn down first, then up" is kept by sending twice.
+// A device can send more data in one message by overriding max_sysex_block_size().
+// The buffer is shared by all devices, as only one scene change is done at a time.
+
+#define ROLAND_MAX_SCENE_WRITES 80
+#define ROLAND_MAX_SCENE_BLOCK_SIZE 16 // Default maximum number of data bytes in one DT1 message
+
+struct Roland_write_struct {
+  uint32_t address;
+  uint8_t value;
+};
+
+Roland_write_struct Roland_scene_writes[ROLAND_MAX_SCENE_WRITES];
+uint8_t Roland_number_of_scene_writes = 0;
+
+uint32_t Roland_next_address(uint32_t address) { // Roland addresses use seven bits per byte
+  address++;
+  if (address & 0x80) address += 0x80;
+  if (address & 0x8000) address += 0x8000;
+  if (address & 0x800000) address += 0x800000;
+  return address;
+}
+
+uint16_t Roland_linear_address(uint32_t address) { // Turns the two lowest bytes of a Roland address into a linear number, so address ranges can be compared
+  return ((address >> 1) & 0x3F80) | (address & 0x7F);
+}
+
+void MD_base_class::Roland_scene_write_clear() {
+  Roland_number_of_scene_writes = 0;
+}
+
+void MD_base_class::Roland_scene_write_add(uint32_t address, uint8_t value) {
+  if (Roland_number_of_scene_writes >= ROLAND_MAX_SCENE_WRITES) { // Buffer is full - send what we have
+    Roland_scene_write_send();
+  }
+  // Insert sorted by address
+  uint8_t i = Roland_number_of_scene_writes++;
+  while ((i > 0) && (Roland_scene_writes[i - 1].address > address)) {
+    Roland_scene_writes[i] = Roland_scene_writes[i - 1];
+    i--;
+  }
+  Roland_scene_writes[i].address = address;
+  Roland_scene_writes[i].value = value;
+}
+
+void MD_base_class::Roland_scene_write_send() {
+  uint8_t max_len = max_sysex_block_size();
+  uint8_t data[max_len];
+  uint8_t w = 0;
+  while (w < Roland_number_of_scene_writes) {
+    uint32_t start_address = Roland_scene_writes[w].address;
+    uint32_t next_address = Roland_next_address(start_address);
+    uint8_t len = 0;
+    data[len++] = Roland_scene_writes[w++].value;
+    while ((w < Roland_number_of_scene_writes) && (Roland_scene_writes[w].address == next_address) && (len < max_len)) {
+      data[len++] = Roland_scene_writes[w++].value;
+      next_address = Roland_next_address(next_address);
+    }
+    write_sysex_block(start_address, data, len);
+  }
+  Roland_number_of_scene_writes = 0;
+}
+
+void MD_base_class::write_sysex_block(uint32_t address, uint8_t *data, uint8_t len) {}
+
+uint8_t MD_base_class::max_sysex_block_size() {
+  return ROLAND_MAX_SCENE_BLOCK_SIZE;
+}
+
 
 void MD_base_class::set_bpm() {}
 void MD_base_class::bpm_tap() {}
 void MD_base_class::start_tuner() {}
 void MD_base_class::stop_tuner() {}
 
+bool MD_base_class::get_tuner_title(String &Output) { // Returns true if the device has tuner data to show on the main display
+  return false;
+}
+
 // ********************************* Section 4: Device program change ********************************************
 
 void MD_base_class::select_patch(uint16_t new_patch) {
@@ -470,6 +553,14 @@ void MD_base_class::setlist_song_short_item_format(uint16_t item, String &Output
   number_format(item, Output);
 }
 
+uint16_t MD_base_class::setlist_song_get_load_time(uint16_t item) { // Time in ms between selecting the item and the device playing the new sound. Used for scheduled song part changes.
+  return 0;
+}
+
+uint16_t MD_base_class::setlist_song_get_vc_memory_patch(uint16_t item) { // Number of the patch in VController memory that is loaded when the item is selected. Used by the song prefetch.
+  return NO_RESULT;
+}
+
 uint16_t MD_base_class::patch_number_in_current_setlist(uint16_t number) {
   if (SCO_setlist_active(my_device_number + SETLIST_TARGET_FIRST_DEVICE)) return SCO_read_setlist_item(number);
   else return number;
@@ -591,6 +682,8 @@ bool MD_base_class::request_parameter(uint8_t sw, uint16_t number) {
   return true;
 }
 
+void MD_base_class::cancel_pending_request() {} // Called when the page stops waiting for the data of the current switch
+
 uint16_t MD_base_class::number_of_parameters() {
   return 0;
 }
@@ -81,6 +81,7 @@
 #define FAS_GET_SCENE_STATUS 0x29
 #define FAS_REALTIME_TEMPO 0x10
 #define FAS_REALTIME_TUNER 0x0D
+#define FAS_REALTIME_TUNER_AF3 0x11
 #define FAS_SET_PARAMETER 0x02
 #define FAS_GET_FX_BLOCK_BYPASS_STATE 0x0E
 #define FAS_GET_SET_BLOCK_PARAMETER_VALUE 0x02
@@ -95,6 +96,7 @@ FLASHMEM void MD_FAS_class::init() { // Default values for variables
   strcpy(device_name, "AXEFX");
   strcpy(full_device_name, "Fractal device");
   model_number = FAS_MODEL_AF2;
+  set_sysex_template();
   patch_min = FAS_PATCH_MIN;
   patch_max = FAS_PATCH_MAX;
   max_times_no_response = MAX_TIMES_NO_RESPONSE; // The number of times the AXEFX does not have to respond before disconnection
@@ -127,6 +129,9 @@ FLASHMEM void MD_FAS_class::init() { // Default values for variables
   clear_FX_states();
   number_of_active_blocks = 0;
   looper_block_detected = false;
+  tuner_note = NOT_FOUND;
+  tuner_pointer = NOT_FOUND;
+  tuner_data_timer = 0;
   //max_looper_length = 30000000; // Normal stereo looper time is 30 seconds - time given in microseconds
 #ifdef IS_VCTOUCH
   device_pic = img_FAS_AXEFX2;
@@ -140,6 +145,26 @@ FLASHMEM void MD_FAS_class::update() {
 
 // ********************************* Section 2: FAS common MIDI in functions ********************************************
 
+// Incoming messages are dispatched on the function ID (byte 5) through the table below.
+// The realtime tempo and tuner messages are streamed continuously by the AxeFX. They are handled in check_SYSEX_in_realtime(), which is called before all other sysex checks.
+
+typedef void (MD_FAS_class::*FAS_sysex_handler)(const unsigned char* sxdata, short unsigned int sxlength);
+
+struct FAS_sysex_function_struct {
+  uint8_t Function;
+  FAS_sysex_handler Handler;
+};
+
+const PROGMEM FAS_sysex_function_struct FAS_sysex_functions[] = {
+  { FAS_GET_PRESET_NUMBER, &MD_FAS_class::read_preset_number },
+  { FAS_GET_PRESET_NAME, &MD_FAS_class::read_preset_name },
+  { FAS_GET_PRESET_NAME_BY_NUMBER, &MD_FAS_class::read_preset_name_by_number },
+  { FAS_GET_SCENE_STATUS, &MD_FAS_class::read_scene_status },
+  { FAS_GET_FX_BLOCK_BYPASS_STATE, &MD_FAS_class::read_fx_block_states },
+};
+
+const uint8_t FAS_NUMBER_OF_SYSEX_FUNCTIONS = sizeof(FAS_sysex_functions) / sizeof(FAS_sysex_functions[0]);
+
 FLASHMEM void MD_FAS_class::check_SYSEX_in(const unsigned char* sxdata, short unsigned int sxlength, uint8_t port) { // Check incoming sysex messages from  Called from MIDI:OnSysEx/OnSerialSysEx
 
   // Check if it is a message from an AXEFX
@@ -152,123 +177,133 @@ FLASHMEM void MD_FAS_class::check_SYSEX_in(const unsigned char* sxdata, short un
     }
 
     else if ((port == MIDI_in_port) && (sxdata[4] == model_number)) { // Check the other messages
-
-      uint16_t new_patch;
-      bool end_reached;
-
       // Byte 5 of the SysEx message holds the function number, the function
       // ids are defined in AxeMidi.h
-      switch (sxdata[5]) {
-
-        case FAS_REALTIME_TEMPO: // We use the realtime tempo messages to check if the AxeFX is still connected
-          no_response_counter = 0;
-          break;
-
-        case FAS_GET_PRESET_NUMBER:
-          new_patch = sxdata[6] << 7 | sxdata[7];
-          if (patch_number != new_patch) { //Right after a patch change the patch number is sent again. So here we catch that message.
-            prev_patch_number = patch_number;
-            set_patch_number(new_patch);
-            //page_check();
-            do_after_patch_selection();
-            update_page = REFRESH_PAGE;
-          }
-          break;
-
-        case FAS_GET_PRESET_NAME:
-          current_patch_name = "";
-          end_reached = false;
-          for (uint8_t count = 6; count < 22; count++) {
-            if (sxdata[count] == 0x00) end_reached = true;
-            if (!end_reached) current_patch_name += static_cast<char>(sxdata[count]); //Add ascii character to Patch Name String
-            else current_patch_name += ' ';
-          }
-          update_main_lcd = true;
-          if (popup_patch_name) {
-            if (LCD_check_popup_allowed(0)) LCD_show_popup_label(current_patch_name, ACTION_TIMER_LENGTH);
-            popup_patch_name = false;
-          }
-          break;
-
-
-        case FAS_GET_PRESET_NAME_BY_NUMBER: // Patch name of specific preset
-          for (uint8_t count = 0; count < 16; count++) {
-            SP[last_requested_sysex_switch].Label[count] = static_cast<char>(sxdata[count + 8]); //Add ascii character to the SP.Label String
-          }
-          if (SP[last_requested_sysex_switch].PP_number == patch_number) {
-            current_patch_name = SP[last_requested_sysex_switch].Label; // Load patchname when it is read
-            update_main_lcd = true; // And show it on the main LCD
-          }
-          DEBUGMSG(SP[last_requested_sysex_switch].Label);
-          PAGE_request_next_switch();
-          break;
-
-        case FAS_GET_SCENE_STATUS:
-          if (current_scene != sxdata[6]) {
-            current_scene = sxdata[6];
-            DEBUGMSG("Current scene: " + String(current_scene));
-            update_page = REFRESH_PAGE;
-          }
-          break;
-
-        case FAS_GET_FX_BLOCK_BYPASS_STATE: // Check if it is a SYSEX_FAS_GET_PRESET_EFFECT_BLOCKS_AND_CC_AND_BYPASS_STATE message
-
-          // Source: https://github.com/mackatack/FCBInfinity/tree/master/Teensyduino/fcbinfinity
-          // declare some vars we'll use in the loop
-          uint8_t state = 0;
-          uint8_t effectID = 0;
-          uint8_t cc = 0;
-          uint8_t cc_xy = 0;
-          looper_block_detected = false;
-
-          // Reset all the effectstates to 'not placed'
-          clear_FX_states();
-          number_of_active_blocks = 0;
-
-          for (uint8_t i = 6; i < sxlength - 4; i += 5) {
-            if (model_number < FAS_MODEL_AF2) {
-              // Older models
-              // byte+0 effect ID LS nibble
-              // byte+1 effect ID MS nibble
-              // byte+2 bypass CC# LS nibble
-              // byte+3 bypass CC# MS nibble
-              // byte+4 bypass state: 0=bypassed; 1=not bypassed
-              effectID = (sxdata[i + 1] << 4) | sxdata[i];
-              cc = (sxdata[i + 3] << 4) | sxdata[i + 2];
-              state = sxdata[i + 4];
-            }
-            else {
-              // AxeFx2 and up style
-              // for each effect there are 5 bytes:
-              // byte+0, bit 1 is bypass, bit 2 is X/Y state
-              // byte+1: bit 2-7 is bypass CC LS 6 bits
-              // byte+2: bit 1+2 is bypass CC MS 2 bits, bit 3 - 7 is XY CC 5 bits
-              // byte+3: bit 1+2 is XY CC LS bits + bit 4 - 7 is effectID LS nibble
-              // byte+4: bit 1-4 is effectID MS nibble
-              effectID = ((sxdata[i + 3] & 0x78) >> 3) | ((sxdata[i + 4] & 0x0F) << 4); // block id
-              cc = ((sxdata[i + 1] & 0x7E) >> 1) | ((sxdata[i + 2] & 3) << 6); // cc number of bypass state
-              cc_xy = ((sxdata[i + 2] & 0x7C) >> 2) | ((sxdata[i + 3] & 3) << 5); // cc number of xy state
-              state = sxdata[i]; // byp and XY state
-            }
-
-            // Update the state and cc of the effectblock to the new values.
-            number_of_active_blocks++;
-            set_FX_state(cc, state & 0x01); // Set the state for the FX bypass
-            set_FX_state(cc_xy, ((state & 0x02) == 0) ? 1 : 0); // Set the state for the FX XY state and reverse it
-            if (effectID == FAS_LOOPER_ID) {
-              looper_block_detected = true;
-              DEBUGMSG("Looper block detected.");
-            }
-
-            DEBUGMSG("effectID: " + String(effectID) + ", cc: " + String(cc) + ", cc_xy: " + String(cc_xy) + ", state: " + String(state));
-          } // for (i)
-          update_page = REFRESH_PAGE;
-          break;
-      } // switch (sxdata[5])
+      for (uint8_t f = 0; f < FAS_NUMBER_OF_SYSEX_FUNCTIONS; f++) {
+        if (FAS_sysex_functions[f].Function == sxdata[5]) {
+          (this->*FAS_sysex_functions[f].Handler)(sxdata, sxlength);
+          return;
+        }
+      }
     }
   }
 }
 
+FLASHMEM bool MD_FAS_class::check_SYSEX_in_realtime(const unsigned char* sxdata, short unsigned int sxlength, uint8_t port) { // Fast path for the tempo and tuner stream
+  if ((!connected) || (sxlength < 7) || (port != MIDI_in_port)) return false;
+  if ((sxdata[3] != 0x74) || (sxdata[2] != 0x01) || (sxdata[1] != 0x00) || (sxdata[4] != model_number)) return false;
+
+  if (sxdata[5] == FAS_REALTIME_TEMPO) { // We use the realtime tempo messages to check if the AxeFX is still connected
+    no_response_counter = 0;
+    return true;
+  }
+
+  if (sxdata[5] == tuner_function) {
+    no_response_counter = 0;
+    if (sxlength >= 10) read_realtime_tuner(sxdata[6], sxdata[8]);
+    return true;
+  }
+  return false;
+}
+
+FLASHMEM void MD_FAS_class::read_preset_number(const unsigned char* sxdata, short unsigned int sxlength) {
+  uint16_t new_patch = sxdata[6] << 7 | sxdata[7];
+  if (patch_number != new_patch) { //Right after a patch change the patch number is sent again. So here we catch that message.
+    prev_patch_number = patch_number;
+    set_patch_number(new_patch);
+    //page_check();
+    do_after_patch_selection();
+    update_page = REFRESH_PAGE;
+  }
+}
+
+FLASHMEM void MD_FAS_class::read_preset_name(const unsigned char* sxdata, short unsigned int sxlength) {
+  current_patch_name = "";
+  bool end_reached = false;
+  for (uint8_t count = 6; count < 22; count++) {
+    if (sxdata[count] == 0x00) end_reached = true;
+    if (!end_reached) current_patch_name += static_cast<char>(sxdata[count]); //Add ascii character to Patch Name String
+    else current_patch_name += ' ';
+  }
+  update_main_lcd = true;
+  if (popup_patch_name) {
+    if (LCD_check_popup_allowed(0)) LCD_show_popup_label(current_patch_name, ACTION_TIMER_LENGTH);
+    popup_patch_name = false;
+  }
+}
+
+FLASHMEM void MD_FAS_class::read_preset_name_by_number(const unsigned char* sxdata, short unsigned int sxlength) { // Patch name of specific preset
+  for (uint8_t count = 0; count < 16; count++) {
+    SP[last_requested_sysex_switch].Label[count] = static_cast<char>(sxdata[count + 8]); //Add ascii character to the SP.Label String
+  }
+  if (SP[last_requested_sysex_switch].PP_number == patch_number) {
+    current_patch_name = SP[last_requested_sysex_switch].Label; // Load patchname when it is read
+    update_main_lcd = true; // And show it on the main LCD
+  }
+  DEBUGMSG(SP[last_requested_sysex_switch].Label);
+  PAGE_request_next_switch();
+}
+
+FLASHMEM void MD_FAS_class::read_scene_status(const unsigned char* sxdata, short unsigned int sxlength) {
+  if (current_scene != sxdata[6]) {
+    current_scene = sxdata[6];
+    DEBUGMSG("Current scene: " + String(current_scene));
+    update_page = REFRESH_PAGE;
+  }
+}
+
+FLASHMEM void MD_FAS_class::read_fx_block_states(const unsigned char* sxdata, short unsigned int sxlength) { // SYSEX_FAS_GET_PRESET_EFFECT_BLOCKS_AND_CC_AND_BYPASS_STATE message
+  // Source: https://github.com/mackatack/FCBInfinity/tree/master/Teensyduino/fcbinfinity
+  // declare some vars we'll use in the loop
+  uint8_t state = 0;
+  uint8_t effectID = 0;
+  uint8_t cc = 0;
+  uint8_t cc_xy = 0;
+  looper_block_detected = false;
+
+  // Reset all the effectstates to 'not placed'
+  clear_FX_states();
+  number_of_active_blocks = 0;
+
+  for (uint8_t i = 6; i < sxlength - 4; i += 5) {
+    if (model_number < FAS_MODEL_AF2) {
+      // Older models
+      // byte+0 effect ID LS nibble
+      // byte+1 effect ID MS nibble
+      // byte+2 bypass CC# LS nibble
+      // byte+3 bypass CC# MS nibble
+      // byte+4 bypass state: 0=bypassed; 1=not bypassed
+      effectID = (sxdata[i + 1] << 4) | sxdata[i];
+      cc = (sxdata[i + 3] << 4) | sxdata[i + 2];
+      state = sxdata[i + 4];
+    }
+    else {
+      // AxeFx2 and up style
+      // for each effect there are 5 bytes:
+      // byte+0, bit 1 is bypass, bit 2 is X/Y state
+      // byte+1: bit 2-7 is bypass CC LS 6 bits
+      // byte+2: bit 1+2 is bypass CC MS 2 bits, bit 3 - 7 is XY CC 5 bits
+      // byte+3: bit 1+2 is XY CC LS bits + bit 4 - 7 is effectID LS nibble
+      // byte+4: bit 1-4 is effectID MS nibble
+      effectID = ((sxdata[i + 3] & 0x78) >> 3) | ((sxdata[i + 4] & 0x0F) << 4); // block id
+      cc = ((sxdata[i + 1] & 0x7E) >> 1) | ((sxdata[i + 2] & 3) << 6); // cc number of bypass state
+      cc_xy = ((sxdata[i + 2] & 0x7C) >> 2) | ((sxdata[i + 3] & 3) << 5); // cc number of xy state
+      state = sxdata[i]; // byp and XY state
+    }
+
+    // Update the state and cc of the effectblock to the new values.
+    number_of_active_blocks++;
+    set_FX_state(cc, state & 0x01); // Set the state for the FX bypass
+    set_FX_state(cc_xy, ((state & 0x02) == 0) ? 1 : 0); // Set the state for the FX XY state and reverse it
+    if (effectID == FAS_LOOPER_ID) {
+      looper_block_detected = true;
+      DEBUGMSG("Looper block detected.");
+    }
+
+    DEBUGMSG("effectID: " + String(effectID) + ", cc: " + String(cc) + ", cc_xy: " + String(cc_xy) + ", state: " + String(state));
+  } // for (i)
+  update_page = REFRESH_PAGE;
+}
 
 FLASHMEM void MD_FAS_class::check_PC_in(uint8_t program, uint8_t channel, uint8_t port) {  // Check incoming PC messages from  Called from MIDI:OnProgramChange
 
@@ -298,6 +333,7 @@ FLASHMEM void MD_FAS_class::send_alternative_identity_request(uint8_t check_devi
 
 FLASHMEM void MD_FAS_class::set_type(uint8_t device_type) { // Is run just before we connect.
   model_number = device_type;
+  set_sysex_template();
   switch (device_type) { // First determine which Fractal Audio device has connected...
     case FAS_MODEL_STANDARD: // Axe-Fx Standard
       strcpy(device_name, "AF1");
@@ -371,32 +407,46 @@ FLASHMEM void MD_FAS_class::check_still_connected() {} // Never disconnect
 
 // ********************************* Section 3: FAS common MIDI out functions ********************************************
 
-FLASHMEM void MD_FAS_class::write_sysex(uint8_t byte1) {
-  uint8_t sysexmessage[8] = {0xF0, 0x00, 0x01, 0x74, model_number, byte1, 0, 0xF7};
-  sysexmessage[6] = calc_FS_checksum(sysexmessage, 6); // Calculate the Fractal Systems checksum over the first 6 bytes and add it to the message
+// The header of the outgoing messages (F0 00 01 74 <model number>) does not change, so its checksum is calculated once in set_sysex_template().
+// The write_sysex() variants only have to add the data bytes to it.
+
+FLASHMEM void MD_FAS_class::set_sysex_template() { // Called when the model number changes
+  const uint8_t sysex_header[5] = {0xF0, 0x00, 0x01, 0x74, model_number};
+  sysex_header_checksum = calc_FS_checksum(sysex_header, 5);
+  tuner_function = (model_number == FAS_MODEL_AF3) ? FAS_REALTIME_TUNER_AF3 : FAS_REALTIME_TUNER;
+}
+
+FLASHMEM void MD_FAS_class::write_sysex_data(const uint8_t *data, uint8_t data_length) { // Max data length is 9
+  uint8_t sysexmessage[16] = {0xF0, 0x00, 0x01, 0x74, model_number};
+  uint8_t cs = sysex_header_checksum;
+  for (uint8_t i = 0; i < data_length; i++) {
+    sysexmessage[i + 5] = data[i];
+    cs ^= data[i];
+  }
+  sysexmessage[data_length + 5] = cs & 0x7F; // Add the Fractal Systems checksum
+  sysexmessage[data_length + 6] = 0xF7;
   check_sysex_delay();
-  MIDI_send_sysex(sysexmessage, 8, MIDI_out_port);
+  MIDI_send_sysex(sysexmessage, data_length + 7, MIDI_out_port);
+}
+
+FLASHMEM void MD_FAS_class::write_sysex(uint8_t byte1) {
+  const uint8_t data[1] = {byte1};
+  write_sysex_data(data, 1);
 }
 
 FLASHMEM void MD_FAS_class::write_sysex(uint8_t byte1, uint8_t byte2) {
-  uint8_t sysexmessage[9] = {0xF0, 0x00, 0x01, 0x74, model_number, byte1, byte2, 0, 0xF7};
-  sysexmessage[7] = calc_FS_checksum(sysexmessage, 7); // Calculate the Fractal Systems checksum over the first 7 bytes and add it to the message
-  check_sysex_delay();
-  MIDI_send_sysex(sysexmessage, 9, MIDI_out_port);
+  const uint8_t data[2] = {byte1, byte2};
+  write_sysex_data(data, 2);
 }
 
 FLASHMEM void MD_FAS_class::write_sysex(uint8_t byte1, uint8_t byte2, uint8_t byte3) {
-  uint8_t sysexmessage[10] = {0xF0, 0x00, 0x01, 0x74, model_number, byte1, byte2, byte3, 0, 0xF7};
-  sysexmessage[8] = calc_FS_checksum(sysexmessage, 8); // Calculate the Fractal Systems checksum over the first 8 bytes and add it to the message
-  check_sysex_delay();
-  MIDI_send_sysex(sysexmessage, 10, MIDI_out_port);
+  const uint8_t data[3] = {byte1, byte2, byte3};
+  write_sysex_data(data, 3);
 }
 
 FLASHMEM void MD_FAS_class::write_sysex(uint8_t byte1, uint8_t byte2, uint8_t byte3, uint8_t byte4, uint8_t byte5, uint8_t byte6, uint8_t byte7, uint8_t byte8, uint8_t byte9) {
-  uint8_t sysexmessage[16] = {0xF0, 0x00, 0x01, 0x74, model_number, byte1, byte2, byte3, byte4, byte5, byte6, byte7, byte8, byte9, 0, 0xF7};
-  sysexmessage[14] = calc_FS_checksum(sysexmessage, 14); // Calculate the Fractal Systems checksum over the first 14 bytes and add it to the message
-  check_sysex_delay();
-  MIDI_send_sysex(sysexmessage, 16, MIDI_out_port);
+  const uint8_t data[9] = {byte1, byte2, byte3, byte4, byte5, byte6, byte7, byte8, byte9};
+  write_sysex_data(data, 9);
 }
 
 FLASHMEM uint8_t MD_FAS_class::calc_FS_checksum(const unsigned char* sxdata, short unsigned int sxlength) {
@@ -447,6 +497,35 @@ FLASHMEM void MD_FAS_class::stop_tuner() {
   }
 }
 
+// The AxeFX streams the tuner data while its tuner is active: F0 00 01 74 <model> 0D <note> <string> <data> F7 (function 0x11 on the AxeFX III)
+// Note 0 - 11 starts at A. Tuner data 0 - 127 has 63 for in tune.
+// The data is shown on the main display as the note name and a pointer. The display is only updated when one of them changes.
+#define FAS_TUNER_POINTER_POSITIONS 11
+#define FAS_TUNER_DATA_TIMEOUT 1000
+
+const PROGMEM char FAS_tuner_notes[12][3] = { "A ", "Bb", "B ", "C ", "C#", "D ", "Eb", "E ", "F ", "F#", "G ", "Ab" };
+
+FLASHMEM void MD_FAS_class::read_realtime_tuner(uint8_t note, uint8_t data) {
+  if (note > 11) return;
+  uint8_t pointer = ((data & 0x7F) * FAS_TUNER_POINTER_POSITIONS) >> 7;
+  tuner_data_timer = millis() + FAS_TUNER_DATA_TIMEOUT;
+  if ((note == tuner_note) && (pointer == tuner_pointer)) return; // Nothing changed on the display
+  tuner_note = note;
+  tuner_pointer = pointer;
+  if (global_tuner_active) update_main_lcd = true;
+}
+
+FLASHMEM bool MD_FAS_class::get_tuner_title(String &Output) {
+  if ((!connected) || (tuner_note == NOT_FOUND) || (millis() > tuner_data_timer)) return false;
+  Output = FAS_tuner_notes[tuner_note];
+  Output += ' ';
+  for (uint8_t i = 0; i < FAS_TUNER_POINTER_POSITIONS; i++) {
+    if (i == tuner_pointer) Output += (i == FAS_TUNER_POINTER_POSITIONS / 2) ? '#' : 'o';
+    else Output += (i == FAS_TUNER_POINTER_POSITIONS / 2) ? '|' : '-';
+  }
+  return true;
+}
+
 // ********************************* Section 4: FAS program change ********************************************
 
 FLASHMEM void MD_FAS_class::select_patch(uint16_t new_patch) {
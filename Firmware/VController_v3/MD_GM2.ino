@@ -236,7 +236,7 @@ void MD_GM2_class::request_current_patch() { //F0 00 20 1F 7F 66 45 00 00 F7
 
 void MD_GM2_class::set_bpm() { //Will change the bpm to the specified value
   if (connected) {
-    uint16_t bpm_in_msec = 60000 / Setting.Bpm;
+    uint16_t bpm_in_msec = 600000 / SCO_get_bpm_x10();
     write_sysex(0x26, (uint8_t) (bpm_in_msec & 0x7F), (uint8_t) (bpm_in_msec >> 7));
   }
 }
@@ -77,6 +77,7 @@ FLASHMEM void MD_GP10_class::init() { // Default values for variables
   my_device_page3 = GP10_DEFAULT_VC_PAGE3;
   my_device_page4 = GP10_DEFAULT_VC_PAGE4;
 #endif
+  build_target_index();
 
 #ifdef IS_VCTOUCH
   device_pic = img_GP10;
@@ -279,6 +280,7 @@ FLASHMEM void MD_GP10_class::do_after_patch_selection() {
   update_LEDS = true;
   update_main_lcd = true;
   assign_read = false; // Assigns should be read again
+  assign_area_requested = false;
   request_guitar_switch_states();
   request_current_patch_name();
   //EEPROM.write(EEPROM_GP10_PATCH_NUMBER, patch_number);
@@ -668,21 +670,20 @@ FLASHMEM uint8_t MD_GP10_class::number_of_values(uint16_t parameter) {
 // 0x20022068 - 0x2002206F: Assign latch (momentary/toggle) 1 - 8
 // The rest we do not need, so we won't read it
 
-// Whenever there is a GP10 assign on the page, the entire 112 bytes of the  GP10 assigns are read from the device
-// Because the MIDI buffer of the VController is limited to 60 bytes including header and footer bytes, we read them in three turns
+// Whenever there is a GP10 assign on the page, the entire 112 bytes of the GP10 assigns are read from the device in one RQ1 message
+// The assign area is kept in assign_mem until the patch changes. A DT1 message from the GP10 that changes the assign area clears assign_read and reloads the page.
 
 // Procedures for GP10_ASSIGN:
 // 1. Load in SP array - GP10_assign_load() below
-// 2. Request - GP10_request_complete_assign_area() (first time only)
-// 3. Read assign area - GP10_read_complete_assign_area() (first time only)
+// 2. Request - GP10_request_complete_assign_area() (first time after a patch change only)
+// 3. Read assign area - GP10_read_complete_assign_area() (first time after a patch change only)
 // 4. Request parameter state - GP10_assign_request() below, also uses GP10_target_lookup()
 // 5. Read parameter state - GP10_read_parameter() above
 // 6. Press switch - GP10_assign_press() below
 // 7. Release switch - GP10_assign_release() below
 
-#define GP10_assign_address_set1 0x20022000
-#define GP10_assign_address_set2 0x20022028
-#define GP10_assign_address_set3 0x20022050
+#define GP10_assign_address 0x20022000
+#define GP10_ASSIGN_AREA_SIZE 112
 #define GP10_NUMBER_OF_ASSIGNS 8
 
 FLASHMEM void MD_GP10_class::read_assign_name(uint8_t number, String & Output) {
@@ -761,31 +762,39 @@ FLASHMEM void MD_GP10_class::request_current_assign(uint8_t sw) {
 }
 
 FLASHMEM void MD_GP10_class::request_complete_assign_area(uint8_t sw) {
-  request_sysex(GP10_assign_address_set1, 40);  //Request the first 40 bytes of the GP10 assign area
-  request_sysex(GP10_assign_address_set2, 40);  //Request the second 40 bytes of the GP10 assign area
-  request_sysex(GP10_assign_address_set3, 32);  //Request the last 32 bytes of the GP10 assign area
+  request_sysex(GP10_assign_address, GP10_ASSIGN_AREA_SIZE);  //Request the complete GP10 assign area
+  assign_area_requested = true;
   last_requested_sysex_switch = sw;
 }
 
-FLASHMEM void MD_GP10_class::read_complete_assign_area(uint8_t sw, uint32_t address, const unsigned char* sxdata, short unsigned int sxlength) {
-  if (address == GP10_assign_address_set1) { // Read assign byte 0 - 39 from GP10 memory
-    for (uint8_t count = 0; count < 40; count++) {
+FLASHMEM void MD_GP10_class::read_complete_assign_area(uint8_t sw, uint32_t address, const unsigned char* sxdata, short unsigned int sxlength) { // Called for all DT1 messages from the GP10
+  if (((address & 0xFFFF0000) != (GP10_assign_address & 0xFFFF0000)) || (sxlength <= 14)) return;
+  uint16_t start = Roland_linear_address(address);
+  uint16_t area_start = Roland_linear_address(GP10_assign_address);
+  uint16_t len = sxlength - 14;
+  if ((start >= area_start + GP10_ASSIGN_AREA_SIZE) || (start + len <= area_start)) return; // Message does not touch the assign area
+
+  if ((!assign_read) && (address == GP10_assign_address) && (len >= GP10_ASSIGN_AREA_SIZE)) { // Read assign byte 0 - 111 from GP10 memory
+    for (uint8_t count = 0; count < GP10_ASSIGN_AREA_SIZE; count++) {
       assign_mem[count] = sxdata[count + 12]; //Add byte to the assign memory
     }
-  }
-
-  if (address == GP10_assign_address_set2) { // Read assign byte 40 - 79 from GP10 memory
-    for (uint8_t count = 0; count < 40; count++) {
-      assign_mem[count + 40] = sxdata[count + 12]; //Add byte to the assign memory
+    assign_read = true;
+    if (assign_area_requested) {
+      assign_area_requested = false;
+      assign_request(sw);
     }
+    return;
   }
 
-  if (address == GP10_assign_address_set3) { // Read assign byte 80 - 111 from GP10 memory
-    for (uint8_t count = 0; count < 32; count++) {
-      assign_mem[count + 80] = sxdata[count + 12]; //Add byte to the assign memory
+  if (assign_read) { // Check if the assigns have been changed on the GP10
+    for (uint16_t i = 0; i < len; i++) {
+      if ((start + i >= area_start) && (start + i < area_start + GP10_ASSIGN_AREA_SIZE) && (sxdata[i + 12] != assign_mem[start + i - area_start])) {
+        DEBUGMSG("GP10 assigns changed");
+        assign_read = false; // Assigns should be read again
+        update_page = REFRESH_PAGE;
+        return;
+      }
     }
-    assign_read = true;
-    assign_request(sw);
   }
 }
 
@@ -864,18 +873,23 @@ FLASHMEM void MD_GP10_class::assign_request(uint8_t sw) { //Request the current
   }
 }
 
-FLASHMEM bool MD_GP10_class::target_lookup(uint8_t sw, uint16_t target) { // Finds the target and its address in the GP10_parameters table
+uint16_t GP10_target_keys[GP10_NUMBER_OF_PARAMETERS]; // Index of GP10_parameters sorted on target
+uint16_t GP10_target_index[GP10_NUMBER_OF_PARAMETERS];
 
-  // Lookup in GP10_parameter array
-  bool found = false;
+FLASHMEM void MD_GP10_class::build_target_index() {
   for (uint16_t i = 0; i < GP10_NUMBER_OF_PARAMETERS; i++) {
-    if (target == GP10_parameters[i].Target) { //Check is we've found the right target
-      SP[sw].PP_number = i; // Save the index number
-      SP[sw].Address = GP10_parameters[i].Address;
-      found = true;
-    }
+    GP10_target_keys[i] = GP10_parameters[i].Target;
+    GP10_target_index[i] = i;
   }
-  return found;
+  PAR_index_sort(GP10_target_keys, GP10_target_index, GP10_NUMBER_OF_PARAMETERS);
+}
+
+FLASHMEM bool MD_GP10_class::target_lookup(uint8_t sw, uint16_t target) { // Finds the target and its address in the GP10_parameters table
+  uint16_t index = PAR_index_lookup(GP10_target_keys, GP10_target_index, GP10_NUMBER_OF_PARAMETERS, target);
+  if (index == NO_RESULT) return false;
+  SP[sw].PP_number = index; // Save the index number
+  SP[sw].Address = GP10_parameters[index].Address;
+  return true;
 }
 
 // ********************************* Section 7: GP10 Expression pedal control ********************************************
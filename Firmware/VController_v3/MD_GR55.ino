@@ -106,6 +106,7 @@ FLASHMEM void MD_GR55_class::init() // Default values for variables
 
   initialize_patch_space();
   initialize_scene_assigns();
+  build_target_index();
 
 #ifdef IS_VCTOUCH
   device_pic = img_GR55;
@@ -142,6 +143,9 @@ FLASHMEM void MD_GR55_class::check_SYSEX_in(const unsigned char* sxdata, short u
       }
     }
 
+    // Check if it is assign data
+    if (checksum_ok) update_assign_cache(address, sxdata, sxlength);
+
     // Check if it is the current parameter
     if (address == last_requested_sysex_address) {
       if (!checksum_ok) {
@@ -202,6 +206,7 @@ FLASHMEM void MD_GR55_class::check_SYSEX_in(const unsigned char* sxdata, short u
     // Check if the GR55 is in bass mode (address: 0x18, 0x00, 0x00, 0x00)
     if ((sxdata[6] == 0x12) && (address == 0x18000000) && (sxdata[11] == 0x01) && (checksum_ok)) {
       bass_mode = true; // In bass mode
+      scene_plan_valid = false; // Instrument parameters are different in bass mode
       preset_banks = 12;
       if (patch_max > GR55_PATCH_MAX_BASS_MODE) patch_max = GR55_PATCH_MAX_BASS_MODE;
       DEBUGMSG("GR55 is in Bass Mode");
@@ -318,6 +323,22 @@ FLASHMEM void MD_GR55_class::write_sysex(uint32_t address, uint8_t value1, uint8
   MIDI_send_sysex(sysexmessage, 16, MIDI_out_port);
 }
 
+FLASHMEM void MD_GR55_class::write_sysex_block(uint32_t address, uint8_t *data, uint8_t len) { // For sending a block of data bytes
+
+  uint8_t *ad = (uint8_t*)&address; //Split the 32-bit address into four bytes: ad[3], ad[2], ad[1] and ad[0]
+  uint16_t sum = ad[3] + ad[2] + ad[1] + ad[0];
+  uint8_t messagesize = len + 13;
+  uint8_t sysexmessage[messagesize] = {0xF0, 0x41, MIDI_device_id, 0x00, 0x00, 0x53, 0x12, ad[3], ad[2], ad[1], ad[0]};
+  for (uint8_t i = 0; i < len; i++) {
+    sysexmessage[i + 11] = data[i];
+    sum += data[i];
+  }
+  sysexmessage[messagesize - 2] = calc_Roland_checksum(sum); // Calculate the Roland checksum
+  sysexmessage[messagesize - 1] = 0xF7;
+  check_sysex_delay();
+  MIDI_send_sysex(sysexmessage, messagesize, MIDI_out_port);
+}
+
 FLASHMEM void MD_GR55_class::request_sysex(uint32_t address, uint8_t no_of_bytes) {
   uint8_t *ad = (uint8_t*)&address; //Split the 32-bit address into four bytes: ad[3], ad[2], ad[1] and ad[0]
   uint8_t checksum = calc_Roland_checksum(ad[3] + ad[2] + ad[1] + ad[0] +  no_of_bytes); // Calculate the Roland checksum
@@ -405,6 +426,7 @@ FLASHMEM void MD_GR55_class::do_after_patch_selection() {
   is_on = connected;
   if (Setting.Send_global_tempo_after_patch_change == true) set_bpm();
   Current_patch_number = patch_number;
+  ctl_assign_cache_valid = 0; // Assigns should be read again
   load_patch(patch_number);
   request_full_assign(0);
   update_LEDS = true;
@@ -937,11 +959,26 @@ FLASHMEM void MD_GR55_class::check_update_label(uint8_t Sw, uint8_t value) { //
   }
 }
 
-FLASHMEM uint8_t MD_GR55_class::find_target(uint16_t target) {
-  for (uint8_t i = 0; i < GR55_NUMBER_OF_PARAMETERS; i++) {
-    if (GR55_parameters[i].Target == target) return i;
+uint16_t GR55_target_keys[GR55_NUMBER_OF_PARAMETERS]; // Index of GR55_parameters sorted on target
+uint16_t GR55_target_index[GR55_NUMBER_OF_PARAMETERS];
+uint16_t GR55_ctl_function_keys[GR55_NUMBER_OF_PARAMETERS]; // Index of GR55_parameters sorted on control function
+uint16_t GR55_ctl_function_index[GR55_NUMBER_OF_PARAMETERS];
+
+FLASHMEM void MD_GR55_class::build_target_index() {
+  for (uint16_t i = 0; i < GR55_NUMBER_OF_PARAMETERS; i++) {
+    GR55_target_keys[i] = GR55_parameters[i].Target;
+    GR55_target_index[i] = i;
+    GR55_ctl_function_keys[i] = GR55_parameters[i].Ctl_function;
+    GR55_ctl_function_index[i] = i;
   }
-  return NOT_FOUND;
+  PAR_index_sort(GR55_target_keys, GR55_target_index, GR55_NUMBER_OF_PARAMETERS);
+  PAR_index_sort(GR55_ctl_function_keys, GR55_ctl_function_index, GR55_NUMBER_OF_PARAMETERS);
+}
+
+FLASHMEM uint8_t MD_GR55_class::find_target(uint16_t target) {
+  uint16_t index = PAR_index_lookup(GR55_target_keys, GR55_target_index, GR55_NUMBER_OF_PARAMETERS, target);
+  if (index == NO_RESULT) return NOT_FOUND;
+  return index;
 }
 
 FLASHMEM uint16_t MD_GR55_class::number_of_parameters() {
@@ -959,16 +996,22 @@ FLASHMEM uint8_t MD_GR55_class::number_of_values(uint16_t parameter) {
 
 // Procedures for GR55_ASSIGN:
 // 1. Load in SP array - GR55_assign_load() below
-// 2. Request - GR55_request_current_assign()
-// 3. Read assign - GR55_read_current_assign(uint8_t sw) - also requests parameter state
-// 4. Read parameter state - GR55_read_parameter() above
-// 5. Press switch - GR55_assign_press() below
-// 6. Release switch - GR55_assign_release() below
+// 2. Request - GR55_request_current_assign() - reads the settings of all control pedals when they are not in the cache
+// 3. Read assign - GR55_update_assign_cache() and GR55_read_current_assign(uint8_t sw)
+// 4. Request parameter state - GR55_assign_request(uint8_t sw) - reads the control pedal from the cache
+// 5. Read parameter state - GR55_read_parameter() above
+// 6. Press switch - GR55_assign_press() below
+// 7. Release switch - GR55_assign_release() below
+
+// The control pedal settings of the current patch are kept in ctl_assign_cache. They are read in one RQ1 message when the first control pedal assign
+// on a page is loaded. The cache is cleared on a patch change. A DT1 message from the GR55 that changes a cached setting removes it from the cache and reloads the page.
 
 const PROGMEM char GR55_ctl_pedal_title[GR55_NUMBER_OF_CONTROL_PEDALS][7] = { "CTL", "EXP SW", "GK S1", "GK S2"};
 const PROGMEM char GR55_ctl_pedal_short_title[GR55_NUMBER_OF_CONTROL_PEDALS][7] = { "CTL", "EXPS", "GKS1", "GKS2"};
 const PROGMEM uint32_t GR55_ctl_pedal_address[GR55_NUMBER_OF_CONTROL_PEDALS] = { 0x18000012, 0x1800004E, 0x18000072, 0x1800007F};
 const PROGMEM uint8_t GR55_ctl_pedal_assign_target[GR55_NUMBER_OF_CONTROL_PEDALS] = { 0, 3, 6, 7 };
+#define GR55_CTL_PEDAL_BLOCK_ADDRESS 0x18000012 // Block with the settings of all control pedals
+#define GR55_CTL_PEDAL_BLOCK_SIZE 122
 const PROGMEM uint8_t GR55_int_pdl_assign_target[GR55_NUMBER_OF_CONTROL_PEDALS] = { 1, 8, 9, 10 };
 const PROGMEM char GR55_ctl_pedal_functions_title[][16] = {
   "--", "HOLD", "TAP TEMPO", "TONE SW", "AMP SW", "MOD SW", "MFX SW", "DELAY SW", "REVERB SW", "CHORUS SW", "PLAY/STOP",
@@ -1075,9 +1118,12 @@ FLASHMEM void MD_GR55_class::assign_load(uint8_t sw, uint8_t assign_number, uint
 FLASHMEM void MD_GR55_class::request_current_assign(uint8_t sw) {
   uint8_t asgn = SP[sw].Assign_number;
   if (asgn < GR55_NUMBER_OF_CONTROL_PEDALS) {
-    uint32_t my_address = GR55_ctl_pedal_address[asgn];
-    request_sysex(my_address , 13);
-    last_requested_sysex_address = my_address;
+    if (ctl_assign_cache_valid & (1 << asgn)) { // Control pedal has been read already
+      assign_request(sw);
+      return;
+    }
+    request_sysex(GR55_CTL_PEDAL_BLOCK_ADDRESS, GR55_CTL_PEDAL_BLOCK_SIZE);
+    last_requested_sysex_address = GR55_CTL_PEDAL_BLOCK_ADDRESS;
     last_requested_sysex_type = REQUEST_ASSIGN_TYPE;
     last_requested_sysex_switch = sw;
   }
@@ -1104,21 +1150,61 @@ FLASHMEM void MD_GR55_class::request_current_assign(uint8_t sw) {
   }
 }
 
+FLASHMEM void MD_GR55_class::update_assign_cache(uint32_t address, const unsigned char* sxdata, short unsigned int sxlength) { // Called for all DT1 messages from the GR55
+  if (((address & 0xFFFF0000) != 0x18000000) || (sxlength <= 13)) return;
+  bool requested = ((address == last_requested_sysex_address) && (last_requested_sysex_type == REQUEST_ASSIGN_TYPE));
+  uint16_t start = Roland_linear_address(address);
+  uint16_t len = sxlength - 13;
+  bool changed = false;
+  for (uint8_t c = 0; c < GR55_NUMBER_OF_CONTROL_PEDALS; c++) {
+    uint16_t ctl_start = Roland_linear_address(GR55_ctl_pedal_address[c]);
+    if ((start >= ctl_start + GR55_CTL_PEDAL_ASSIGN_SIZE) || (start + len <= ctl_start)) continue; // Message does not touch this control pedal
+    uint8_t mask = 1 << c;
+    if ((requested) && (start <= ctl_start) && (start + len >= ctl_start + GR55_CTL_PEDAL_ASSIGN_SIZE)) { // Store the control pedal settings
+      for (uint8_t i = 0; i < GR55_CTL_PEDAL_ASSIGN_SIZE; i++) ctl_assign_cache[c][i] = sxdata[ctl_start - start + i + 11];
+      ctl_assign_cache_valid |= mask;
+    }
+    else if (ctl_assign_cache_valid & mask) { // Check if the control pedal has been changed on the GR55
+      for (uint16_t i = 0; i < len; i++) {
+        if ((start + i >= ctl_start) && (start + i < ctl_start + GR55_CTL_PEDAL_ASSIGN_SIZE) && (sxdata[i + 11] != ctl_assign_cache[c][start + i - ctl_start])) {
+          ctl_assign_cache_valid &= ~mask;
+          changed = true;
+          DEBUGMSG("GR55 control pedal " + String(c + 1) + " changed");
+          break;
+        }
+      }
+    }
+  }
+  if (changed) update_page = REFRESH_PAGE;
+}
+
 FLASHMEM void MD_GR55_class::read_current_assign(uint8_t sw, uint32_t address, const unsigned char* sxdata, short unsigned int sxlength) {
+  uint8_t asgn = SP[sw].Assign_number;
+  if (asgn >= GR55_NUMBER_OF_CONTROL_PEDALS) return;
+  if (ctl_assign_cache_valid & (1 << asgn)) assign_request(sw);
+  else if (address != GR55_ctl_pedal_address[asgn]) { // Block did not arrive complete - read the control pedal on its own
+    last_requested_sysex_address = GR55_ctl_pedal_address[asgn];
+    request_sysex(last_requested_sysex_address, GR55_CTL_PEDAL_ASSIGN_SIZE);
+  }
+  else PAGE_request_next_switch();
+}
+
+FLASHMEM void MD_GR55_class::assign_request(uint8_t sw) { // Read the control pedal from the cache and request the target state
   bool found;
   String msg;
   uint8_t ctl_function_number;
   uint8_t asgn = SP[sw].Assign_number;
 
   if (asgn < GR55_NUMBER_OF_CONTROL_PEDALS) { // CTL assign
-    ctl_function_number = sxdata[11];
+    const uint8_t *ctl_data = ctl_assign_cache[asgn];
+    ctl_function_number = ctl_data[0];
     if ((asgn > 0) && (ctl_function_number > 0)) ctl_function_number++; // Skip hold function for all but first ctl pedal
     bool ctl_function_on = ((ctl_function_number > 0) || (asgn == 1));
 
     if (ctl_function_on) {
       SP[sw].Assign_on = true;
       SP[sw].Latch = TOGGLE;
-      if (((ctl_function_number == 1) && (sxdata[14] == 1)) || (ctl_function_number == 2) || (ctl_function_number == 10) || (ctl_function_number == 11)
+      if (((ctl_function_number == 1) && (ctl_data[3] == 1)) || (ctl_function_number == 2) || (ctl_function_number == 10) || (ctl_function_number == 11)
           || (ctl_function_number == 12) || (ctl_function_number == 15)) SP[sw].Latch = MOMENTARY;
       SP[sw].Assign_max = 1;
       SP[sw].Assign_min = 0;
@@ -1133,33 +1219,33 @@ FLASHMEM void MD_GR55_class::read_current_assign(uint8_t sw, uint32_t address, c
       // Save tone on/off states bitwise in Target_byte2 for GKS1 en GKS2
       if (ctl_function_number == 3) {
         uint8_t on_off_state = 0;
-        for (uint8_t b = 16; b < 24; b++) {
+        for (uint8_t b = 5; b < 13; b++) {
           on_off_state <<= 1;
-          on_off_state |= (sxdata[b] & 1);
+          on_off_state |= (ctl_data[b] & 1);
         }
         SP[sw].Step = on_off_state;
         DEBUGMSG("FULL_ONOFF_STATE:" + String(on_off_state));
 
         // find the tone switch that is different
-        if (sxdata[16] != sxdata[20]) {
+        if (ctl_data[5] != ctl_data[9]) {
           ctl_function_number = 10;
-          SP[sw].Assign_max = sxdata[20];
-          SP[sw].Assign_min = sxdata[16];
+          SP[sw].Assign_max = ctl_data[9];
+          SP[sw].Assign_min = ctl_data[5];
         }
-        else if (sxdata[17] != sxdata[21]) {
+        else if (ctl_data[6] != ctl_data[10]) {
           ctl_function_number = 11;
-          SP[sw].Assign_max = sxdata[21];
-          SP[sw].Assign_min = sxdata[17];
+          SP[sw].Assign_max = ctl_data[10];
+          SP[sw].Assign_min = ctl_data[6];
         }
-        else if (sxdata[18] != sxdata[22]) {
+        else if (ctl_data[7] != ctl_data[11]) {
           ctl_function_number = 12;
-          SP[sw].Assign_max = sxdata[22];
-          SP[sw].Assign_min = sxdata[18];
+          SP[sw].Assign_max = ctl_data[11];
+          SP[sw].Assign_min = ctl_data[7];
         }
-        else if (sxdata[19] != sxdata[23]) {
+        else if (ctl_data[8] != ctl_data[12]) {
           ctl_function_number = 13;
-          SP[sw].Assign_max = sxdata[23];
-          SP[sw].Assign_min = sxdata[17];
+          SP[sw].Assign_max = ctl_data[12];
+          SP[sw].Assign_min = ctl_data[6];
         }
       }
 
@@ -1199,17 +1285,11 @@ FLASHMEM void MD_GR55_class::read_current_assign(uint8_t sw, uint32_t address, c
 }
 
 FLASHMEM bool MD_GR55_class::ctl_target_lookup(uint8_t sw, uint8_t target) {  // Finds the target and its address in the GR55_parameters table
-
-  // Lookup in GR55_parameter array
-  bool found = false;
-  for (uint16_t i = 0; i < GR55_NUMBER_OF_PARAMETERS; i++) {
-    if (target == GR55_parameters[i].Ctl_function) { //Check is we've found the right target
-      SP[sw].PP_number = i; // Save the index number
-      SP[sw].Address = GR55_parameters[i].Address;
-      found = true;
-    }
-  }
-  return found;
+  uint16_t index = PAR_index_lookup(GR55_ctl_function_keys, GR55_ctl_function_index, GR55_NUMBER_OF_PARAMETERS, target);
+  if (index == NO_RESULT) return false;
+  SP[sw].PP_number = index; // Save the index number
+  SP[sw].Address = GR55_parameters[index].Address;
+  return true;
 }
 
 FLASHMEM void MD_GR55_class::set_tone_state(uint8_t state) {
@@ -1708,6 +1788,8 @@ const PROGMEM GR55_scene_inst_parameter_struct GR55_scene_inst_parameters[][GR55
 };
 
 #define GR55_TOTAL_NUMBER_OF_SCENE_PARAMETERS GR55_NUMBER_OF_INST_PARAMETERS + GR55_NUMBER_OF_SCENE_PARAMETERS
+static_assert(GR55_TOTAL_NUMBER_OF_SCENE_PARAMETERS == GR55_SCENE_PLAN_SIZE, "GR55_SCENE_PLAN_SIZE in Class_MD.ino must match the scene parameter tables");
+#define GR55_SCENE_PLAN_UNUSED 0xFF // Parameter is not used for this instrument type
 
 FLASHMEM uint32_t MD_GR55_class::get_scene_inst_parameter_address(uint16_t number) {
   uint32_t address;
@@ -1782,7 +1864,7 @@ FLASHMEM void MD_GR55_class::set_snapscene(uint8_t sw, uint8_t number) {
   MIDI_send_current_snapscene(my_device_number, current_snapscene);
   switch_scene_momentary_inst(false);
 
-  int_pdl_speed = 60000 * 8 / Setting.Bpm; // Send cc#94 internal pedal emulation on scene change which goes from 0 - 127 in 8 beats of the current bpm
+  int_pdl_speed = 600000 * 8 / SCO_get_bpm_x10(); // Send cc#94 internal pedal emulation on scene change which goes from 0 - 127 in 8 beats of the current bpm
   int_pdl_cc_val = 0;
   MIDI_send_CC(94, int_pdl_cc_val, MIDI_channel, MIDI_out_port);
   int_pdl_timer = millis();
@@ -1801,8 +1883,40 @@ FLASHMEM void MD_GR55_class::show_snapscene(uint8_t number) {
   DEBUGMSG("GR55 snapscene change to scene " + String(number));
 }
 
-FLASHMEM bool MD_GR55_class::load_scene(uint8_t prev_scene, uint8_t new_scene) {
+// Scene plans
+// The scene data in GR55_patch_buffer is decoded once into scene_plan[] when the patch is loaded or a scene is changed.
+// A scene change then only compares the values of both scenes. Changes are written with Roland_scene_write_add(), so parameters
+// with consecutive addresses are sent together. Parameters that are turned down or off are sent first, then the ones that are turned up or on.
+// scene_plan_valid must be cleared whenever the scene data in GR55_patch_buffer changes.
+
+FLASHMEM void MD_GR55_class::compile_scene_plans() {
   uint8_t my_byte, my_shift, my_mask;
+  for (uint8_t s = 1; s <= 8; s++) {
+    uint8_t index = get_scene_index(s);
+    uint8_t *plan = scene_plan[s - 1];
+    uint8_t p = 0;
+    uint8_t inst_type_index;
+    if (!bass_mode) inst_type_index = read_scene_data(s, COSM_GTR_TYPE_ITEM);
+    else inst_type_index = read_scene_data(s, COSM_BASS_TYPE_ITEM) + 4;
+    for (uint8_t par = 0; par < GR55_NUMBER_OF_INST_PARAMETERS; par++) {
+      my_byte = (GR55_scene_inst_parameters[inst_type_index][par].Bit_address >> 4) + GR55_INST_DATA_OFFSET;
+      my_shift = GR55_scene_inst_parameters[inst_type_index][par].Bit_address & 0x0F;
+      my_mask = GR55_scene_inst_parameters[inst_type_index][par].Bit_mask;
+      if (my_mask != 0) plan[p++] = (GR55_patch_buffer[index + my_byte] >> my_shift) & my_mask;
+      else plan[p++] = GR55_SCENE_PLAN_UNUSED;
+    }
+    for (uint8_t i = 0; i < GR55_NUMBER_OF_SCENE_PARAMETERS; i++) {
+      my_byte = GR55_scene_parameters[i].Bit_address >> 4;
+      my_shift = GR55_scene_parameters[i].Bit_address & 0x0F;
+      my_mask = GR55_scene_parameters[i].Bit_mask;
+      if (my_mask != 0) plan[p++] = (GR55_patch_buffer[index + my_byte] >> my_shift) & my_mask;
+      else plan[p++] = GR55_SCENE_PLAN_UNUSED;
+    }
+  }
+  scene_plan_valid = true;
+}
+
+FLASHMEM bool MD_GR55_class::load_scene(uint8_t prev_scene, uint8_t new_scene) {
   MIDI_debug_sysex(GR55_patch_buffer, VC_PATCH_SIZE, 255, true);
   bool load_all_data = false;
   if (prev_scene == new_scene) return false;
@@ -1811,6 +1925,7 @@ FLASHMEM bool MD_GR55_class::load_scene(uint8_t prev_scene, uint8_t new_scene) {
 
   DEBUGMAIN("Loading scene " + String(new_scene) + " (prev scene:" + String(prev_scene) + ')');
   //control_edit_mode();
+  if (!scene_plan_valid) compile_scene_plans();
 
   // Read inst state and types:
   DEBUGMAIN("Checking INST changes");
@@ -1824,122 +1939,74 @@ FLASHMEM bool MD_GR55_class::load_scene(uint8_t prev_scene, uint8_t new_scene) {
   uint8_t prev_cosm_gtr_type, prev_cosm_bass_type;
   prev_cosm_gtr_type = read_scene_data(prev_scene, COSM_GTR_TYPE_ITEM);
   prev_cosm_bass_type = read_scene_data(prev_scene, COSM_BASS_TYPE_ITEM);
+  bool inst_changed;
+  if (!bass_mode) inst_changed = (COSM_gtr_type != prev_cosm_gtr_type);
+  else inst_changed = (COSM_bass_type != prev_cosm_bass_type);
 
   uint8_t index_new = get_scene_index(new_scene);
   uint8_t index_prev = get_scene_index(prev_scene);
+  const uint8_t *new_plan = scene_plan[new_scene - 1];
+  const uint8_t *prev_plan = scene_plan[(prev_scene > 0) ? prev_scene - 1 : 0]; // Scene 0 reads the data of scene 1, like get_scene_index()
 
   // Mute instruments
   mute_during_scene_change = check_mute_during_scene_change(new_scene);
   if (mute_during_scene_change) mute();
 
-  uint8_t addr_index = 0;
-  DEBUGMAIN("Checking INST to turn down of off");
-  uint8_t inst_type_index;
-  bool inst_changed;
-  if (!bass_mode) {
-    inst_type_index = COSM_gtr_type;
-    inst_changed = (COSM_gtr_type != prev_cosm_gtr_type);
-  }
-  else {
-    inst_type_index = COSM_bass_type + 4;
-    inst_changed = (COSM_bass_type != prev_cosm_bass_type);
-  }
-  for (uint8_t par = 0; par < GR55_NUMBER_OF_INST_PARAMETERS; par++) {
-    my_byte = (GR55_scene_inst_parameters[inst_type_index][par].Bit_address >> 4) + GR55_INST_DATA_OFFSET;
-    my_shift = GR55_scene_inst_parameters[inst_type_index][par].Bit_address & 0x0F;
-    my_mask = GR55_scene_inst_parameters[inst_type_index][par].Bit_mask << my_shift;
-
-    if (my_mask != 0) {
-      uint8_t new_data = GR55_patch_buffer[index_new + my_byte] & my_mask;
-      uint8_t old_data = GR55_patch_buffer[index_prev + my_byte] & my_mask;
-      if ((new_data < old_data) && (!inst_changed) && (!load_all_data)) {
-        uint32_t address = get_scene_inst_parameter_address(addr_index);
-        uint8_t data = new_data >> my_shift;
-        write_sysex(address, data);
-      }
+  DEBUGMAIN("Checking parameters to turn down or off");
+  Roland_scene_write_clear();
+  if (!load_all_data) {
+    for (uint8_t p = 0; p < GR55_NUMBER_OF_INST_PARAMETERS; p++) {
+      if (new_plan[p] == GR55_SCENE_PLAN_UNUSED) continue;
+      if ((new_plan[p] < prev_plan[p]) && (!inst_changed)) Roland_scene_write_add(get_scene_inst_parameter_address(p), new_plan[p]);
     }
-    addr_index++;
-  }
-
-  DEBUGMAIN("Checking common parameters to turn down or off");
-  for (uint8_t i = 0; i < GR55_NUMBER_OF_SCENE_PARAMETERS; i++) {
-    bool is_inst_sw = (i == PCM1_SW_ITEM) || (i == PCM2_SW_ITEM) || (i == COSM_GTR_SW_ITEM);
-    if ((!mute_during_scene_change) || (!is_inst_sw)) {
-      my_byte = GR55_scene_parameters[i].Bit_address >> 4;
-      my_shift = GR55_scene_parameters[i].Bit_address & 0x0F;
-      my_mask = GR55_scene_parameters[i].Bit_mask << my_shift;
-
-      if (my_mask != 0) {
-        uint8_t new_data = GR55_patch_buffer[index_new + my_byte] & my_mask;
-        uint8_t old_data = GR55_patch_buffer[index_prev + my_byte] & my_mask;
-        if ((new_data < old_data)  && (!load_all_data)) {
-          uint32_t address = get_scene_parameter_address(i);
-          uint8_t data = new_data >> my_shift;
-          if ((i == PCM1_OCTAVE_SHIFT) || (i == PCM2_OCTAVE_SHIFT)) data += 61; // Octave shift is sent as 61 - 67.
-          write_sysex(address, data);
-        }
-      }
+    for (uint8_t i = 0; i < GR55_NUMBER_OF_SCENE_PARAMETERS; i++) {
+      bool is_inst_sw = (i == PCM1_SW_ITEM) || (i == PCM2_SW_ITEM) || (i == COSM_GTR_SW_ITEM);
+      if ((mute_during_scene_change) && (is_inst_sw)) continue;
+      uint8_t p = GR55_NUMBER_OF_INST_PARAMETERS + i;
+      if (new_plan[p] == GR55_SCENE_PLAN_UNUSED) continue;
+      if (new_plan[p] < prev_plan[p]) Roland_scene_write_add(get_scene_parameter_address(i), scene_plan_data(i, new_plan[p]));
     }
-    addr_index++;
   }
+  Roland_scene_write_send();
+
+  DEBUGMAIN("Check scene assigns");
+  check_scene_assigns_with_new_state(GR55_patch_buffer[index_new + GR55_SCENE_ASSIGN_BYTE]);
+  scene_momentary_inst_state = GR55_patch_buffer[index_new + GR55_SCENE_MOMENTARY_BYTE] & 0x07;
+  last_loaded_scene = new_scene;
 
   DEBUGMAIN("Checking synth types");
+  // The synth types are sent with the parameters that are turned up, so they can be combined with the PCM mute switches
   uint16_t new_pcm1_type = (GR55_patch_buffer[index_new] << 2) + (GR55_patch_buffer[index_new + 1] & 3);
   uint16_t old_pcm1_type = (GR55_patch_buffer[index_prev] << 2) + (GR55_patch_buffer[index_prev + 1] & 3);
   DEBUGMSG("PCM1 old_type: " + String(old_pcm1_type) + ", new type: " + String(new_pcm1_type));
-  if (new_pcm1_type != old_pcm1_type) write_sysex(GR55_PCM1_TYPE, 0x58, (new_pcm1_type >> 7), (new_pcm1_type & 0x7F));
+  if (new_pcm1_type != old_pcm1_type) {
+    Roland_scene_write_add(GR55_PCM1_TYPE, 0x58);
+    Roland_scene_write_add(GR55_PCM1_TYPE + 1, new_pcm1_type >> 7);
+    Roland_scene_write_add(GR55_PCM1_TYPE + 2, new_pcm1_type & 0x7F);
+  }
 
   uint16_t new_pcm2_type = (GR55_patch_buffer[index_new + 2] << 2) + (GR55_patch_buffer[index_new + 3] & 3);
   uint16_t old_pcm2_type = (GR55_patch_buffer[index_prev + 2] << 2) + (GR55_patch_buffer[index_prev + 3] & 3);
   DEBUGMSG("PCM2 old_type: " + String(old_pcm2_type) + ", new type: " + String(new_pcm2_type));
-  if (new_pcm2_type != old_pcm2_type) write_sysex(GR55_PCM2_TYPE, 0x58, (new_pcm2_type >> 7), (new_pcm2_type & 0x7F));
-
-
-  DEBUGMAIN("Check scene assigns");
-  check_scene_assigns_with_new_state(GR55_patch_buffer[index_new + GR55_SCENE_ASSIGN_BYTE]);
-  scene_momentary_inst_state = GR55_patch_buffer[index_new + GR55_SCENE_MOMENTARY_BYTE] & 0x07;
-  last_loaded_scene = new_scene;
-
-  addr_index = 0;
-  DEBUGMAIN("Checking INST to turn up or on");
-  for (uint8_t par = 0; par < GR55_NUMBER_OF_INST_PARAMETERS; par++) {
-    my_byte = (GR55_scene_inst_parameters[inst_type_index][par].Bit_address >> 4) + GR55_INST_DATA_OFFSET;
-    my_shift = GR55_scene_inst_parameters[inst_type_index][par].Bit_address & 0x0F;
-    my_mask = GR55_scene_inst_parameters[inst_type_index][par].Bit_mask << my_shift;
-
-    if (my_mask != 0) {
-      uint8_t new_data = GR55_patch_buffer[index_new + my_byte] & my_mask;
-      uint8_t old_data = GR55_patch_buffer[index_prev + my_byte] & my_mask;
-      if ((new_data > old_data) || (inst_changed) || (load_all_data)) {
-        uint32_t address = get_scene_inst_parameter_address(addr_index);
-        uint8_t data = new_data >> my_shift;
-        write_sysex(address, data);
-      }
-    }
-    addr_index++;
+  if (new_pcm2_type != old_pcm2_type) {
+    Roland_scene_write_add(GR55_PCM2_TYPE, 0x58);
+    Roland_scene_write_add(GR55_PCM2_TYPE + 1, new_pcm2_type >> 7);
+    Roland_scene_write_add(GR55_PCM2_TYPE + 2, new_pcm2_type & 0x7F);
   }
 
-  DEBUGMAIN("Checking common parameters to turn up or on");
+  DEBUGMAIN("Checking parameters to turn up or on");
+  for (uint8_t p = 0; p < GR55_NUMBER_OF_INST_PARAMETERS; p++) {
+    if (new_plan[p] == GR55_SCENE_PLAN_UNUSED) continue;
+    if ((new_plan[p] > prev_plan[p]) || (inst_changed) || (load_all_data)) Roland_scene_write_add(get_scene_inst_parameter_address(p), new_plan[p]);
+  }
   for (uint8_t i = 0; i < GR55_NUMBER_OF_SCENE_PARAMETERS; i++) {
     bool is_inst_sw = (i == PCM1_SW_ITEM) || (i == PCM2_SW_ITEM) || (i == COSM_GTR_SW_ITEM);
-    if ((!mute_during_scene_change) || (!is_inst_sw)) {
-      my_byte = GR55_scene_parameters[i].Bit_address >> 4;
-      my_shift = GR55_scene_parameters[i].Bit_address & 0x0F;
-      my_mask = GR55_scene_parameters[i].Bit_mask << my_shift;
-
-      if (my_mask != 0) {
-        uint8_t new_data = GR55_patch_buffer[index_new + my_byte] & my_mask;
-        uint8_t old_data = GR55_patch_buffer[index_prev + my_byte] & my_mask;
-        if ((new_data > old_data) || (load_all_data)) {
-          uint32_t address = get_scene_parameter_address(i);
-          uint8_t data = new_data >> my_shift;
-          if ((i == PCM1_OCTAVE_SHIFT) || (i == PCM2_OCTAVE_SHIFT)) data += 61; // Octave shift is sent as 61 - 67.
-          write_sysex(address, data);
-        }
-      }
-    }
-    addr_index++;
+    if ((mute_during_scene_change) && (is_inst_sw)) continue;
+    uint8_t p = GR55_NUMBER_OF_INST_PARAMETERS + i;
+    if (new_plan[p] == GR55_SCENE_PLAN_UNUSED) continue;
+    if ((new_plan[p] > prev_plan[p]) || (load_all_data)) Roland_scene_write_add(get_scene_parameter_address(i), scene_plan_data(i, new_plan[p]));
   }
+  Roland_scene_write_send();
 
   // Unmute instruments
   if (mute_during_scene_change) unmute();
@@ -1948,6 +2015,11 @@ FLASHMEM bool MD_GR55_class::load_scene(uint8_t prev_scene, uint8_t new_scene) {
   return true;
 }
 
+FLASHMEM uint8_t MD_GR55_class::scene_plan_data(uint8_t parameter, uint8_t value) {
+  if ((parameter == PCM1_OCTAVE_SHIFT) || (parameter == PCM2_OCTAVE_SHIFT)) return value + 61; // Octave shift is sent as 61 - 67.
+  return value;
+}
+
 FLASHMEM uint8_t MD_GR55_class::get_scene_index(uint8_t scene) {
   if (scene > 0) scene--;
   return (scene * GR55_SCENE_SIZE) + GR55_COMMON_DATA_SIZE;
@@ -2155,6 +2227,7 @@ FLASHMEM void MD_GR55_class::read_scene_message(uint8_t number, uint8_t data) {
       for (uint8_t i = 0; i < GR55_SCENE_DATA_BUFFER_SIZE; i++) {
         GR55_patch_buffer[b++] = scene_data_buffer[i];
       }
+      scene_plan_valid = false;
       set_mute_during_scene_change(save_scene_number, mute_during_scene_change);
       set_scene_active(save_scene_number);
       update_page = RELOAD_PAGE;
@@ -2171,6 +2244,7 @@ FLASHMEM void MD_GR55_class::read_scene_message(uint8_t number, uint8_t data) {
     else { // Update scene differences and write them to all scenes
       if (last_loaded_scene == 0) return;
       check_delta_and_update_scenes();
+      scene_plan_valid = false;
       load_scene(0, last_loaded_scene);
       //store_patch(patch_number);
     }
@@ -2199,6 +2273,7 @@ FLASHMEM void MD_GR55_class::exchange_scene(uint8_t new_scene, uint8_t prev_scen
     index_new++;
     index_prev++;
   }
+  scene_plan_valid = false;
 
   if (new_scene_active) set_scene_active(prev_scene);
   else clear_scene_active(prev_scene);
@@ -2215,6 +2290,7 @@ FLASHMEM void MD_GR55_class::initialize_scene(uint8_t scene) {
   DEBUGMAIN("Initializing scene " + String(scene));
   uint8_t index = get_scene_index(scene);
   for (uint8_t i = 0; i < GR55_SCENE_DATA_BUFFER_SIZE + 8; i++) GR55_patch_buffer[index++] = 0;
+  scene_plan_valid = false;
 
   // Set default label
   scene_label_buffer[0] = '-';
@@ -2285,6 +2361,7 @@ FLASHMEM void MD_GR55_class::load_patch(uint16_t number) {
     initialize_patch_space();
     last_loaded_scene = 0;
   }
+  scene_plan_valid = false;
   current_snapscene = last_loaded_scene;
   uint8_t index = get_scene_index(current_snapscene);
   set_scene_assign_states(GR55_patch_buffer[index + GR55_SCENE_ASSIGN_BYTE]);
@@ -2294,6 +2371,11 @@ FLASHMEM void MD_GR55_class::load_patch(uint16_t number) {
   //MIDI_debug_sysex(GR55_patch_buffer, VC_PATCH_SIZE, 255, true); // Show contents of patch buffer
 }
 
+FLASHMEM uint16_t MD_GR55_class::setlist_song_get_vc_memory_patch(uint16_t item) {
+  if (bass_mode) item += GR55_BASS_MODE_NUMBER_OFFSET; // Same number as load_patch() reads
+  return item;
+}
+
 FLASHMEM bool MD_GR55_class::store_patch(uint16_t number) {
 
   if (bass_mode) number |= GR55_BASS_MODE_NUMBER_OFFSET;
@@ -2352,6 +2434,7 @@ FLASHMEM bool MD_GR55_class::initialize_patch(uint16_t number) {
 
 FLASHMEM void MD_GR55_class::initialize_patch_space() {
   memset(GR55_patch_buffer, 0, VC_PATCH_SIZE);
+  scene_plan_valid = false;
   scene_label_buffer[0] = '-';
   scene_label_buffer[1] = '-';
   for (uint8_t i = 2; i < 8; i++) scene_label_buffer[i] = ' ';
@@ -109,10 +109,6 @@ FLASHMEM void MD_HLX_class::init() { // Default values for variables
 FLASHMEM void MD_HLX_class::update() {
   if (!connected) return;
   looper_timer_check();
-  if (update_sequencer) { // Is triggered from the device_sequencer_timer_expired().
-    send_sequence_step_CC();
-    update_sequencer = false;
-  }
 }
 
 FLASHMEM uint8_t MD_HLX_class::get_number_of_dev_types() {
@@ -242,12 +238,12 @@ FLASHMEM void MD_HLX_class::do_after_connect() {
   current_exp_pedal = 2;
 }
 
-// ********************************* Section 3: HLX common MIDI out functions ********************************************
-
-FLASHMEM void MD_HLX_class::set_bpm() {
-  device_sequencer_update(number_of_sequence_steps, beat_divider);
+FLASHMEM void MD_HLX_class::do_after_disconnect() {
+  stop_sequence();
 }
 
+// ********************************* Section 3: HLX common MIDI out functions ********************************************
+
 FLASHMEM void MD_HLX_class::bpm_tap() {
   if (connected) {
     MIDI_send_CC(64, 127, MIDI_channel, MIDI_out_port); // Tap tempo on HLX
@@ -650,85 +646,32 @@ FLASHMEM bool MD_HLX_class::send_looper_cmd(uint8_t cmd) {
 // ********************************* Section 6: HLX special MIDI functions **********************************************
 
 // Function 1: MIDI sequencer
-// There are 32 patterns that can be stored in EEPROM. Furthermore there are some more patterns defined here
-
-// Every pattern consists of 36 bytes
-// Byte 01: The beat divider
-// Byte 02: The number of steps in this sequence
-// Byte 03: Spare
-// Byte 04: Spare
-// Byte 05 - 36: The steps of the sequence.
-
-const PROGMEM uint8_t HLX_sequencer_pattern[][36] = {
-  // First value is the beat divider for this pattern.
-  { 1, 24, 0, 0, 64, 80, 95, 108, 118, 125, 127, 125, 118, 108, 95, 80, 64, 47, 32, 19, 9, 2, 0, 2, 9, 19, 32, 47 },   // 33: Sine wave
-  { 1, 24, 0, 0, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },     // 34: Block wave
-  { 1, 24, 0, 0, 11, 21, 32, 42, 53, 64, 74, 85, 95, 106, 116, 127, 116, 106, 95, 85, 74, 64, 53, 42, 32, 21, 11, 0 }, // 35: Triangle wave
-  { 1, 24, 0, 0, 0, 6, 11, 17, 22, 28, 33, 39, 44, 50, 55, 61, 66, 72, 77, 83, 88, 94, 99, 105, 110, 116, 121, 127 },  // 36: Saw tooth
-  { 1, 24, 0, 0, 127, 127, 127, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },                       // 37: Single 8th beat
-  { 2, 24, 0, 0, 127, 127, 0, 32, 32, 0, 32, 0, 0, 127, 64, 0, 127, 127, 0, 32, 32, 0, 32, 32, 0, 32, 32, 0 },         // 38: Beat 1
-  { 4, 24, 0, 0, 127, 0, 0, 64, 0, 0, 64, 0, 0, 127, 127, 127, 127, 0, 0, 64, 0, 0, 64, 0, 0, 64, 0, 0 },              // 39: Beat 2
-  { 1, 24, 0, 0, 127, 127, 127, 127, 127, 127, 0, 0, 32, 32, 32, 32, 32, 32, 0, 0, 95, 95, 95, 95, 95, 95, 0, 0 },     // 40: Beat 3
-};                                                                                                           // 41: Random pattern
-
-#define HLX_NUMBER_OF_SEQUENCER_PATTERNS sizeof(HLX_sequencer_pattern) / sizeof(HLX_sequencer_pattern[0])
-
-#define PATTERN_EEPROM 254
-#define PATTERN_RANDOM 255
+// The sequencer runs on a lane of the modulation engine (in Devices.ino). The lane sends the steps to the CC of the sequencer.
+// The patterns are loaded by SCO_load_modulation_pattern(). Patterns 1 - 32 can be stored in EEPROM, then follow the fixed patterns and the random pattern.
+
+#define HLX_SEQUENCER_LANE 0
 
 FLASHMEM void MD_HLX_class::set_sequence(uint8_t pattern) {
   if (pattern == 0) { // Stop sequencer
-    current_sequence = 0;
-    number_of_sequence_steps = 0;
-  }
-
-  else if (pattern <= EXT_MAX_NUMBER_OF_SEQ_PATTERNS) { // Load from EEPROM
-    EEPROM_load_seq_pattern(pattern - 1, EEPROM_seq_pattern);
-    current_sequence = PATTERN_EEPROM;
-    beat_divider = EEPROM_seq_pattern[0];
-    number_of_sequence_steps = EEPROM_seq_pattern[1];
+    stop_sequence();
+    return;
   }
 
-  else if (pattern <= EXT_MAX_NUMBER_OF_SEQ_PATTERNS + HLX_NUMBER_OF_SEQUENCER_PATTERNS) { // Load HLX_sequence_pattern
-    current_sequence = pattern - EXT_MAX_NUMBER_OF_SEQ_PATTERNS;
-    beat_divider = HLX_sequencer_pattern[current_sequence - 1][0];
-    number_of_sequence_steps = HLX_sequencer_pattern[current_sequence - 1][1];
-  }
-
-  else { // Load ramdom pattern
-    current_sequence = PATTERN_RANDOM;
-    beat_divider = 12;
-    number_of_sequence_steps = 24;
-  }
-
-  device_sequencer_update(number_of_sequence_steps, beat_divider);
-  DEBUGMSG("current_sequence:" + String(current_sequence) + ", number_of_sequence_steps:" + String(number_of_sequence_steps) + ", beat_divider:" + String(beat_divider));
+  SCO_load_modulation_pattern(HLX_SEQUENCER_LANE, pattern);
+  MOD_set_target_CC(HLX_SEQUENCER_LANE, HLX_SET_SEQUENCER_PATTERN_CC, MIDI_channel, MIDI_out_port);
+  MOD_set_phase(HLX_SEQUENCER_LANE, 0);
+  MOD_set_range(HLX_SEQUENCER_LANE, 0, 127);
+  MOD_start(HLX_SEQUENCER_LANE);
+  DEBUGMSG("Sequencer pattern:" + String(pattern));
 }
 
 FLASHMEM void MD_HLX_class::set_sequence_beats(uint8_t beats) {
   if (beats == 0) return;
-  beat_divider = beats;
-  device_sequencer_update(number_of_sequence_steps, beat_divider);
+  MOD_set_rate(HLX_SEQUENCER_LANE, MOD_SYNC_TEMPO, beats);
 }
 
 FLASHMEM void MD_HLX_class::stop_sequence() {
-  current_sequence = 0;
-  beat_divider = 1;
-}
-
-FLASHMEM void MD_HLX_class::send_sequence_step_CC() {
-  uint8_t value;
-  if (current_sequence == 0) return;
-  if (current_sequence == PATTERN_EEPROM) value = EEPROM_seq_pattern[current_sequence_step + 4];
-  else if (current_sequence <= HLX_NUMBER_OF_SEQUENCER_PATTERNS) value = HLX_sequencer_pattern[current_sequence - 1][current_sequence_step + 4];
-  else if (current_sequence == PATTERN_RANDOM) value = generate_random_number();
-  else return;
-  if (value != previous_sequence_value) {
-    MIDI_send_CC(HLX_SET_SEQUENCER_PATTERN_CC, value, MIDI_channel, MIDI_out_port);
-    previous_sequence_value = value;
-  }
-  current_sequence_step++;
-  if (current_sequence_step >= number_of_sequence_steps) current_sequence_step = 0;
+  MOD_stop(HLX_SEQUENCER_LANE);
 }
 
 // ********************************* Section 7: HELIX MIDI forward messaging ********************************************
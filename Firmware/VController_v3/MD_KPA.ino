@@ -57,10 +57,23 @@
 #define KPA_BEACON_FLAG_NOCTR       0x10 // if set, the KPA will not send back the periodic KPA_PARAM_ACTIVE_SENSING_SIGNAL
 #define KPA_BEACON_FLAG_TUNEMODE    0x20 // if set, the Tuning information is only sent in Tuner Mode, otherwise it's being sent all the time
 
-/*uint8_t beaconFlags = KPA_BEACON_FLAG_INIT        // Send current state of the KPA on receiving beacon
-                      | KPA_BEACON_FLAG_SYSEX     // library works only with SysEx
-                      | KPA_BEACON_FLAG_TUNEMODE; // tuner will send only in tuner mode*/
-uint8_t beaconFlags = 0; //KPA_BEACON_FLAG_SYSEX; // Decided not to use the beacon method of the KPA as it interferes with the VController message requests to the KPA
+uint8_t beaconFlags = KPA_BEACON_FLAG_SYSEX     // library works only with SysEx
+                      | KPA_BEACON_FLAG_TUNEMODE; // tuner will send only in tuner mode
+
+// Bidirectional mode:
+// On connection the VController sends the beacon with KPA_BEACON_FLAG_INIT, so the KPA sends its current state. After that, the KPA sends every change by itself.
+// The beacon is renewed every KPA_BEACON_RENEW_TIME, before the time lease runs out.
+// The stomp types and states are kept in fx_type_mirror and fx_state_mirror. While the KPA sends its periodic active sensing signal (beacon_active),
+// request_parameter() reads the stomps from the mirror and does not send any requests. Otherwise the stomps are requested as before.
+// The same is done for the names in name_mirror: the rig name, the performance name and the five slot names.
+// request_current_patch_name() and the RIG UP/RIG DOWN switches in performance mode read them from the mirror.
+// When the rig or the performance changes, the mirror is cleared until the KPA has sent the new values.
+// As requested data and sent data arrive in the same messages, request_pending is set while a switch waits for its reply.
+// Only then a message is used for the switch on the page. Other messages only update the mirror.
+#define KPA_BEACON_SET 2
+#define KPA_BEACON_TIME_LEASE 127
+#define KPA_BEACON_RENEW_TIME 60000 // Renew the beacon every minute
+#define KPA_BEACON_TIMEOUT 10000 // Use polling again when no active sensing signal has been received for this time
 
 // To request the owner name of the rig send: F0 00 20 33 02 7F 06 00 00 00 06 15 09 00 00 00 00 00 F7
 // KPA will respond with: F0 00 20 33 00 00 07 00 00 00 0C 1A 41 4F 6E 6E 6F 20 47 65 65 72 6C 69  6E 67 00 F7
@@ -114,6 +127,7 @@ FLASHMEM void MD_KPA_class::init() { // Default values for variables
   current_mode = KPA_PERFORMANCE_MODE;
   max_looper_length = 30000000; // Normal stereo looper time is 30 seconds - time given in microseconds
   page_update_timer = 0;
+  clear_name_cache();
   last_read_rig_name.reserve(MAIN_LCD_DISPLAY_SIZE + 1);
   current_snapscene_label.reserve(MAIN_LCD_DISPLAY_SIZE + 1);
 
@@ -123,7 +137,9 @@ FLASHMEM void MD_KPA_class::init() { // Default values for variables
 }
 
 FLASHMEM void MD_KPA_class::update() {
+  name_cache_timer_check();
   if (!connected) return;
+  beacon_timer_check();
   page_update_timer_check();
   looper_timer_check();
 }
@@ -134,8 +150,16 @@ FLASHMEM void MD_KPA_class::check_SYSEX_in(const unsigned char* sxdata, short un
   // Check if it is a message from an KPA
   if ((sxdata[1] == 0x00) && (sxdata[2] == 0x20) && (sxdata[3] == 0x33) && (port == MIDI_in_port)) {
 
+    if (sxdata[6] == KPA_FUNCTION_SYS_COMMUNICATION) { // Active sensing signal of the bidirectional mode
+      if (!beacon_active) DEBUGMSG("KPA bidirectional mode active");
+      beacon_active = true;
+      beacon_data_timer = millis() + KPA_BEACON_TIMEOUT;
+    }
+
     if (sxdata[6] == KPA_FUNCTION_SINGLE_PARAMETER_CHANGE) {
       uint16_t address = (sxdata[8] << 8) + sxdata[9];
+      bool requested = ((request_pending) && (last_requested_sysex_type == REQUEST_PARAMETER_TYPE));
+      update_fx_mirror(address, (sxdata[10] << 7) + sxdata[11], requested);
 
       if (address == KPA_MODE_ADDRESS) {
         if (!connected) {
@@ -152,46 +176,38 @@ FLASHMEM void MD_KPA_class::check_SYSEX_in(const unsigned char* sxdata, short un
         }
       }
 
-      if (address == (last_requested_sysex_address & 0xFF00)) { // Effect type received
+      if ((requested) && (address == (last_requested_sysex_address & 0xFF00))) { // Effect type received
         read_FX_type(last_requested_sysex_switch, (sxdata[10] << 7) + sxdata[11]);
       }
 
-      if (address == last_requested_sysex_address)  { // Effect state received
+      if ((requested) && (address == last_requested_sysex_address))  { // Effect state received
         SP[last_requested_sysex_switch].State = (sxdata[11] == 0x01) ? 1 : 2;
+        request_pending = false;
         PAGE_request_next_switch();
       }
     }
     if (sxdata[6] == KPA_FUNCTION_STRING_PARAMETER_CHANGE) { //Rig Name passed as STRING_PARAMETER_CHANGE
       uint16_t address = (sxdata[8] << 8) + sxdata[9];
-      if ((current_mode == KPA_BROWSE_MODE) && (address == KPA_PARAM_RIG_NAME_ADDRESS)) {
-        current_patch_name = "";
+      if (address == KPA_PARAM_RIG_NAME_ADDRESS) {
+        String rname = "";
         bool end_reached = false;
         uint8_t patch_name_size = MAIN_LCD_DISPLAY_SIZE;
         if (patch_name_size > 24) patch_name_size = 24;
         for (uint8_t count = 10; count < (10 + patch_name_size); count++) {
           if (sxdata[count] == 0x00) end_reached = true;
-          if (!end_reached) current_patch_name += static_cast<char>(sxdata[count]); //Add ascii character or space to Patch Name String
-          else current_patch_name += ' ';
+          if (!end_reached) rname += static_cast<char>(sxdata[count]); //Add ascii character or space to rname
+          else rname += ' ';
         }
-        update_main_lcd = true;
-        if (popup_patch_name) {
-          if (LCD_check_popup_allowed(0)) LCD_show_popup_label(current_patch_name, ACTION_TIMER_LENGTH);
-          popup_patch_name = false;
+        bool complete = (sxdata[sxlength - 1] == 0xF7);
+        if (complete) {
+          name_mirror[KPA_NAME_MIRROR_RIG] = rname;
+          name_mirror_valid |= (1 << KPA_NAME_MIRROR_RIG);
         }
-        if ((ready_to_read_rig_name) && (patch_number != last_checked_rig_number) && (sxdata[sxlength - 1] == 0xF7)) {
-          if (current_patch_name != last_read_rig_name) {
-            check_write_performance_name(patch_number + KPA_RIG_BASE_NUMBER, current_patch_name);
-            last_checked_rig_number = patch_number;
-          }
-          else clear_performance_name(patch_number + KPA_RIG_BASE_NUMBER);
-          update_page = REFRESH_PATCH_BANK_ONLY;
-        }
-        last_read_rig_name = current_patch_name;
-        ready_to_read_rig_name = false;
+        if (current_mode == KPA_BROWSE_MODE) show_rig_name(rname, complete);
       }
     }
     if (sxdata[6] == KPA_FUNCTION_EXTENDED_STRING_PARAMETER_CHANGE) { // Check for performance/slot name passed as EXTENDED_STRING_PARAMETER_CHANGE
-      if ((current_mode == KPA_PERFORMANCE_MODE) && (sxdata[8] == 0) && (sxdata[9] == 0) && (sxdata[10] == 1) && (sxdata[11] == 0)) {
+      if ((sxdata[8] == 0) && (sxdata[9] == 0) && (sxdata[10] == 1) && (sxdata[11] == 0)) {
         // Read name
         String pname = "";
         if (sxlength > 14) { // Return data contains name
@@ -208,20 +224,20 @@ FLASHMEM void MD_KPA_class::check_SYSEX_in(const unsigned char* sxdata, short un
           pname = "--";
         }
         DEBUGMSG(pname);
-        if (sxdata[12] == 0) { // Read performance name
-          if ((patch_number == performance_on_kpa) && (sxdata[sxlength - 1] == 0xF7)) {
-            current_patch_name = pname;
-            check_write_performance_name(patch_number, pname);
-            update_main_lcd = true;
-          }
+        bool complete = (sxdata[sxlength - 1] == 0xF7);
+        if ((complete) && (sxdata[12] < KPA_NAME_MIRROR_RIG)) {
+          name_mirror[sxdata[12]] = pname;
+          name_mirror_valid |= (1 << sxdata[12]);
         }
-        else if ((last_requested_sysex_type == REQUEST_PATCH_NAME) && (sxdata[12] == last_requested_sysex_address)) { // Read performance slot name
-          // If name is "Çrunch"'or "SLOT"'then slot is empty!
-          if (((pname.trim() == "Crunch") && (last_requested_sysex_address > 1)) || (pname.trim() == "Slot")) pname = "--";
-          LCD_set_SP_label(last_requested_sysex_switch, pname);
-          update_main_lcd = true;
-          if ((current_snapscene == SP[last_requested_sysex_switch].State) && (current_snapscene > 0)) current_snapscene_label = pname;
-          PAGE_request_next_switch();
+        if (current_mode == KPA_PERFORMANCE_MODE) {
+          if (sxdata[12] == 0) { // Read performance name
+            if (complete) show_performance_name(pname);
+          }
+          else if ((request_pending) && (last_requested_sysex_type == REQUEST_PATCH_NAME) && (sxdata[12] == last_requested_sysex_address)) { // Read performance slot name
+            show_slot_name(last_requested_sysex_switch, last_requested_sysex_address, pname);
+            request_pending = false;
+            PAGE_request_next_switch();
+          }
         }
       }
     }
@@ -233,6 +249,8 @@ FLASHMEM void MD_KPA_class::check_PC_in(uint8_t program, uint8_t channel, uint8_
   // Check the source by checking the channel
   if ((port == MIDI_in_port) && (channel == MIDI_channel)) { // KPA sends a program change
     if (patch_number != program) {
+      fx_mirror_valid = 0; // The KPA will send the stomps of the new rig
+      name_mirror_valid = 0; // and the names
       set_patch_number(program);
       //page_check();
       do_after_patch_selection();
@@ -244,6 +262,9 @@ FLASHMEM void MD_KPA_class::check_PC_in(uint8_t program, uint8_t channel, uint8_
 FLASHMEM void MD_KPA_class::check_CC_in(uint8_t control, uint8_t value, uint8_t channel, uint8_t port) {
   if (!connected) return;
   if ((port == MIDI_in_port) && (channel == MIDI_channel)) {
+    if ((control >= 47) && (control <= 54)) fx_mirror_valid = 0; // The KPA will send the stomps of the new rig
+    if ((control >= 47) && (control <= 49)) name_mirror_valid = 0; // The KPA will send the names of the new performance
+    if ((control >= 50) && (control <= 54)) name_mirror_valid &= ~(1 << KPA_NAME_MIRROR_RIG); // The KPA will send the name of the new rig
     switch (control) {
       /*case 47:
         if (millis() > pc_change_timeout) {
@@ -321,6 +342,7 @@ FLASHMEM void MD_KPA_class::check_active_sense_in(uint8_t port) {
 FLASHMEM void MD_KPA_class::send_alternative_identity_request(uint8_t check_device_no) {
   if (start_KPA_detection) {
     if ((connected) && (MIDI_out_port != Current_MIDI_out_port)) return; // Do not send data to other MIDI ports after connection has been made
+    if ((connected) && (beacon_active)) return; // Mode changes are sent by the KPA in bidirectional mode
     //request_owner_name();
     // We keep requesting the mode, so a mode change on the KPA is also detected
     uint8_t sysexmessage[11] = {0xF0, 0x00, 0x20, 0x33, 0x02, 0x7F, KPA_FUNCTION_REQUEST_SINGLE_PARAMETER_VALUE, 0x00, (uint8_t) (KPA_MODE_ADDRESS >> 8), (uint8_t) (KPA_MODE_ADDRESS & 0x7F), 0xF7};
@@ -336,8 +358,12 @@ FLASHMEM void MD_KPA_class::do_after_connect() {
   current_performance = 255;
   char floorboard_name[] = VC_NAME;
   write_sysex_string(KPA_PARAM_FLOORBOARD_NAME_ADDRESS, floorboard_name);
-  send_beacon(0, 0, 127); // We are not using the beacon messages of the KPA, as it interferes with the info requests of the VController
-  //send_beacon(2, beaconFlags, 127); // So changes on the KPA will be communicated through sysex messages.
+  beacon_active = false;
+  request_pending = false;
+  fx_mirror_valid = 0;
+  name_mirror_valid = 0;
+  send_beacon(KPA_BEACON_SET, beaconFlags | KPA_BEACON_FLAG_INIT, KPA_BEACON_TIME_LEASE); // So changes on the KPA will be communicated through sysex messages.
+  beacon_timer = millis() + KPA_BEACON_RENEW_TIME;
   DEBUGMAIN("Request tempo:");
   request_single_parameter(KPA_RIG_TEMPO_ADDRESS);
 }
@@ -368,6 +394,17 @@ FLASHMEM void MD_KPA_class::send_beacon(uint8_t setNum, uint8_t flags, uint8_t t
   MIDI_send_sysex(sysexmessage, 13, MIDI_out_port);
 }
 
+FLASHMEM void MD_KPA_class::beacon_timer_check() {
+  if ((beacon_active) && (millis() > beacon_data_timer)) {
+    beacon_active = false; // KPA has stopped sending - request the data again
+    DEBUGMSG("KPA bidirectional mode stopped");
+  }
+  if (millis() > beacon_timer) {
+    send_beacon(KPA_BEACON_SET, beaconFlags, KPA_BEACON_TIME_LEASE); // Renew the time lease
+    beacon_timer = millis() + KPA_BEACON_RENEW_TIME;
+  }
+}
+
 FLASHMEM void MD_KPA_class::request_single_parameter(uint16_t address) {
   uint8_t sysexmessage[11] = {0xF0, 0x00, 0x20, 0x33, 0x02, 0x7F, KPA_FUNCTION_REQUEST_SINGLE_PARAMETER_VALUE, 0x00, (uint8_t) (address >> 8), (uint8_t) (address & 0x7F), 0xF7};
   check_sysex_delay();
@@ -396,7 +433,7 @@ FLASHMEM void MD_KPA_class::request_owner_name() {
 
 FLASHMEM void MD_KPA_class::set_bpm() {
   if (connected) {
-    write_sysex(KPA_RIG_TEMPO_ADDRESS, Setting.Bpm * 64);
+    write_sysex(KPA_RIG_TEMPO_ADDRESS, ((SCO_get_bpm_x10() * 64) + 5) / 10); // Kemper tempo is in 1/64 bpm
   }
 }
 
@@ -446,6 +483,9 @@ FLASHMEM void MD_KPA_class::switch_mode(uint8_t mode) {
 FLASHMEM void MD_KPA_class::select_patch(uint16_t new_patch) {
   prev_patch_number = patch_number;
   patch_number = new_patch;
+  fx_mirror_valid = 0; // The KPA will send the stomps of the new rig
+  name_mirror_valid = 0; // and the names
+  patch_name_received = false;
   if (current_mode == KPA_BROWSE_MODE) {
     browse_rig_number = new_patch;
     MIDI_send_CC(32, new_patch >> 7, MIDI_channel, MIDI_out_port);
@@ -534,31 +574,82 @@ FLASHMEM void MD_KPA_class::page_update_timer_check() {
   if (page_update_timer == 0) return;
   if (millis() > page_update_timer) {
     page_update_timer = 0;
-    request_current_patch_name();
+    if (!patch_name_received) request_current_patch_name(); // In bidirectional mode, the KPA has sent the name already
     do_after_patch_selection();
     update_page = REFRESH_PAGE;
   }
 }
 
-FLASHMEM void MD_KPA_class::check_write_performance_name(uint16_t number, String pname) {
-  String old_name;
-  uint16_t buffer_number = (number / 8) + 1;
-  bool found = read_performance_name(number, old_name);
+// Performance name cache
+// The names of performances and rigs are stored in the VController patch memory, eight names per patch (name page).
+// The last KPA_NAME_CACHE_PAGES name pages that were used are kept in name_cache. When another page is needed, the least recently used page is replaced.
+// Changed pages are written back to EEPROM when they are replaced or KPA_NAME_CACHE_WRITE_BACK_TIME after the last change.
 
-  if (!found) { // initialize KPA_name_buffer
-    for (uint8_t i = 0; i < VC_PATCH_SIZE; i++) KPA_name_buffer[i] = ' ';
-    current_buffer_number = buffer_number;
+FLASHMEM uint8_t MD_KPA_class::get_name_page(uint16_t page_number, bool create) { // Returns the cache slot of the page or NOT_FOUND
+  name_cache_use_counter++;
+  uint8_t lru_slot = 0;
+  for (uint8_t s = 0; s < KPA_NAME_CACHE_PAGES; s++) {
+    if (name_cache_page[s] == page_number) {
+      name_cache_last_used[s] = name_cache_use_counter;
+      name_cache_hits++;
+      return s;
+    }
+    if (name_cache_last_used[s] < name_cache_last_used[lru_slot]) lru_slot = s;
   }
 
+  uint16_t index = EEPROM_find_patch_data_index(my_device_number + 1, page_number);
+  if ((index == PATCH_INDEX_NOT_FOUND) && (!create)) return NOT_FOUND; // Page is not stored - keep the cached pages
+
+  name_cache_misses++;
+  DEBUGMSG("KPA name cache miss for page " + String(page_number) + " - hit rate " + String(name_cache_hits * 100 / (name_cache_hits + name_cache_misses)) + '%');
+  write_back_name_page(lru_slot);
+  if (index != PATCH_INDEX_NOT_FOUND) EEPROM_load_device_patch_by_index(index, name_cache[lru_slot], VC_PATCH_SIZE);
+  else {
+    for (uint8_t i = 0; i < VC_PATCH_SIZE; i++) name_cache[lru_slot][i] = ' '; // initialize name page
+  }
+  name_cache_page[lru_slot] = page_number;
+  name_cache_last_used[lru_slot] = name_cache_use_counter;
+  return lru_slot;
+}
+
+FLASHMEM void MD_KPA_class::write_back_name_page(uint8_t slot) {
+  if (!name_cache_dirty[slot]) return;
+  EEPROM_save_device_patch(my_device_number + 1, name_cache_page[slot], name_cache[slot], VC_PATCH_SIZE);
+  name_cache_dirty[slot] = false;
+}
+
+FLASHMEM void MD_KPA_class::name_cache_timer_check() {
+  if (name_cache_write_back_timer == 0) return;
+  if (millis() > name_cache_write_back_timer) {
+    name_cache_write_back_timer = 0;
+    for (uint8_t s = 0; s < KPA_NAME_CACHE_PAGES; s++) write_back_name_page(s);
+  }
+}
+
+FLASHMEM void MD_KPA_class::clear_name_cache() {
+  for (uint8_t s = 0; s < KPA_NAME_CACHE_PAGES; s++) {
+    name_cache_page[s] = 0;
+    name_cache_last_used[s] = 0;
+    name_cache_dirty[s] = false;
+  }
+  name_cache_write_back_timer = 0;
+}
+
+FLASHMEM void MD_KPA_class::check_write_performance_name(uint16_t number, String pname) {
+  String old_name;
+  read_performance_name(number, old_name);
+
   if (pname != old_name) {
+    uint8_t slot = get_name_page((number / 8) + 1, true);
     uint8_t name_index = (number % 8) * 22 + 16;
     uint8_t max_index = MAIN_LCD_DISPLAY_SIZE;
     if (max_index > 22) max_index = 22;
     for (uint8_t i = 0; i < max_index; i++) {
-      KPA_name_buffer[name_index++] = (uint8_t) pname[i];
+      name_cache[slot][name_index++] = (uint8_t) pname[i];
     }
-    //Serial.println("Wrote:" + pname + " with patch number " + String(number) + ", bufnumber " + String(buffer_number) + " and index " + String(name_index - max_index));
-    EEPROM_save_device_patch(my_device_number + 1, buffer_number, KPA_name_buffer, VC_PATCH_SIZE);
+    //Serial.println("Wrote:" + pname + " with patch number " + String(number) + ", page " + String(name_cache_page[slot]) + " and index " + String(name_index - max_index));
+    name_cache_dirty[slot] = true;
+    name_cache_write_back_timer = millis() + KPA_NAME_CACHE_WRITE_BACK_TIME;
   }
 }
 
@@ -569,30 +660,22 @@ FLASHMEM void MD_KPA_class::clear_performance_name(uint16_t number) {
 }
 
 FLASHMEM bool MD_KPA_class::read_performance_name(uint16_t number, String &pname) {
-  uint16_t new_buffer_number = (number / 8) + 1;
-  if (current_buffer_number != new_buffer_number) {
-    //Serial.println("Loading buffer " + String(new_buffer_number));
-    bool loaded = EEPROM_load_device_patch(my_device_number + 1, new_buffer_number, KPA_name_buffer, VC_PATCH_SIZE);
-    if (loaded) current_buffer_number = new_buffer_number;
-    else {
-      //Serial.println("Buffer not loaded");
-      return false;
-    }
-  }
+  uint8_t slot = get_name_page((number / 8) + 1, false);
+  if (slot == NOT_FOUND) return false;
 
   uint8_t name_index = (number % 8) * 22 + 16;
   pname = "";
   uint8_t max_index = MAIN_LCD_DISPLAY_SIZE;
   if (max_index > 22) max_index = 22;
   for (uint8_t i = 0; i < max_index; i++) {
-    pname += (char) KPA_name_buffer[name_index++];
+    pname += (char) name_cache[slot][name_index++];
   }
-  //Serial.println("Read:" + pname + " with patch number " + String(number) + ", bufnumber " + String(new_buffer_number) + " and index " + String(name_index - max_index));
+  //Serial.println("Read:" + pname + " with patch number " + String(number) + ", page " + String(name_cache_page[slot]) + " and index " + String(name_index - max_index));
   return true;
 }
 
 FLASHMEM void MD_KPA_class::check_after_editor_patch_dump() {
-  current_buffer_number = 0; // Will trigger a reread of the buffer
+  clear_name_cache(); // Will trigger a reread of the name pages
   performance_on_kpa = 255;
   ready_to_read_rig_name = false;
   last_read_rig_name = "";
@@ -689,14 +772,57 @@ FLASHMEM void MD_KPA_class::do_after_patch_selection() {
     set_bpm();
   }
   Current_patch_number = patch_number;
+  request_pending = false;
   update_LEDS = true;
   update_main_lcd = true;
   MD_base_class::do_after_patch_selection();
 }
 
 FLASHMEM void MD_KPA_class::request_current_patch_name() {
-  if (current_mode == KPA_BROWSE_MODE) request_current_rig_name();
-  if (current_mode == KPA_PERFORMANCE_MODE) request_performance_name(0); // Request performance name
+  if (current_mode == KPA_BROWSE_MODE) {
+    if ((beacon_active) && (name_mirror_valid & (1 << KPA_NAME_MIRROR_RIG))) show_rig_name(name_mirror[KPA_NAME_MIRROR_RIG], true); // Read from the mirror
+    else request_current_rig_name();
+  }
+  if (current_mode == KPA_PERFORMANCE_MODE) {
+    if ((beacon_active) && (name_mirror_valid & (1 << KPA_NAME_MIRROR_PERFORMANCE))) show_performance_name(name_mirror[KPA_NAME_MIRROR_PERFORMANCE]); // Read from the mirror
+    else request_performance_name(0); // Request performance name
+  }
+}
+
+FLASHMEM void MD_KPA_class::show_rig_name(String rname, bool complete) { // Called in browse mode when the rig name has been received or read from the mirror
+  current_patch_name = rname;
+  update_main_lcd = true;
+  patch_name_received = true;
+  if (popup_patch_name) {
+    if (LCD_check_popup_allowed(0)) LCD_show_popup_label(current_patch_name, ACTION_TIMER_LENGTH);
+    popup_patch_name = false;
+  }
+  if ((ready_to_read_rig_name) && (patch_number != last_checked_rig_number) && (complete)) {
+    if (current_patch_name != last_read_rig_name) {
+      check_write_performance_name(patch_number + KPA_RIG_BASE_NUMBER, current_patch_name);
+      last_checked_rig_number = patch_number;
+    }
+    else clear_performance_name(patch_number + KPA_RIG_BASE_NUMBER);
+    update_page = REFRESH_PATCH_BANK_ONLY;
+  }
+  last_read_rig_name = current_patch_name;
+  ready_to_read_rig_name = false;
+}
+
+FLASHMEM void MD_KPA_class::show_performance_name(String pname) {
+  if (patch_number != performance_on_kpa) return;
+  current_patch_name = pname;
+  check_write_performance_name(patch_number, pname);
+  update_main_lcd = true;
+  patch_name_received = true;
+}
+
+FLASHMEM void MD_KPA_class::show_slot_name(uint8_t sw, uint8_t slot, String pname) {
+  // If name is "Çrunch"'or "SLOT"'then slot is empty!
+  if (((pname.trim() == "Crunch") && (slot > 1)) || (pname.trim() == "Slot")) pname = "--";
+  LCD_set_SP_label(sw, pname);
+  update_main_lcd = true;
+  if ((current_snapscene == SP[sw].State) && (current_snapscene > 0)) current_snapscene_label = pname;
 }
 
 const PROGMEM char KPA_number[5][4] = { "1st", "2nd", "3rd", "4th", "5th" };
@@ -752,7 +878,6 @@ const PROGMEM KPA_CC_type_struct KPA_CC_types[] = {
 };
 
 const uint16_t KPA_NUMBER_OF_PARAMETERS = sizeof(KPA_CC_types) / sizeof(KPA_CC_types[0]);
-#define KPA_NUMBER_OF_FX_SLOTS 8
 
 #define KPA_STOMP_DLY 6
 #define KPA_STOMP_RVB 7
@@ -898,6 +1023,29 @@ FLASHMEM void MD_KPA_class::set_FX_state(uint8_t index, bool state) {
   effect_state[index] = (state == 0) ? 2 : 1; // Set state to 2 if state is zero and to 1 if state is not zero
 }
 
+FLASHMEM void MD_KPA_class::update_fx_mirror(uint16_t address, uint16_t value, bool requested) { // Called for every parameter received from the KPA
+  for (uint8_t slot = 0; slot < KPA_NUMBER_OF_FX_SLOTS; slot++) {
+    uint16_t state_address = KPA_CC_types[slot].Address;
+    uint16_t type_bit = 1 << slot;
+    uint16_t state_bit = 1 << (slot + 8);
+    bool changed = false;
+    if (address == (state_address & 0xFF00)) { // Stomp type
+      changed = ((fx_mirror_valid & type_bit) && (fx_type_mirror[slot] != value));
+      fx_type_mirror[slot] = value;
+      fx_mirror_valid |= type_bit;
+    }
+    else if (address == state_address) { // Stomp state
+      uint8_t state = (value == 0x01) ? 1 : 2;
+      changed = ((fx_mirror_valid & state_bit) && (fx_state_mirror[slot] != state));
+      fx_state_mirror[slot] = state;
+      fx_mirror_valid |= state_bit;
+    }
+    else continue;
+    if ((changed) && (!requested)) update_page = REFRESH_FX_ONLY; // Stomp was changed on the KPA
+    return;
+  }
+}
+
 FLASHMEM void MD_KPA_class::set_mode(uint8_t mode) {
   write_sysex(KPA_CC_types[KPA_MODE].Address, mode);
   switch_mode (mode);
@@ -957,8 +1105,16 @@ FLASHMEM void MD_KPA_class::read_parameter_title(uint16_t number, String & Outpu
 
 FLASHMEM bool MD_KPA_class::request_parameter(uint8_t sw, uint16_t number) {
   if ((can_request_sysex_data()) && (number < KPA_NUMBER_OF_FX_SLOTS)) {
+    uint16_t mirror_bits = (1 << number) | (1 << (number + 8));
+    if ((beacon_active) && ((fx_mirror_valid & mirror_bits) == mirror_bits)) { // Read stomp from the mirror
+      read_FX_type(sw, fx_type_mirror[number]);
+      SP[sw].State = fx_state_mirror[number];
+      return true;
+    }
+    last_requested_sysex_type = REQUEST_PARAMETER_TYPE;
     last_requested_sysex_address = KPA_CC_types[number].Address;
     last_requested_sysex_switch = sw;
+    request_pending = true;
     request_single_parameter(KPA_CC_types[number].Address & 0xFF00); // Request type
     request_single_parameter(KPA_CC_types[number].Address); // Request state
     return false;
@@ -967,9 +1123,14 @@ FLASHMEM bool MD_KPA_class::request_parameter(uint8_t sw, uint16_t number) {
     uint8_t s = current_snapscene;
     if (s > 5) s -= 5; // Check we are not in morph
     if (s > 1) {
+      if ((beacon_active) && (name_mirror_valid & (1 << (s - 1)))) { // Read slot name from the mirror
+        show_slot_name(sw, s - 1, name_mirror[s - 1]);
+        return true;
+      }
       last_requested_sysex_type = REQUEST_PATCH_NAME;
       last_requested_sysex_address = s - 1;
       last_requested_sysex_switch = sw;
+      request_pending = true;
       request_performance_name(last_requested_sysex_address);
       return false;
     }
@@ -982,9 +1143,14 @@ FLASHMEM bool MD_KPA_class::request_parameter(uint8_t sw, uint16_t number) {
     uint8_t s = current_snapscene;
     if (s > 5) s -= 5; // Check we are not in morph
     if (s < 5) {
+      if ((beacon_active) && (name_mirror_valid & (1 << (s + 1)))) { // Read slot name from the mirror
+        show_slot_name(sw, s + 1, name_mirror[s + 1]);
+        return true;
+      }
       last_requested_sysex_type = REQUEST_PATCH_NAME;
       last_requested_sysex_address = s + 1;
       last_requested_sysex_switch = sw;
+      request_pending = true;
       request_performance_name(last_requested_sysex_address);
       return false;
     }
@@ -1016,6 +1182,10 @@ FLASHMEM bool MD_KPA_class::request_parameter(uint8_t sw, uint16_t number) {
   }
 }
 
+FLASHMEM void MD_KPA_class::cancel_pending_request() { // Called on page (re)load and when the sysex watchdog expires
+  request_pending = false; // So a later pushed message is not taken for the reply
+}
+
 FLASHMEM void MD_KPA_class::read_FX_type(uint8_t sw, uint8_t type) {
   if (type == 0) { // No effect in slot
     String msg = "--";
@@ -1142,6 +1312,7 @@ FLASHMEM bool MD_KPA_class::request_snapscene_name(uint8_t sw, uint8_t sw1, uint
       last_requested_sysex_type = REQUEST_PATCH_NAME;
       last_requested_sysex_address = (SP[sw].PP_number - 1) % 5 + 1;
       last_requested_sysex_switch = sw;
+      request_pending = true;
       request_performance_name(last_requested_sysex_address);
       return false;
     }
@@ -1169,6 +1340,10 @@ FLASHMEM void MD_KPA_class::set_snapscene(uint8_t sw, uint8_t number) {
   send_morph_message = false;
   if (number > 5) send_morph_message = true;
   if ((current_snapscene - number) == 5)  send_morph_message = true;
+  if (number != current_snapscene) {
+    fx_mirror_valid = 0; // The KPA will send the stomps of the new rig
+    name_mirror_valid &= ~(1 << KPA_NAME_MIRROR_RIG); // and its name
+  }
   current_snapscene = number;
   if (current_snapscene <= 5) {
     uint8_t cc = current_snapscene + 49; // cc50-54 - used both in browse and performance mode
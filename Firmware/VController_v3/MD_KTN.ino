@@ -71,6 +71,7 @@
 #define KTN_READ_MIDI_TIMER_LENGTH 1000
 
 #define KTN_DEFAULT_MIDI_DELAY 5
+#define KTN_MAX_SYSEX_BLOCK_SIZE 32 // The Katana takes longer DT1 messages than the Roland default. This fits the FX chain (20 bytes) and any effect block in one message.
 
 // Called at startup of VController
 FLASHMEM void MD_KTN_class::init() { // Default values for variables
@@ -113,6 +114,7 @@ FLASHMEM void MD_KTN_class::init() { // Default values for variables
   count_parameter_categories();
   midi_timer = 0;
   current_global_eq_type = 0;
+  clear_shadow();
 
 #ifdef IS_VCTOUCH
   device_pic = img_KTN;
@@ -153,6 +155,7 @@ FLASHMEM void MD_KTN_class::check_SYSEX_in(const unsigned char* sxdata, short un
     uint16_t sum = 0;
     for (uint8_t i = 8; i < sxlength - 2; i++) sum += sxdata[i];
     bool checksum_ok = (sxdata[sxlength - 2] == calc_Roland_checksum(sum));
+    if ((checksum_ok) && (sxlength > 14)) update_shadow(address, &sxdata[12], sxlength - 14);
 
     if ((!is_mk2) && (checksum_ok)) {
       switch (address) {
@@ -271,6 +274,7 @@ FLASHMEM void MD_KTN_class::check_SYSEX_in(const unsigned char* sxdata, short un
     }
 
     if ((address == KTN_CURRENT_PATCH_NUMBER_ADDRESS) && (checksum_ok)) { // check if we are reading the current patch number
+      clear_shadow(); // The Katana has loaded a channel, so its temporary patch no longer matches the last recalled patch
       if (patch_number < 10) { // Check if we are not already on a VController patch
         set_patch_number(sxdata[13]);
         prev_patch_number = patch_number;
@@ -314,9 +318,11 @@ FLASHMEM void MD_KTN_class::forward_MIDI_message(const unsigned char* sxdata, sh
     editor_connected = true;
     check_sysex_delay();
     MIDI_send_sysex(sxdata, sxlength, MIDI_out_port);
+    if ((sxdata[7] == 0x12) && (sxlength > 14)) update_shadow((sxdata[8] << 24) + (sxdata[9] << 16) + (sxdata[10] << 8) + sxdata[11], &sxdata[12], sxlength - 14);
 
     // Pull out the patch number
     if ((sxdata[7] == 0x12) && (sxdata[8] == 0x10) && (sxdata[10] == 0x00) && (sxdata[11] == 0x00)) {
+      clear_shadow();
       if (sxdata[9] < 8) {
         set_patch_number(sxdata[9]);
         do_after_patch_selection();
@@ -334,6 +340,7 @@ FLASHMEM void MD_KTN_class::check_PC_in(uint8_t program, uint8_t channel, uint8_
     if (program == 4) new_patch_number = 0; // Panel
     else if (program < 4) new_patch_number = program + 1; // CH1 - CH4
     else new_patch_number = program; // CH5 - CH8
+    clear_shadow(); // The Katana has loaded a channel
     if (patch_number != new_patch_number) {
       set_patch_number(new_patch_number);
       request_current_patch_name();
@@ -346,6 +353,7 @@ FLASHMEM void MD_KTN_class::check_PC_in(uint8_t program, uint8_t channel, uint8_
 FLASHMEM void MD_KTN_class::forward_PC_message(uint8_t program, uint8_t channel) { // Forward PC messages from editor to Katana
   if ((connected)  && (channel == MIDI_channel)) { // Editor sends a program change to the Katanan
     MIDI_send_PC(program, MIDI_channel, MIDI_out_port); // Forward the message to the Katana
+    clear_shadow();
 
     // Update the patch number on the VController as well
     uint8_t new_patch_number = 0;
@@ -390,6 +398,7 @@ FLASHMEM void MD_KTN_class::respond_to_identity_request_of_editor() {
 }
 
 FLASHMEM void MD_KTN_class::do_after_connect() {
+  clear_shadow();
   write_sysex(KTN_EDITOR_MODE_ON); // Put the KTN in EDITOR mode - otherwise patch number request will not work
   request_sysex(KTN_VERSION_REQUEST, 1);
   request_sysex(KTN_CURRENT_PATCH_NUMBER_ADDRESS, 2);
@@ -428,6 +437,7 @@ FLASHMEM void MD_KTN_class::write_sysex(uint32_t address, uint8_t value) { // Fo
   check_sysex_delay();
   MIDI_send_sysex(sysexmessage, 15, MIDI_out_port, 1);
   if (editor_connected) MIDI_send_sysex(sysexmessage, 15, USBMIDI_PORT); // Forward message to BTS
+  update_shadow(address, &sysexmessage[12], 1);
 }
 
 FLASHMEM void MD_KTN_class::write_sysex(uint32_t address, uint8_t value1, uint8_t value2) { // For sending two data bytes
@@ -438,6 +448,7 @@ FLASHMEM void MD_KTN_class::write_sysex(uint32_t address, uint8_t value1, uint8_
   check_sysex_delay();
   MIDI_send_sysex(sysexmessage, 16, MIDI_out_port, 1);
   if (editor_connected) MIDI_send_sysex(sysexmessage, 16, USBMIDI_PORT); // Forward message to BTS
+  update_shadow(address, &sysexmessage[12], 2);
 }
 
 FLASHMEM void MD_KTN_class::request_sysex(uint32_t address, uint8_t no_of_bytes) {
@@ -450,23 +461,30 @@ FLASHMEM void MD_KTN_class::request_sysex(uint32_t address, uint8_t no_of_bytes)
   MIDI_send_sysex(sysexmessage, 18, MIDI_out_port, 1);
 }
 
-FLASHMEM void MD_KTN_class::write_patch_data(uint32_t address, uint8_t index, uint8_t len) {
+FLASHMEM void MD_KTN_class::write_sysex_block(uint32_t address, uint8_t *data, uint8_t len) { // Used by Roland_scene_write_send() on patch recall
   uint8_t *ad = (uint8_t*)&address; //Split the 32-bit address into four bytes: ad[3], ad[2], ad[1] and ad[0]
   uint16_t checksum = ad[3] + ad[2] + ad[1] + ad[0];
-  uint8_t sysexmessage[35] = {0xF0, 0x41, MIDI_device_id, 0x00, 0x00, 0x00, 0x33, 0x12, ad[3], ad[2], ad[1], ad[0]}; // Longest message is 34 bytes
+  uint8_t messagesize = len + 14;
+  uint8_t sysexmessage[messagesize] = {0xF0, 0x41, MIDI_device_id, 0x00, 0x00, 0x00, 0x33, 0x12, ad[3], ad[2], ad[1], ad[0]};
   for (uint8_t i = 0; i < len; i++) {
-    sysexmessage[i + 12] = KTN_patch_buffer[index + i];
-    checksum += KTN_patch_buffer[index + i];
+    sysexmessage[i + 12] = data[i];
+    checksum += data[i];
   }
-  sysexmessage[len + 12] = calc_Roland_checksum(checksum);
-  sysexmessage[len + 13] = 0xF7;
+  sysexmessage[messagesize - 2] = calc_Roland_checksum(checksum);
+  sysexmessage[messagesize - 1] = 0xF7;
   check_sysex_delay();
-  MIDI_send_sysex(sysexmessage, len + 14, MIDI_out_port, 1);
+  MIDI_send_sysex(sysexmessage, messagesize, MIDI_out_port, 1);
+  recall_messages++;
+  recall_bytes += messagesize;
+}
+
+FLASHMEM uint8_t MD_KTN_class::max_sysex_block_size() {
+  return KTN_MAX_SYSEX_BLOCK_SIZE;
 }
 
 FLASHMEM void MD_KTN_class::set_bpm() {
   if (connected) {
-    uint16_t time1 = 60000 / Setting.Bpm;
+    uint16_t time1 = 600000 / SCO_get_bpm_x10();
     uint32_t address_dly1, address_dly2;
     if (is_mk2) {
       address_dly1 = KTN_TIME_DELAY1_MK2;
@@ -477,7 +495,7 @@ FLASHMEM void MD_KTN_class::set_bpm() {
       address_dly2 = KTN_TIME_DELAY2_MK1;
     }
     write_sysex(address_dly1, time1 >> 7, time1 & 0x7F);
-    uint16_t time2 = 45000 / Setting.Bpm; // Delay 2 is always dotted eights!!!
+    uint16_t time2 = 450000 / SCO_get_bpm_x10(); // Delay 2 is always dotted eights!!!
     write_sysex(address_dly2, time2 >> 7, time2 & 0x7F);
     //DEBUGMSG("Katana: set delay 1 to " + String(time1) + " ms and delay 2 to " + String(time2) + " ms");
   }
@@ -504,6 +522,7 @@ FLASHMEM void MD_KTN_class::select_patch(uint16_t new_patch) {
     }
     MIDI_send_PC(send_channel_number, MIDI_channel, MIDI_out_port);
     prev_channel_number = send_channel_number;
+    clear_shadow();
     DEBUGMSG("out(" + String(device_name) + ") PC" + String(new_patch)); //Debug
   }
   else { // Load patch from EEPROM
@@ -697,35 +716,43 @@ struct KTN_patch_memory_struct { // Address map for the essential patch data tha
   uint8_t Length;   // The Length of the data
   uint8_t Index;    // The index in the KTN_patch_buffer[] array
   uint8_t Supported_in_version;
+  bool Panel;       // The data can be changed on the Katana itself or from a GA-FC, so it is always written on patch recall
 };
 
 const PROGMEM KTN_patch_memory_struct KTN_patch_memory[] = {
-  { 0x0720, 0x0600, 20, KTN_FX_CHAIN_INDEX, 1   },  // FX chain - must be first
-  { 0x0051, 0x0021, 9, KTN_AMP_INDEX, 1         },  // Amp - mk2 solo sw and level !!!
-  { 0x0030, 0x0010, 15, KTN_BOOST_INDEX, 1      },  // Boost effect
-  { 0x0130, 0x0040, 1, KTN_EQ_SW_INDEX, 1       },  // Eq
-  { 0x1104, 0x0041, 1, KTN_EQ_TYPE_INDEX, 3     },  // GEQ
-  { 0x0140, 0x0100, 2, KTN_MOD_BASE_INDEX, 1    },  // Mod base
-  { 0x034C, 0x0300, 2, KTN_FX_BASE_INDEX, 1     },  // FX base
-  { 0x0633, 0x0561, 1, KTN_FOOT_VOL_INDEX, 1    },  // Foot volume
-  { 0x0655, 0x0562, 4, KTN_S_R_LOOP_INDEX, 1    },  // S/R loop
-  { 0x0560, 0x0500, 9, KTN_DELAY1_INDEX, 1      },  // Delay 1
-  { 0x0573, 0x0513, 2, KTN_DELAY1_MOD_INDEX, 1  },  // Delay 1 - MOD settings
-  { 0x0610, 0x0540, 12, KTN_REVERB_INDEX, 1     },  // Reverb
-  { 0x104E, 0x0520, 9, KTN_DELAY2_INDEX, 2      },  // Delay 2
-  { 0x1061, 0x0533, 2, KTN_DELAY2_MOD_INDEX, 1  },  // Delay 2 - MOD settings
-  { 0x1049, 0x0515, 5, KTN_DELAY1_SDE_INDEX, 2  },  // Delay 1 - SDE3000 settings
-  { 0x1049, 0x0535, 5, KTN_DELAY2_SDE_INDEX, 2  },  // Delay 2 - SDE3000 settings
-  { 0x0620, 0x0550, 1, KTN_PEDAL_SW_INDEX, 4    },  // Pedal SW
-  { 0x1111, 0x0551, 1, KTN_PEDAL_TYPE_INDEX, 4  },  // Pedal type
-  { 0x121F, 0x063E, 6, KTN_EXP_ASSIGNS_INDEX, 3 },  // Assigns for expression pedals, FS en Cabinet resonance
-  { 0x0663, 0x0566, 4, KTN_NOISE_GATE_INDEX, 1  },  // Noise gate
-  { 0x0718, 0x0571, 1, KTN_MASTER_KEY_INDEX, 1  },  // Master key
-  { 0x0000, 0x0000, 16, KTN_PATCH_NAME_INDEX, 1 },  // Patch name (1)
+  { 0x0720, 0x0600, 20, KTN_FX_CHAIN_INDEX, 1, false   },  // FX chain - must be first
+  { 0x0051, 0x0021, 9, KTN_AMP_INDEX, 1, true          },  // Amp - mk2 solo sw and level !!!
+  { 0x0030, 0x0010, 15, KTN_BOOST_INDEX, 1, true       },  // Boost effect
+  { 0x0130, 0x0040, 1, KTN_EQ_SW_INDEX, 1, false       },  // Eq
+  { 0x1104, 0x0041, 1, KTN_EQ_TYPE_INDEX, 3, false     },  // GEQ
+  { 0x0140, 0x0100, 2, KTN_MOD_BASE_INDEX, 1, true     },  // Mod base
+  { 0x034C, 0x0300, 2, KTN_FX_BASE_INDEX, 1, true      },  // FX base
+  { 0x0633, 0x0561, 1, KTN_FOOT_VOL_INDEX, 1, true     },  // Foot volume
+  { 0x0655, 0x0562, 4, KTN_S_R_LOOP_INDEX, 1, true     },  // S/R loop
+  { 0x0560, 0x0500, 9, KTN_DELAY1_INDEX, 1, true       },  // Delay 1
+  { 0x0573, 0x0513, 2, KTN_DELAY1_MOD_INDEX, 1, false  },  // Delay 1 - MOD settings
+  { 0x0610, 0x0540, 12, KTN_REVERB_INDEX, 1, true      },  // Reverb
+  { 0x104E, 0x0520, 9, KTN_DELAY2_INDEX, 2, false      },  // Delay 2
+  { 0x1061, 0x0533, 2, KTN_DELAY2_MOD_INDEX, 1, false  },  // Delay 2 - MOD settings
+  { 0x1049, 0x0515, 5, KTN_DELAY1_SDE_INDEX, 2, false  },  // Delay 1 - SDE3000 settings
+  { 0x1049, 0x0535, 5, KTN_DELAY2_SDE_INDEX, 2, false  },  // Delay 2 - SDE3000 settings
+  { 0x0620, 0x0550, 1, KTN_PEDAL_SW_INDEX, 4, true     },  // Pedal SW
+  { 0x1111, 0x0551, 1, KTN_PEDAL_TYPE_INDEX, 4, false  },  // Pedal type
+  { 0x121F, 0x063E, 6, KTN_EXP_ASSIGNS_INDEX, 3, false },  // Assigns for expression pedals, FS en Cabinet resonance
+  { 0x0663, 0x0566, 4, KTN_NOISE_GATE_INDEX, 1, false  },  // Noise gate
+  { 0x0718, 0x0571, 1, KTN_MASTER_KEY_INDEX, 1, false  },  // Master key
+  { 0x0000, 0x0000, 16, KTN_PATCH_NAME_INDEX, 1, false },  // Patch name (1)
 };
 
 const uint8_t KTN_NUMBER_OF_PATCH_MESSAGES = sizeof(KTN_patch_memory) / sizeof(KTN_patch_memory[0]);
 
+// Blocks of the shadow buffer (see load_patch()): the patch messages above are followed by the data of the selected types
+#define KTN_SHADOW_MOD_BLOCK KTN_NUMBER_OF_PATCH_MESSAGES
+#define KTN_SHADOW_FX_BLOCK (KTN_NUMBER_OF_PATCH_MESSAGES + 1)
+#define KTN_SHADOW_PEDAL_BLOCK (KTN_NUMBER_OF_PATCH_MESSAGES + 2)
+#define KTN_SHADOW_EQ_BLOCK (KTN_NUMBER_OF_PATCH_MESSAGES + 3)
+#define KTN_NUMBER_OF_SHADOW_BLOCKS (KTN_NUMBER_OF_PATCH_MESSAGES + 4)
+
 #define KTN_NUMBER_OF_FX_TYPES 42
 
 struct KTN_fx_memory_struct { // Address map for the essential patch data that will be stored
@@ -814,9 +841,21 @@ FLASHMEM void MD_KTN_class::load_patch_buffer_with_default_patch() {
   memcpy(KTN_patch_buffer, KTN_default_patch, VC_PATCH_SIZE);
 }
 
+FLASHMEM uint16_t MD_KTN_class::setlist_song_get_load_time(uint16_t item) {
+  uint8_t number_of_channels = (dev_type == TYPE_KTN_50) ? 4 : 8;
+  if (item <= number_of_channels) return 0; // Channels are selected with a single PC
+  return (KTN_NUMBER_OF_PATCH_MESSAGES + 4) * sysex_delay_length; // Patches from VController memory are written with sysex messages by load_patch()
+}
+
+FLASHMEM uint16_t MD_KTN_class::setlist_song_get_vc_memory_patch(uint16_t item) {
+  uint8_t number_of_channels = (dev_type == TYPE_KTN_50) ? 4 : 8;
+  if (item <= number_of_channels) return NO_RESULT; // Channels are stored in the Katana
+  return item - number_of_channels - 1; // Same number as select_patch() passes to load_patch()
+}
+
 FLASHMEM void MD_KTN_class::load_patch(uint8_t number) {
-  uint16_t address, mod_address, fx_address, pedal_address;
-  uint32_t geq_address, peq_address;
+  uint16_t address;
+  uint32_t start_time = millis();
 
   // Load patch from EEPROM in KTN_patch_memory
   bool loaded = EEPROM_load_device_patch(my_device_number + 1, number, KTN_patch_buffer, VC_PATCH_SIZE);
@@ -825,55 +864,154 @@ FLASHMEM void MD_KTN_class::load_patch(uint8_t number) {
   }
 
   //sysex_delay_length = 5; //Speed up the MIDI data
-  // Write the patch from KTN_patch_memory to the Katana
+  // Write the patch from KTN_patch_memory to the Katana. Only the data that is different from the shadow buffer is sent.
+  recall_messages = 0;
+  recall_bytes = 0;
 
   current_mod_type = KTN_patch_buffer[KTN_MOD_BASE_INDEX + 1];
-  if (is_mk2) mod_address = KTN_fx_memory[current_mod_type].Mod_address_MK2;
-  else mod_address = KTN_fx_memory[current_mod_type].Mod_address_MK1;
-  if (mod_address > 0x0000) write_patch_data(0x60000000 + mod_address, KTN_MOD_INDEX, KTN_fx_memory[current_mod_type].Length);
-
   current_fx_type = KTN_patch_buffer[KTN_FX_BASE_INDEX + 1];
-  if (is_mk2) fx_address = KTN_fx_memory[current_fx_type].Mod_address_MK2 + 0x0200;
-  else fx_address = KTN_fx_memory[current_fx_type].FX_address_MK1;
-  if (fx_address > 0x0000) write_patch_data(0x60000000 + fx_address, KTN_FX_INDEX, KTN_fx_memory[current_fx_type].Length);
-
   current_eq_type = KTN_patch_buffer[KTN_EQ_TYPE_INDEX];
   DEBUGMSG("eq type: " + String(current_eq_type));
-  if (is_mk2) {
-    peq_address = KTN_PEQ_START_ADDRESS_MK2;
-    geq_address = KTN_GEQ_START_ADDRESS_MK2;
-  }
-  else {
-    peq_address = KTN_PEQ_START_ADDRESS_MK1;
-    geq_address = KTN_GEQ_START_ADDRESS_MK1;
-  }
-  if ((current_eq_type == 0) || (version < 3)) write_patch_data(peq_address, KTN_PEQ_GEQ_INDEX, 11); // write to parametric eq space on Katana
-  else write_patch_data(geq_address, KTN_PEQ_GEQ_INDEX, 11); // write to graphic eq space on Katana
-
   current_pedal_type = KTN_patch_buffer[KTN_PEDAL_TYPE_INDEX];
-  if (is_mk2) pedal_address = KTN_pedal_memory[current_pedal_type].Address_MK2;
-  else pedal_address = KTN_pedal_memory[current_pedal_type].Address_MK1;
-  if ((version >= 4) && (current_pedal_type < KTN_NUMBER_OF_PEDAL_TYPES)) write_patch_data(0x60000000 + pedal_address, KTN_PEDAL_INDEX, KTN_pedal_memory[current_pedal_type].Length);
+
+  // Write the data of the selected effect types first
+  Roland_scene_write_clear();
+  write_patch_block(KTN_SHADOW_MOD_BLOCK, current_mod_type);
+  write_patch_block(KTN_SHADOW_FX_BLOCK, current_fx_type);
+  write_patch_block(KTN_SHADOW_EQ_BLOCK, ((current_eq_type == 0) || (version < 3)) ? 0 : 1); // write to parametric or graphic eq space on Katana
+  write_patch_block(KTN_SHADOW_PEDAL_BLOCK, current_pedal_type);
+  Roland_scene_write_send();
 
   if (FX_chain_changed()) {
     DEBUGMSG("FX chain changed");
     if (is_mk2) address = KTN_patch_memory[0].Address_MK2;
     else address = KTN_patch_memory[0].Address_MK1;
-    write_patch_data(0x60000000 + address, KTN_patch_memory[0].Index, KTN_patch_memory[0].Length); // Write FX chain only when it is different to avoid gap
+    uint32_t chain_address = 0x60000000 + address; // Write FX chain only when it is different to avoid gap
+    for (uint8_t i = 0; i < KTN_patch_memory[0].Length; i++) {
+      Roland_scene_write_add(chain_address, KTN_patch_buffer[KTN_patch_memory[0].Index + i]);
+      chain_address = Roland_next_address(chain_address);
+    }
+    Roland_scene_write_send(); // In one message, before the blocks of the effects in the chain
   }
 
   for (uint8_t i = 1; i < KTN_NUMBER_OF_PATCH_MESSAGES; i++) {
-    if (version >= KTN_patch_memory[i].Supported_in_version) {
-      if (is_mk2) address = KTN_patch_memory[i].Address_MK2;
-      else address = KTN_patch_memory[i].Address_MK1;
-      write_patch_data(0x60000000 + address, KTN_patch_memory[i].Index, KTN_patch_memory[i].Length);
-    }
+    if (version >= KTN_patch_memory[i].Supported_in_version) write_patch_block(i, 0);
   }
+  Roland_scene_write_send();
   //sysex_delay_length = KTN_DEFAULT_MIDI_DELAY;
 
+  DEBUGMSG("Katana patch recall: " + String(recall_messages) + " messages, " + String(recall_bytes) + " bytes, " + String(millis() - start_time) + " ms");
   save_patch_number = number; // Remember memory number for the next time we save a patch
 }
 
+// ** Shadow buffer
+// The shadow buffer holds what we know of the temporary patch on the Katana, in the same layout as KTN_patch_buffer[].
+// It is filled by patch recalls, parameter changes from the VController and data received from the Katana or the editor.
+// On patch recall only the bytes that are different from the shadow buffer are written. Changes in a block are sent from the first
+// to the last changed byte, and the writes of consecutive addresses are combined by Roland_scene_write_send().
+// The blocks are the messages of KTN_patch_memory[] and the data of the selected MOD, FX, EQ and pedal type. The Katana has a memory
+// area for every type, so the data of a type block is only compared if it was last written for the same type.
+// The shadow buffer is cleared when the Katana selects a channel or (re)connects. The FX chain is not kept here, as FX_chain_changed() takes care of it.
+
+FLASHMEM bool MD_KTN_class::get_shadow_block(uint8_t block, uint8_t type, uint32_t &address, uint8_t &index, uint8_t &len) {
+  switch (block) {
+    case KTN_SHADOW_MOD_BLOCK:
+      if (type >= KTN_NUMBER_OF_FX_TYPES) return false;
+      if (is_mk2) address = KTN_fx_memory[type].Mod_address_MK2;
+      else address = KTN_fx_memory[type].Mod_address_MK1;
+      if (address == 0x0000) return false;
+      address += 0x60000000;
+      index = KTN_MOD_INDEX;
+      len = KTN_fx_memory[type].Length;
+      return true;
+    case KTN_SHADOW_FX_BLOCK:
+      if (type >= KTN_NUMBER_OF_FX_TYPES) return false;
+      if (is_mk2) address = KTN_fx_memory[type].Mod_address_MK2 + 0x0200;
+      else address = KTN_fx_memory[type].FX_address_MK1;
+      if (address == 0x0000) return false;
+      address += 0x60000000;
+      index = KTN_FX_INDEX;
+      len = KTN_fx_memory[type].Length;
+      return true;
+    case KTN_SHADOW_EQ_BLOCK:
+      if (type == 0) address = is_mk2 ? KTN_PEQ_START_ADDRESS_MK2 : KTN_PEQ_START_ADDRESS_MK1;
+      else address = is_mk2 ? KTN_GEQ_START_ADDRESS_MK2 : KTN_GEQ_START_ADDRESS_MK1;
+      index = KTN_PEQ_GEQ_INDEX;
+      len = 11;
+      return true;
+    case KTN_SHADOW_PEDAL_BLOCK:
+      if ((version < 4) || (type >= KTN_NUMBER_OF_PEDAL_TYPES)) return false;
+      if (is_mk2) address = KTN_pedal_memory[type].Address_MK2;
+      else address = KTN_pedal_memory[type].Address_MK1;
+      address += 0x60000000;
+      index = KTN_PEDAL_INDEX;
+      len = KTN_pedal_memory[type].Length;
+      return true;
+    default:
+      if ((block == 0) || (block >= KTN_NUMBER_OF_PATCH_MESSAGES)) return false; // The FX chain is not in the shadow buffer
+      if (version < KTN_patch_memory[block].Supported_in_version) return false;
+      if (is_mk2) address = KTN_patch_memory[block].Address_MK2;
+      else address = KTN_patch_memory[block].Address_MK1;
+      address += 0x60000000;
+      index = KTN_patch_memory[block].Index;
+      len = KTN_patch_memory[block].Length;
+      return true;
+  }
+}
+
+FLASHMEM void MD_KTN_class::write_patch_block(uint8_t block, uint8_t type) { // Adds the changed data of a block to the Roland scene writes
+  uint32_t address;
+  uint8_t index, len;
+  if (!get_shadow_block(block, type, address, index, len)) return;
+
+  uint8_t first = 0;
+  uint8_t last = len;
+  bool compare = (shadow_valid_blocks & (1UL << block));
+  if (block < KTN_NUMBER_OF_PATCH_MESSAGES) {
+    if (KTN_patch_memory[block].Panel) compare = false;
+  }
+  else if (shadow_type[block - KTN_SHADOW_MOD_BLOCK] != type) compare = false;
+
+  if (compare) {
+    while ((first < len) && (KTN_patch_buffer[index + first] == KTN_shadow_buffer[index + first])) first++;
+    if (first == len) return; // Nothing has changed
+    while (KTN_patch_buffer[index + last - 1] == KTN_shadow_buffer[index + last - 1]) last--;
+  }
+
+  for (uint8_t i = 0; i < first; i++) address = Roland_next_address(address);
+  uint32_t first_address = address;
+  for (uint8_t i = first; i < last; i++) {
+    Roland_scene_write_add(address, KTN_patch_buffer[index + i]);
+    address = Roland_next_address(address);
+  }
+
+  update_shadow(first_address, &KTN_patch_buffer[index + first], last - first); // Other blocks on the same address
+  memcpy(&KTN_shadow_buffer[index], &KTN_patch_buffer[index], len);
+  if (block >= KTN_SHADOW_MOD_BLOCK) shadow_type[block - KTN_SHADOW_MOD_BLOCK] = type;
+  shadow_valid_blocks |= (1UL << block);
+}
+
+FLASHMEM void MD_KTN_class::update_shadow(uint32_t address, const uint8_t *data, uint16_t len) { // Called for all data written to or read from the Katana
+  if ((address & 0xFFFF0000) != 0x60000000) return; // Only data of the temporary patch is kept
+  uint16_t start = Roland_linear_address(address);
+  uint32_t block_address;
+  uint8_t index, block_len;
+  for (uint8_t b = 1; b < KTN_NUMBER_OF_SHADOW_BLOCKS; b++) {
+    if ((shadow_valid_blocks & (1UL << b)) == 0) continue;
+    uint8_t type = (b >= KTN_SHADOW_MOD_BLOCK) ? shadow_type[b - KTN_SHADOW_MOD_BLOCK] : 0;
+    if (!get_shadow_block(b, type, block_address, index, block_len)) continue;
+    uint16_t block_start = Roland_linear_address(block_address);
+    if ((start >= block_start + block_len) || (start + len <= block_start)) continue;
+    for (uint16_t i = 0; i < len; i++) {
+      if ((start + i >= block_start) && (start + i < block_start + block_len)) KTN_shadow_buffer[index + start + i - block_start] = data[i];
+    }
+  }
+}
+
+FLASHMEM void MD_KTN_class::clear_shadow() {
+  shadow_valid_blocks = 0;
+}
+
 FLASHMEM void MD_KTN_class::update_patch(uint8_t version, uint16_t number) { // V2 - added GEQ block
   if (version < 2) {
     if ((KTN_patch_buffer[KTN_EQ_TYPE_INDEX] == 1) && (version > 2)) { // Move GEQ data to the regular patch block
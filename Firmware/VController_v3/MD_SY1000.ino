@@ -147,6 +147,7 @@ FLASHMEM void MD_SY1000_class::init() { // Default values for variables
   initialize_patch_space();
   //bass_mode = true;
   initialize_scene_assigns();
+  build_target_index();
   //edit_mode_always_on = false;
 
 #ifdef IS_VCTOUCH
@@ -241,9 +242,7 @@ void MD_SY1000_class::check_SYSEX_in(const unsigned char* sxdata, short unsigned
     }
 
     // Check for scene parameter data
-    if (read_scene_parameter_number > 0) {
-      if ((address == read_scene_parameter_address) && (checksum_ok)) read_scene_message(read_scene_parameter_number, sxdata[sx_index(data3, 12)]);
-    }
+    if ((reading_scene) && (checksum_ok)) read_scene_message(address, sxdata, sxlen, data3);
 
     // Check if it is the current patch name
     if (((address == SY1000_GM_CURRENT_PATCH_NAME) || (address == SY1000_BM_CURRENT_PATCH_NAME)) && (sxlength == 30) && (checksum_ok)) {
@@ -270,6 +269,7 @@ void MD_SY1000_class::check_SYSEX_in(const unsigned char* sxdata, short unsigned
     // Check for bass mode
     if ((address == SY1000_BASS_MODE) && (checksum_ok)) {
       bass_mode = (sxdata[sx_index(data3, 12)] == 0x01);
+      scene_plan_valid = false; // Instrument parameters are different in bass mode
       if (bass_mode) {
         DEBUGMAIN("BASS MODE DETECTED");
       }
@@ -280,8 +280,8 @@ void MD_SY1000_class::check_SYSEX_in(const unsigned char* sxdata, short unsigned
     if ((address == SY1000_GM_TEMPO) || (address == SY1000_BM_TEMPO)) {
       if ((checksum_ok) && (millis() > patch_gap_timer + 1500)) {
         uint16_t new_tempo = (sxdata[sx_index(data3, 12)] << 12) + (sxdata[sx_index(data3, 13)] << 8) + (sxdata[sx_index(data3, 14)] << 4) + sxdata[sx_index(data3, 15)];
-        DEBUGMSG("Tempo received: " + String(new_tempo / 10));
-        SCO_set_global_tempo_press(new_tempo / 10);
+        DEBUGMSG("Tempo received: " + String(new_tempo / 10) + "." + String(new_tempo % 10));
+        SCO_set_global_tempo_x10(new_tempo);
       }
     }
 
@@ -557,6 +557,23 @@ FLASHMEM void MD_SY1000_class::write_sysex(uint32_t address, uint8_t value1, uin
   if (editor_connected) MIDI_send_sysex(sysexmessage, 22, USBMIDI_PORT); // Forward message to BTS
 }
 
+FLASHMEM void MD_SY1000_class::write_sysex_block(uint32_t address, uint8_t *data, uint8_t len) { // For sending a block of data bytes
+
+  uint8_t *ad = (uint8_t*)&address; //Split the 32-bit address into four bytes: ad[3], ad[2], ad[1] and ad[0]
+  uint16_t sum = ad[3] + ad[2] + ad[1] + ad[0];
+  uint8_t messagesize = len + 14;
+  uint8_t sysexmessage[messagesize] = {0xF0, 0x41, MIDI_device_id, 0x00, 0x00, 0x00, 0x69, 0x12, ad[3], ad[2], ad[1], ad[0]};
+  for (uint8_t i = 0; i < len; i++) {
+    sysexmessage[i + 12] = data[i];
+    sum += data[i];
+  }
+  sysexmessage[messagesize - 2] = calc_Roland_checksum(sum); // Calculate the Roland checksum
+  sysexmessage[messagesize - 1] = 0xF7;
+  check_sysex_delay();
+  MIDI_send_sysex(sysexmessage, messagesize, MIDI_out_port);
+  if (editor_connected) MIDI_send_sysex(sysexmessage, messagesize, USBMIDI_PORT); // Forward message to BTS
+}
+
 FLASHMEM void MD_SY1000_class::request_sysex(uint32_t address, uint8_t no_of_bytes) {
   uint8_t *ad = (uint8_t*)&address; //Split the 32-bit address into four bytes: ad[3], ad[2], ad[1] and ad[0]
   uint8_t no1 = no_of_bytes >> 7;
@@ -595,7 +612,7 @@ FLASHMEM void MD_SY1000_class::set_editor_mode(bool state) {
 FLASHMEM void MD_SY1000_class::set_bpm() {
   if (connected) {
     uint32_t address;
-    uint16_t t = Setting.Bpm * 10;
+    uint16_t t = SCO_get_bpm_x10(); // The SY1000 tempo is in tenths of bpm
     control_edit_mode();
     if (!bass_mode) address = SY1000_GM_TEMPO;
     else address = SY1000_BM_TEMPO;
@@ -2023,43 +2040,43 @@ FLASHMEM void MD_SY1000_class::read_current_assign(uint8_t sw, uint32_t address,
   }
 }
 
-FLASHMEM bool MD_SY1000_class::ctl_target_lookup(uint8_t sw, uint16_t target) { // Finds the target and its address in the SY1000_parameters table
+uint16_t SY1000_ctl_target_keys[SY1000_NUMBER_OF_PARAMETERS]; // Index of SY1000_parameters sorted on CTL target
+uint16_t SY1000_ctl_target_index[SY1000_NUMBER_OF_PARAMETERS];
+uint16_t SY1000_target_GM_keys[SY1000_NUMBER_OF_PARAMETERS]; // Index of SY1000_parameters sorted on assign target in guitar mode
+uint16_t SY1000_target_GM_index[SY1000_NUMBER_OF_PARAMETERS];
+uint16_t SY1000_target_BM_keys[SY1000_NUMBER_OF_PARAMETERS]; // Index of SY1000_parameters sorted on assign target in bass mode
+uint16_t SY1000_target_BM_index[SY1000_NUMBER_OF_PARAMETERS];
 
-  // Lookup in SY1000_parameter array
-  bool found = false;
+FLASHMEM void MD_SY1000_class::build_target_index() {
   for (uint16_t i = 0; i < SY1000_NUMBER_OF_PARAMETERS; i++) {
-    if (target == SY1000_parameters[i].Ctl_target) { //Check is we've found the right target
-      SP[sw].PP_number = i; // Save the index number
-      SP[sw].Address = read_parameter_address(i);
-      found = true;
-    }
+    SY1000_ctl_target_keys[i] = SY1000_parameters[i].Ctl_target;
+    SY1000_ctl_target_index[i] = i;
+    SY1000_target_GM_keys[i] = SY1000_parameters[i].Target_GM;
+    SY1000_target_GM_index[i] = i;
+    SY1000_target_BM_keys[i] = SY1000_parameters[i].Target_BM;
+    SY1000_target_BM_index[i] = i;
   }
-  return found;
+  PAR_index_sort(SY1000_ctl_target_keys, SY1000_ctl_target_index, SY1000_NUMBER_OF_PARAMETERS);
+  PAR_index_sort(SY1000_target_GM_keys, SY1000_target_GM_index, SY1000_NUMBER_OF_PARAMETERS);
+  PAR_index_sort(SY1000_target_BM_keys, SY1000_target_BM_index, SY1000_NUMBER_OF_PARAMETERS);
 }
 
-FLASHMEM bool MD_SY1000_class::target_lookup(uint8_t sw, uint16_t target) { // Finds the target and its address in the SY1000_parameters table
+FLASHMEM bool MD_SY1000_class::ctl_target_lookup(uint8_t sw, uint16_t target) { // Finds the target and its address in the SY1000_parameters table
+  uint16_t index = PAR_index_lookup(SY1000_ctl_target_keys, SY1000_ctl_target_index, SY1000_NUMBER_OF_PARAMETERS, target);
+  if (index == NO_RESULT) return false;
+  SP[sw].PP_number = index; // Save the index number
+  SP[sw].Address = read_parameter_address(index);
+  return true;
+}
 
-  // Lookup in SY1000_parameter array
-  bool found = false;
-  if (!bass_mode) {
-    for (uint16_t i = 0; i < SY1000_NUMBER_OF_PARAMETERS; i++) {
-      if (target == SY1000_parameters[i].Target_GM) { //Check is we've found the right target
-        SP[sw].PP_number = i; // Save the index number
-        SP[sw].Address = read_parameter_address(i);
-        found = true;
-      }
-    }
-  }
-  else {
-    for (uint16_t i = 0; i < SY1000_NUMBER_OF_PARAMETERS; i++) {
-      if (target == SY1000_parameters[i].Target_BM) { //Check is we've found the right target
-        SP[sw].PP_number = i; // Save the index number
-        SP[sw].Address = read_parameter_address(i);
-        found = true;
-      }
-    }
-  }
-  return found;
+FLASHMEM bool MD_SY1000_class::target_lookup(uint8_t sw, uint16_t target) { // Finds the target and its address in the SY1000_parameters table
+  uint16_t index;
+  if (!bass_mode) index = PAR_index_lookup(SY1000_target_GM_keys, SY1000_target_GM_index, SY1000_NUMBER_OF_PARAMETERS, target);
+  else index = PAR_index_lookup(SY1000_target_BM_keys, SY1000_target_BM_index, SY1000_NUMBER_OF_PARAMETERS, target);
+  if (index == NO_RESULT) return false;
+  SP[sw].PP_number = index; // Save the index number
+  SP[sw].Address = read_parameter_address(index);
+  return true;
 }
 
 FLASHMEM void MD_SY1000_class::request_full_assign(uint8_t number) {
@@ -2498,6 +2515,8 @@ const PROGMEM SY1000_scene_inst_parameter_struct SY1000_scene_inst_parameters[][
 
 #define SY1000_NUMBER_OF_SCENE_INST_PARAMETERS (SY1000_NUMBER_OF_INST_PARAMETERS * 3)
 #define SY1000_TOTAL_NUMBER_OF_SCENE_PARAMETERS SY1000_NUMBER_OF_SCENE_INST_PARAMETERS + SY1000_NUMBER_OF_SCENE_PARAMETERS
+static_assert(SY1000_TOTAL_NUMBER_OF_SCENE_PARAMETERS == SY1000_SCENE_PLAN_SIZE, "SY1000_SCENE_PLAN_SIZE in Class_MD.ino must match the scene parameter tables");
+#define SY1000_SCENE_PLAN_UNUSED 0xFF // Parameter is not used for this instrument type
 
 const uint32_t GM_inst_start_address[] = { 0x10001500, 0x10002000, 0x10002B00 };
 const uint32_t BM_inst_start_address[] = { 0x10021500, 0x10021F00, 0x10022900 };
@@ -2622,8 +2641,42 @@ FLASHMEM void MD_SY1000_class::set_snapscene_number_and_LED(uint8_t number) {
   }
 }
 
-FLASHMEM bool MD_SY1000_class::load_scene(uint8_t prev_scene, uint8_t new_scene) {
+// Scene plans
+// The scene data in SY1000_patch_buffer is decoded once into scene_plan[] when the patch is loaded or a scene is changed.
+// A scene change then only compares the values of both scenes. Changes are written with Roland_scene_write_add(), so parameters
+// with consecutive addresses are sent together. Parameters that are turned down or off are sent first, then the ones that are turned up or on.
+// scene_plan_valid must be cleared whenever the scene data in SY1000_patch_buffer changes.
+
+FLASHMEM void MD_SY1000_class::compile_scene_plans() {
   uint8_t my_byte, my_shift, my_mask;
+  const uint8_t inst_type_item[3] = { INST1_TYPE_ITEM, INST2_TYPE_ITEM, INST3_TYPE_ITEM };
+  for (uint8_t s = 1; s <= 8; s++) {
+    uint8_t index = get_scene_index(s);
+    uint8_t *plan = scene_plan[s - 1];
+    uint8_t p = 0;
+    for (uint8_t inst = 0; inst < 3; inst++) {
+      uint8_t inst_type_index = read_scene_data(s, inst_type_item[inst]);
+      if ((bass_mode) && (inst_type_index > 2)) inst_type_index += 5; // jump from inst 3 to inst 8 for Bass mode
+      for (uint8_t par = 0; par < SY1000_NUMBER_OF_INST_PARAMETERS; par++) {
+        my_byte = (SY1000_scene_inst_parameters[inst_type_index][par].Bit_address >> 4) + (inst * 2) + SY1000_INST_DATA_OFFSET;
+        my_shift = SY1000_scene_inst_parameters[inst_type_index][par].Bit_address & 0x0F;
+        my_mask = SY1000_scene_inst_parameters[inst_type_index][par].Bit_mask;
+        if (my_mask != 0) plan[p++] = (SY1000_patch_buffer[index + my_byte] >> my_shift) & my_mask;
+        else plan[p++] = SY1000_SCENE_PLAN_UNUSED;
+      }
+    }
+    for (uint8_t i = 0; i < SY1000_NUMBER_OF_SCENE_PARAMETERS; i++) {
+      my_byte = SY1000_scene_parameters[i].Bit_address >> 4;
+      my_shift = SY1000_scene_parameters[i].Bit_address & 0x0F;
+      my_mask = SY1000_scene_parameters[i].Bit_mask;
+      if (my_mask != 0) plan[p++] = (SY1000_patch_buffer[index + my_byte] >> my_shift) & my_mask;
+      else plan[p++] = SY1000_SCENE_PLAN_UNUSED;
+    }
+  }
+  scene_plan_valid = true;
+}
+
+FLASHMEM bool MD_SY1000_class::load_scene(uint8_t prev_scene, uint8_t new_scene) {
   MIDI_debug_sysex(SY1000_patch_buffer, VC_PATCH_SIZE, 255, true);
   bool load_all_data = false;
   if (prev_scene == new_scene) return false;
@@ -2632,6 +2685,7 @@ FLASHMEM bool MD_SY1000_class::load_scene(uint8_t prev_scene, uint8_t new_scene)
 
   DEBUGMAIN("Loading scene " + String(new_scene) + " (prev scene:" + String(prev_scene) + ')');
   control_edit_mode();
+  if (!scene_plan_valid) compile_scene_plans();
 
   // Read inst state and types:
   DEBUGMAIN("Checking INST changes");
@@ -2646,107 +2700,54 @@ FLASHMEM bool MD_SY1000_class::load_scene(uint8_t prev_scene, uint8_t new_scene)
   prev_inst_type[0] = read_scene_data(prev_scene, INST1_TYPE_ITEM);
   prev_inst_type[1] = read_scene_data(prev_scene, INST2_TYPE_ITEM);
   prev_inst_type[2] = read_scene_data(prev_scene, INST3_TYPE_ITEM);
+  bool inst_changed[3];
+  for (uint8_t inst = 0; inst < 3; inst++) inst_changed[inst] = (INST_type[inst] != prev_inst_type[inst]);
 
-  uint8_t index_new = get_scene_index(new_scene);
-  uint8_t index_prev = get_scene_index(prev_scene);
+  const uint8_t *new_plan = scene_plan[new_scene - 1];
+  const uint8_t *prev_plan = scene_plan[(prev_scene > 0) ? prev_scene - 1 : 0]; // Scene 0 reads the data of scene 1, like get_scene_index()
 
   // Mute instruments
   mute_during_scene_change = check_mute_during_scene_change(new_scene);
   if (mute_during_scene_change) mute_now();
 
-  uint8_t addr_index = 0;
-  for (uint8_t inst = 0; inst < 3; inst ++) {
-    DEBUGMAIN("Checking INST to turn down of off" + String(inst + 1));
-    uint8_t inst_type_index = INST_type[inst];
-    if ((bass_mode) && (inst_type_index > 2)) inst_type_index += 5; // jump from inst 3 to inst 8 for Bass mode
-    bool inst_changed = (INST_type[inst] != prev_inst_type[inst]);
-    for (uint8_t par = 0; par < SY1000_NUMBER_OF_INST_PARAMETERS; par++) {
-      my_byte = (SY1000_scene_inst_parameters[inst_type_index][par].Bit_address >> 4) + (inst * 2) + SY1000_INST_DATA_OFFSET;
-      my_shift = SY1000_scene_inst_parameters[inst_type_index][par].Bit_address & 0x0F;
-      my_mask = SY1000_scene_inst_parameters[inst_type_index][par].Bit_mask << my_shift;
-
-      if (my_mask != 0) {
-        uint8_t new_data = SY1000_patch_buffer[index_new + my_byte] & my_mask;
-        uint8_t old_data = SY1000_patch_buffer[index_prev + my_byte] & my_mask;
-        if ((new_data < old_data) && (!inst_changed) && (!load_all_data)) {
-          uint32_t address = get_scene_inst_parameter_address(addr_index);
-          uint8_t data = new_data >> my_shift;
-          write_sysex(address, data);
-        }
+  DEBUGMAIN("Checking parameters to turn down or off");
+  Roland_scene_write_clear();
+  if (!load_all_data) {
+    for (uint8_t p = 0; p < SY1000_NUMBER_OF_SCENE_INST_PARAMETERS; p++) {
+      if (new_plan[p] == SY1000_SCENE_PLAN_UNUSED) continue;
+      if ((new_plan[p] < prev_plan[p]) && (!inst_changed[p / SY1000_NUMBER_OF_INST_PARAMETERS])) {
+        Roland_scene_write_add(get_scene_inst_parameter_address(p), new_plan[p]);
       }
-      addr_index++;
     }
-  }
-
-  DEBUGMAIN("Checking common parameters to turn down or off");
-  for (uint8_t i = 0; i < SY1000_NUMBER_OF_SCENE_PARAMETERS; i++) {
-    bool is_inst_sw = (i == INST1_SW_ITEM) || (i == INST2_SW_ITEM) || (i == INST3_SW_ITEM);
-    if ((!mute_during_scene_change) || (!is_inst_sw)) {
-      my_byte = SY1000_scene_parameters[i].Bit_address >> 4;
-      my_shift = SY1000_scene_parameters[i].Bit_address & 0x0F;
-      my_mask = SY1000_scene_parameters[i].Bit_mask << my_shift;
-
-      if (my_mask != 0) {
-        uint8_t new_data = SY1000_patch_buffer[index_new + my_byte] & my_mask;
-        uint8_t old_data = SY1000_patch_buffer[index_prev + my_byte] & my_mask;
-        if ((new_data < old_data)  && (!load_all_data)) {
-          uint32_t address = get_scene_parameter_address(i);
-          uint8_t data = new_data >> my_shift;
-          write_sysex(address, data);
-        }
-      }
+    for (uint8_t i = 0; i < SY1000_NUMBER_OF_SCENE_PARAMETERS; i++) {
+      bool is_inst_sw = (i == INST1_SW_ITEM) || (i == INST2_SW_ITEM) || (i == INST3_SW_ITEM);
+      if ((mute_during_scene_change) && (is_inst_sw)) continue;
+      uint8_t p = SY1000_NUMBER_OF_SCENE_INST_PARAMETERS + i;
+      if (new_plan[p] == SY1000_SCENE_PLAN_UNUSED) continue;
+      if (new_plan[p] < prev_plan[p]) Roland_scene_write_add(get_scene_parameter_address(i), new_plan[p]);
     }
-    addr_index++;
   }
+  Roland_scene_write_send();
 
   DEBUGMAIN("Check scene assigns");
-  check_scene_assigns_with_new_state(SY1000_patch_buffer[index_new + SY1000_SCENE_ASSIGN_BYTE]);
+  check_scene_assigns_with_new_state(SY1000_patch_buffer[get_scene_index(new_scene) + SY1000_SCENE_ASSIGN_BYTE]);
   last_loaded_scene = new_scene;
 
-  addr_index = 0;
-  for (uint8_t inst = 0; inst < 3; inst ++) {
-    DEBUGMAIN("Checking INST to turn up or on" + String(inst + 1));
-    uint8_t inst_type_index = INST_type[inst];
-    if ((bass_mode) && (inst_type_index > 2)) inst_type_index += 5; // jump from inst 3 to inst 8 for Bass mode
-    bool inst_changed = (INST_type[inst] != prev_inst_type[inst]);
-    for (uint8_t par = 0; par < SY1000_NUMBER_OF_INST_PARAMETERS; par++) {
-      my_byte = (SY1000_scene_inst_parameters[inst_type_index][par].Bit_address >> 4) + (inst * 2) + SY1000_INST_DATA_OFFSET;
-      my_shift = SY1000_scene_inst_parameters[inst_type_index][par].Bit_address & 0x0F;
-      my_mask = SY1000_scene_inst_parameters[inst_type_index][par].Bit_mask << my_shift;
-
-      if (my_mask != 0) {
-        uint8_t new_data = SY1000_patch_buffer[index_new + my_byte] & my_mask;
-        uint8_t old_data = SY1000_patch_buffer[index_prev + my_byte] & my_mask;
-        if ((new_data > old_data) || (inst_changed) || (load_all_data)) {
-          uint32_t address = get_scene_inst_parameter_address(addr_index);
-          uint8_t data = new_data >> my_shift;
-          write_sysex(address, data);
-        }
-      }
-      addr_index++;
+  DEBUGMAIN("Checking parameters to turn up or on");
+  for (uint8_t p = 0; p < SY1000_NUMBER_OF_SCENE_INST_PARAMETERS; p++) {
+    if (new_plan[p] == SY1000_SCENE_PLAN_UNUSED) continue;
+    if ((new_plan[p] > prev_plan[p]) || (inst_changed[p / SY1000_NUMBER_OF_INST_PARAMETERS]) || (load_all_data)) {
+      Roland_scene_write_add(get_scene_inst_parameter_address(p), new_plan[p]);
     }
   }
-
-  DEBUGMAIN("Checking common parameters to turn up or on");
   for (uint8_t i = 0; i < SY1000_NUMBER_OF_SCENE_PARAMETERS; i++) {
     bool is_inst_sw = (i == INST1_SW_ITEM) || (i == INST2_SW_ITEM) || (i == INST3_SW_ITEM);
-    if ((!mute_during_scene_change) || (!is_inst_sw)) {
-      my_byte = SY1000_scene_parameters[i].Bit_address >> 4;
-      my_shift = SY1000_scene_parameters[i].Bit_address & 0x0F;
-      my_mask = SY1000_scene_parameters[i].Bit_mask << my_shift;
-
-      if (my_mask != 0) {
-        uint8_t new_data = SY1000_patch_buffer[index_new + my_byte] & my_mask;
-        uint8_t old_data = SY1000_patch_buffer[index_prev + my_byte] & my_mask;
-        if ((new_data > old_data) || (load_all_data)) {
-          uint32_t address = get_scene_parameter_address(i);
-          uint8_t data = new_data >> my_shift;
-          write_sysex(address, data);
-        }
-      }
-    }
-    addr_index++;
+    if ((mute_during_scene_change) && (is_inst_sw)) continue;
+    uint8_t p = SY1000_NUMBER_OF_SCENE_INST_PARAMETERS + i;
+    if (new_plan[p] == SY1000_SCENE_PLAN_UNUSED) continue;
+    if ((new_plan[p] > prev_plan[p]) || (load_all_data)) Roland_scene_write_add(get_scene_parameter_address(i), new_plan[p]);
   }
+  Roland_scene_write_send();
 
   // Unmute instruments
   if (mute_during_scene_change) unmute();
@@ -2793,8 +2794,7 @@ FLASHMEM void MD_SY1000_class::store_scene() { // Returning from menu
   set_snapscene_number_and_LED(save_scene_number);
   last_loaded_scene = save_scene_number;
   MIDI_disable_device_check();
-  memset(scene_data_buffer, 0, SY1000_SCENE_DATA_BUFFER_SIZE);
-  request_scene_message(1);
+  start_scene_read();
   update_page = 0;
 }
 
@@ -2804,8 +2804,7 @@ FLASHMEM void MD_SY1000_class::update_change_on_all_scenes() {
   // 2) Compare the bytes of the scene_data_buffer to the last_loaded_scene - in check_delta_and_update_scenes()
   // 3) Write this difference to all scenes - in check_delta_and_update_scenes()
   save_scene_number = 9;
-  memset(scene_data_buffer, 0, SY1000_SCENE_DATA_BUFFER_SIZE);
-  request_scene_message(1);
+  start_scene_read();
   update_page = 0;
 }
 
@@ -2884,14 +2883,71 @@ FLASHMEM void MD_SY1000_class::check_delta_and_update_scenes() {
     DEBUGMAIN("Done!");*/
 }
 
-FLASHMEM void MD_SY1000_class::request_scene_message(uint8_t number) {
-  if (number == 0) return;
-  if (number == 2) LCD_show_popup_label("Reading scene...", MESSAGE_TIMER_LENGTH);
-  read_scene_parameter_number = number;
-  if (number < SY1000_NUMBER_OF_SCENE_INST_PARAMETERS) read_scene_parameter_address = get_scene_inst_parameter_address(number - 1);
-  else read_scene_parameter_address = get_scene_parameter_address(number - SY1000_NUMBER_OF_SCENE_INST_PARAMETERS - 1);
-  DEBUGMAIN("Requesting item " + String(number - 1) + " at address " + String(read_scene_parameter_address, HEX));
-  request_sysex(read_scene_parameter_address, 1);
+// Reading scenes
+// The scene parameters are read from the SY1000 in blocks. plan_scene_read() groups the parameters that are in the same address page (128 bytes)
+// into blocks of at most SY1000_SCENE_READ_MAX_BLOCK_SIZE bytes, so the gaps between the parameters are read along with them.
+// SY1000_SCENE_READ_WINDOW blocks are requested at the same time. When the timer expires, only the blocks that have not been received are requested again.
+
+FLASHMEM uint32_t MD_SY1000_class::get_scene_read_address(uint8_t parameter) { // Returns 0 if parameter is not used
+  if (parameter < SY1000_NUMBER_OF_SCENE_INST_PARAMETERS) {
+    uint8_t inst = parameter / SY1000_NUMBER_OF_INST_PARAMETERS;
+    uint8_t par = parameter % SY1000_NUMBER_OF_INST_PARAMETERS;
+    uint8_t inst_type_index = INST_type[inst];
+    if ((bass_mode) && (inst_type_index > 2)) inst_type_index += 5; // jump from inst 3 to inst 8 for Bass mode
+    if (SY1000_scene_inst_parameters[inst_type_index][par].Bit_mask == 0) return 0;
+    return get_scene_inst_parameter_address(parameter);
+  }
+  return get_scene_parameter_address(parameter - SY1000_NUMBER_OF_SCENE_INST_PARAMETERS);
+}
+
+FLASHMEM void MD_SY1000_class::plan_scene_read() {
+  read_scene_number_of_blocks = 0;
+  for (uint8_t p = 0; p < SY1000_TOTAL_NUMBER_OF_SCENE_PARAMETERS; p++) {
+    read_scene_block_of_parameter[p] = SY1000_SCENE_PLAN_UNUSED;
+    uint32_t address = get_scene_read_address(p);
+    if (address == 0) continue;
+    uint8_t b;
+    for (b = 0; b < read_scene_number_of_blocks; b++) { // Find a block in the same page that can include this address
+      uint32_t first = read_scene_block_start[b];
+      uint32_t last = first + read_scene_block_size[b] - 1;
+      if ((address & 0xFFFFFF80) != (first & 0xFFFFFF80)) continue;
+      if (address < first) first = address;
+      if (address > last) last = address;
+      if (last - first + 1 > SY1000_SCENE_READ_MAX_BLOCK_SIZE) continue;
+      read_scene_block_start[b] = first;
+      read_scene_block_size[b] = last - first + 1;
+      break;
+    }
+    if (b == read_scene_number_of_blocks) { // Start a new block
+      read_scene_block_start[b] = address;
+      read_scene_block_size[b] = 1;
+      read_scene_number_of_blocks++;
+    }
+    read_scene_block_of_parameter[p] = b;
+  }
+  for (uint8_t p = 0; p < SY1000_TOTAL_NUMBER_OF_SCENE_PARAMETERS; p++) { // Blocks can grow downwards, so the offsets are set when all blocks are known
+    uint8_t b = read_scene_block_of_parameter[p];
+    if (b != SY1000_SCENE_PLAN_UNUSED) read_scene_offset_of_parameter[p] = get_scene_read_address(p) - read_scene_block_start[b];
+  }
+  DEBUGMAIN("Scene read planned in " + String(read_scene_number_of_blocks) + " blocks");
+}
+
+FLASHMEM void MD_SY1000_class::start_scene_read() {
+  memset(scene_data_buffer, 0, SY1000_SCENE_DATA_BUFFER_SIZE);
+  plan_scene_read();
+  for (uint8_t b = 0; b < read_scene_number_of_blocks; b++) read_scene_block_received[b] = false;
+  read_scene_blocks_received = 0;
+  read_scene_next_block = 0;
+  reading_scene = true;
+  LCD_show_popup_label("Reading scene...", MESSAGE_TIMER_LENGTH);
+  while ((read_scene_next_block < read_scene_number_of_blocks) && (read_scene_next_block < SY1000_SCENE_READ_WINDOW)) {
+    request_scene_message(read_scene_next_block++);
+  }
+}
+
+FLASHMEM void MD_SY1000_class::request_scene_message(uint8_t block) {
+  DEBUGMAIN("Requesting scene block " + String(block) + " at address " + String(read_scene_block_start[block], HEX) + " (" + String(read_scene_block_size[block]) + " bytes)");
+  request_sysex(read_scene_block_start[block], read_scene_block_size[block]);
   read_scene_midi_timer = millis() + SY1000_READ_SCENE_MIDI_TIMER_LENGTH; // Set the timer
 }
 
@@ -2899,40 +2955,53 @@ void MD_SY1000_class::check_read_scene_midi_timer() {
   if (read_scene_midi_timer > 0) { // Check timer is running
     if (millis() > read_scene_midi_timer) {
       DEBUGMSG("SY1000 Midi timer expired!");
-      request_scene_message(read_scene_parameter_number);
+      for (uint8_t b = 0; b < read_scene_next_block; b++) { // Request the missing blocks again
+        if (!read_scene_block_received[b]) request_scene_message(b);
+      }
     }
   }
 }
 
-FLASHMEM void MD_SY1000_class::read_scene_message(uint8_t number, uint8_t data) {
+FLASHMEM void MD_SY1000_class::read_scene_message(uint32_t address, const unsigned char* sxdata, uint16_t sxlen, uint8_t data3) {
   uint8_t my_byte, my_shift, my_mask;
-  if (number == 0) return;
-  number--;
-  if (number < SY1000_NUMBER_OF_SCENE_INST_PARAMETERS) {
-    uint8_t inst = number / SY1000_NUMBER_OF_INST_PARAMETERS;
-    uint8_t par = number % SY1000_NUMBER_OF_INST_PARAMETERS;
-    uint8_t inst_type_index = INST_type[inst];
-    if ((bass_mode) && (inst_type_index > 2)) inst_type_index += 5; // jump from inst 3 to inst 8 for Bass mode
-
-    my_byte = (SY1000_scene_inst_parameters[inst_type_index][par].Bit_address >> 4) + (inst * 2) + SY1000_INST_DATA_OFFSET;
-    my_shift = SY1000_scene_inst_parameters[inst_type_index][par].Bit_address & 0x0F;
-    my_mask = SY1000_scene_inst_parameters[inst_type_index][par].Bit_mask;
-    DEBUGMAIN("INST" + String(inst + 1) + ": item:" + String(par) + ", my_byte:" + String(my_byte));
+  uint8_t block;
+  for (block = 0; block < read_scene_next_block; block++) {
+    if ((read_scene_block_start[block] == address) && (read_scene_block_size[block] + 14 == sxlen) && (!read_scene_block_received[block])) break;
   }
-  else {
-    uint8_t index = number - SY1000_NUMBER_OF_SCENE_INST_PARAMETERS;
-    my_byte = SY1000_scene_parameters[index].Bit_address >> 4;
-    my_shift = SY1000_scene_parameters[index].Bit_address & 0x0F;
-    my_mask = SY1000_scene_parameters[index].Bit_mask;
-    DEBUGMAIN("COMMON ITEM " + String(index) + ": my_byte:" + String(my_byte) + ", my_shift:" + String(my_shift));
+  if (block == read_scene_next_block) return; // Not a block we are waiting for
+
+  for (uint8_t number = 0; number < SY1000_TOTAL_NUMBER_OF_SCENE_PARAMETERS; number++) {
+    if (read_scene_block_of_parameter[number] != block) continue;
+    uint8_t data = sxdata[sx_index(data3, 12 + read_scene_offset_of_parameter[number])];
+    if (number < SY1000_NUMBER_OF_SCENE_INST_PARAMETERS) {
+      uint8_t inst = number / SY1000_NUMBER_OF_INST_PARAMETERS;
+      uint8_t par = number % SY1000_NUMBER_OF_INST_PARAMETERS;
+      uint8_t inst_type_index = INST_type[inst];
+      if ((bass_mode) && (inst_type_index > 2)) inst_type_index += 5; // jump from inst 3 to inst 8 for Bass mode
+
+      my_byte = (SY1000_scene_inst_parameters[inst_type_index][par].Bit_address >> 4) + (inst * 2) + SY1000_INST_DATA_OFFSET;
+      my_shift = SY1000_scene_inst_parameters[inst_type_index][par].Bit_address & 0x0F;
+      my_mask = SY1000_scene_inst_parameters[inst_type_index][par].Bit_mask;
+    }
+    else {
+      uint8_t index = number - SY1000_NUMBER_OF_SCENE_INST_PARAMETERS;
+      my_byte = SY1000_scene_parameters[index].Bit_address >> 4;
+      my_shift = SY1000_scene_parameters[index].Bit_address & 0x0F;
+      my_mask = SY1000_scene_parameters[index].Bit_mask;
+    }
+    scene_data_buffer[my_byte] |= ((data & my_mask) << my_shift);
   }
-  if (my_mask != 0) scene_data_buffer[my_byte] |= ((data & my_mask) << my_shift);
+  read_scene_block_received[block] = true;
+  read_scene_blocks_received++;
+  LCD_show_bar(0, map(read_scene_blocks_received, 0, read_scene_number_of_blocks, 0, 127), 0);
 
-  if (number < SY1000_TOTAL_NUMBER_OF_SCENE_PARAMETERS - 1) {
-    request_scene_message(read_scene_parameter_number + 1); // Request next message
+  if (read_scene_blocks_received < read_scene_number_of_blocks) {
+    if (read_scene_next_block < read_scene_number_of_blocks) request_scene_message(read_scene_next_block++); // Keep the window full
+    else read_scene_midi_timer = millis() + SY1000_READ_SCENE_MIDI_TIMER_LENGTH;
   }
   else { // Done reading messages for scene
-    read_scene_parameter_number = 0;
+    DEBUGMAIN("Scene read in " + String(read_scene_number_of_blocks) + " blocks");
+    reading_scene = false;
     read_scene_midi_timer = 0;
     MIDI_enable_device_check();
 
@@ -2946,6 +3015,7 @@ FLASHMEM void MD_SY1000_class::read_scene_message(uint8_t number, uint8_t data)
       for (uint8_t i = 0; i < SY1000_SCENE_DATA_BUFFER_SIZE; i++) {
         SY1000_patch_buffer[b++] = scene_data_buffer[i];
       }
+      scene_plan_valid = false;
       set_mute_during_scene_change(save_scene_number, mute_during_scene_change);
       set_scene_active(save_scene_number);
       update_page = RELOAD_PAGE;
@@ -2960,10 +3030,10 @@ FLASHMEM void MD_SY1000_class::read_scene_message(uint8_t number, uint8_t data)
     else { // Update scene differences and write them to all scenes
       if (last_loaded_scene == 0) return;
       check_delta_and_update_scenes();
+      scene_plan_valid = false;
       load_scene(0, last_loaded_scene);
     }
   }
-  LCD_show_bar(0, map(number, 0, SY1000_TOTAL_NUMBER_OF_SCENE_PARAMETERS, 0, 127), 0);
 }
 
 FLASHMEM void MD_SY1000_class::exchange_scene(uint8_t new_scene, uint8_t prev_scene) {
@@ -2981,6 +3051,7 @@ FLASHMEM void MD_SY1000_class::exchange_scene(uint8_t new_scene, uint8_t prev_sc
     index_new++;
     index_prev++;
   }
+  scene_plan_valid = false;
 
   if (new_scene_active) set_scene_active(prev_scene);
   else clear_scene_active(prev_scene);
@@ -2996,6 +3067,7 @@ FLASHMEM void MD_SY1000_class::initialize_scene(uint8_t scene) {
   DEBUGMAIN("Initializing scene " + String(scene));
   uint8_t index = get_scene_index(scene);
   for (uint8_t i = 0; i < SY1000_SCENE_DATA_BUFFER_SIZE + 8; i++) SY1000_patch_buffer[index++] = 0;
+  scene_plan_valid = false;
 
   // Set default label
   scene_label_buffer[0] = '-';
@@ -3065,6 +3137,7 @@ FLASHMEM void MD_SY1000_class::load_patch(uint16_t number) {
     initialize_patch_space();
     last_loaded_scene = 0;
   }
+  scene_plan_valid = false;
   current_snapscene = last_loaded_scene;
   uint8_t index = get_scene_index(current_snapscene) + SY1000_SCENE_ASSIGN_BYTE;
   set_scene_assign_states(SY1000_patch_buffer[index]);
@@ -3072,6 +3145,11 @@ FLASHMEM void MD_SY1000_class::load_patch(uint16_t number) {
   //MIDI_debug_sysex(SY1000_patch_buffer, VC_PATCH_SIZE, 255, true); // Show contents of patch buffer
 }
 
+FLASHMEM uint16_t MD_SY1000_class::setlist_song_get_vc_memory_patch(uint16_t item) {
+  if (bass_mode) item += SY1000_BASS_MODE_NUMBER_OFFSET; // Same number as load_patch() reads
+  return item;
+}
+
 FLASHMEM bool MD_SY1000_class::store_patch(uint16_t number) {
 
   if (bass_mode) number |= SY1000_BASS_MODE_NUMBER_OFFSET;
@@ -3130,6 +3208,7 @@ FLASHMEM bool MD_SY1000_class::initialize_patch(uint16_t number) {
 
 FLASHMEM void MD_SY1000_class::initialize_patch_space() {
   memset(SY1000_patch_buffer, 0, VC_PATCH_SIZE);
+  scene_plan_valid = false;
   scene_label_buffer[0] = '-';
   scene_label_buffer[1] = '-';
   for (uint8_t i = 2; i < 8; i++) scene_label_buffer[i] = ' ';
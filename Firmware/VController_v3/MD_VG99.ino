@@ -98,6 +98,7 @@ FLASHMEM void MD_VG99_class::init() // Default values for variables
   my_device_page4 = VG99_DEFAULT_VC_PAGE4;
 #endif
   count_parameter_categories();
+  build_target_index();
   is_on = false;
 
 #ifdef IS_VCTOUCH
@@ -133,6 +134,9 @@ FLASHMEM void MD_VG99_class::check_SYSEX_in(const unsigned char* sxdata, short u
       }
     }
 
+    // Check if it is assign data
+    if (checksum_ok) update_assign_cache(address, sxdata, sxlength);
+
     // Check if it is the current parameter
     if (address == last_requested_sysex_address) {
       if (!checksum_ok) {
@@ -349,6 +353,7 @@ FLASHMEM void MD_VG99_class::do_after_patch_selection() {
   is_on = connected;
   if (Setting.Send_global_tempo_after_patch_change == true) set_bpm();
   Current_patch_number = patch_number;
+  assign_cache_valid = 0; // Assigns should be read again
   update_LEDS = true;
   update_main_lcd = true;
   request_guitar_switch_states();
@@ -1088,11 +1093,12 @@ FLASHMEM uint16_t MD_VG99_class::get_parbank_parameter_id(uint16_t par_number) {
 
 // Procedures for VG99_ASSIGN:
 // 1. Load in SP array - MD_VG99_class::assign_load() below
-// 2. Request - MD_VG99_class::request_current_assign(uint8_t sw)
-// 3. Read assign - MD_VG99_class::read_current_assign(uint8_t sw) - also requests parameter state
-// 4. Read parameter state - MD_VG99_class::read_parameter() above
-// 5. Press switch - MD_VG99_class::assign_press() below
-// 6. Release switch - MD_VG99_class::assign_release() below
+// 2. Request - MD_VG99_class::request_current_assign(uint8_t sw) - reads the assign block when the assign is not in the cache
+// 3. Read assign block - MD_VG99_class::update_assign_cache() and MD_VG99_class::read_current_assign(uint8_t sw)
+// 4. Request parameter state - MD_VG99_class::assign_request(uint8_t sw) - reads the assign from the cache
+// 5. Read parameter state - MD_VG99_class::read_parameter() above
+// 6. Press switch - MD_VG99_class::assign_press() below
+// 7. Release switch - MD_VG99_class::assign_release() below
 
 struct VG99_assign_struct {
   char Title[14];
@@ -1144,6 +1150,35 @@ const PROGMEM VG99_assign_struct VG99_assigns[] = {
 
 const uint16_t VG99_NUMBER_OF_ASSIGNS = sizeof(VG99_assigns) / sizeof(VG99_assigns[0]);
 
+// Assign cache
+// The assigns of the current patch are kept in VG99_assign_cache, so every assign is read only once per patch.
+// An assign that is not in the cache is read together with the other assigns in its block, so a page with several assigns needs only a few RQ1 messages.
+// The cache is cleared on a patch change. A DT1 message from the VG99 that changes a cached assign removes that assign from the cache and reloads the page.
+
+#define VG99_ASSIGN_SIZE 14 // Number of bytes read for every assign
+
+struct VG99_assign_block_struct {
+  uint32_t Address;
+  uint8_t Size;
+};
+
+const PROGMEM VG99_assign_block_struct VG99_assign_blocks[] = {
+  {0x60000100, 114}, // GK VOL - CTL3
+  {0x60000178, 14}, // CTL4
+  {0x60000300, 74}, // DBEAM-V - RIBBON POS
+  {0x60000500, 74}, // FC300 EXP1 - EXP SW2
+  {0x60000600, 114}, // FC300 CTL1 - CTL6
+  {0x60000678, 34}, // FC300 CTL7 - CTL8
+  {0x60007000, 98}, // ASSIGN 1 - 4
+  {0x60007100, 98}, // ASSIGN 5 - 8
+  {0x60007200, 98}, // ASSIGN 9 - 12
+  {0x60007300, 98}, // ASSIGN 13 - 16
+};
+
+const uint8_t VG99_NUMBER_OF_ASSIGN_BLOCKS = sizeof(VG99_assign_blocks) / sizeof(VG99_assign_blocks[0]);
+
+uint8_t VG99_assign_cache[VG99_NUMBER_OF_ASSIGNS][VG99_ASSIGN_SIZE];
+
 const PROGMEM uint16_t FC300_CTL[12] = {0x2100, 0x2101, 0x2402, 0x2102, 0x2403, 0x2103, 0x2404, 0x2104, 0x2400, 0x2200, 0x2401, 0x2201}; //CTL 1-8, EXP1, EP SW1, EXP2, EP SW2
 
 #define VG99_FC300_EXP1 8
@@ -1246,27 +1281,85 @@ FLASHMEM void MD_VG99_class::assign_load(uint8_t sw, uint8_t assign_number, uint
 FLASHMEM void MD_VG99_class::request_current_assign(uint8_t sw) {
   uint8_t index = SP[sw].Assign_number;
   if (index < VG99_NUMBER_OF_ASSIGNS) {
-    DEBUGMSG("Request assign " + String(index + 1));
-    //read_assign_target = false;
-    uint32_t my_address = VG99_assigns[index].Address;
-    SP[sw].Address = my_address;
+    if (assign_cache_valid & (1ULL << index)) { // Assign has been read already
+      assign_request(sw);
+      return;
+    }
+    uint32_t my_address;
+    uint8_t my_size;
+    get_assign_block(index, my_address, my_size);
+    DEBUGMSG("Request assign " + String(index + 1) + " in block " + String(my_address, HEX));
+    SP[sw].Address = VG99_assigns[index].Address;
     last_requested_sysex_address = my_address;
     last_requested_sysex_type = REQUEST_ASSIGN_TYPE;
     last_requested_sysex_switch = sw;
-    request_sysex(my_address, 14);  //Request 14 bytes for the VG99 assign
+    request_sysex(my_address, my_size);  //Request the VG99 assign block
   }
   else PAGE_request_next_switch(); // Wrong assign number given in Config - skip it
 }
 
+FLASHMEM void MD_VG99_class::get_assign_block(uint8_t index, uint32_t &address, uint8_t &size) {
+  address = VG99_assigns[index].Address;
+  size = VG99_ASSIGN_SIZE;
+  uint16_t assign_start = Roland_linear_address(address);
+  for (uint8_t b = 0; b < VG99_NUMBER_OF_ASSIGN_BLOCKS; b++) {
+    uint16_t block_start = Roland_linear_address(VG99_assign_blocks[b].Address);
+    if ((assign_start >= block_start) && (assign_start + VG99_ASSIGN_SIZE <= block_start + VG99_assign_blocks[b].Size)) {
+      address = VG99_assign_blocks[b].Address;
+      size = VG99_assign_blocks[b].Size;
+      return;
+    }
+  }
+}
+
+FLASHMEM void MD_VG99_class::update_assign_cache(uint32_t address, const unsigned char* sxdata, short unsigned int sxlength) { // Called for all DT1 messages from the VG99
+  if (((address & 0xFFFF0000) != 0x60000000) || (sxlength <= 13)) return;
+  bool requested = ((address == last_requested_sysex_address) && (last_requested_sysex_type == REQUEST_ASSIGN_TYPE));
+  uint16_t start = Roland_linear_address(address);
+  uint16_t len = sxlength - 13;
+  bool changed = false;
+  for (uint8_t a = 0; a < VG99_NUMBER_OF_ASSIGNS; a++) {
+    uint16_t assign_start = Roland_linear_address(VG99_assigns[a].Address);
+    if ((start >= assign_start + VG99_ASSIGN_SIZE) || (start + len <= assign_start)) continue; // Message does not touch this assign
+    uint64_t mask = 1ULL << a;
+    if ((requested) && (start <= assign_start) && (start + len >= assign_start + VG99_ASSIGN_SIZE)) { // Store the assign
+      for (uint8_t i = 0; i < VG99_ASSIGN_SIZE; i++) VG99_assign_cache[a][i] = sxdata[assign_start - start + i + 11];
+      assign_cache_valid |= mask;
+    }
+    else if (assign_cache_valid & mask) { // Check if the assign has been changed on the VG99
+      for (uint16_t i = 0; i < len; i++) {
+        if ((start + i >= assign_start) && (start + i < assign_start + VG99_ASSIGN_SIZE) && (sxdata[i + 11] != VG99_assign_cache[a][start + i - assign_start])) {
+          assign_cache_valid &= ~mask;
+          changed = true;
+          DEBUGMSG("VG99 assign " + String(a + 1) + " changed");
+          break;
+        }
+      }
+    }
+  }
+  if (changed) update_page = REFRESH_PAGE;
+}
+
 FLASHMEM void MD_VG99_class::read_current_assign(uint8_t sw, uint32_t address, const unsigned char* sxdata, short unsigned int sxlength) {
+  uint8_t index = SP[sw].Assign_number;
+  if (assign_cache_valid & (1ULL << index)) assign_request(sw);
+  else if (address != VG99_assigns[index].Address) { // Block did not arrive complete - read the assign on its own
+    last_requested_sysex_address = VG99_assigns[index].Address;
+    request_sysex(last_requested_sysex_address, VG99_ASSIGN_SIZE);
+  }
+  else PAGE_request_next_switch();
+}
+
+FLASHMEM void MD_VG99_class::assign_request(uint8_t sw) { // Read the assign from the cache and request the target state
   bool assign_on, found;
   String msg;
-  uint8_t assign_switch = sxdata[11];
-  uint16_t assign_target = (sxdata[12] << 8) + sxdata[13];
-  uint16_t assign_target_min = (sxdata[14] << 8) + sxdata[15];
-  uint16_t assign_target_max = (sxdata[16] << 8) + sxdata[17];
-  uint8_t assign_latch = sxdata[18];
-  uint8_t assign_source = sxdata[24]; // As sxdata[23] is always 0, we will not bother reading it.
+  const uint8_t *assign_data = VG99_assign_cache[SP[sw].Assign_number];
+  uint8_t assign_switch = assign_data[0];
+  uint16_t assign_target = (assign_data[1] << 8) + assign_data[2];
+  uint16_t assign_target_min = (assign_data[3] << 8) + assign_data[4];
+  uint16_t assign_target_max = (assign_data[5] << 8) + assign_data[6];
+  uint8_t assign_latch = assign_data[7];
+  uint8_t assign_source = assign_data[13]; // As assign_data[12] is always 0, we will not bother reading it.
 
   // Check for valid assign. We have three options
   // 1) CTL assign with FC300 CTL as source
@@ -1344,20 +1437,23 @@ FLASHMEM void MD_VG99_class::read_current_assign(uint8_t sw, uint32_t address, c
   }
 }
 
-FLASHMEM bool MD_VG99_class::target_lookup(uint8_t sw, uint16_t target) {  // Finds the target and its address in the VG99_parameters table
+uint16_t VG99_target_keys[VG99_NUMBER_OF_PARAMETERS]; // Index of VG99_parameters sorted on address
+uint16_t VG99_target_index[VG99_NUMBER_OF_PARAMETERS];
 
-  // Lookup in VG99_parameter array
-  //uint8_t part = (target / 0x1000); // As the array is divided in addresses by 1000, it is easy to find the right part
-  bool found = false;
+FLASHMEM void MD_VG99_class::build_target_index() {
   for (uint16_t i = 0; i < VG99_NUMBER_OF_PARAMETERS; i++) {
-    //if (VG99_parameters[i].Address == 0) break; //Break the loop if there is no more useful data
-    if (target == VG99_parameters[i].Address) { //Check is we've found the right target
-      SP[sw].PP_number = i; // Save the index number
-      found = true;
-      break;
-    }
+    VG99_target_keys[i] = VG99_parameters[i].Address;
+    VG99_target_index[i] = i;
   }
-  return found;
+  PAR_index_sort(VG99_target_keys, VG99_target_index, VG99_NUMBER_OF_PARAMETERS);
+}
+
+FLASHMEM bool MD_VG99_class::target_lookup(uint8_t sw, uint16_t target) {  // Finds the target and its address in the VG99_parameters table
+  // On the VG99 the target is the address of the parameter
+  uint16_t index = PAR_index_lookup(VG99_target_keys, VG99_target_index, VG99_NUMBER_OF_PARAMETERS, target);
+  if (index == NO_RESULT) return false;
+  SP[sw].PP_number = index; // Save the index number
+  return true;
 }
 
 FLASHMEM void MD_VG99_class::move_expression_pedal(uint8_t sw, uint8_t value, uint8_t exp_pedal) {
@@ -155,41 +155,43 @@ FLASHMEM void MD_ZMS_class::do_after_dev_type_update() {
 
 // ********************************* Section 2: ZOOM MS SERIES common MIDI in functions ********************************************
 
+// Zoom sends patch data in groups of eight bytes: the first byte holds bit 8 of the next seven bytes (bit 6 for the first byte, bit 0 for the last one).
+// The patch data is unpacked once when it is received, so names and FX data can be read from fixed positions.
+#define ZMS_CURRENT_PATCH_DATA_START 5 // Packed data starts after F0 52 <device id> <model> 28
+#define ZMS_PATCH_DUMP_DATA_START 10 // Packed data starts after F0 52 <device id> <model> 08 00 00 <patch> 00 00
+#define ZMS_UNPACKED_PATCH_SIZE 128
+#define ZMS_FX_SLOT_SIZE 18 // Every FX slot takes 18 bytes of unpacked data
+#define ZMS_FX_SLOT_TYPE_BYTE 3 // The FX type byte in the FX slot
+#define ZMS_NAME_POSITION 111 // Position of the patch name in the unpacked data of the MS50G and MS70CDR
+#define ZMS60B_NAME_POSITION 75 // Position of the patch name in the unpacked data of the MS60B
+#define ZMS_NAME_LENGTH 10
+
+FLASHMEM uint16_t ZOOM_unpack_7bit(const uint8_t *packed, uint16_t packed_len, uint8_t *unpacked, uint16_t max_len) { // Returns the number of unpacked bytes
+  uint16_t len = 0;
+  for (uint16_t g = 0; g < packed_len; g += 8) {
+    uint8_t high_bits = packed[g];
+    for (uint8_t i = 0; (i < 7) && (g + 1 + i < packed_len) && (len < max_len); i++) {
+      unpacked[len++] = packed[g + 1 + i] | (((high_bits >> (6 - i)) & 1) << 7);
+    }
+  }
+  return len;
+}
+
+FLASHMEM uint16_t ZOOM_packed_index(uint16_t unpacked_index) { // Returns the position of an unpacked byte in the packed data
+  return ((unpacked_index / 7) * 8) + 1 + (unpacked_index % 7);
+}
+
 FLASHMEM void MD_ZMS_class::check_SYSEX_in(const unsigned char* sxdata, short unsigned int sxlength, uint8_t port) { // Check incoming sysex messages from  Called from MIDI:OnSysEx/OnSerialSysEx
 
   // Check if it is a message from a ZOOM MS SERIES
   if ((port == MIDI_in_port) && (sxdata[1] == 0x52) && (sxdata[2] == MIDI_device_id) && (sxdata[3] == model_number)) {
+    uint8_t patch_data[ZMS_UNPACKED_PATCH_SIZE];
 
     // Check if it is patch data for a specific patch
     if ((sxdata[4] == 0x08)  && (sxdata[7] == last_requested_sysex_patch_number)) {
       if  (sxlength == sysex_size + 10) { // Check if full sysex message is read...
-        if (model_number != ZMS60B_MODEL_NUMBER) {
-          // Read the patch name - needs to be read in three parts, to sail around the overflow bytes.
-          // Read the first character of the name
-          SP[last_requested_sysex_switch].Label[0] = static_cast<char>(sxdata[0x89]); //Add first character ascii character to the SP.Label String
-          for (uint8_t count = 1; count < 8; count++) { // Read the next seven characters of the name
-            SP[last_requested_sysex_switch].Label[count] = static_cast<char>(sxdata[count + 0x8A]); //Add byte 2 - 8 to ascii character to the SP.Label String
-          }
-          for (uint8_t count = 8; count < 10; count++) { // Read the last two characters of the name
-            SP[last_requested_sysex_switch].Label[count] = static_cast<char>(sxdata[count + 0x8B]); //Add byte 9 and 10 to ascii character to the SP.Label String
-          }
-          for (uint8_t count = 10; count < 16; count++) { // Fill the rest with spaces
-            SP[last_requested_sysex_switch].Label[count] = ' ';
-          }
-        }
-        else { // MS60B
-          // Read the current patch name - needs to be read in two parts, because the third byte in the patchname string is a 0.
-          current_patch_name[0] = static_cast<char>(CP_MEM[96]);
-          current_patch_name[1] = static_cast<char>(CP_MEM[97]);
-          for (uint8_t count = 2; count < 9; count++) { // Read the last nine characters of the name
-            current_patch_name[count] = static_cast<char>(CP_MEM[count + 97]); //Add byte 3 - 9 to ascii character to the SP.Label String
-          }
-          current_patch_name[9] = static_cast<char>(CP_MEM[107]);
-        }
-
-        for (uint8_t count = 10; count < 16; count++) { // Fill the rest with spaces
-          SP[last_requested_sysex_switch].Label[count] = ' ';
-        }
+        uint16_t len = ZOOM_unpack_7bit(&sxdata[ZMS_PATCH_DUMP_DATA_START], sxlength - ZMS_PATCH_DUMP_DATA_START - 1, patch_data, ZMS_UNPACKED_PATCH_SIZE);
+        read_patch_name(patch_data, len, SP[last_requested_sysex_switch].Label);
         DEBUGMSG (SP[last_requested_sysex_switch].Label);
 
         if (SP[last_requested_sysex_switch].PP_number == patch_number) {
@@ -211,35 +213,15 @@ FLASHMEM void MD_ZMS_class::check_SYSEX_in(const unsigned char* sxdata, short un
         CP_MEM_current = true;
         DEBUGMSG("Copied current patch to CP_MEM");
 
-        // Here we read the FX types and states from the current patch memory (CP_MEM)
-        FX[0] = FXtypeMangler(CP_MEM[6] + ((CP_MEM[5] & B01000000) << 1), CP_MEM[7], CP_MEM[9]);
-        FX[1] = FXtypeMangler(CP_MEM[26] + ((CP_MEM[21] & B00000100) << 5), CP_MEM[27], CP_MEM[30]);
-        FX[2] = FXtypeMangler(CP_MEM[47] + ((CP_MEM[45] & B00100000) << 2), CP_MEM[48], CP_MEM[50]);
-        FX[3] = FXtypeMangler(CP_MEM[67] + ((CP_MEM[61] & B00000010) << 6), CP_MEM[68], CP_MEM[71]);
-        if (number_of_fx == 6) {
-          FX[4] = FXtypeMangler(CP_MEM[88] + ((CP_MEM[85] & B00010000) << 3), CP_MEM[89], CP_MEM[91]);
-          FX[5] = FXtypeMangler(CP_MEM[108] + ((CP_MEM[101] & B00000001) << 7), CP_MEM[110], CP_MEM[112]);
-        }
-
-        if (model_number != ZMS60B_MODEL_NUMBER) {
-          // Read the current patch name - needs to be read in two parts, because the eighth byte in the patchname string is a 0.
-          current_patch_name[0] = static_cast<char>(CP_MEM[0x84]); //Add first character ascii character to the SP.Label String
-          for (uint8_t count = 1; count < 8; count++) { // Read the last nine characters of the name
-            current_patch_name[count] = static_cast<char>(CP_MEM[count + 0x85]); //Add byte 2 - 8 to ascii character to the SP.Label String
-          }
-          for (uint8_t count = 8; count < 10; count++) { // Read the last nine characters of the name
-            current_patch_name[count] = static_cast<char>(CP_MEM[count + 0x86]); //Add byte 9 and 10 to ascii character to the SP.Label String
-          }
-        }
-        else { // MS60B
-          // Read the current patch name - needs to be read in two parts, because the third byte in the patchname string is a 0.
-          current_patch_name[0] = static_cast<char>(CP_MEM[91]);
-          current_patch_name[1] = static_cast<char>(CP_MEM[92]);
-          for (uint8_t count = 2; count < 9; count++) { // Read the last nine characters of the name
-            current_patch_name[count] = static_cast<char>(CP_MEM[count + 92]); //Add byte 3 - 9 to ascii character to the SP.Label String
-          }
-          current_patch_name[9] = static_cast<char>(CP_MEM[102]);
+        // Here we read the FX types and states and the patch name from the unpacked patch data
+        uint16_t len = ZOOM_unpack_7bit(&CP_MEM[ZMS_CURRENT_PATCH_DATA_START], sysex_size - ZMS_CURRENT_PATCH_DATA_START - 1, patch_data, ZMS_UNPACKED_PATCH_SIZE);
+        for (uint8_t f = 0; f < number_of_fx; f++) {
+          uint16_t slot = f * ZMS_FX_SLOT_SIZE;
+          if (slot + ZMS_FX_SLOT_TYPE_BYTE < len) FX[f] = FXtypeMangler(&patch_data[slot]);
         }
+        char name[17];
+        read_patch_name(patch_data, len, name);
+        current_patch_name = name;
 
         MIDI_enable_device_check();
         update_main_lcd = true;
@@ -262,16 +244,20 @@ FLASHMEM void MD_ZMS_class::check_SYSEX_in(const unsigned char* sxdata, short un
   }
 }
 
-FLASHMEM uint16_t MD_ZMS_class::FXtypeMangler(uint8_t byte1, uint8_t byte2, uint8_t byte4) {
-  // We will read three bytes from the sysex stream. All of them contain some bits that together make the FX type
-  // Byte1 is the first byte of every fx slot
-  // Bit one of Byte1 signals whether the effect is on or off
-  // Bit 5-8 are all relevant for the effect type
-
-  // Byte2 is the second byte of every fx slot
-  // AFAIK only the first three bits are relevant for the effect type
+FLASHMEM void MD_ZMS_class::read_patch_name(const uint8_t *patch_data, uint16_t len, char *name) { // Reads the name from unpacked patch data and pads it with spaces to 16 characters
+  uint8_t pos = (model_number == ZMS60B_MODEL_NUMBER) ? ZMS60B_NAME_POSITION : ZMS_NAME_POSITION;
+  for (uint8_t count = 0; count < 16; count++) {
+    if ((count < ZMS_NAME_LENGTH) && (pos + count < len)) name[count] = static_cast<char>(patch_data[pos + count]);
+    else name[count] = ' ';
+  }
+  name[16] = 0;
+}
 
-  // Byte4 is the fourth byte of every fx stream - this one contain the effect type. The following values are known
+FLASHMEM uint16_t MD_ZMS_class::FXtypeMangler(const uint8_t *fx_slot) {
+  // The FX type is made from bits in three bytes of the unpacked FX slot
+  // Byte 0: bit 0 is the effect state, bit 3-7 are relevant for the effect type
+  // Byte 1: bit 0-3 are relevant for the effect type
+  // Byte 3: contains the effect category. The following values are known
   // 02: Reverb?
   // 04: Eq effects
   // 12: Chorus effects
@@ -280,10 +266,10 @@ FLASHMEM uint16_t MD_ZMS_class::FXtypeMangler(uint8_t byte1, uint8_t byte2, uint
   // 18: Reverb effects
 
   // We will search for the right effect type
-  uint16_t my_type = FXsearch((byte4 & 0x1F), (byte1 & 0xF8) + (byte2 & 0x0F)); // We include bit 4 from byte1, so the difference between HD Hall and HD reverb is clear.
-  DEBUGMSG("Input: type:" + String(byte4 & 0x1F) + ", fx:" + String((byte1 & 0xF8) + (byte2 & 0x0F)));
+  uint16_t my_type = FXsearch((fx_slot[ZMS_FX_SLOT_TYPE_BYTE] & 0x1F), (fx_slot[0] & 0xF8) + (fx_slot[1] & 0x0F)); // We include bit 4 from byte 0, so the difference between HD Hall and HD reverb is clear.
+  DEBUGMSG("Input: type:" + String(fx_slot[ZMS_FX_SLOT_TYPE_BYTE] & 0x1F) + ", fx:" + String((fx_slot[0] & 0xF8) + (fx_slot[1] & 0x0F)));
   // Then we will return the effect index + the effect state
-  return (my_type << 1) + (byte1 & 1);
+  return (my_type << 1) + (fx_slot[0] & 1);
 }
 
 // Detection of Zoom MS SERIES
@@ -413,227 +399,227 @@ struct ZMS_FX_type_struct { // Combines all the data we need for controlling a p
   uint8_t Colour; // The colour for this effect.
 };
 
-const PROGMEM ZMS_FX_type_struct ZMS_FX_types[] = { // Table with the name and colour for every effect of the Zoom MS SERIES
-  {0, 0,    "---", FX_TYPE_OFF}, // 01
-  {12, 195, "CoronaCho", FX_MODULATE_TYPE}, // 02
-  {12, 224, "Chorus", FX_MODULATE_TYPE}, // 03
-  {12, 33,  "VintageCE", FX_MODULATE_TYPE}, // 04
-  {12, 227, "ANA 234Cho", FX_MODULATE_TYPE}, // 05
-  {12, 3,   "CE-Cho5", FX_MODULATE_TYPE}, // 06
-  {12, 35,  "Clone Chorus", FX_MODULATE_TYPE}, // 07
-  {12, 161, "Super Cho", FX_MODULATE_TYPE}, // 08
-  {12, 163, "Mirage Chorus", FX_MODULATE_TYPE}, // 09
-  {12, 65,  "Stereo Cho", FX_MODULATE_TYPE}, // 10
-  {12, 4,   "Corona Tri", FX_MODULATE_TYPE}, // 11
-  {12, 97,  "Ensemble", FX_MODULATE_TYPE}, // 12
-  {12, 131, "Silky Chorus", FX_MODULATE_TYPE}, // 13
-  {12, 1,   "Detune", FX_MODULATE_TYPE}, // 14
-  {12, 240, "Bass Chorus", FX_MODULATE_TYPE}, // 15
-  {12, 17,  "Bass Detune", FX_MODULATE_TYPE}, // 16
-  {12, 113, "Bass Ensemble", FX_MODULATE_TYPE}, // 17
-  {12, 193, "Flanger", FX_MODULATE_TYPE}, // 18
-  {12, 209, "Bass Flanger", FX_MODULATE_TYPE}, // 19
-  {12, 2,   "Vibrato", FX_MODULATE_TYPE}, // 20
-  {12, 96,  "Phaser", FX_MODULATE_TYPE}, // 21
-  {12, 128, "The Vibe", FX_MODULATE_TYPE}, // 22
-  {12, 66,  "Pitch SHFT", FX_MODULATE_TYPE}, // 23
-  {12, 130, "HPS", FX_MODULATE_TYPE}, // 24
-  {12, 114, "Bass Pitch", FX_MODULATE_TYPE}, // 25
-  {12, 32,  "Duo-Trem", FX_MODULATE_TYPE}, // 26
-  {14, 160, "Auto-Pan", FX_MODULATE_TYPE}, // 27
-  {14, 192, "Roto Closet", FX_MODULATE_TYPE}, // 28
-  {16, 193, "Duo Digital Dly", FX_DELAY_TYPE}, // 29
-  {16, 16,  "Delay", FX_DELAY_TYPE}, // 30
-  {16, 129, "Stomp Dly", FX_DELAY_TYPE}, // 31
-  {16, 33,  "Stereo Delay", FX_DELAY_TYPE}, // 32
-  {16, 225, "Carbon Delay", FX_DELAY_TYPE}, // 33
-  {16, 96,  "Analog DLY", FX_DELAY_TYPE}, // 34
-  {16, 32,  "Tape Echo", FX_DELAY_TYPE}, // 35
-  {16, 161, "Tape Echo3", FX_DELAY_TYPE}, // 36
-  {16, 2,   "Drive Echo", FX_DELAY_TYPE}, // 37
-  {16, 34,  "Slapback Delay", FX_DELAY_TYPE}, // 38
-  {16, 66,  "Smooth Delay", FX_DELAY_TYPE}, // 39
-  {16, 160, "Multi Tap Delay", FX_DELAY_TYPE}, // 40
-  {16, 128, "Reverse Delay", FX_DELAY_TYPE}, // 41
-  {16, 98,  "Lo-Fi Delay", FX_DELAY_TYPE}, // 42
-  {16, 130, "Slow Attack Dly", FX_DELAY_TYPE}, // 43
-  {16, 192, "Dyna Delay", FX_DELAY_TYPE}, // 44
-  {16, 162, "Tremolo Delay", FX_DELAY_TYPE}, // 45
-  {16, 64,  "ModDelay", FX_DELAY_TYPE}, // 46
-  {16, 97,  "Trigger Hold Dly", FX_DELAY_TYPE}, // 47
-  {16, 194, "Filter PP-Delay", FX_DELAY_TYPE}, // 48
-  {16, 224, "Filter Dly", FX_DELAY_TYPE}, // 49
-  {16, 65,  "Phase Delay", FX_DELAY_TYPE}, // 50
-  {16, 226, "Auto Pan Delay", FX_DELAY_TYPE}, // 51
-  {16, 1,   "Pitch Delay", FX_DELAY_TYPE}, // 52
-  {16, 3,   "ICE Delay", FX_DELAY_TYPE}, // 53
-  {16, 80,  "ModDelay2", FX_DELAY_TYPE}, // 54
-  {18, 24,  "HD Reverb", FX_REVERB_TYPE}, // 55
-  {18, 128, "Spring", FX_REVERB_TYPE}, // 56
-  {18, 129, "Spring63", FX_REVERB_TYPE}, // 57
-  {18, 33,  "Plate", FX_REVERB_TYPE}, // 58
-  {18, 64,  "Room", FX_REVERB_TYPE}, // 59
-  {18, 96,  "Tiled Room", FX_REVERB_TYPE}, // 60
-  {18, 161, "Chamber", FX_REVERB_TYPE}, // 61
-  {18, 193, "LoFi Reverb", FX_REVERB_TYPE}, // 62
-  {18, 32,  "Hall", FX_REVERB_TYPE}, // 63
-  {18, 16,  "HD Hall", FX_REVERB_TYPE}, // 64
-  {18, 225, "Church", FX_REVERB_TYPE}, // 65
-  {18, 160, "Arena Reverb", FX_REVERB_TYPE}, // 66
-  {18, 2,   "Cave", FX_REVERB_TYPE}, // 67
-  {18, 34,  "Ambience", FX_REVERB_TYPE}, // 68
-  {18, 224, "AIR", FX_REVERB_TYPE}, // 69
-  {18, 192, "Early Reflection", FX_REVERB_TYPE}, // 70
-  {18, 66,  "Gate Reverb", FX_REVERB_TYPE}, // 71
-  {18, 98,  "Revere Reverb", FX_REVERB_TYPE}, // 72
-  {18, 97,  "Slap Back Reverb", FX_REVERB_TYPE}, // 73
-  {18, 130, "Echo", FX_REVERB_TYPE}, // 74
-  {18, 65,  "Mod Reverb", FX_REVERB_TYPE}, // 75
-  {18, 162, "Tremelo Reverb", FX_REVERB_TYPE}, // 76
-  {18, 194, "Holy Flerb", FX_REVERB_TYPE}, // 77
-  {18, 226, "Dynamic Reverb", FX_REVERB_TYPE}, // 78
-  {18, 3,   "Shimmer Reverb", FX_REVERB_TYPE}, // 79
-  {18, 35,  "Particle Reverb", FX_REVERB_TYPE}, // 80
-  {18, 67,  "Space Hole", FX_REVERB_TYPE}, // 81
-  {18, 99,  "Mangled Space", FX_REVERB_TYPE}, // 82
-  {18, 131, "Dual Reverb", FX_REVERB_TYPE}, // 83
-  {2, 160,  "ZNR", FX_DYNAMICS_TYPE}, // 84
-  {4, 193,  "Stereo Gtr GEQ", FX_FILTER_TYPE}, // 85
-  {4, 2,    "Stereo Bass GEQ", FX_FILTER_TYPE}, // 86
-  {4, 16,   "LineSel", FX_GTR_TYPE}, // 87
-  {12, 16,  "Tremolo", FX_MODULATE_TYPE}, // New FX from firmware version 2.00
-  {12, 64,  "Slicer", FX_MODULATE_TYPE},
-  {12, 104, "Duo-Phase", FX_MODULATE_TYPE},
-  {12, 112,  "Warp Phaser", FX_MODULATE_TYPE},
-  {12, 177, "VinFLNGR", FX_MODULATE_TYPE},
-  {12, 225, "DynaFLNGR", FX_MODULATE_TYPE},
+const PROGMEM ZMS_FX_type_struct ZMS_FX_types[] = { // Table with the name and colour for every effect of the Zoom MS SERIES - sorted by Type and Number for FXsearch()
+  {0, 0,   "---", FX_TYPE_OFF},
+  {2, 1,   "Orange Lim", FX_DYNAMICS_TYPE},
+  {2, 16,  "COMP", FX_DYNAMICS_TYPE},
+  {2, 32,  "Rock Comp", FX_DYNAMICS_TYPE},
+  {2, 33,  "Gray Comp", FX_DYNAMICS_TYPE},
+  {2, 48,  "D Comp", FX_DYNAMICS_TYPE},
+  {2, 64,  "M Comp", FX_DYNAMICS_TYPE},
+  {2, 65,  "Dual Comp", FX_DYNAMICS_TYPE},
+  {2, 96,  "Opto Comp", FX_DYNAMICS_TYPE},
+  {2, 104, "160 COMP", FX_DYNAMICS_TYPE},
+  {2, 112, "Limiter", FX_DYNAMICS_TYPE},
+  {2, 128, "Slow Attack", FX_FILTER_TYPE},
+  {2, 160, "ZNR", FX_DYNAMICS_TYPE},
+  {2, 192, "Noise Gate", FX_DYNAMICS_TYPE},
+  {2, 224, "Dirty Gate", FX_DYNAMICS_TYPE},
+  {4, 1,   "Slow Filter", FX_FILTER_TYPE},
+  {4, 2,   "Stereo Bass GEQ", FX_FILTER_TYPE},
+  {4, 16,  "LineSel", FX_GTR_TYPE},
+  {4, 17,  "Z Tron", FX_FILTER_TYPE},
+  {4, 32,  "Graphic EQ", FX_FILTER_TYPE},
+  {4, 33,  "M-Filter", FX_FILTER_TYPE},
+  {4, 41,  "A-Filter", FX_FILTER_TYPE},
+  {4, 48,  "Bass Graphic EQ", FX_FILTER_TYPE},
+  {4, 49,  "Bass Cry", FX_WAH_TYPE},
+  {4, 64,  "Para EQ", FX_FILTER_TYPE},
+  {4, 65,  "STEP", FX_WAH_TYPE},
+  {4, 72,  "Bass Para EQ", FX_FILTER_TYPE},
+  {4, 80,  "Splitter", FX_FILTER_TYPE},
+  {4, 88,  "Bottom B", FX_FILTER_TYPE},
+  {4, 96,  "Exciter", FX_FILTER_TYPE},
+  {4, 97,  "SEQ Filter", FX_FILTER_TYPE},
+  {4, 128, "Comb FLTR", FX_FILTER_TYPE},
+  {4, 129, "Random Filter", FX_FILTER_TYPE},
+  {4, 160, "Auto Wah", FX_WAH_TYPE},
+  {4, 161, "FCycle", FX_FILTER_TYPE},
+  {4, 176, "Bass Auto Wah", FX_WAH_TYPE},
+  {4, 192, "Resonance", FX_WAH_TYPE},
+  {4, 193, "Stereo Gtr GEQ", FX_FILTER_TYPE},
+  {4, 224, "Cry", FX_WAH_TYPE},
+  {6, 1,   "Great Muff", FX_DIST_TYPE},
+  {6, 2,   "Z Neos", FX_DIST_TYPE},
+  {6, 3,   "BG Throttle", FX_DIST_TYPE},
+  {6, 16,  "Booster", FX_DIST_TYPE},
+  {6, 32,  "Overdrive", FX_DIST_TYPE},
+  {6, 34,  "Z Wild", FX_DIST_TYPE},
+  {6, 35,  "Oct Fuzz", FX_DIST_TYPE},
+  {6, 36,  "Dynamic Drive", FX_DIST_TYPE},
+  {6, 64,  "T Scream", FX_DIST_TYPE},
+  {6, 65,  "HotBox", FX_DIST_TYPE},
+  {6, 66,  "Zoom 9002 Lead", FX_DIST_TYPE},
+  {6, 67,  "BG Grid", FX_DIST_TYPE},
+  {6, 96,  "Governor", FX_DIST_TYPE},
+  {6, 97,  "Z Clean", FX_DIST_TYPE},
+  {6, 98,  "Extreme Dist", FX_DIST_TYPE},
+  {6, 99,  "Red Crunch", FX_DIST_TYPE},
+  {6, 128, "Dist +", FX_DIST_TYPE},
+  {6, 129, "Z MP1", FX_DIST_TYPE},
+  {6, 130, "Acoustic", FX_DIST_TYPE},
+  {6, 131, "TB MK 1.5", FX_DIST_TYPE},
+  {6, 160, "Dist 1", FX_DIST_TYPE},
+  {6, 161, "Z Bottom", FX_DIST_TYPE},
+  {6, 162, "CentaGold", FX_DIST_TYPE},
+  {6, 163, "Sweet Drive", FX_DIST_TYPE},
+  {6, 192, "Squeak", FX_DIST_TYPE},
+  {6, 193, "Z Dream", FX_DIST_TYPE},
+  {6, 194, "NYC Muff", FX_DIST_TYPE},
+  {6, 224, "Fuzz Smile", FX_DIST_TYPE},
+  {6, 225, "Z Scream", FX_DIST_TYPE},
+  {6, 226, "TS Drive", FX_DIST_TYPE},
+  {6, 227, "RC Boost", FX_DIST_TYPE},
+  {8, 1,   "Car Drive", FX_AMP_TYPE},
+  {8, 2,   "MS Drive", FX_AMP_TYPE},
+  {8, 16,  "FD Combo", FX_AMP_TYPE},
+  {8, 32,  "Deluxe-R", FX_AMP_TYPE},
+  {8, 33,  "TW Rock", FX_AMP_TYPE},
+  {8, 34,  "BGN DRV", FX_AMP_TYPE},
+  {8, 64,  "FD Vibro", FX_AMP_TYPE},
+  {8, 65,  "Tone City", FX_AMP_TYPE},
+  {8, 66,  "BG Drive", FX_AMP_TYPE},
+  {8, 96,  "US Blues", FX_AMP_TYPE},
+  {8, 97,  "HW Stack", FX_AMP_TYPE},
+  {8, 98,  "DZ Drive", FX_AMP_TYPE},
+  {8, 128, "VX Combo", FX_AMP_TYPE},
+  {8, 129, "Tangerine", FX_AMP_TYPE},
+  {8, 130, "Alien", FX_AMP_TYPE},
+  {8, 160, "VX Jimi", FX_AMP_TYPE},
+  {8, 161, "B-Breaker", FX_AMP_TYPE},
+  {8, 162, "Revo T", FX_AMP_TYPE},
+  {8, 192, "BG Crunch", FX_AMP_TYPE},
+  {8, 193, "MS Crunch", FX_AMP_TYPE},
+  {8, 224, "Match30", FX_AMP_TYPE},
+  {8, 225, "MS 1959", FX_AMP_TYPE},
+  {10, 1,   "Monotone", FX_AMP_TYPE},
+  {10, 33,  "Super B", FX_AMP_TYPE},
+  {10, 65,  "G-Krueger", FX_AMP_TYPE},
+  {10, 97,  "The Heaven", FX_AMP_TYPE},
+  {10, 128, "SMR", FX_AMP_TYPE},
+  {10, 160, "Flip Top", FX_AMP_TYPE},
+  {12, 1,   "Detune", FX_MODULATE_TYPE},
+  {12, 2,   "Vibrato", FX_MODULATE_TYPE},
+  {12, 3,   "CE-Cho5", FX_MODULATE_TYPE},
+  {12, 4,   "Corona Tri", FX_MODULATE_TYPE},
+  {12, 16,  "Tremolo", FX_MODULATE_TYPE},
+  {12, 17,  "Bass Detune", FX_MODULATE_TYPE},
+  {12, 32,  "Duo-Trem", FX_MODULATE_TYPE},
+  {12, 33,  "VintageCE", FX_MODULATE_TYPE},
   {12, 34,  "Octave", FX_MODULATE_TYPE},
+  {12, 35,  "Clone Chorus", FX_MODULATE_TYPE},
   {12, 50,  "Bass Octave", FX_MODULATE_TYPE},
+  {12, 64,  "Slicer", FX_MODULATE_TYPE},
+  {12, 65,  "Stereo Cho", FX_MODULATE_TYPE},
+  {12, 66,  "Pitch SHFT", FX_MODULATE_TYPE},
+  {12, 67,  "Stone Phase", FX_MODULATE_TYPE},
+  {12, 96,  "Phaser", FX_MODULATE_TYPE},
+  {12, 97,  "Ensemble", FX_MODULATE_TYPE},
   {12, 98,  "Mono Pitch", FX_MODULATE_TYPE},
+  {12, 99,  "BF FLG 2", FX_MODULATE_TYPE},
+  {12, 104, "Duo-Phase", FX_MODULATE_TYPE},
+  {12, 112, "Warp Phaser", FX_MODULATE_TYPE},
+  {12, 113, "Bass Ensemble", FX_MODULATE_TYPE},
+  {12, 114, "Bass Pitch", FX_MODULATE_TYPE},
+  {12, 128, "The Vibe", FX_MODULATE_TYPE},
+  {12, 130, "HPS", FX_MODULATE_TYPE},
+  {12, 131, "Silky Chorus", FX_MODULATE_TYPE},
+  {12, 161, "Super Cho", FX_MODULATE_TYPE},
   {12, 162, "Bend Cho", FX_MODULATE_TYPE},
+  {12, 163, "Mirage Chorus", FX_MODULATE_TYPE},
+  {12, 177, "VinFLNGR", FX_MODULATE_TYPE},
+  {12, 193, "Flanger", FX_MODULATE_TYPE},
   {12, 194, "Mojo Roller", FX_MODULATE_TYPE},
+  {12, 195, "CoronaCho", FX_MODULATE_TYPE},
+  {12, 209, "Bass Flanger", FX_MODULATE_TYPE},
+  {12, 224, "Chorus", FX_MODULATE_TYPE},
+  {12, 225, "DynaFLNGR", FX_MODULATE_TYPE},
   {12, 226, "Ring Mod", FX_MODULATE_TYPE},
-  {12, 67,  "Stone Phase", FX_MODULATE_TYPE},
-  {12, 99,  "BF FLG 2", FX_MODULATE_TYPE},
+  {12, 227, "ANA 234Cho", FX_MODULATE_TYPE},
+  {12, 240, "Bass Chorus", FX_MODULATE_TYPE},
+  {14, 1,   "Syn Tlk", FX_FILTER_TYPE},
   {14, 32,  "Bit Crush", FX_MODULATE_TYPE},
   {14, 64,  "Bomber", FX_MODULATE_TYPE},
+  {14, 65,  "Defret", FX_FILTER_TYPE},
   {14, 96,  "Mono Synth", FX_MODULATE_TYPE},
-  {14, 128, "Z-Organ", FX_MODULATE_TYPE},
-  {2, 16,   "COMP", FX_DYNAMICS_TYPE},
-  {2, 32,   "Rock Comp", FX_DYNAMICS_TYPE},
-  {2, 64,   "M Comp", FX_DYNAMICS_TYPE},
-  {2, 96,   "Opto Comp", FX_DYNAMICS_TYPE},
-  {2, 104,  "160 COMP", FX_DYNAMICS_TYPE},
-  {2, 112,  "Limiter", FX_DYNAMICS_TYPE},
-  {2, 128,  "Slow Attack", FX_FILTER_TYPE},
-  {2, 192,  "Noise Gate", FX_DYNAMICS_TYPE},
-  {2, 224,  "Dirty Gate", FX_DYNAMICS_TYPE},
-  {2, 1,    "Orange Lim", FX_DYNAMICS_TYPE},
-  {2, 33,   "Gray Comp", FX_DYNAMICS_TYPE},
-  {2, 65,   "Dual Comp", FX_DYNAMICS_TYPE},
-  {4, 32,   "Graphic EQ", FX_FILTER_TYPE},
-  {4, 48,   "Bass Graphic EQ", FX_FILTER_TYPE},
-  {4, 64,   "Para EQ", FX_FILTER_TYPE},
-  {4, 72,   "Bass Para EQ", FX_FILTER_TYPE},
-  {4, 80,   "Splitter", FX_FILTER_TYPE},
-  {4, 88,   "Bottom B", FX_FILTER_TYPE},
-  {4, 96,   "Exciter", FX_FILTER_TYPE},
-  {4, 128,  "Comb FLTR", FX_FILTER_TYPE},
-  {4, 160,  "Auto Wah", FX_WAH_TYPE},
-  {4, 176,  "Bass Auto Wah", FX_WAH_TYPE},
-  {4, 192,  "Resonance", FX_WAH_TYPE},
-  {4, 224,  "Cry", FX_WAH_TYPE},
-  {4, 1,    "Slow Filter", FX_FILTER_TYPE},
-  {4, 17,   "Z Tron", FX_FILTER_TYPE},
-  {4, 33,   "M-Filter", FX_FILTER_TYPE},
-  {4, 41,   "A-Filter", FX_FILTER_TYPE},
-  {4, 49,   "Bass Cry", FX_WAH_TYPE},
-  {4, 65,   "STEP", FX_WAH_TYPE},
-  {4, 97,   "SEQ Filter", FX_FILTER_TYPE},
-  {4, 129,  "Random Filter", FX_FILTER_TYPE},
-  {4, 161,  "FCycle", FX_FILTER_TYPE},
-  // Unique effects from MS-50G
-  {8, 16,   "FD Combo", FX_AMP_TYPE},
-  {8, 32,   "Deluxe-R", FX_AMP_TYPE},
-  {8, 64,   "FD Vibro", FX_AMP_TYPE},
-  {8, 96,   "US Blues", FX_AMP_TYPE},
-  {8, 128,  "VX Combo", FX_AMP_TYPE},
-  {8, 160,  "VX Jimi", FX_AMP_TYPE},
-  {8, 192,  "BG Crunch", FX_AMP_TYPE},
-  {8, 224,  "Match30", FX_AMP_TYPE},
-  {8, 1,    "Car Drive", FX_AMP_TYPE},
-  {8, 33,   "TW Rock", FX_AMP_TYPE},
-  {8, 65,   "Tone City", FX_AMP_TYPE},
-  {8, 97,   "HW Stack", FX_AMP_TYPE},
-  {8, 129,  "Tangerine", FX_AMP_TYPE},
-  {8, 161,  "B-Breaker", FX_AMP_TYPE},
-  {8, 193,  "MS Crunch", FX_AMP_TYPE},
-  {8, 225,  "MS 1959", FX_AMP_TYPE},
-  {8, 2,    "MS Drive", FX_AMP_TYPE},
-  {8, 34,   "BGN DRV", FX_AMP_TYPE},
-  {8, 66,   "BG Drive", FX_AMP_TYPE},
-  {8, 98,   "DZ Drive", FX_AMP_TYPE},
-  {8, 130,  "Alien", FX_AMP_TYPE},
-  {8, 162,  "Revo T", FX_AMP_TYPE},
-  {6, 16,   "Booster", FX_DIST_TYPE},
-  {6, 32,   "Overdrive", FX_DIST_TYPE},
-  {6, 64,   "T Scream", FX_DIST_TYPE},
-  {6, 96,   "Governor", FX_DIST_TYPE},
-  {6, 128,  "Dist +", FX_DIST_TYPE},
-  {6, 160,  "Dist 1", FX_DIST_TYPE},
-  {6, 192,  "Squeak", FX_DIST_TYPE},
-  {6, 224,  "Fuzz Smile", FX_DIST_TYPE},
-  {6, 1,    "Great Muff", FX_DIST_TYPE},
-  {6, 65,   "HotBox", FX_DIST_TYPE},
-  {6, 97,   "Z Clean", FX_DIST_TYPE},
-  {6, 129,  "Z MP1", FX_DIST_TYPE},
-  {6, 161,  "Z Bottom", FX_DIST_TYPE},
-  {6, 193,  "Z Dream", FX_DIST_TYPE},
-  {6, 225,  "Z Scream", FX_DIST_TYPE},
-  {6, 2,    "Z Neos", FX_DIST_TYPE},
-  {6, 34,   "Z Wild", FX_DIST_TYPE},
-  {6, 66,   "Zoom 9002 Lead", FX_DIST_TYPE},
-  {6, 98,   "Extreme Dist", FX_DIST_TYPE},
-  {6, 130,  "Acoustic", FX_DIST_TYPE},
-  {6, 162,  "CentaGold", FX_DIST_TYPE},
-  {6, 194,  "NYC Muff", FX_DIST_TYPE},
-  {6, 226,  "TS Drive", FX_DIST_TYPE},
-  {6, 3,    "BG Throttle", FX_DIST_TYPE},
-  {6, 35,   "Oct Fuzz", FX_DIST_TYPE},
-  {6, 67,   "BG Grid", FX_DIST_TYPE},
-  {6, 99,   "Red Crunch", FX_DIST_TYPE},
-  {6, 131,  "TB MK 1.5", FX_DIST_TYPE},
-  {6, 163,  "Sweet Drive", FX_DIST_TYPE},
-  {6, 227,  "RC Boost", FX_DIST_TYPE},
-  {6, 36,   "Dynamic Drive", FX_DIST_TYPE},
-  // Unique effects from MS-60B that do not crash the MS SERIES
-  {24, 65,  "T Scream", FX_DIST_TYPE},
-  {10, 128, "SMR", FX_AMP_TYPE},
-  {10, 160, "Flip Top", FX_AMP_TYPE},
-  {10, 1,   "Monotone", FX_AMP_TYPE},
-  {10, 33,  "Super B", FX_AMP_TYPE},
-  {10, 65,  "G-Krueger", FX_AMP_TYPE},
-  {10, 97,  "The Heaven", FX_AMP_TYPE},
   {14, 112, "Bass Synth", FX_FILTER_TYPE},
-  {14, 224, "Std Syn", FX_FILTER_TYPE},
-  {14, 1,   "Syn Tlk", FX_FILTER_TYPE},
-  {14, 65,  "Defret", FX_FILTER_TYPE},
+  {14, 128, "Z-Organ", FX_MODULATE_TYPE},
   {14, 129, "V-Syn", FX_FILTER_TYPE},
+  {14, 160, "Auto-Pan", FX_MODULATE_TYPE},
   {14, 161, "4VoiceSyn", FX_FILTER_TYPE},
-  {2, 48,   "D Comp", FX_DYNAMICS_TYPE},
+  {14, 192, "Roto Closet", FX_MODULATE_TYPE},
+  {14, 224, "Std Syn", FX_FILTER_TYPE},
+  {16, 1,   "Pitch Delay", FX_DELAY_TYPE},
+  {16, 2,   "Drive Echo", FX_DELAY_TYPE},
+  {16, 3,   "ICE Delay", FX_DELAY_TYPE},
+  {16, 16,  "Delay", FX_DELAY_TYPE},
+  {16, 32,  "Tape Echo", FX_DELAY_TYPE},
+  {16, 33,  "Stereo Delay", FX_DELAY_TYPE},
+  {16, 34,  "Slapback Delay", FX_DELAY_TYPE},
+  {16, 64,  "ModDelay", FX_DELAY_TYPE},
+  {16, 65,  "Phase Delay", FX_DELAY_TYPE},
+  {16, 66,  "Smooth Delay", FX_DELAY_TYPE},
+  {16, 80,  "ModDelay2", FX_DELAY_TYPE},
+  {16, 96,  "Analog DLY", FX_DELAY_TYPE},
+  {16, 97,  "Trigger Hold Dly", FX_DELAY_TYPE},
+  {16, 98,  "Lo-Fi Delay", FX_DELAY_TYPE},
+  {16, 128, "Reverse Delay", FX_DELAY_TYPE},
+  {16, 129, "Stomp Dly", FX_DELAY_TYPE},
+  {16, 130, "Slow Attack Dly", FX_DELAY_TYPE},
+  {16, 160, "Multi Tap Delay", FX_DELAY_TYPE},
+  {16, 161, "Tape Echo3", FX_DELAY_TYPE},
+  {16, 162, "Tremolo Delay", FX_DELAY_TYPE},
+  {16, 192, "Dyna Delay", FX_DELAY_TYPE},
+  {16, 193, "Duo Digital Dly", FX_DELAY_TYPE},
+  {16, 194, "Filter PP-Delay", FX_DELAY_TYPE},
+  {16, 224, "Filter Dly", FX_DELAY_TYPE},
+  {16, 225, "Carbon Delay", FX_DELAY_TYPE},
+  {16, 226, "Auto Pan Delay", FX_DELAY_TYPE},
+  {18, 2,   "Cave", FX_REVERB_TYPE},
+  {18, 3,   "Shimmer Reverb", FX_REVERB_TYPE},
+  {18, 16,  "HD Hall", FX_REVERB_TYPE},
+  {18, 24,  "HD Reverb", FX_REVERB_TYPE},
+  {18, 32,  "Hall", FX_REVERB_TYPE},
+  {18, 33,  "Plate", FX_REVERB_TYPE},
+  {18, 34,  "Ambience", FX_REVERB_TYPE},
+  {18, 35,  "Particle Reverb", FX_REVERB_TYPE},
+  {18, 64,  "Room", FX_REVERB_TYPE},
+  {18, 65,  "Mod Reverb", FX_REVERB_TYPE},
+  {18, 66,  "Gate Reverb", FX_REVERB_TYPE},
+  {18, 67,  "Space Hole", FX_REVERB_TYPE},
+  {18, 96,  "Tiled Room", FX_REVERB_TYPE},
+  {18, 97,  "Slap Back Reverb", FX_REVERB_TYPE},
+  {18, 98,  "Revere Reverb", FX_REVERB_TYPE},
+  {18, 99,  "Mangled Space", FX_REVERB_TYPE},
+  {18, 128, "Spring", FX_REVERB_TYPE},
+  {18, 129, "Spring63", FX_REVERB_TYPE},
+  {18, 130, "Echo", FX_REVERB_TYPE},
+  {18, 131, "Dual Reverb", FX_REVERB_TYPE},
+  {18, 160, "Arena Reverb", FX_REVERB_TYPE},
+  {18, 161, "Chamber", FX_REVERB_TYPE},
+  {18, 162, "Tremelo Reverb", FX_REVERB_TYPE},
+  {18, 192, "Early Reflection", FX_REVERB_TYPE},
+  {18, 193, "LoFi Reverb", FX_REVERB_TYPE},
+  {18, 194, "Holy Flerb", FX_REVERB_TYPE},
+  {18, 224, "AIR", FX_REVERB_TYPE},
+  {18, 225, "Church", FX_REVERB_TYPE},
+  {18, 226, "Dynamic Reverb", FX_REVERB_TYPE},
+  {24, 65,  "T Scream", FX_DIST_TYPE},
 };
 
 const uint8_t ZMS_NUMBER_OF_FX = sizeof(ZMS_FX_types) / sizeof(ZMS_FX_types[0]);
 
-FLASHMEM uint8_t MD_ZMS_class::FXsearch(uint8_t type, uint8_t number) {
-  uint8_t my_type = 0;
-  for (uint8_t i = 0; i < ZMS_NUMBER_OF_FX; i++) {
-    if ((ZMS_FX_types[i].Type == type) && (ZMS_FX_types[i].Number == number)) {
-      my_type = i;
-      break; // break loop when found
-    }
+FLASHMEM uint8_t MD_ZMS_class::FXsearch(uint8_t type, uint8_t number) { // Binary search in ZMS_FX_types. Returns 0 ("---") if the effect is unknown
+  uint16_t key = (type << 8) + number;
+  uint8_t low = 0;
+  uint8_t high = ZMS_NUMBER_OF_FX;
+  while (low < high) {
+    uint8_t mid = (low + high) / 2;
+    if (((ZMS_FX_types[mid].Type << 8) + ZMS_FX_types[mid].Number) < key) low = mid + 1;
+    else high = mid;
   }
-  return my_type; // Return index to the effect type
+  if ((low < ZMS_NUMBER_OF_FX) && (ZMS_FX_types[low].Type == type) && (ZMS_FX_types[low].Number == number)) return low; // Return index to the effect type
+  return 0;
 }
 
 FLASHMEM void MD_ZMS_class::parameter_press(uint8_t Sw, Cmd_struct *cmd, uint16_t number) {
@@ -641,14 +627,7 @@ FLASHMEM void MD_ZMS_class::parameter_press(uint8_t Sw, Cmd_struct *cmd, uint16_
   uint8_t value = SCO_return_parameter_value(Sw, cmd);
   bool FX_on = (value & 1);
   if (CP_MEM_current) { // Here we change the on/off bit in the patch data memory and write it back to the unit
-    switch (SP[Sw].PP_number) {
-      case 0: bitWrite(CP_MEM[6], 0, FX_on); break;
-      case 1: bitWrite(CP_MEM[26], 0, FX_on); break;
-      case 2: bitWrite(CP_MEM[47], 0, FX_on); break;
-      case 3: bitWrite(CP_MEM[67], 0, FX_on); break;
-      case 4: if (number_of_fx == 6) bitWrite(CP_MEM[88], 0, FX_on); break;
-      case 5: if (number_of_fx == 6) bitWrite(CP_MEM[108], 0, FX_on); break;
-    }
+    if (SP[Sw].PP_number < number_of_fx) bitWrite(CP_MEM[ZMS_CURRENT_PATCH_DATA_START + ZOOM_packed_index(SP[Sw].PP_number * ZMS_FX_SLOT_SIZE)], 0, FX_on); // Bit 0 of the first byte of the FX slot is the FX state
     write_current_effect_focus_to_cpmem(SP[Sw].PP_number);
     write_tempo_to_cpmem();
     send_current_patch(); // Write the updated patch memory to the MS SERIES
@@ -663,14 +642,7 @@ FLASHMEM void MD_ZMS_class::parameter_press(uint8_t Sw, Cmd_struct *cmd, uint16_
 FLASHMEM void MD_ZMS_class::parameter_release(uint8_t Sw, Cmd_struct *cmd, uint16_t number) {
   if (SP[Sw].Latch == MOMENTARY) {
     if (CP_MEM_current) { // Here we change the on/off bit in the patch data memory and write it back to the unit
-      switch (SP[Sw].PP_number) {
-        case 0: bitWrite(CP_MEM[6], 0, cmd->Value2); break;
-        case 1: bitWrite(CP_MEM[26], 0, cmd->Value2); break;
-        case 2: bitWrite(CP_MEM[47], 0, cmd->Value2); break;
-        case 3: bitWrite(CP_MEM[67], 0, cmd->Value2); break;
-        case 4: if (number_of_fx == 6) bitWrite(CP_MEM[88], 0, cmd->Value2); break;
-        case 5: if (number_of_fx == 6) bitWrite(CP_MEM[108], 0, cmd->Value2); break;
-      }
+      if (SP[Sw].PP_number < number_of_fx) bitWrite(CP_MEM[ZMS_CURRENT_PATCH_DATA_START + ZOOM_packed_index(SP[Sw].PP_number * ZMS_FX_SLOT_SIZE)], 0, cmd->Value2); // Bit 0 of the first byte of the FX slot is the FX state
       write_current_effect_focus_to_cpmem(SP[Sw].PP_number);
       write_tempo_to_cpmem();
       send_current_patch(); // Write the updated patch memory to the MS SERIES
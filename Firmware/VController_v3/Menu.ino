@@ -88,6 +88,7 @@ struct menu_struct {
 #define USER_MENU 23
 #define SETUP_USER_DEVICE_MENU 24
 #define SETUP_USER_PARAMETERS_MENU 25
+#define BASS_MODE_MENU 26
 
 #define DEVICE_SUBLIST 255
 #define PAGE_SUBLIST 254
@@ -150,7 +151,7 @@ const PROGMEM menu_struct menu[][15] = {
     { "Hide tempo LED", SET, 1, 0, 1, &Setting.Hide_tap_tempo_LED }, // Switch 7
     { "Backlight Type", SET, 51, 0, 1, &Setting.RGB_Backlight_scheme }, // Switch 8
     { "Show popups", SET, 130, 0, 2, &Setting.Show_popup_messages }, // Switch 9
-    { "", NONE }, // Switch 10
+    { "Part change at", SET, 145, 0, 2, &Setting.Song_part_change_timing }, // Switch 10
     { "SAVE & EXIT", SAVE_AND_EXIT, 1 }, // Switch 11
     { "Cancel", SAVE_AND_EXIT, 0 }, // Switch 12 (should not be of type NONE)
     { "", NONE }, // Switch 13 (LEFT)
@@ -172,7 +173,7 @@ const PROGMEM menu_struct menu[][15] = {
     { "SAVE & EXIT", SAVE_AND_EXIT, 1 }, // Switch 11
     { "Cancel", SAVE_AND_EXIT, 0 }, // Switch 12 (should not be of type NONE)
     { "SETUP USER DEVCE",  EXECUTE, USER_DEVICE_EDIT_SUBLIST, 0, 0, (void*)USER_setup_user_device }, // Switch 13 (LEFT)
-    { "", NONE }, // Switch 14 (RIGHT)
+    { "PC echo port", DEVICE_SET, 26, 0, NUMBER_OF_MIDI_PORTS + 1, (void*) 12 }, // Switch 14 (RIGHT)
   },
 
   { // Menu 3 - LED settings menu
@@ -344,7 +345,7 @@ const PROGMEM menu_struct menu[][15] = {
     { "Set Max (Toe)",  EXECUTE, 0, 0, 0, (void*)SC_set_expr_max }, // Switch 2
     { "Set Min (Heel)",  EXECUTE, 0, 0, 0, (void*)SC_set_expr_min },// Switch 3
     { "Auto Calibrate  ",  EXECUTE, 0, 0, 0, (void*)SC_set_auto_calibrate }, // Switch 4
-    { "", NONE }, // Switch 5
+    { "High res CC", SET, 1, 0, 1, &Setting.Exp_pedal_high_res_CC }, // Switch 5
     { "", NONE }, // Switch 6
     { "", NONE }, // Switch 7
     { "", NONE }, // Switch 8
@@ -394,7 +395,7 @@ const PROGMEM menu_struct menu[][15] = {
     { "SAVE & EXIT", SAVE_AND_EXIT, 1 }, // Switch 11
     { "Cancel", SAVE_AND_EXIT, 0 }, // Switch 12 (should not be of type NONE)
     { "", NONE }, // Switch 13 (LEFT)
-    { "", NONE }, // Switch 14 (RIGHT)
+    { "BASS MODE MENU", OPEN_MENU, BASS_MODE_MENU }, // Switch 14 (RIGHT)
   },
 
   { // Menu 14 - Midi forwarding
@@ -613,6 +614,24 @@ const PROGMEM menu_struct menu[][15] = {
     { "DEVICE SETINGS", OPEN_MENU, DEVICE_MENU }, // Switch 13 (LEFT)
     { "", NONE }, // Switch 14 (RIGHT)
   },
+
+  { // Menu 26 - Bass mode menu
+    { "BASS MODE MENU", NONE }, // Menu title
+    { "Priority", SET, 141, 0, 3, &Setting.Bass_mode_priority }, // Switch 1
+    { "Strings", SET, 0, 6, 7, &Setting.Bass_mode_number_of_strings }, // Switch 2
+    { "Hold time x10ms", SET, 0, 0, 50, &Setting.Bass_mode_hold_time }, // Switch 3
+    { "Cmd time x0.1ms", SET, 0, 0, 100, &Setting.Cmd_execute_time_budget }, // Switch 4
+    { "", NONE }, // Switch 5
+    { "", NONE }, // Switch 6
+    { "", NONE }, // Switch 7
+    { "", NONE }, // Switch 8
+    { "", NONE }, // Switch 9
+    { "", NONE }, // Switch 10
+    { "SAVE & EXIT", SAVE_AND_EXIT, 1 }, // Switch 11
+    { "Cancel", SAVE_AND_EXIT, 0 }, // Switch 12 (should not be of type NONE)
+    { "MIDI ADVNCD MENU", OPEN_MENU, MIDI_ADV_MENU }, // Switch 13 (LEFT)
+    { "", NONE }, // Switch 14 (RIGHT)
+  },
 };
 
 
@@ -677,6 +696,12 @@ const PROGMEM char menu_sublist[][17] = {
 
   // Sublist 133 - 140: USER device PC types
   "PC only", "PC and CC 0", "PC and CC32", "PC/CC0 mod 100", "PC/CC32 mod 100", "NUX CC 60", "", "",
+
+  // Sublist 141 - 144: Bass mode priority types
+  "LOW + HIGH", "LOW STRING", "HIGH STRING", "CHORD",
+
+  // Sublist 145 - 147: Song part change timing
+  "IMMEDIATELY", "NEXT BEAT", "NEXT BAR",
 };
 
 #define SUBLIST_COLOUR 4
@@ -1978,6 +2003,14 @@ struct cmdtype_struct {
 #define TYPE_MODE 40
 #define TYPE_MIDI_MORE 41
 #define TYPE_MUTE 42
+#define TYPE_MOD_TYPE 43
+#define TYPE_MOD_LANE 44
+#define TYPE_MOD_PATTERN 45
+#define TYPE_MOD_PHASE 46
+#define TYPE_NRPN_MSB 47
+#define TYPE_NRPN_LSB 48
+#define TYPE_MOD_DEVICE 49
+#define TYPE_MOD_PARAMETER 50
 
 // Some of the data for the sublists below is not fixed, but must be read from a Device class or from EEPROM
 // Here we define these sublists
@@ -1992,6 +2025,9 @@ struct cmdtype_struct {
 #define SUBLIST_PATCH_BANK 247 // To show the bank number
 #define SUBLIST_SETLIST 246 // To show the setlist name
 #define SUBLIST_SONG 245 // To show the song name
+#define SUBLIST_MOD_PATTERN 244 // To show the modulation pattern
+#define SUBLIST_MOD_DEVICE 243 // To show the device of a modulation lane
+#define SUBLIST_MOD_PARAMETER 242 // To show the parameter name of the device of a modulation lane
 
 const PROGMEM cmdtype_struct cmdtype[] = {
   { "", 0, 0, 0 }, // TYPE_OFF 0
@@ -2037,12 +2073,20 @@ const PROGMEM cmdtype_struct cmdtype[] = {
   { "MODE", 146, 0, 2 }, // TYPE_MODE
   { "COMMAND", 149, 0, 2 }, // TYPE_MIDI_MORE
   { "MUTE TYPE", 152, 0, 3 }, // TYPE_MUTE
+  { "MOD COMMAND", 156, 0, 5 }, // TYPE_MOD_TYPE 43
+  { "LANE", 0, 1, MOD_NUMBER_OF_LANES }, // TYPE_MOD_LANE 44
+  { "PATTERN", SUBLIST_MOD_PATTERN, 1, MOD_NUMBER_OF_PATTERNS }, // TYPE_MOD_PATTERN 45
+  { "PHASE", 0, 0, 127 }, // TYPE_MOD_PHASE 46
+  { "NRPN MSB", 0, 0, 127 }, // TYPE_NRPN_MSB 47
+  { "NRPN LSB", 0, 0, 127 }, // TYPE_NRPN_LSB 48
+  { "DEVICE", SUBLIST_MOD_DEVICE, 0, NUMBER_OF_DEVICES - 1 }, // TYPE_MOD_DEVICE 49
+  { "PARAMETER", SUBLIST_MOD_PARAMETER, 0, 255 }, // TYPE_MOD_PARAMETER 50
 };
 
 const PROGMEM char cmd_sublist[][17] = {
 
   // Sublist 1 - 17: Common Command Types
-  "NO COMMAND", "PAGE", "TAP TEMPO", "SET TEMPO", "GLOBAL TUNER", "MIDI PC", "MIDI CC", "MIDI NOTE", "NEXT DEVICE", "SETLIST", "SONG", "MODE", "MIDI MORE", "MENU", "", "", "",
+  "NO COMMAND", "PAGE", "TAP TEMPO", "SET TEMPO", "GLOBAL TUNER", "MIDI PC", "MIDI CC", "MIDI NOTE", "NEXT DEVICE", "SETLIST", "SONG", "MODE", "MIDI MORE", "MODULATION", "MENU", "", "",
 
   // Sublist 18 - 39: Device Command Types
   "PATCH", "PARAMETER", "ASSIGN", "SNAPSHOT/SCENE", "LOOPER", "MUTE", "SEL DEVICE PAGE", "SEL NEXT PAGE", "MASTER EXP PEDAL", "TOGGL MASTER EXP",
@@ -2103,10 +2147,17 @@ const PROGMEM char cmd_sublist[][17] = {
 
   // Sublist 152 - 155: Mute types
   "ON", "OFF", "OFF/ALWAYS ON", "TOGGLE",
+
+  // Sublist 156 - 161: Modulation command types
+  "START", "STOP", "START/STOP", "TARGET CC", "TARGET NRPN", "TARGET PARAM",
+
+  // Sublist 162 - 170: Fixed modulation patterns
+  "SINE", "BLOCK", "TRIANGLE", "SAW TOOTH", "SINGLE 8TH", "BEAT 1", "BEAT 2", "BEAT 3", "RANDOM",
 };
 
 #define SUBLIST_DEVICE_COMMAND_NUMBER 18
 #define SUBLIST_SELECT_TYPE_NUMBER 117
+#define SUBLIST_MOD_FIXED_PATTERN_NUMBER 162
 
 struct cmdbyte_struct {
   uint8_t Type;
@@ -2430,6 +2481,20 @@ void read_cmd_sublist(uint8_t cmd_type, uint8_t value, String & msg) {
     case SUBLIST_SONG:
       SCO_get_song_name(value, msg);
       break;
+    case SUBLIST_MOD_PATTERN:
+      if (value <= EXT_MAX_NUMBER_OF_SEQ_PATTERNS) msg = "USER " + String(value);
+      else msg = cmd_sublist[value - EXT_MAX_NUMBER_OF_SEQ_PATTERNS + SUBLIST_MOD_FIXED_PATTERN_NUMBER - 2];
+      break;
+    case SUBLIST_MOD_DEVICE:
+      if (value < NUMBER_OF_DEVICES) msg = Device[value]->full_device_name;
+      else msg = String(value);
+      break;
+    case SUBLIST_MOD_PARAMETER: // Copy the parameter name from the device in the first value byte
+      dev = cmdbyte[CB_VAL1].Value;
+      msg = "";
+      if (dev < NUMBER_OF_DEVICES) Device[dev]->read_parameter_name(value, msg);
+      else msg = String(value);
+      break;
     default: // Static sublist - read it from the cmd_sublist array
       index = value + cmdtype[cmd_type].Sublist;
       msg = cmd_sublist[index - 1];
@@ -2559,6 +2624,15 @@ void build_command_structure(uint8_t cmd_byte_no, uint8_t cmd_type, bool in_edit
           set_type_and_value(CB_DATA2, TYPE_MIDI_PORT, 0, in_edit_mode);
           clear_cmd_bytes(CB_VAL1, in_edit_mode); // Clear bytes 3-7
           break;
+        case MODULATION:
+          // Command: COMMON, MODULATION, START/STOP, LANE, PATTERN, PHASE, MIN, MAX
+          set_type_and_value(CB_DATA1, TYPE_MOD_TYPE, MOD_CMD_START_STOP, in_edit_mode);
+          set_type_and_value(CB_DATA2, TYPE_MOD_LANE, 1, in_edit_mode);
+          set_type_and_value(CB_VAL1, TYPE_MOD_PATTERN, 1, in_edit_mode);
+          set_type_and_value(CB_VAL2, TYPE_MOD_PHASE, 0, in_edit_mode);
+          set_type_and_value(CB_VAL3, TYPE_MIN, 0, in_edit_mode);
+          set_type_and_value(CB_VAL4, TYPE_MAX, 127, in_edit_mode);
+          break;
         default:
           // For all two byte commands
           clear_cmd_bytes(CB_DATA1, in_edit_mode); // Clear bytes 2-7
@@ -2812,6 +2886,42 @@ void build_command_structure(uint8_t cmd_byte_no, uint8_t cmd_type, bool in_edit
           break;
       }
     }
+
+    // *****************************************
+    // * BYTE3: Modulation command type updated *
+    // *****************************************
+    if (cmd_type == TYPE_MOD_TYPE) {
+      set_type_and_value(CB_DATA2, TYPE_MOD_LANE, 1, in_edit_mode);
+      switch (cmdbyte[cmd_byte_no].Value) {
+        case MOD_CMD_START:
+        case MOD_CMD_START_STOP:
+          set_type_and_value(CB_VAL1, TYPE_MOD_PATTERN, 1, in_edit_mode);
+          set_type_and_value(CB_VAL2, TYPE_MOD_PHASE, 0, in_edit_mode);
+          set_type_and_value(CB_VAL3, TYPE_MIN, 0, in_edit_mode);
+          set_type_and_value(CB_VAL4, TYPE_MAX, 127, in_edit_mode);
+          break;
+        case MOD_CMD_STOP:
+          clear_cmd_bytes(CB_VAL1, in_edit_mode);
+          break;
+        case MOD_CMD_TARGET_CC:
+          set_type_and_value(CB_VAL1, TYPE_CC_NUMBER, 0, in_edit_mode);
+          set_type_and_value(CB_VAL2, TYPE_MIDI_CHANNEL, 1, in_edit_mode);
+          set_type_and_value(CB_VAL3, TYPE_MIDI_PORT, 0, in_edit_mode);
+          clear_cmd_bytes(CB_VAL4, in_edit_mode);
+          break;
+        case MOD_CMD_TARGET_NRPN:
+          set_type_and_value(CB_VAL1, TYPE_NRPN_MSB, 0, in_edit_mode);
+          set_type_and_value(CB_VAL2, TYPE_NRPN_LSB, 0, in_edit_mode);
+          set_type_and_value(CB_VAL3, TYPE_MIDI_CHANNEL, 1, in_edit_mode);
+          set_type_and_value(CB_VAL4, TYPE_MIDI_PORT, 0, in_edit_mode);
+          break;
+        case MOD_CMD_TARGET_PAR:
+          set_type_and_value(CB_VAL1, TYPE_MOD_DEVICE, 0, in_edit_mode);
+          set_type_and_value(CB_VAL2, TYPE_MOD_PARAMETER, 0, in_edit_mode);
+          clear_cmd_bytes(CB_VAL3, in_edit_mode);
+          break;
+      }
+    }
   }
 
   // *******************************************
@@ -3063,6 +3173,9 @@ uint8_t find_cmd_byte_max(uint8_t cmd_byte_no) {
       return Number_of_pages;
     case TYPE_CMD:
       return EEPROM_count_cmds(cmdbyte[CB_PAGE].Value, cmdbyte[CB_SWITCH].Value);
+    case TYPE_MOD_PARAMETER: // The device is in the first value byte
+      if (cmdbyte[CB_VAL1].Value < NUMBER_OF_DEVICES) return Device[cmdbyte[CB_VAL1].Value]->number_of_parameters() - 1;
+      break;
   }
   return cmdtype[cmd_type].Max;
 }
@@ -88,6 +88,7 @@ void main_page() {
 void PAGE_load_current() {
   //update_page = OFF; //Switch LCDs are updated here as well
   on_looper_page = false;
+  EEPROM_get_page_plan(Current_page); // The switches below read their commands from the plan
   for (uint8_t s = 0; s < (TOTAL_NUMBER_OF_SWITCHES + 1); s++) { // Load regular switches
     PAGE_load_switch(s);
   }
@@ -318,6 +319,13 @@ void PAGE_load_switch(uint8_t sw) {
         MIDI_get_port_number_name(Data2, msg);
         LCD_set_SP_label(sw, msg);
         break;
+      case MODULATION:
+        SP[sw].PP_number = Data1;
+        SP[sw].Value1 = Data2; // Lane
+        SP[sw].Colour = Setting.LED_global_colour;
+        msg = "LANE " + String(Data2);
+        LCD_set_SP_label(sw, msg);
+        break;
     }
   }
 }
@@ -332,6 +340,7 @@ void PAGE_request_first_switch() {
   read_attempt = 1;
   DEBUGMSG("Start reading switch parameters");
   PAGE_stop_sysex_watchdog();
+  for (uint8_t d = 0; d < NUMBER_OF_DEVICES; d++) Device[d]->cancel_pending_request(); // Replies to requests of a previous page load are no longer expected
   PAGE_request_current_switch();
 }
 
@@ -707,6 +716,7 @@ void PAGE_request_current_switch() { //Will request the data for the next switch
               SP[Current_switch].PP_number = update_encoder_value(-1, Current_mode, 0, NUMBER_OF_MODES - 1);
             break;
           case MIDI_MORE:
+          case MODULATION:
             break;
         }
         // Set main backlight colour
@@ -745,6 +755,7 @@ void PAGE_check_sysex_watchdog() {
   if ((millis() > SysexWatchdog) && (Sysex_watchdog_running)) {
     DEBUGMSG("Sysex watchdog expired");
     read_attempt++;
+    for (uint8_t d = 0; d < NUMBER_OF_DEVICES; d++) Device[d]->cancel_pending_request(); // The switch is requested again or skipped
     if (read_attempt > SYSEX_NUMBER_OF_READ_ATTEMPS) PAGE_request_next_switch();
     else PAGE_request_current_switch(); // Try reading the current parameter again
   }
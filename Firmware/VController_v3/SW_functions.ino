@@ -13,6 +13,7 @@
 // Section 10: Master expression pedal control
 // Section 11: Setlist Commands
 // Section 12: Song Commands
+// Section 13: Modulation Commands
 
 // ********************************* Section 1: Switch Action Trigger and Command Lookup ********************************************
 
@@ -61,6 +62,8 @@ uint8_t current_cmd_switch_action = 0; // Placeholder for the switch action of t
 uint8_t arm_page_cmd_exec = 0; // Set to the number of the selected page to execute the commands for this page
 bool par_state_set = false;
 
+#define CMD_EXECUTE_TIME_STEP 100 // Setting.Cmd_execute_time_budget is in steps of 100 microseconds
+
 void setup_switch_control()
 {
   DEBUGMAIN("Starting switch control");
@@ -70,7 +73,8 @@ void setup_switch_control()
 
 // Take action on switch being pressed / released/ held / long pressed or extra long pressed.
 // There can be any number of commands executed by one switch press. The maximum number of commands for one switch is determined by the size of the buffer (CMD_BUFFER_SIZE).
-// On every loop cycle one command is executed. THe next command to be executed is set in the current_cmd variable.
+// On every loop cycle commands are executed until the time in Setting.Cmd_execute_time_budget has passed, so the LEDs and displays are only updated when the batch is done.
+// The next command to be executed is set in the current_cmd variable.
 // Commands read from EEPROM are stored in a memory buffer (cmd_buf) in RAM to increase performance.
 
 void main_switch_control()  // Checks if a button has been pressed and check out which functions have to be executed
@@ -114,6 +118,7 @@ void main_switch_control()  // Checks if a button has been pressed and check out
     if (switch_pressed & ON_DUAL_PRESS) current_cmd_switch_action = SWITCH_DUAL_LONG_PRESSED;
     else current_cmd_switch_action = SWITCH_LONG_PRESSED;
     current_cmd = EEPROM_first_cmd(Current_page, switch_long_pressed & SWITCH_MASK);
+    if ((current_cmd_switch_action == SWITCH_LONG_PRESSED) && (!EEPROM_switch_has_trigger(Current_page, switch_long_pressed, ON_LONG_PRESS))) current_cmd = 0; // Nothing to do
     current_cmd_switch = switch_long_pressed;
     current_cmdbuf_index = 0;
     switch_long_pressed = 0;
@@ -150,16 +155,27 @@ void main_switch_control()  // Checks if a button has been pressed and check out
   }
 
   if (current_cmd > 0) { // If current_cmd points to a command we can execute, do it. Then check if there is another command to execute.
-    SCO_execute_cmd(current_cmd_switch, current_cmd_switch_action, current_cmdbuf_index);
-    current_cmd = EEPROM_next_cmd(current_cmd); //Find the next command - will be executed on the next cycle
-    current_cmdbuf_index++; // Point to the next command in the command buffer
-    if (current_cmdbuf_index >= CMD_BUFFER_SIZE) current_cmd = 0; // Stop executing commands when the end of the buffer is reached.
+    uint32_t batch_start_time = micros();
+    uint32_t batch_time = Setting.Cmd_execute_time_budget * CMD_EXECUTE_TIME_STEP; // When it is zero, one command is executed per loop cycle
+    uint8_t batch_start_index = current_cmdbuf_index;
+    do {
+      SCO_execute_cmd(current_cmd_switch, current_cmd_switch_action, current_cmdbuf_index);
+      current_cmd = EEPROM_next_cmd(current_cmd); //Find the next command
+      current_cmdbuf_index++; // Point to the next command in the command buffer
+      if (current_cmdbuf_index >= CMD_BUFFER_SIZE) current_cmd = 0; // Stop executing commands when the end of the buffer is reached.
+      if (update_page == RELOAD_PAGE) break; // A page was selected - the page has to be loaded before the next command is executed
+    } while ((current_cmd > 0) && (micros() - batch_start_time < batch_time));
+    PROFILE_check_cmd_batch(current_cmdbuf_index - batch_start_index);
+    MIDI_send_now(); // Send the MIDI messages of this batch together
   }
   else {
     prev_switch_pressed = current_cmd_switch & SWITCH_MASK; // Will stop the reading of switch commands from EEPROM
   }
 
   SCO_check_update_tempo();
+  SCO_bass_mode_check_pending();
+  SCO_check_scheduled_part_change();
+  SCO_check_song_prefetch();
 }
 
 // ********************************* Section 2: Command Execution ********************************************
@@ -169,8 +185,8 @@ void SCO_execute_cmd(uint8_t sw, uint8_t action, uint8_t index) {
     // Here we read the switch and store the value in the command buffer. This is only done on first press. After that the commands are executed from the buffer.
     // This allows for smoother expression pedal operation, where we trigger the same commands in quick succesion
     prev_switch_page = Current_page; // Remember the page the switch was on, so repressing it after changing page will cause a re-read from EEPROM.
-    read_cmd_EEPROM(current_cmd, &cmd_buf[index]);
-    DEBUGMSG("Cmd buffer read from EEPROM. Switch number is " + String(cmd_buf[index].Switch));
+    EEPROM_read_planned_cmd(Current_page, sw, index, current_cmd, &cmd_buf[index]);
+    DEBUGMSG("Cmd buffer read from page plan. Switch number is " + String(cmd_buf[index].Switch));
   }
 
   uint8_t switch_type = cmd_buf[index].Switch & SWITCH_TYPE_MASK;
@@ -535,6 +551,10 @@ void SCO_execute_command(uint8_t Sw, Cmd_struct *cmd, bool first_cmd) {
           update_page = REFRESH_PAGE;
         }
         break;
+      case MODULATION:
+        if (SC_switch_is_expr_pedal()) break;
+        SCO_modulation_command(cmd);
+        break;
     }
   }
   else if (Dev < NUMBER_OF_DEVICES) { // Check for device specific parameters
@@ -1200,12 +1220,16 @@ void SCO_CC_press(uint8_t CC_number, uint8_t CC_toggle, uint8_t value1, uint8_t
 
   if (SC_switch_is_expr_pedal()) {
     if (SP[Sw].Latch == CC_RANGE) {
-      val = map(Expr_ped_value, 0, 127, value2, value1);
-      if (val != SP[Sw].Target_byte1) { // Check if we have a new value
-        MIDI_send_CC(CC_number, val, channel, port); // Controller, Value, Channel, Port;
-        MIDI_update_CC_ledger(CC_number, val, channel, port, true);
-        SP[Sw].Target_byte1 = val;
+      if ((Setting.Exp_pedal_high_res_CC) && (CC_number < 32)) SCO_CC_send_high_res(CC_number, value1, value2, channel, port, Sw);
+      else {
+        val = map(Expr_ped_value, 0, 127, value2, value1);
+        if (val != SP[Sw].Target_byte1) { // Check if we have a new value
+          MIDI_send_CC(CC_number, val, channel, port); // Controller, Value, Channel, Port;
+          MIDI_update_CC_ledger(CC_number, val, channel, port, true);
+          SP[Sw].Target_byte1 = val;
+        }
       }
+      val = SP[Sw].Target_byte1;
       LCD_show_bar(0, Expr_ped_value, 0); // Show it on the main display
       if (switch_controlled_by_master_exp_pedal > 0) {
         LCD_show_bar(switch_controlled_by_master_exp_pedal, Expr_ped_value, 0); // Show it on the individual display
@@ -1261,6 +1285,27 @@ void SCO_CC_press(uint8_t CC_number, uint8_t CC_toggle, uint8_t value1, uint8_t
   }
 }
 
+void SCO_CC_send_high_res(uint8_t CC_number, uint8_t value1, uint8_t value2, uint8_t channel, uint8_t port, uint8_t Sw) {
+  // Send a 14 bit CC message: the MSB on CC_number and the LSB on CC_number + 32.
+  // Receivers reset the LSB when a new MSB arrives, so the LSB is always sent after the MSB.
+  // The LSB of the highest value is 0x7F, so the full range up to 16383 can be reached.
+  uint16_t val1 = value1 << 7;
+  uint16_t val2 = value2 << 7;
+  if (value1 >= value2) val1 |= 0x7F;
+  else val2 |= 0x7F;
+  uint16_t val = map(Expr_ped_value_14bit, 0, EXPR_PEDAL_MAX_14BIT, val2, val1);
+  uint8_t msb = val >> 7;
+  uint8_t lsb = val & 0x7F;
+  if (msb != SP[Sw].Target_byte1) {
+    MIDI_send_CC(CC_number, msb, channel, port);
+    MIDI_update_CC_ledger(CC_number, msb, channel, port, true);
+    MIDI_send_CC(CC_number + 32, lsb, channel, port);
+  }
+  else if (lsb != SP[Sw].Target_byte2) MIDI_send_CC(CC_number + 32, lsb, channel, port);
+  SP[Sw].Target_byte1 = msb;
+  SP[Sw].Target_byte2 = lsb;
+}
+
 void SCO_CC_release(uint8_t CC_number, uint8_t CC_toggle, uint8_t value1, uint8_t value2, uint8_t channel, uint8_t port, uint8_t Sw, bool first_cmd) {
   if (CC_toggle == CC_MOMENTARY) {
     MIDI_send_CC(CC_number, value2, channel, port); // Controller, Value, Channel, Port
@@ -1488,12 +1533,15 @@ void SCO_global_tuner_stop() {
 #define NUMBER_OF_TAPS 4 // When tapping a new tempo, this is the number of taps that are sent
 uint8_t tap = 0;
 
-#define NUMBER_OF_TAPMEMS 5
-uint32_t tap_time[NUMBER_OF_TAPMEMS];
-uint8_t tap_time_index = 0;
-uint32_t new_time, time_diff, avg_time;
+#define NUMBER_OF_TAPMEMS 8 // Maximum number of tap intervals used for calculating the tempo
+#define TAP_OUTLIER_PERCENTAGE 25 // Tap intervals that differ more than 25% from the median are ignored
+#define TAP_TEMPO_CHANGE_PERCENTAGE 15 // When the last two taps differ more than 15% from the median in the same direction, a new tempo is tapped
+uint32_t tap_interval[NUMBER_OF_TAPMEMS]; // Tap intervals in microseconds - newest first
+uint8_t number_of_tap_intervals = 0;
+uint32_t new_time, time_diff;
 uint32_t prev_time = 0;
-bool tap_array_full = false;
+uint32_t tap_sequence_start_time = 0;
+uint16_t Current_bpm_x10 = 0; // The current tempo in tenths of bpm. Setting.Bpm holds the rounded tempo.
 bool send_new_bpm_value = false;
 bool tap_tempo_pressed_once = false;
 #define SWITCH_TEMPO_FOLLOW_MODE_TIME 2000000 // Time before switching tap tempo follow mode
@@ -1503,7 +1551,7 @@ bool tempo_edited = false;
 uint8_t do_not_tap_port = 255;
 uint32_t ignore_midi_clock_timer = 0;
 #define IGNORE_MIDI_CLOCK_TIMER_LENGTH 500000 // Time midi clock messages are ignored after tapping tap tempo
-uint8_t MIDI_CLOCK_BPM_MEMS[NUMBER_OF_MIDI_CLOCK_MEMS] = { 0 };
+uint16_t MIDI_CLOCK_BPM_MEMS[NUMBER_OF_MIDI_CLOCK_MEMS] = { 0 }; // Tempo in tenths of bpm
 uint8_t MIDI_clock_bpm_mem_index = 0;
 uint32_t previous_midi_clock_time = 0;
 bool MIDI_clock_received = false;
@@ -1511,18 +1559,40 @@ bool update_tempo = false;
 IntervalTimer MIDI_clock_timer;
 uint8_t bpm_LED_tick = 0;
 
-#define NUMBER_OF_BPM_FOLLOW_MEMS 6
-uint32_t tap_follow_mems[NUMBER_OF_BPM_FOLLOW_MEMS];
-uint8_t tap_follow_bpm_index = 0;
-bool tap_follow_buffer_full = false;
+// Beat position of the clock that is followed: the received MIDI clock while it is running, otherwise the internal clock
+volatile uint32_t clock_beat_time = 0; // Time of the last beat (in microseconds)
+volatile uint32_t clock_beat_number = 0; // Number of the last beat - the first beat of a bar when (clock_beat_number % BEATS_PER_BAR) == 0
+#define BEATS_PER_BAR 4
+uint32_t rx_clock_pulse_time = 0;
+uint8_t rx_clock_tick = 0;
+#define RX_CLOCK_TIMEOUT 100000 // Clock pulses at MIN_BPM are 62.5 ms apart
+
+uint16_t SCO_get_bpm_x10() { // Returns the current tempo in tenths of bpm
+  // Setting.Bpm can also be changed directly (by loading the settings from EEPROM or the editor). Then the tenths are lost.
+  if ((Current_bpm_x10 + 5) / 10 != Setting.Bpm) Current_bpm_x10 = Setting.Bpm * 10;
+  return Current_bpm_x10;
+}
+
+void SCO_set_bpm_x10(uint16_t bpm_x10) { // Sets the tempo in tenths of bpm and the rounded tempo in Setting.Bpm
+  if (bpm_x10 < MIN_BPM * 10) bpm_x10 = MIN_BPM * 10;
+  if (bpm_x10 > MAX_BPM * 10) bpm_x10 = MAX_BPM * 10;
+  Current_bpm_x10 = bpm_x10;
+  Setting.Bpm = (bpm_x10 + 5) / 10;
+}
+
+String SCO_get_bpm_string() { // Returns the tempo with one decimal when the tempo is not a whole number
+  uint16_t bpm_x10 = SCO_get_bpm_x10();
+  if ((bpm_x10 % 10) == 0) return String(bpm_x10 / 10);
+  return String(bpm_x10 / 10) + "." + String(bpm_x10 % 10);
+}
 
 void SCO_MIDI_clock_start() {
-  long timer_interval = 60000000 / (24 * Setting.Bpm);
+  long timer_interval = 600000000 / (24 * SCO_get_bpm_x10());
   MIDI_clock_timer.begin(SCO_MIDI_clock_timer_expired, timer_interval);
 }
 
 void SCO_MIDI_clock_update() {
-  long timer_interval = 60000000 / (24 * Setting.Bpm);
+  long timer_interval = 600000000 / (24 * SCO_get_bpm_x10());
   MIDI_clock_timer.update(timer_interval);
 }
 
@@ -1532,7 +1602,7 @@ void SCO_check_update_tempo() {
     update_tempo = false;
   }
   if (tap_tempo_pressed_once) {
-    if ((Setting.Follow_tempo_from_G2M > 0) && (micros() > tap_time[0] + SWITCH_TEMPO_FOLLOW_MODE_TIME)) {
+    if ((Setting.Follow_tempo_from_G2M > 0) && (micros() > tap_sequence_start_time + SWITCH_TEMPO_FOLLOW_MODE_TIME)) {
       if (Setting.Follow_tempo_from_G2M == 1) {
         Setting.Follow_tempo_from_G2M = 2;
         LCD_show_popup_label("Tempo follow on", ACTION_TIMER_LENGTH);
@@ -1553,10 +1623,21 @@ void SCO_MIDI_clock_timer_expired() {
   bpm_LED_tick++;
   if (bpm_LED_tick >= 24) { // 24 ticks per beat
     bpm_LED_tick = 0;
+    uint32_t now = micros();
+    if (now - rx_clock_pulse_time > RX_CLOCK_TIMEOUT) SCO_clock_beat(now); // The received MIDI clock sets the beat while it is running
   }
   __enable_irq();
 }
 
+void SCO_clock_beat(uint32_t beat_time) {
+  clock_beat_time = beat_time;
+  clock_beat_number++;
+}
+
+uint32_t SCO_get_clock_beat_number() { // Also called from the modulation timer interrupt
+  return clock_beat_number;
+}
+
 void SCO_global_tap_external() { // For external tapping sources
   time_switch_pressed = micros();
   SCO_global_tap_tempo_press(0);
@@ -1565,51 +1646,56 @@ void SCO_global_tap_external() { // For external tapping sources
 
 void SCO_global_tap_tempo_press(uint8_t sw) {
 
-#ifdef INTA_PIN // When using display boards, use the time from the inta interrupt, otherwise bpm timing is not correct
-  new_time = time_switch_pressed;
-#else
-  new_time = micros(); //Store the current time
-#endif
+  new_time = time_switch_pressed; // The time of the switch edge, so bpm timing does not depend on the loop time
 
   SCO_tap_on_device(); // Send out tap tempo to devices where tempo can not be set directly
 
   time_diff = new_time - prev_time;
   prev_time = new_time;
-  //DEBUGMSG("*** Tap no:" + String(tap_time_index) + " with difference " + String(time_diff));
+  //DEBUGMSG("*** Tap with difference " + String(time_diff));
 
   // If time difference between two taps is too long, we will start new tapping sequence
   if (time_diff > MAX_BPM_TIME) {
-    tap_time_index = 1;
-    tap_array_full = false;
-    tap_time[0] = new_time;
+    number_of_tap_intervals = 0;
+    tap_sequence_start_time = new_time;
     tap_tempo_pressed_once = true;
     //DEBUGMSG("!!! STARTED NEW TAP SEQUENCE");
   }
   else {
-    //Calculate the average time depending on if the tap_time array is full or not
-    if (tap_array_full) {
-      avg_time = (new_time - tap_time[tap_time_index]) / (NUMBER_OF_TAPMEMS);
-    }
-    else {
-      avg_time = (new_time - tap_time[0]) / tap_time_index;
+    // Store the new interval in front of the others
+    if (number_of_tap_intervals < NUMBER_OF_TAPMEMS) number_of_tap_intervals++;
+    for (uint8_t i = number_of_tap_intervals - 1; i > 0; i--) tap_interval[i] = tap_interval[i - 1];
+    tap_interval[0] = time_diff;
+
+    uint32_t median = SCO_tap_median_interval();
+
+    // When the last two taps are both much faster or much slower than the median, the player has changed the tempo. Start a new window with these two taps.
+    if (number_of_tap_intervals > 3) {
+      uint32_t change = median * TAP_TEMPO_CHANGE_PERCENTAGE / 100;
+      if (((tap_interval[0] > median + change) && (tap_interval[1] > median + change)) || ((tap_interval[0] < median - change) && (tap_interval[1] < median - change))) {
+        number_of_tap_intervals = 2;
+        median = SCO_tap_median_interval();
+      }
     }
 
-    // Store new time in memory
-    tap_time[tap_time_index] = new_time;
-
-    // Calculate the bpm
-    uint16_t new_bpm = ((60000000 + (avg_time >> 1)) / avg_time); // Calculate the bpm
-    SCO_update_bpm(new_bpm);
-
-    // Move to the next memory slot
-    tap_time_index++;
-    if (tap_time_index >= NUMBER_OF_TAPMEMS) { // We have reached the last tap memory
-      tap_time_index = 0;
-      tap_array_full = true; // So we need to calculate the average tap time in a different way
+    // Average all intervals that are close to the median
+    uint32_t outlier = median * TAP_OUTLIER_PERCENTAGE / 100;
+    uint32_t total = 0;
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < number_of_tap_intervals; i++) {
+      if ((tap_interval[i] + outlier >= median) && (tap_interval[i] <= median + outlier)) {
+        total += tap_interval[i];
+        count++;
+      }
+    }
+    if (count > 0) {
+      uint32_t avg_time = total / count;
+      uint16_t new_bpm_x10 = (600000000 + (avg_time >> 1)) / avg_time; // Calculate the bpm in tenths
+      SCO_update_bpm(new_bpm_x10);
     }
     tap_tempo_pressed_once = false;
   }
-  if (Setting.Main_display_show_top_right != MDT_CURRENT_TEMPO) LCD_show_popup_label("Tempo " + String(Setting.Bpm) + " bpm", ACTION_TIMER_LENGTH); // Show the tempo on the main display
+  if (Setting.Main_display_show_top_right != MDT_CURRENT_TEMPO) LCD_show_popup_label("Tempo " + SCO_get_bpm_string() + " bpm", ACTION_TIMER_LENGTH); // Show the tempo on the main display
   else update_main_lcd = true;
   if (sw > 0) update_lcd = sw; // Update the LCD of the display above the tap tempo button
   else update_page = REFRESH_PAGE; // Running tap tempo from CURNUM - update entire page
@@ -1620,10 +1706,26 @@ void SCO_global_tap_tempo_press(uint8_t sw) {
   reset_tempo_following();
 }
 
-bool SCO_update_bpm(uint8_t new_bpm) {
-  if (new_bpm > MAX_BPM) new_bpm = MAX_BPM;
-  if (Setting.Bpm == new_bpm) return false;
-  Setting.Bpm = new_bpm;
+uint32_t SCO_tap_median_interval() {
+  uint32_t sorted[NUMBER_OF_TAPMEMS];
+  for (uint8_t i = 0; i < number_of_tap_intervals; i++) { // Insertion sort - there are never more than eight intervals
+    uint32_t value = tap_interval[i];
+    uint8_t j = i;
+    while ((j > 0) && (sorted[j - 1] > value)) {
+      sorted[j] = sorted[j - 1];
+      j--;
+    }
+    sorted[j] = value;
+  }
+  if (number_of_tap_intervals == 0) return 0;
+  if (number_of_tap_intervals & 1) return sorted[number_of_tap_intervals / 2];
+  return (sorted[(number_of_tap_intervals / 2) - 1] + sorted[number_of_tap_intervals / 2]) / 2;
+}
+
+bool SCO_update_bpm(uint16_t new_bpm_x10) { // Tempo in tenths of bpm
+  if (new_bpm_x10 > MAX_BPM * 10) new_bpm_x10 = MAX_BPM * 10;
+  if (SCO_get_bpm_x10() == new_bpm_x10) return false;
+  SCO_set_bpm_x10(new_bpm_x10);
 
   // Send it to the devices
   for (uint8_t d = 0; d < NUMBER_OF_DEVICES; d++) {
@@ -1636,10 +1738,14 @@ bool SCO_update_bpm(uint8_t new_bpm) {
 }
 
 void SCO_set_global_tempo_press(uint8_t new_bpm) {
-  if (new_bpm < MIN_BPM) return;
-  if (new_bpm > MAX_BPM) return;
-  if (new_bpm == Setting.Bpm) return;
-  Setting.Bpm = new_bpm;
+  SCO_set_global_tempo_x10(new_bpm * 10);
+}
+
+void SCO_set_global_tempo_x10(uint16_t new_bpm_x10) { // Tempo in tenths of bpm
+  if (new_bpm_x10 < MIN_BPM * 10) return;
+  if (new_bpm_x10 > MAX_BPM * 10) return;
+  if (new_bpm_x10 == SCO_get_bpm_x10()) return;
+  SCO_set_bpm_x10(new_bpm_x10);
   // Send it to the devices
   send_new_bpm_value = true; // Will delay sending the data, but also hangs the VC-mini when using the encoder for tempo change
   /*for (uint8_t d = 0; d < NUMBER_OF_DEVICES; d++) {
@@ -1665,6 +1771,16 @@ void SCO_receive_MIDI_clock_pulse(uint8_t port) {
   // 24 pulses are sent, so bpm = 2500000 / deltatime
   uint32_t current_time = micros();
 
+  // Keep track of the beat. The first pulse after the clock has (re)started is the first beat of a bar.
+  if (current_time - rx_clock_pulse_time > RX_CLOCK_TIMEOUT) {
+    rx_clock_tick = 0;
+    clock_beat_number = BEATS_PER_BAR - 1;
+  }
+  rx_clock_pulse_time = current_time;
+  if (rx_clock_tick == 0) SCO_clock_beat(current_time);
+  rx_clock_tick++;
+  if (rx_clock_tick >= 24) rx_clock_tick = 0;
+
   if (!MIDI_clock_received) {
     DEBUGMSG("Clock received from port " + String(Current_MIDI_in_port >> 4));
   }
@@ -1674,17 +1790,16 @@ void SCO_receive_MIDI_clock_pulse(uint8_t port) {
 
   if (previous_midi_clock_time > 0) {
     if (current_time - previous_midi_clock_time < 9999) return; // time too short
-    uint16_t bpm_course = 25000000 / (current_time - previous_midi_clock_time);
-    uint8_t bpm_new = (bpm_course + 5) / 10; // Calculate a correct average
-    MIDI_CLOCK_BPM_MEMS[MIDI_clock_bpm_mem_index] = bpm_new;
+    uint16_t bpm_x10 = 25000000 / (current_time - previous_midi_clock_time);
+    MIDI_CLOCK_BPM_MEMS[MIDI_clock_bpm_mem_index] = bpm_x10;
     MIDI_clock_bpm_mem_index++;
     if (MIDI_clock_bpm_mem_index >= NUMBER_OF_MIDI_CLOCK_MEMS) {
       MIDI_clock_bpm_mem_index = 0;
-      uint16_t total = 0;
+      uint32_t total = 0;
 
-      uint8_t bpm = MIDI_CLOCK_BPM_MEMS[0];
+      uint16_t bpm = MIDI_CLOCK_BPM_MEMS[0];
       total = bpm;
-      uint8_t dev = bpm / 5;
+      uint16_t dev = bpm / 5;
       for (uint8_t i = 1; i < NUMBER_OF_MIDI_CLOCK_MEMS; i++) {
         if ((MIDI_CLOCK_BPM_MEMS[i] < bpm - dev) || (MIDI_CLOCK_BPM_MEMS[i] > bpm + dev)) {
           DEBUGMSG("Too much deviation in MIDI clock");
@@ -1693,9 +1808,10 @@ void SCO_receive_MIDI_clock_pulse(uint8_t port) {
         bpm = MIDI_CLOCK_BPM_MEMS[i];
         total += bpm;
       }
-      uint8_t avg_bpm = total / NUMBER_OF_MIDI_CLOCK_MEMS;
-      if ((avg_bpm < Setting.Bpm - 1) || (avg_bpm > Setting.Bpm + 1)) { // Check if tempo has changed
-        Setting.Bpm = avg_bpm;
+      uint16_t avg_bpm_x10 = (total + (NUMBER_OF_MIDI_CLOCK_MEMS / 2)) / NUMBER_OF_MIDI_CLOCK_MEMS;
+      uint16_t current_bpm_x10 = SCO_get_bpm_x10();
+      if ((avg_bpm_x10 + 10 < current_bpm_x10) || (avg_bpm_x10 > current_bpm_x10 + 10)) { // Check if tempo has changed
+        SCO_set_bpm_x10(avg_bpm_x10);
         SCO_MIDI_clock_update();
         MIDI_clock_received = true;
         for (uint8_t d = 0; d < NUMBER_OF_DEVICES; d++) {
@@ -1754,6 +1870,7 @@ void SCO_update_tap_tempo_LED() {
 
 void SCO_reset_tap_tempo_LED() {
   bpm_LED_tick = 23;
+  clock_beat_number = BEATS_PER_BAR - 1; // The last tap is the first beat of a bar
 }
 
 void SCO_retap_tempo() { // Retap the tempo on all external devices (that support this method)
@@ -1767,72 +1884,214 @@ void SCO_tap_on_device() {
 }
 
 // Automatic tempo following from Guitar2MIDI
+// Every note onset is compared with the previous onsets. All intervals that fit a tempo between MIN_BPM and MAX_BPM are added to a histogram with half bpm bins.
+// The histogram decays on every onset, so old notes are forgotten. The tempo is the bin with the highest score, where the score of a bin also counts
+// the bins of half, a third and double the tempo (comb filter), so syncopated notes and notes played on every other beat still add to the right tempo.
+// If half or double the tempo scores almost as well, we stay closest to the current tempo. The tempo is calculated in tenths of bpm from the shape of the peak.
 uint32_t prev_note_on_time = 0;
-uint32_t start_measurement_time = 0;
-uint8_t number_of_intervals = 0;
 #define MSEC_TIME_BETWEEN_CHORD_PLAYING 100000
+#define TF_BINS_PER_BPM 2
+#define TF_NUMBER_OF_BINS (((MAX_BPM - MIN_BPM) * TF_BINS_PER_BPM) + 1)
+#define TF_NUMBER_OF_ONSETS 8 // Number of previous onsets every new onset is compared with
+#define TF_MIN_ONSETS 4 // Minimum number of onsets before the tempo is updated
+#define TF_ONSET_WEIGHT 64 // Histogram weight of every interval
+#define TF_DECAY_SHIFT 2 // Histogram decays with 1/4 on every onset
+#define TF_MIN_CONFIDENCE 25 // Minimum percentage the chosen tempo must score above any unrelated tempo
+#define TF_OCTAVE_SCORE 70 // Half or double tempo is chosen when it is near the current tempo and scores at least 70% of the best tempo
+#define TF_OCTAVE_RANGE 15 // Percentage around the current tempo where half or double tempo is preferred
+#define TF_SMOOTH_RANGE_X10 50 // Changes up to 5 bpm are smoothed, bigger changes need two matching estimates
+uint16_t tf_histogram[TF_NUMBER_OF_BINS];
+uint32_t tf_onset_time[TF_NUMBER_OF_ONSETS];
+uint8_t tf_onset_index = 0;
+uint8_t tf_number_of_onsets = 0;
+uint16_t tf_bpm_x10 = 0; // The followed tempo in tenths of bpm
+uint16_t tf_new_tempo_candidate_x10 = 0;
 
 void SCO_tempo_following_receive_note_on(uint8_t note, uint8_t velocity, uint8_t channel, uint8_t port) {
   if (Setting.Follow_tempo_from_G2M != 2) return;
   if (velocity == 0) return; // filter out note off
-  if ((channel >= Setting.Bass_mode_G2M_channel) && (channel <= Setting.Bass_mode_G2M_channel + 6)) {
-    // First check if time delta is long enough to make sure we are not strumming
-    uint32_t delta = MIDI_note_on_time - prev_note_on_time;
-    prev_note_on_time = MIDI_note_on_time;
-    if (delta < MSEC_TIME_BETWEEN_CHORD_PLAYING) return;
-
-    // Now calculate the real delta
-    delta = MIDI_note_on_time - start_measurement_time;
-    uint32_t average_delta_from_tempo = 60000000 / Setting.Bpm;
-    if (delta > (average_delta_from_tempo * 17 / 20)) {
-      start_measurement_time = MIDI_note_on_time;
-      number_of_intervals = 0;
+  if ((channel < Setting.Bass_mode_G2M_channel) || (channel > Setting.Bass_mode_G2M_channel + 6)) return;
+
+  // First check if time delta is long enough to make sure we are not strumming
+  uint32_t delta = MIDI_note_on_time - prev_note_on_time;
+  prev_note_on_time = MIDI_note_on_time;
+  if (delta < MSEC_TIME_BETWEEN_CHORD_PLAYING) return;
+
+  SCO_tempo_following_add_onset(MIDI_note_on_time);
+
+  uint8_t confidence;
+  uint16_t new_bpm_x10 = SCO_tempo_following_find_tempo(confidence);
+  DEBUGMSG("Tempo follow: " + String(new_bpm_x10 / 10) + "." + String(new_bpm_x10 % 10) + " bpm, confidence " + String(confidence) + "%");
+  if ((tf_number_of_onsets < TF_MIN_ONSETS) || (confidence < TF_MIN_CONFIDENCE) || (new_bpm_x10 == 0)) return;
+
+  if (tf_bpm_x10 == 0) tf_bpm_x10 = SCO_get_bpm_x10();
+  uint16_t diff = (new_bpm_x10 > tf_bpm_x10) ? new_bpm_x10 - tf_bpm_x10 : tf_bpm_x10 - new_bpm_x10;
+  if (diff <= TF_SMOOTH_RANGE_X10) { // Glide towards the new tempo
+    tf_bpm_x10 = ((tf_bpm_x10 * 3) + new_bpm_x10 + 2) / 4;
+    tf_new_tempo_candidate_x10 = 0;
+  }
+  else { // Jump to a new tempo when it is found twice in a row
+    uint16_t cdiff = (new_bpm_x10 > tf_new_tempo_candidate_x10) ? new_bpm_x10 - tf_new_tempo_candidate_x10 : tf_new_tempo_candidate_x10 - new_bpm_x10;
+    if (cdiff > TF_SMOOTH_RANGE_X10) {
+      tf_new_tempo_candidate_x10 = new_bpm_x10;
+      return;
     }
-    number_of_intervals++;
-    /*if (delta < (average_delta_from_tempo * 11 / 10)) {
-      tap_follow_bpm_index = 0; // Restart getting tempo
-      tap_follow_buffer_full = false;
-      }*/
-
-    DEBUGMSG("Delta: " + String(delta) + ", avg delta: " + String(average_delta_from_tempo));
-    if (number_of_intervals > 2) return;
-    if ((delta > (average_delta_from_tempo * 17 / 20)) && (delta < (average_delta_from_tempo * 23 / 20))) {
-      tap_follow_mems[tap_follow_bpm_index] = delta;
-      tap_follow_bpm_index++;
-      if (tap_follow_bpm_index >= NUMBER_OF_BPM_FOLLOW_MEMS) {
-        tap_follow_bpm_index = 0;
-        tap_follow_buffer_full = true;
-      }
+    tf_bpm_x10 = new_bpm_x10;
+    tf_new_tempo_candidate_x10 = 0;
+  }
 
-      if (tap_follow_buffer_full) {
-        uint32_t total = 0;
-        for (uint8_t i = 0; i < NUMBER_OF_BPM_FOLLOW_MEMS; i++) total += tap_follow_mems[i];
+  if (SCO_update_bpm(tf_bpm_x10)) {
+    SCO_MIDI_clock_update();
+    tap = 0;
+    do_not_tap_port = port;
+    update_page = REFRESH_PAGE;
+  }
+}
 
-        uint32_t avg_time = total / NUMBER_OF_BPM_FOLLOW_MEMS;
-        //if ((avg_time < (average_delta_from_tempo * 9 / 10)) || (avg_time > (average_delta_from_tempo * 11 / 10))) { // If outside 1% deviation
-        uint8_t new_tempo = 60000000 / avg_time;
-        if (SCO_update_bpm(new_tempo)) {
-          tap = 0;
-          do_not_tap_port = port;
-          update_page = REFRESH_PAGE;
-        }
-      }
+void SCO_tempo_following_add_onset(uint32_t onset_time) {
+  for (uint16_t b = 0; b < TF_NUMBER_OF_BINS; b++) tf_histogram[b] -= tf_histogram[b] >> TF_DECAY_SHIFT;
+
+  uint8_t index = tf_onset_index;
+  for (uint8_t k = 0; k < tf_number_of_onsets; k++) {
+    if (index == 0) index = TF_NUMBER_OF_ONSETS;
+    index--;
+    uint32_t interval = onset_time - tf_onset_time[index];
+    if (interval > MAX_BPM_TIME) break; // Older onsets are even further away
+    if (interval < 60000000 / MAX_BPM) continue; // Subdivision - the comb filter will pick this up from the longer intervals
+    uint16_t bpm_x10 = 600000000 / interval;
+    uint16_t bin = (((bpm_x10 - (MIN_BPM * 10)) * TF_BINS_PER_BPM) + 5) / 10;
+    if (bin >= TF_NUMBER_OF_BINS) continue;
+    SCO_tempo_following_add_weight(bin, TF_ONSET_WEIGHT);
+    if (bin > 0) SCO_tempo_following_add_weight(bin - 1, TF_ONSET_WEIGHT / 2);
+    if (bin < TF_NUMBER_OF_BINS - 1) SCO_tempo_following_add_weight(bin + 1, TF_ONSET_WEIGHT / 2);
+  }
+
+  tf_onset_time[tf_onset_index] = onset_time;
+  tf_onset_index++;
+  if (tf_onset_index >= TF_NUMBER_OF_ONSETS) tf_onset_index = 0;
+  if (tf_number_of_onsets < TF_NUMBER_OF_ONSETS) tf_number_of_onsets++;
+}
+
+void SCO_tempo_following_add_weight(uint16_t bin, uint16_t weight) {
+  if (tf_histogram[bin] > 0xFFFF - weight) tf_histogram[bin] = 0xFFFF;
+  else tf_histogram[bin] += weight;
+}
+
+int16_t SCO_tempo_following_half_bin(uint16_t bin) { // Returns the bin with half the tempo or a negative number if it is out of range
+  int16_t half = ((MIN_BPM * TF_BINS_PER_BPM) + bin) / 2 - (MIN_BPM * TF_BINS_PER_BPM);
+  return half;
+}
+
+int16_t SCO_tempo_following_third_bin(uint16_t bin) { // Returns the bin with a third of the tempo or a negative number if it is out of range
+  return ((MIN_BPM * TF_BINS_PER_BPM) + bin) / 3 - (MIN_BPM * TF_BINS_PER_BPM);
+}
+
+int16_t SCO_tempo_following_double_bin(uint16_t bin) { // Returns the bin with double the tempo or -1 if it is out of range
+  int16_t dbl = 2 * ((MIN_BPM * TF_BINS_PER_BPM) + bin) - (MIN_BPM * TF_BINS_PER_BPM);
+  if (dbl >= TF_NUMBER_OF_BINS) return -1;
+  return dbl;
+}
+
+uint32_t SCO_tempo_following_score(int16_t bin) {
+  if ((bin < 0) || (bin >= TF_NUMBER_OF_BINS)) return 0;
+  uint32_t score = tf_histogram[bin];
+  int16_t half = SCO_tempo_following_half_bin(bin);
+  if (half >= 0) score += tf_histogram[half] / 2;
+  int16_t third = SCO_tempo_following_third_bin(bin);
+  if (third >= 0) score += tf_histogram[third] / 3;
+  int16_t dbl = SCO_tempo_following_double_bin(bin);
+  if (dbl >= 0) score += tf_histogram[dbl] / 4; // Subdivisions support the tempo less than intervals of two beats
+  return score;
+}
+
+uint16_t SCO_tempo_following_find_tempo(uint8_t &confidence) { // Returns the tempo in tenths of bpm
+  uint32_t best_score = 0;
+  int16_t best_bin = -1;
+  for (uint16_t b = 0; b < TF_NUMBER_OF_BINS; b++) {
+    uint32_t score = SCO_tempo_following_score(b);
+    if (score > best_score) {
+      best_score = score;
+      best_bin = b;
+    }
+  }
+  confidence = 0;
+  if (best_bin < 0) return 0;
+
+  // Half/double time: stay at the current tempo if the other octave scores almost as well
+  int16_t current_bin = ((SCO_get_bpm_x10() - (MIN_BPM * 10)) * TF_BINS_PER_BPM) / 10;
+  int16_t candidates[2] = { SCO_tempo_following_half_bin(best_bin), SCO_tempo_following_double_bin(best_bin) };
+  int16_t chosen_bin = best_bin;
+  for (uint8_t c = 0; c < 2; c++) {
+    if (candidates[c] < 0) continue;
+    if (SCO_tempo_following_score(candidates[c]) * 100 < best_score * TF_OCTAVE_SCORE) continue;
+    if (abs(candidates[c] - current_bin) * 100 > Setting.Bpm * TF_BINS_PER_BPM * TF_OCTAVE_RANGE) continue;
+    if (abs(candidates[c] - current_bin) < abs(chosen_bin - current_bin)) chosen_bin = candidates[c];
+  }
+
+  // Confidence compares the chosen tempo with the best tempo that is not related to it
+  int16_t related[4] = { chosen_bin, SCO_tempo_following_half_bin(chosen_bin), SCO_tempo_following_third_bin(chosen_bin), SCO_tempo_following_double_bin(chosen_bin) };
+  uint32_t chosen_score = SCO_tempo_following_score(chosen_bin);
+  uint32_t second_score = 0;
+  for (uint16_t b = 0; b < TF_NUMBER_OF_BINS; b++) {
+    bool is_related = false;
+    for (uint8_t r = 0; r < 4; r++) {
+      if ((related[r] >= 0) && (abs((int16_t)b - related[r]) <= 2)) is_related = true;
     }
+    if (is_related) continue;
+    uint32_t score = SCO_tempo_following_score(b);
+    if (score > second_score) second_score = score;
+  }
+  if (second_score >= chosen_score) confidence = 0;
+  else confidence = 100 - ((second_score * 100) / chosen_score);
+
+  // Parabolic interpolation of the peak gives the tempo in tenths of bpm
+  int32_t offset_x10 = 0;
+  if ((chosen_bin > 0) && (chosen_bin < TF_NUMBER_OF_BINS - 1)) {
+    int32_t l = tf_histogram[chosen_bin - 1];
+    int32_t c = tf_histogram[chosen_bin];
+    int32_t r = tf_histogram[chosen_bin + 1];
+    int32_t denom = l - (2 * c) + r;
+    if (denom < 0) offset_x10 = (5 * (l - r)) / denom; // Offset in tenths of a bin, between -5 and 5
   }
+  int32_t bpm_x10 = (MIN_BPM * 10) + (((chosen_bin * 10) + offset_x10) / TF_BINS_PER_BPM);
+  if (bpm_x10 < MIN_BPM * 10) bpm_x10 = MIN_BPM * 10;
+  if (bpm_x10 > MAX_BPM * 10) bpm_x10 = MAX_BPM * 10;
+  return bpm_x10;
 }
 
 void reset_tempo_following() {
-  tap_follow_bpm_index = 0;
-  tap_follow_buffer_full = false;
+  memset(tf_histogram, 0, sizeof(tf_histogram));
+  tf_onset_index = 0;
+  tf_number_of_onsets = 0;
+  tf_bpm_x10 = 0;
+  tf_new_tempo_candidate_x10 = 0;
 }
 
 // ********************************* Section 8: Bass Mode (Low/High String Priority) ********************************************
 
 // Bass mode: sends a CC message with the number of the lowest string that is being played.
 // By making smart assigns on a device, you can hear just the bass note played
+// High note priority sends the number of the highest string on the HNP CC. Chord mode sends the strings that are played as a bit pattern (bit 0 is string 1) on the bass mode CC.
+// When strumming fast, the string state changes many times within a few milliseconds. A new state is sent right away when the last bass mode CC was sent
+// more than BASS_MODE_MIN_CC_INTERVAL ago. Otherwise only the newest state is sent once the interval has passed, so no CC messages are queued up on slow ports.
+// A string keeps priority for at least the hold time (Setting.Bass_mode_hold_time) when it is released, so short drops of the string level will not switch strings.
+
+#define BASS_MODE_LOW_AND_HIGH 0
+#define BASS_MODE_LOW_ONLY 1
+#define BASS_MODE_HIGH_ONLY 2
+#define BASS_MODE_CHORD 3
+#define BASS_MODE_MAX_STRINGS 7
+#define BASS_MODE_MAX_HOLD_TIME 50 // In steps of 10 ms
+#define BASS_MODE_VELOCITY_HYSTERESIS 10 // A string that is on, is only switched off by a note on message with a velocity this much below the minimum velocity
+#define BASS_MODE_MIN_CC_INTERVAL 3000 // Minimum time in microseconds between bass mode CC messages. A CC message on a 5-pin DIN port takes about one millisecond.
 
 uint8_t bass_string = 0; //remembers the lowest string played
-uint8_t top_string = 5; // remebers the highest string played
+uint8_t top_string = 7; // remebers the highest string played
+uint8_t chord_strings = 0; // remembers the strings played in chord mode
+uint32_t bass_string_time = 0; // the time the bass string was selected
+uint32_t top_string_time = 0; // the time the top string was selected
+uint32_t bass_mode_last_cc_time = 0;
+bool bass_mode_update_pending = false;
 
 // Method 1:
 /*
@@ -1861,59 +2120,111 @@ uint8_t top_string = 5; // remebers the highest string played
   }
 */
 // Method 2:
-bool string_on[6] = { false }; // remember the current state of every string
+bool string_on[BASS_MODE_MAX_STRINGS] = { false }; // remember the current state of every string
 
 void SCO_bass_mode_note_on(uint8_t note, uint8_t velocity, uint8_t channel, uint8_t port) {
-  if ((channel >= Setting.Bass_mode_G2M_channel) && (channel <= Setting.Bass_mode_G2M_channel + 5)) {
-    uint8_t string_played = channel - Setting.Bass_mode_G2M_channel;
-
-    if (velocity >= Setting.Bass_mode_min_velocity) {
-      string_on[string_played] = true;
-      SCO_bass_mode_check_string();
-      SCO_bass_mode_check_high_string();
-    }
+  uint8_t string_played;
+  if (!SCO_bass_mode_get_string(channel, string_played)) return;
 
-    else { // string level below minimum threshold or string off on VG99
-      string_on[string_played] = false;
-      SCO_bass_mode_check_string();
-      //SCO_bass_mode_check_high_string();
-    }
-  }
+  if ((velocity > 0) && (velocity >= Setting.Bass_mode_min_velocity)) string_on[string_played] = true;
+  else if ((velocity == 0) || (velocity + BASS_MODE_VELOCITY_HYSTERESIS < Setting.Bass_mode_min_velocity)) string_on[string_played] = false; // string level below minimum threshold or string off on VG99
+  SCO_bass_mode_update();
 }
 
 void SCO_bass_mode_note_off(uint8_t note, uint8_t velocity, uint8_t channel, uint8_t port) {
-  if ((channel >= Setting.Bass_mode_G2M_channel) && (channel <= Setting.Bass_mode_G2M_channel + 5)) {
-    uint8_t string_played = channel - Setting.Bass_mode_G2M_channel;
-    string_on[string_played] = false;
-    SCO_bass_mode_check_string();
-    //SCO_bass_mode_check_high_string();
+  uint8_t string_played;
+  if (!SCO_bass_mode_get_string(channel, string_played)) return;
+  string_on[string_played] = false;
+  SCO_bass_mode_update();
+}
+
+bool SCO_bass_mode_get_string(uint8_t channel, uint8_t &string_played) {
+  if (channel < Setting.Bass_mode_G2M_channel) return false;
+  string_played = channel - Setting.Bass_mode_G2M_channel;
+  return (string_played < SCO_bass_mode_number_of_strings());
+}
+
+uint8_t SCO_bass_mode_number_of_strings() {
+  if (Setting.Bass_mode_number_of_strings == BASS_MODE_MAX_STRINGS) return BASS_MODE_MAX_STRINGS;
+  return 6;
+}
+
+void SCO_bass_mode_check_pending() { // Called from the main loop
+  if (bass_mode_update_pending) SCO_bass_mode_update();
+}
+
+void SCO_bass_mode_update() {
+  if (Setting.Bass_mode_device >= NUMBER_OF_DEVICES) return;
+  if (micros() - bass_mode_last_cc_time < BASS_MODE_MIN_CC_INTERVAL) {
+    bass_mode_update_pending = true; // Send the newest state when the interval has passed
+    return;
   }
+  bass_mode_update_pending = false;
+
+  uint8_t mode = Setting.Bass_mode_priority;
+  if (mode > BASS_MODE_CHORD) mode = BASS_MODE_LOW_AND_HIGH;
+  if (mode == BASS_MODE_CHORD) {
+    SCO_bass_mode_check_chord();
+    return;
+  }
+  if (mode != BASS_MODE_HIGH_ONLY) SCO_bass_mode_check_string();
+  if (mode != BASS_MODE_LOW_ONLY) SCO_bass_mode_check_high_string();
+}
+
+bool SCO_bass_mode_hold_time_passed(uint32_t selected_time) {
+  uint8_t hold_time = Setting.Bass_mode_hold_time;
+  if (hold_time > BASS_MODE_MAX_HOLD_TIME) hold_time = 0;
+  if (millis() - selected_time >= (uint32_t)hold_time * 10) return true;
+  bass_mode_update_pending = true; // Check again from the main loop
+  return false;
+}
+
+void SCO_bass_mode_send_cc(uint8_t cc, uint8_t value) {
+  MIDI_send_CC(cc, value, Device[Setting.Bass_mode_device]->MIDI_channel, Device[Setting.Bass_mode_device]->MIDI_out_port);
+  bass_mode_last_cc_time = micros();
 }
 
 void SCO_bass_mode_check_string() {
   uint8_t lowest_string_played = 0;
-  for (uint8_t s = 0; s < 6; s++) { // Find the lowest string that is played (has highest string number)
+  uint8_t number_of_strings = SCO_bass_mode_number_of_strings();
+  for (uint8_t s = 0; s < number_of_strings; s++) { // Find the lowest string that is played (has highest string number)
     if (string_on[s]) lowest_string_played = s + 1;
   }
-  if (lowest_string_played != bass_string) {
-    bass_string = lowest_string_played;
-    if (Setting.Bass_mode_device < NUMBER_OF_DEVICES)
-      MIDI_send_CC(Setting.Bass_mode_cc_number , bass_string, Device[Setting.Bass_mode_device]->MIDI_channel, Device[Setting.Bass_mode_device]->MIDI_out_port);
-    DEBUGMAIN("Set lowest string: " + String(bass_string));
-  }
+  if (lowest_string_played == bass_string) return;
+  if ((lowest_string_played < bass_string) && (!SCO_bass_mode_hold_time_passed(bass_string_time))) return; // Bass string released - wait for the hold time
+  bass_string = lowest_string_played;
+  bass_string_time = millis();
+  SCO_bass_mode_send_cc(Setting.Bass_mode_cc_number, bass_string);
+  DEBUGMAIN("Set lowest string: " + String(bass_string));
 }
 
 void SCO_bass_mode_check_high_string() {
-  uint8_t highest_string_played = 7;
-  for (uint8_t s = 5; s -- > 0;) { // Find the lowest string that is played (has highest string number)
+  uint8_t number_of_strings = SCO_bass_mode_number_of_strings();
+  uint8_t highest_string_played = number_of_strings + 1;
+  for (uint8_t s = number_of_strings; s-- > 0;) { // Find the highest string that is played (has lowest string number)
     if (string_on[s]) highest_string_played = s + 1;
   }
-  if (highest_string_played != top_string) {
-    top_string = highest_string_played;
-    if (Setting.Bass_mode_device < NUMBER_OF_DEVICES)
-      MIDI_send_CC(Setting.HNP_mode_cc_number, top_string, Device[Setting.Bass_mode_device]->MIDI_channel, Device[Setting.Bass_mode_device]->MIDI_out_port);
-    DEBUGMAIN("Set highest string: " + String(top_string));
+  if (highest_string_played > number_of_strings) return; // No strings played - keep the last string, so it can ring out
+  if (highest_string_played == top_string) return;
+  if ((highest_string_played > top_string) && (!SCO_bass_mode_hold_time_passed(top_string_time))) return; // Top string released - wait for the hold time
+  top_string = highest_string_played;
+  top_string_time = millis();
+  SCO_bass_mode_send_cc(Setting.HNP_mode_cc_number, top_string);
+  DEBUGMAIN("Set highest string: " + String(top_string));
+}
+
+void SCO_bass_mode_check_chord() {
+  uint8_t strings_played = 0;
+  uint8_t number_of_strings = SCO_bass_mode_number_of_strings();
+  for (uint8_t s = 0; s < number_of_strings; s++) {
+    if (string_on[s]) strings_played |= (1 << s);
   }
+  if (strings_played == chord_strings) return;
+  if (((strings_played & chord_strings) == strings_played) && (!SCO_bass_mode_hold_time_passed(bass_string_time))) return; // Only strings released - wait for the hold time
+  chord_strings = strings_played;
+  bass_string_time = millis();
+  SCO_bass_mode_send_cc(Setting.Bass_mode_cc_number, chord_strings);
+  DEBUGMAIN("Set chord strings: " + String(chord_strings, BIN));
 }
 
 // ********************************* Section 9: VController Power On/Off Switching ********************************************
@@ -2012,6 +2323,7 @@ void SCO_move_master_exp_pedal(uint8_t Sw, uint8_t Dev) {
 void SCO_move_touch_screen_parameter(uint8_t sw, uint8_t val) { // Dragging a touch screen switch takes you here.
   switch_controlled_by_master_exp_pedal = sw;
   Expr_ped_value = val;
+  Expr_ped_value_14bit = (val << 7) | val;
   switch_type = SW_TYPE_EXPRESSION_PEDAL;
   SCO_change_menu_or_parameter_switch();
 }
@@ -2248,7 +2560,7 @@ uint8_t SCO_read_setlist_tempo(uint8_t item) {
 
 void SCO_setlist_set_tempo(uint16_t item) {
   uint8_t tempo = SCO_read_setlist_tempo(item);
-  if (tempo > GLOBAL_TEMPO) SCO_set_global_tempo_press(tempo);
+  if (tempo > GLOBAL_TEMPO) SCO_set_global_tempo_x10(tempo * 10);
 }
 
 void SCO_save_setlist_item(uint8_t item) {
@@ -2445,7 +2757,7 @@ bool SCO_setlist_active(uint8_t target) {
 // byte 28      Target #3 midi data
 // byte 29      Target #4 midi data
 // byte 30      Target #5 midi data
-// byte 31      Spare
+// byte 31      Song tempo tenths (0 - 9)
 // byte 32 - 51 Part 1 (10 bytes name + 10 bytes for target data)
 // --
 // byte 172 - 191 Part 8
@@ -2454,6 +2766,7 @@ bool SCO_setlist_active(uint8_t target) {
 #define SONG_NAME_SIZE 16
 #define SONG_PART_ACTIVE_INDEX 19
 #define SONG_TEMPO_INDEX 20
+#define SONG_TEMPO_TENTHS_INDEX 31
 #define SONG_TARGET_DEVICE1 21
 #define SONG_TARGET_DEVICE2 22
 #define SONG_TARGET_DEVICE3 23
@@ -2468,6 +2781,10 @@ bool SCO_setlist_active(uint8_t target) {
 #define SONG_PART_SIZE 20
 #define SONG_PART_NAME_SIZE 10
 
+#define PART_CHANGE_IMMEDIATELY 0
+#define PART_CHANGE_NEXT_BEAT 1
+#define PART_CHANGE_NEXT_BAR 2
+
 void SCO_get_song_number_name(uint8_t number, String &name) {
   name += "SNG";
   LCD_add_2digit_number(number + 1, name);
@@ -2580,9 +2897,11 @@ void SCO_select_song(uint8_t number) {
   update_page = REFRESH_PAGE;
   update_main_lcd = true;
   EEPROM_update_when_quiet();
+  SCO_schedule_song_prefetch();
 }
 
 void SCO_song_up_down(signed int delta) {
+  song_prefetch_direction = (delta < 0) ? -1 : 1;
   uint8_t New_song = update_encoder_value(delta, Current_song_setlist_item, 0, SCO_get_song_max());
   Current_song_setlist_item = New_song;
   SCO_select_song(SCO_get_song_number(New_song));
@@ -2611,14 +2930,17 @@ void SCO_select_part(uint8_t number) {
   if (LCD_check_popup_allowed(0)) LCD_show_popup_label(msg, MESSAGE_TIMER_LENGTH);
   device_in_bank_selection = 0;
   EEPROM_update_when_quiet();
+  SCO_schedule_song_prefetch();
 }
 
 void SCO_part_up_down(signed int delta) {
+  song_prefetch_direction = (delta < 0) ? -1 : 1;
   uint8_t New_part = update_encoder_value(delta, Current_part, 0, NUMBER_OF_PARTS - 1);
   SCO_select_part(SCO_get_song_number(New_part));
 }
 
 void SCO_songpart_up_down(signed int delta) {
+  song_prefetch_direction = (delta < 0) ? -1 : 1;
   for (uint16_t i = 0; i < abs(delta); i++) {
     uint8_t next_part = NOT_FOUND;
     if (delta < 0) next_part = SCO_find_prev_active_part(Current_part);
@@ -2718,6 +3040,7 @@ void SCO_load_song_buffer_with_empty_song() {
   for (uint8_t i = name.length(); i < SONG_NAME_SIZE; i++) Current_song_buffer[SONG_NAME_INDEX + i] = (uint8_t) ' ';
   Current_song_buffer[SONG_PART_ACTIVE_INDEX] = 0;
   Current_song_buffer[SONG_TEMPO_INDEX] = GLOBAL_TEMPO;
+  Current_song_buffer[SONG_TEMPO_TENTHS_INDEX] = 0;
   for (uint8_t i = 0; i < NUMBER_OF_SONG_TARGETS; i++) {
     Current_song_buffer[SONG_TARGET_DEVICE1 + i] = 0;
     Current_song_buffer[SONG_TARGET_MIDI_DATA1 + i] = 0;
@@ -2733,29 +3056,91 @@ void SCO_load_song_buffer_with_empty_song() {
 }
 
 void SCO_execute_current_part() {
+  part_change_pending = 0; // A new part replaces a part that is still waiting for its beat
   if (!SCO_check_part_active(Current_part)) return;
+  if (Setting.Song_part_change_timing != PART_CHANGE_IMMEDIATELY) {
+    SCO_schedule_current_part(micros());
+    return;
+  }
+  for (uint8_t i = 0; i < NUMBER_OF_SONG_TARGETS; i++) SCO_execute_part_target(i, Current_song_item[i]);
+}
+
+void SCO_execute_part_target(uint8_t index, uint16_t item) {
+  uint8_t target = Current_song_buffer[SONG_TARGET_DEVICE1 + index];
+  uint8_t port = MIDI_set_port_number_from_menu(Current_song_midi_port[index]);
+  if (target == SONG_TARGET_PC) {
+    MIDI_send_PC(item, Current_song_midi_channel[index], port); // Program, Channel, Port
+    MIDI_update_PC_ledger(item, Current_song_midi_channel[index], port, true);
+  }
+  if (target == SONG_TARGET_CC) {
+    MIDI_send_CC(item >> 7, item & 0x7F, Current_song_midi_channel[index], port); // Controller, Value, Channel, Port
+    MIDI_update_CC_ledger(item >> 7, item & 0x7F, Current_song_midi_channel[index], port, true);
+  }
+  if (target == SONG_TARGET_TEMPO) {
+    SCO_set_global_tempo_press(item + MIN_BPM);
+  }
+  if ((target >= SONG_TARGET_FIRST_DEVICE) && (target < (NUMBER_OF_DEVICES + SONG_TARGET_FIRST_DEVICE))) {
+    Device[target - SONG_TARGET_FIRST_DEVICE]->setlist_song_select(item);
+  }
+}
+
+// Scheduled part changes
+// When Setting.Song_part_change_timing is set, the targets of a part are sent on the next beat or the next bar of the clock (see SCO_clock_beat()).
+// Every device target is sent its load time (setlist_song_get_load_time()) before the beat, so the devices play the new sound on the beat.
+// If there is not enough time left before the next beat for the slowest device, the part changes on the beat (or bar) after that.
+
+void SCO_schedule_current_part(uint32_t now) {
+  uint32_t lead_time[NUMBER_OF_SONG_TARGETS];
+  uint32_t max_lead_time = 0;
   for (uint8_t i = 0; i < NUMBER_OF_SONG_TARGETS; i++) {
+    lead_time[i] = 0;
     uint8_t target = Current_song_buffer[SONG_TARGET_DEVICE1 + i];
-    if (target == SONG_TARGET_PC) {
-      MIDI_send_PC(Current_song_item[i], Current_song_midi_channel[i], MIDI_set_port_number_from_menu(Current_song_midi_port[i])); // Program, Channel, Port
-      MIDI_update_PC_ledger(Current_song_item[i], Current_song_midi_channel[i], MIDI_set_port_number_from_menu(Current_song_midi_port[i]), true);
-    }
-    if (target == SONG_TARGET_CC) {
-      MIDI_send_CC(Current_song_item[i] >> 7, Current_song_item[i] & 0x7F, Current_song_midi_channel[i], MIDI_set_port_number_from_menu(Current_song_midi_port[i])); // Controller, Value, Channel, Port
-      MIDI_update_CC_ledger(Current_song_item[i] >> 7, Current_song_item[i] & 0x7F, Current_song_midi_channel[i], MIDI_set_port_number_from_menu(Current_song_midi_port[i]), true);
-    }
-    if (target == SONG_TARGET_TEMPO) {
-      SCO_set_global_tempo_press(Current_song_item[i] + MIN_BPM);
-    }
     if ((target >= SONG_TARGET_FIRST_DEVICE) && (target < (NUMBER_OF_DEVICES + SONG_TARGET_FIRST_DEVICE))) {
-      Device[target - SONG_TARGET_FIRST_DEVICE]->setlist_song_select(Current_song_item[i]);
+      lead_time[i] = Device[target - SONG_TARGET_FIRST_DEVICE]->setlist_song_get_load_time(Current_song_item[i]) * 1000UL;
+    }
+    if (lead_time[i] > max_lead_time) max_lead_time = lead_time[i];
+  }
+
+  __disable_irq();
+  uint32_t beat_time = clock_beat_time;
+  uint32_t beat_number = clock_beat_number;
+  __enable_irq();
+  uint32_t change_time = SCO_next_part_change_time(now + max_lead_time, beat_time, beat_number, 600000000 / SCO_get_bpm_x10(), Setting.Song_part_change_timing);
+  DEBUGMSG("Part change scheduled in " + String((change_time - now) / 1000) + " ms");
+
+  for (uint8_t i = 0; i < NUMBER_OF_SONG_TARGETS; i++) {
+    part_change_item[i] = Current_song_item[i];
+    part_change_time[i] = change_time - lead_time[i];
+    bitSet(part_change_pending, i);
+  }
+}
+
+uint32_t SCO_next_part_change_time(uint32_t earliest_time, uint32_t beat_time, uint32_t beat_number, uint32_t beat_interval, uint8_t timing) {
+  // Returns the time of the first beat (or first beat of a bar) after earliest_time. Times are in microseconds, beat_time and beat_number are of the last beat.
+  uint32_t beats = ((earliest_time - beat_time) / beat_interval) + 1;
+  if (timing == PART_CHANGE_NEXT_BAR) {
+    uint8_t position = (beat_number + beats) % BEATS_PER_BAR;
+    if (position != 0) beats += BEATS_PER_BAR - position;
+  }
+  return beat_time + (beats * beat_interval);
+}
+
+void SCO_check_scheduled_part_change() { // Called from the main loop
+  if (part_change_pending == 0) return;
+  uint32_t now = micros();
+  for (uint8_t i = 0; i < NUMBER_OF_SONG_TARGETS; i++) {
+    if ((bitRead(part_change_pending, i)) && ((int32_t)(now - part_change_time[i]) >= 0)) {
+      bitClear(part_change_pending, i);
+      SCO_execute_part_target(i, part_change_item[i]);
     }
   }
 }
 
 void SCO_send_song_tempo() {
   uint8_t tempo = Current_song_buffer[SONG_TEMPO_INDEX];
-  if (tempo > GLOBAL_TEMPO) SCO_set_global_tempo_press(tempo);
+  uint8_t tenths = Current_song_buffer[SONG_TEMPO_TENTHS_INDEX];
+  if (tenths > 9) tenths = 0; // Songs from older versions have a spare byte here
+  if (tempo > GLOBAL_TEMPO) SCO_set_global_tempo_x10((tempo * 10) + tenths);
 }
 
 void SCO_load_current_device_state_in_song() {
@@ -2792,9 +3177,14 @@ void SCO_load_current_device_state_in_song() {
     Current_song_item[index] = Setting.Bpm - MIN_BPM;
   }
   else if (tempo_edited) {
-    Current_song_buffer[SONG_TEMPO_INDEX] = Setting.Bpm;
+    uint16_t bpm_x10 = SCO_get_bpm_x10();
+    Current_song_buffer[SONG_TEMPO_INDEX] = bpm_x10 / 10;
+    Current_song_buffer[SONG_TEMPO_TENTHS_INDEX] = bpm_x10 % 10;
+  }
+  else {
+    Current_song_buffer[SONG_TEMPO_INDEX] = GLOBAL_TEMPO;
+    Current_song_buffer[SONG_TEMPO_TENTHS_INDEX] = 0;
   }
-  else Current_song_buffer[SONG_TEMPO_INDEX] = GLOBAL_TEMPO;
 
   SCO_save_current_part();
 }
@@ -2893,3 +3283,132 @@ bool SCO_check_song_target_set() {
   }
   return false;
 }
+
+// Song prefetch
+// After a song or part change, the song and part that are most likely selected next are read into the patch cache (see H_MEMORY.ino).
+// This is done from the main loop once all commands of the switch have been executed, so the next song or part change only has to send MIDI.
+
+void SCO_schedule_song_prefetch() {
+  song_prefetch_timer = millis() + SONG_PREFETCH_DELAY;
+}
+
+void SCO_check_song_prefetch() { // Called from the main loop
+  if (song_prefetch_timer == 0) return;
+  if (current_cmd > 0) return; // Wait until the commands of the switch have been executed
+  if (part_change_pending != 0) return; // Do not delay a scheduled part change
+  if (millis() < song_prefetch_timer) return;
+  song_prefetch_timer = 0;
+  SCO_prefetch_next_song_and_part();
+}
+
+void SCO_prefetch_next_song_and_part() {
+  // Next part of the current song
+  uint8_t next_part;
+  if (song_prefetch_direction < 0) next_part = SCO_find_prev_active_part(Current_part);
+  else next_part = SCO_find_next_active_part(Current_part);
+  if (next_part != NOT_FOUND) SCO_prefetch_part_device_patches(Current_song_buffer, next_part);
+
+  // Next song - SCO_select_song() always starts with the first part
+  uint8_t item = Current_song_setlist_item;
+  if (song_prefetch_direction < 0) {
+    if (item == 0) return;
+    item--;
+  }
+  else {
+    if (item >= SCO_get_song_max()) return;
+    item++;
+  }
+  const uint8_t *next_song_buffer = EEPROM_prefetch_device_patch(EXT_SONG_TYPE, SCO_get_song_number(item));
+  if (next_song_buffer != NULL) SCO_prefetch_part_device_patches(next_song_buffer, 0);
+}
+
+void SCO_prefetch_part_device_patches(const uint8_t *song_buffer, uint8_t part) {
+  if ((song_buffer[SONG_PART_ACTIVE_INDEX] & (1 << part)) == 0) return;
+  uint8_t part_index = SONG_PART_BASE_INDEX + SONG_PART_NAME_SIZE + (SONG_PART_SIZE * part);
+  for (uint8_t i = 0; i < NUMBER_OF_SONG_TARGETS; i++) {
+    uint8_t target = song_buffer[SONG_TARGET_DEVICE1 + i];
+    uint16_t item = (song_buffer[part_index] << 8) + song_buffer[part_index + 1];
+    part_index += 2;
+    if ((target >= SONG_TARGET_FIRST_DEVICE) && (target < (NUMBER_OF_DEVICES + SONG_TARGET_FIRST_DEVICE))) {
+      uint8_t dev = target - SONG_TARGET_FIRST_DEVICE;
+      uint16_t patch = Device[dev]->setlist_song_get_vc_memory_patch(item);
+      if (patch != NO_RESULT) EEPROM_prefetch_device_patch(dev + 1, patch); // Patch data is stored with the device number + 1 as type
+    }
+  }
+}
+
+// ********************************* Section 13: Modulation Commands ********************************************
+
+// The MODULATION command sets up and starts the lanes of the modulation engine in Devices.ino.
+// Data1 is the command type (MOD_CMD_START - MOD_CMD_TARGET_PAR) and Data2 the lane (1 - 4). The values depend on the command type:
+// MOD_CMD_START and MOD_CMD_START_STOP: Value1 is the pattern, Value2 the phase (0 - 127), Value3 and Value4 the minimum and maximum value.
+// MOD_CMD_TARGET_CC: Value1 is the CC number, Value2 the MIDI channel and Value3 the MIDI port.
+// MOD_CMD_TARGET_NRPN: Value1 is the MSB and Value2 the LSB of the NRPN number, Value3 the MIDI channel and Value4 the MIDI port.
+// MOD_CMD_TARGET_PAR: Value1 is the device and Value2 the parameter number. The lane values are scaled to the range of the parameter.
+
+// Patterns 1 - EXT_MAX_NUMBER_OF_SEQ_PATTERNS are stored in EEPROM. Then follow the fixed patterns in MOD_fixed_pattern (in Devices.ino) and the random pattern.
+// The Line6 Helix uses the same pattern numbers for its MIDI sequencer.
+
+#define MOD_FREE_RATE_STEP 100 // Cycle time of a free running pattern in ms per unit of the beat divider
+
+void SCO_modulation_command(Cmd_struct *cmd) {
+  uint8_t lane = cmd->Data2 - 1;
+  if (lane >= MOD_NUMBER_OF_LANES) return;
+  switch (cmd->Data1) {
+    case MOD_CMD_START:
+      SCO_start_modulation(lane, cmd);
+      break;
+    case MOD_CMD_STOP:
+      MOD_stop(lane);
+      break;
+    case MOD_CMD_START_STOP:
+      if (MOD_running(lane)) MOD_stop(lane);
+      else SCO_start_modulation(lane, cmd);
+      update_page = REFRESH_PAGE;
+      break;
+    case MOD_CMD_TARGET_CC:
+      MOD_set_target_CC(lane, cmd->Value1, cmd->Value2, MIDI_set_port_number_from_menu(cmd->Value3));
+      break;
+    case MOD_CMD_TARGET_NRPN:
+      MOD_set_target_NRPN(lane, (cmd->Value1 << 7) + cmd->Value2, cmd->Value3, MIDI_set_port_number_from_menu(cmd->Value4));
+      break;
+    case MOD_CMD_TARGET_PAR:
+      MOD_set_target_parameter(lane, cmd->Value1, cmd->Value2);
+      break;
+  }
+}
+
+void SCO_start_modulation(uint8_t lane, Cmd_struct *cmd) {
+  SCO_load_modulation_pattern(lane, cmd->Value1);
+  MOD_set_phase(lane, cmd->Value2);
+  MOD_set_range(lane, cmd->Value3, cmd->Value4);
+  MOD_start(lane);
+}
+
+void SCO_load_modulation_pattern(uint8_t lane, uint8_t pattern) {
+  // Loads the pattern with its rate, sync and smoothing. Pattern numbers start at 1.
+  const uint8_t *data;
+  if ((pattern > 0) && (pattern <= EXT_MAX_NUMBER_OF_SEQ_PATTERNS)) { // Load from EEPROM
+    EEPROM_load_seq_pattern(pattern - 1, EEPROM_seq_pattern);
+    data = EEPROM_seq_pattern;
+  }
+  else if ((pattern > 0) && (pattern < MOD_NUMBER_OF_PATTERNS)) { // Load fixed pattern
+    data = MOD_fixed_pattern[pattern - EXT_MAX_NUMBER_OF_SEQ_PATTERNS - 1];
+  }
+  else { // Load random pattern
+    MOD_set_random_pattern(lane, MOD_RANDOM_PATTERN_STEPS);
+    MOD_set_rate(lane, MOD_SYNC_TEMPO, MOD_RANDOM_PATTERN_BEATS);
+    MOD_set_smoothing(lane, 0);
+    DEBUGMSG("Modulation lane " + String(lane) + ": random pattern");
+    return;
+  }
+
+  uint8_t sync = data[2];
+  uint16_t rate = data[0];
+  if (sync > MOD_SYNC_FREE) sync = MOD_SYNC_TEMPO;
+  if (sync == MOD_SYNC_FREE) rate *= MOD_FREE_RATE_STEP;
+  MOD_set_pattern(lane, &data[4], data[1]);
+  MOD_set_rate(lane, sync, rate);
+  MOD_set_smoothing(lane, data[3]);
+  DEBUGMSG("Modulation lane " + String(lane) + ": pattern " + String(pattern) + ", rate:" + String(rate) + ", sync:" + String(sync));
+}
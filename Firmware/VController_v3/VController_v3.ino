@@ -129,14 +129,23 @@ void setup() {
 }
 
 void loop() {
+  uint32_t profile_time = PROFILE_start_loop(); // The loop profiler is in debug.h
   main_switch_check(); // Check for switches pressed
+  profile_time = PROFILE_measure(PROFILE_SWITCH_CHECK, profile_time);
   main_switch_control(); //If switch is pressed, take the configured action
+  profile_time = PROFILE_measure(PROFILE_SWITCH_CONTROL, profile_time);
   main_LED_control(); //Check update of LEDs
+  profile_time = PROFILE_measure(PROFILE_LED_CONTROL, profile_time);
   main_LCD_control(); //Check update of displays
+  profile_time = PROFILE_measure(PROFILE_LCD_CONTROL, profile_time);
   main_MIDI_common(); //Read MIDI ports
+  profile_time = PROFILE_measure(PROFILE_MIDI_COMMON, profile_time);
   main_page(); // Check update of current page
+  profile_time = PROFILE_measure(PROFILE_PAGE, profile_time);
   main_devices();
+  profile_time = PROFILE_measure(PROFILE_DEVICES, profile_time);
   main_eeprom();
+  PROFILE_measure(PROFILE_EEPROM, profile_time);
   //MIDI_check_USBHMIDI();
 }
 
@@ -19,6 +19,9 @@ void StartFreeTimer();
 
 #define DEBUG_SYSEX_MAX_LENGTH 256 // The maximum numbers of bytes shown in the debug window
 
+// Print the time and the sum of the readings of every expression pedal update - for the traces in host_tests/traces
+//#define DEBUG_EXPR_TRACE
+
 // Check for free memory - to detect memory leaks
 //#define DEBUG_FREE
 
@@ -27,7 +30,7 @@ void StartFreeTimer();
 uint32_t serial_timer;
 
 void setup_debug() {
-#if defined(DEBUG_NORMAL) || defined(DEBUG_MAIN) || defined(DEBUG_MIDI) || defined(DEBUG_SYSEX)
+#if defined(DEBUG_NORMAL) || defined(DEBUG_MAIN) || defined(DEBUG_MIDI) || defined(DEBUG_SYSEX) || defined(DEBUG_EXPR_TRACE)
   Serial.begin(115200);
   serial_timer = millis();
   while ((!Serial) && (serial_timer - millis() < SERIAL_STARTUP_TIMER_LENGTH)) {}; // Wait while the serial communication is not ready or while the SERIAL_START_UP time has not elapsed.
@@ -149,4 +152,142 @@ void StartFreeTimer() {
 #endif
 }
 
+// Loop profiler
+// Measures the time every main_* function in loop() takes. On Teensy the time is read from the cycle counter of the Cortex-M (DWT_CYCCNT),
+// on other platforms micros() is used. Per subsystem the minimum, average and maximum time are kept, together with a histogram
+// with one bin per power of two microseconds. The 99th percentile is taken from the histogram, so it is the upper limit of its bin.
+// The profiler only runs while VC-edit asks for the telemetry. The statistics are sent to VC-edit by MIDI_send_profile_telemetry()
+// and cleared after each message, so every message covers the time since the previous one.
+// The profiler also measures the switch latency: the time from the switch edge to the first MIDI message that is sent after the switch event is handled.
+// The latency histogram has bins of one millisecond and is kept from the start of the profiler, as there are only a few switch events per message.
+
+#define PROFILE_SWITCH_CHECK 0
+#define PROFILE_SWITCH_CONTROL 1
+#define PROFILE_LED_CONTROL 2
+#define PROFILE_LCD_CONTROL 3
+#define PROFILE_MIDI_COMMON 4
+#define PROFILE_PAGE 5
+#define PROFILE_DEVICES 6
+#define PROFILE_EEPROM 7
+#define NUMBER_OF_PROFILE_SUBSYSTEMS 8
+#define PROFILE_HISTOGRAM_BINS 16 // Bin 0 is below 1 us, bin n is from 2^(n-1) to 2^n us. The last bin has no upper limit.
+#define PROFILE_LATENCY_BINS 32 // Bin n is from n to n + 1 ms. The last bin also counts all slower events.
+#define PROFILE_LATENCY_MAX_AGE 500000 // Messages sent later than this (in us) are not caused by the switch event
+
+#ifdef ARM_DWT_CYCCNT
+#define PROFILE_CLOCK() ARM_DWT_CYCCNT
+#if defined(__IMXRT1062__) // Teensy 4.0 and 4.1
+#define PROFILE_CYCLES_PER_US (F_CPU_ACTUAL / 1000000)
+#else
+#define PROFILE_CYCLES_PER_US (F_CPU / 1000000)
+#endif
+#else
+#define PROFILE_CLOCK() micros()
+#define PROFILE_CYCLES_PER_US 1
+#endif
+
+struct Profile_struct {
+  uint32_t min_time; // Times in microseconds
+  uint32_t max_time;
+  uint32_t total_time;
+  uint32_t count;
+  uint32_t bins[PROFILE_HISTOGRAM_BINS];
+};
+
+Profile_struct Profile[NUMBER_OF_PROFILE_SUBSYSTEMS];
+bool profile_active = false;
+bool profile_requested = false; // Set by VC-edit. The profiler starts or stops at the start of the next loop, so no loop is measured halfway
+uint32_t profile_loop_count = 0;
+uint32_t profile_start_time = 0; // In ms
+uint8_t profile_max_event_queue_depth = 0;
+uint16_t profile_events_lost = 0;
+uint8_t profile_max_cmd_batch = 0;
+uint16_t profile_latency_histogram[PROFILE_LATENCY_BINS];
+uint16_t profile_latency_count = 0;
+uint32_t profile_latency_edge_time = 0;
+bool profile_latency_pending = false;
+
+void PROFILE_clear() {
+  memset(Profile, 0, sizeof(Profile));
+  for (uint8_t s = 0; s < NUMBER_OF_PROFILE_SUBSYSTEMS; s++) Profile[s].min_time = 0xFFFFFFFF;
+  profile_loop_count = 0;
+  profile_start_time = millis();
+  profile_max_event_queue_depth = 0;
+  profile_max_cmd_batch = 0;
+}
+
+uint32_t PROFILE_start_loop() { // Returns the start time of the first subsystem
+  if (profile_requested != profile_active) {
+    profile_active = profile_requested;
+    if (profile_active) {
+#if defined(ARM_DWT_CYCCNT) && !defined(__IMXRT1062__)
+      ARM_DEMCR |= ARM_DEMCR_TRCENA; // The cycle counter is already running on Teensy 4.x
+      ARM_DWT_CTRL |= ARM_DWT_CTRL_CYCCNTENA;
+#endif
+      PROFILE_clear();
+      memset(profile_latency_histogram, 0, sizeof(profile_latency_histogram));
+      profile_latency_count = 0;
+      profile_latency_pending = false;
+    }
+  }
+  if (!profile_active) return 0;
+  profile_loop_count++;
+  return PROFILE_CLOCK();
+}
+
+uint32_t PROFILE_measure(uint8_t subsystem, uint32_t start) { // Returns the start time of the next subsystem
+  if (!profile_active) return 0;
+  uint32_t time = (PROFILE_CLOCK() - start) / PROFILE_CYCLES_PER_US;
+  Profile_struct &p = Profile[subsystem];
+  if (time < p.min_time) p.min_time = time;
+  if (time > p.max_time) p.max_time = time;
+  p.total_time += time;
+  p.count++;
+  uint8_t bin = (time == 0) ? 0 : 32 - __builtin_clz(time);
+  if (bin >= PROFILE_HISTOGRAM_BINS) bin = PROFILE_HISTOGRAM_BINS - 1;
+  p.bins[bin]++;
+  return PROFILE_CLOCK(); // Read the clock again, so the time of the profiler itself is not measured
+}
+
+uint32_t PROFILE_percentile_99(uint8_t subsystem) {
+  Profile_struct &p = Profile[subsystem];
+  uint32_t target = p.count - (p.count / 100); // Number of measurements at or below the 99th percentile
+  uint32_t total = 0;
+  for (uint8_t b = 0; b < PROFILE_HISTOGRAM_BINS - 1; b++) {
+    total += p.bins[b];
+    if (total >= target) {
+      uint32_t limit = (b == 0) ? 0 : (1UL << b) - 1;
+      return (limit < p.max_time) ? limit : p.max_time;
+    }
+  }
+  return p.max_time;
+}
+
+void PROFILE_check_event_queue(uint8_t depth, uint16_t events_lost) {
+  if (!profile_active) return;
+  if (depth > profile_max_event_queue_depth) profile_max_event_queue_depth = depth;
+  profile_events_lost = events_lost;
+}
+
+void PROFILE_check_cmd_batch(uint8_t number_of_commands) {
+  if ((profile_active) && (number_of_commands > profile_max_cmd_batch)) profile_max_cmd_batch = number_of_commands;
+}
+
+void PROFILE_start_switch_latency(uint32_t edge_time) { // Called when a switch event is read from the queue
+  if (!profile_active) return;
+  profile_latency_edge_time = edge_time;
+  profile_latency_pending = true;
+}
+
+void PROFILE_check_switch_latency() { // Called when a MIDI message is sent to a device
+  if (!profile_latency_pending) return;
+  profile_latency_pending = false;
+  uint32_t latency = micros() - profile_latency_edge_time;
+  if (latency > PROFILE_LATENCY_MAX_AGE) return;
+  uint8_t bin = latency / 1000;
+  if (bin >= PROFILE_LATENCY_BINS) bin = PROFILE_LATENCY_BINS - 1;
+  if (profile_latency_histogram[bin] < 0xFFFF) profile_latency_histogram[bin]++;
+  if (profile_latency_count < 0xFFFF) profile_latency_count++;
+}
+
 #endif
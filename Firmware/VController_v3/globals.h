@@ -61,6 +61,12 @@ struct Setting_struct { // All the global settings in one place.
   uint8_t Show_popup_messages; // Show popup messages
   uint8_t Main_display_top_line_mode;
   uint8_t Block_identity_messages; // To block sysex messages as it messes with certain devices
+  uint8_t Bass_mode_priority; // Low and high string, low string only, high string only or chord
+  uint8_t Bass_mode_number_of_strings; // 6 or 7 strings
+  uint8_t Bass_mode_hold_time; // Minimum time a string keeps priority after it is released (in steps of 10 ms)
+  uint8_t Song_part_change_timing; // Song parts change immediately, on the next beat or on the next bar
+  uint8_t Exp_pedal_high_res_CC; // Expression pedals send 14 bit CC messages (MSB on CC 0 - 31, LSB on CC 32 - 63)
+  uint8_t Cmd_execute_time_budget; // Time that switch commands may be executed in one loop cycle (in steps of 100 us, 0 is one command per loop cycle)
 };
 
 #define SETTING_BACKLIGHT_BRIGHTNESS_BYTE 5
@@ -127,6 +133,12 @@ const Setting_struct Default_settings = {  // Default values for global settings
   0,     // Show popup messages
   5,     // Main_display_top_line_mode
   0,     // Block_identity_messages
+  0,     // Bass_mode_priority: low and high string
+  6,     // Bass_mode_number_of_strings
+  0,     // Bass_mode_hold_time
+  0,     // Song_part_change_timing: immediately
+  false, // Exp_pedal_high_res_CC
+  20,    // Cmd_execute_time_budget: 2 ms
 };
 
 Setting_struct Setting;
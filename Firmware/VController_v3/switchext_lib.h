@@ -9,6 +9,14 @@
 // Can detect switch type by measuring voltage on jack ring.
 // Also detects and supports both normally open and normally closed switches by checking the value at the tip on startup.
 
+// Expression pedals are read through a pipeline:
+// 1) Oversampling: every update the tip is read EXPR_OVERSAMPLING times and the readings are added up.
+// 2) Calibration maps the sum to a 14 bit value (0 - 16383).
+// 3) An adaptive low pass filter (1 euro filter) removes jitter. The cutoff frequency is low when the pedal is not moving
+//    and goes up with the speed of the pedal, so moving the pedal gives little lag.
+// 4) Change detection with hysteresis: a new 7 bit value is only reported when the filtered value has moved past the current step
+//    by EXPR_HYSTERESIS. In high resolution mode a new value is reported when the 14 bit value has moved EXPR_HIGH_RES_HYSTERESIS.
+
 // Define switch types
 #define DETECT 0
 #define SWITCH_NORMALLY_OPEN 1
@@ -16,9 +24,19 @@
 #define EXPRESSION_PEDAL 3
 
 #define DEFAULT_EXP_PEDAL_UPDATE_TIME 25 // Time between detecting and reading.
-#define NUMBER_OF_UNIQUE_READINGS 3 // Number of values remembered. To avoid jitter of the expression pedal, a new value must be unique.
 //#define NUMBER_OF_STABLE_READINGS 5
 
+#define EXPR_PEDAL_UPDATE_TIME 5 // Time between reading an expression pedal
+#define EXPR_OVERSAMPLING 4 // Number of readings added up on every update
+#define EXPR_PEDAL_MAX_14BIT 16383
+#define EXPR_DEAD_ZONE 320 // The 14 bit value is stretched by this amount on either side, so we always reach min and max value.
+#define EXPR_MIN_CALIBRATION_RANGE 137 // Minimum difference between min and max reading before the pedal is used
+#define EXPR_FILTER_MIN_CUTOFF 1.0 // Cutoff frequency in Hz when the pedal is not moving
+#define EXPR_FILTER_BETA 8.0 // Increase of the cutoff frequency in Hz per full pedal sweep per second
+#define EXPR_FILTER_D_CUTOFF 2.0 // Cutoff frequency in Hz of the speed measurement
+#define EXPR_HYSTERESIS 32 // In 14 bit units - a quarter of a 7 bit step
+#define EXPR_HIGH_RES_HYSTERESIS 12 // In 14 bit units
+
 #define PAUSE_READING_TIME 50
 #define NUMBER_OF_PAUSES_BEFORE_SWITCH_TYPE_CHANGE 10
 
@@ -26,6 +44,42 @@
 #define REDETECT_HOLD_SWITCH_ACTIVITY 1
 #define REDETECT_SEND_SWITCH_RELEASE 2
 
+class ExprPedalFilter // The 1 euro filter
+{
+  public:
+    void reset() { started = false; }
+    float update(float value, uint32_t now_us);
+
+  private:
+    static float alpha(float cutoff, float dt) {
+      float tau = 1.0 / (2 * PI * cutoff);
+      return 1.0 / (1.0 + (tau / dt));
+    }
+    bool started = false;
+    float value_prev;
+    float speed_prev;
+    uint32_t time_prev;
+};
+
+float ExprPedalFilter::update(float value, uint32_t now_us) {
+  if (!started) {
+    started = true;
+    value_prev = value;
+    speed_prev = 0;
+    time_prev = now_us;
+    return value;
+  }
+  float dt = (now_us - time_prev) / 1000000.0;
+  if (dt <= 0) return value_prev;
+  time_prev = now_us;
+
+  float speed = (value - value_prev) / dt;
+  speed_prev += alpha(EXPR_FILTER_D_CUTOFF, dt) * (speed - speed_prev);
+  float cutoff = EXPR_FILTER_MIN_CUTOFF + (EXPR_FILTER_BETA * fabs(speed_prev) / EXPR_PEDAL_MAX_14BIT);
+  value_prev += alpha(cutoff, dt) * (value - value_prev);
+  return value_prev;
+}
+
 class SwitchExt
 {
   public:
@@ -33,6 +87,8 @@ class SwitchExt
     void init();
     bool update();
     uint8_t pedal_value();
+    uint16_t pedal_value_14bit();
+    void set_high_resolution(bool state);
     uint8_t pressed();
     uint8_t released();
     bool check_expr_pedal();
@@ -49,7 +105,8 @@ class SwitchExt
     bool update_expr_pedal();
     bool update_switches();
     bool detect(bool first_time);
-    bool check_unique_tip_value(uint16_t new_value);
+    uint16_t read_oversampled();
+    bool check_new_value(uint16_t new_value_14bit);
     //bool check_stable_ring_value(uint16_t new_value);
 
     uint8_t dpin_tip; // Pin number of digital pin connected to the tip of the Jack connector
@@ -73,11 +130,12 @@ class SwitchExt
     bool detectable;
     
     uint16_t expr_value;
+    uint16_t expr_value_14bit;
     uint16_t expr_ped_min; // Minimal value the expression pedal has reached
     uint16_t expr_ped_max; // maximum value the expression pedal has reached
+    ExprPedalFilter filter;
+    bool high_resolution = false;
 
-    uint16_t reading_tip_values[NUMBER_OF_UNIQUE_READINGS] = { 255 };
-    uint8_t read_index_tip;
     //uint16_t reading_ring_values[NUMBER_OF_STABLE_READINGS] = { 255 };
     uint8_t read_index_ring;
     uint32_t redetect_timer = 0;
@@ -101,7 +159,8 @@ SwitchExt::SwitchExt(uint8_t dpin_tip, uint8_t dpin_ring, uint8_t apin_tip, uint
   this->pull_up = pull_up;
   this->expr_ped_max = 0;
   this->expr_ped_min = 1023;
-  read_index_tip = 0;
+  expr_value = 0;
+  expr_value_14bit = 0;
   read_index_ring = 0;
   detectable = ((switch_type == DETECT) && (!pull_up));
   number_of_pauses_before_switch_type_change = 0;
@@ -154,7 +213,9 @@ bool SwitchExt::detect(bool first_time) {
         expr_ped_min = 1023;
         expr_ped_max = 0;
         expr_value = 127;
+        expr_value_14bit = EXPR_PEDAL_MAX_14BIT;
       }
+      filter.reset();
       // If an expression pedal is connected and there are no external pull up resistors, put power on the ring
       if (pull_up) {
         pinMode(dpin_ring, OUTPUT);
@@ -167,7 +228,8 @@ bool SwitchExt::detect(bool first_time) {
 
 bool SwitchExt::update() {
   if (millis() > updateTimer) {
-    updateTimer = millis() + DEFAULT_EXP_PEDAL_UPDATE_TIME; // Reset the timer
+    if (switch_type == EXPRESSION_PEDAL) updateTimer = millis() + EXPR_PEDAL_UPDATE_TIME; // Reset the timer
+    else updateTimer = millis() + DEFAULT_EXP_PEDAL_UPDATE_TIME;
 
     // Detect_type
     if (detectable) {
@@ -181,37 +243,48 @@ bool SwitchExt::update() {
 }
 
 bool SwitchExt::update_expr_pedal() {
-  uint16_t new_state = analogRead(apin_tip);
+  uint16_t new_sum = read_oversampled();
+  uint16_t new_state = new_sum / EXPR_OVERSAMPLING; // Calibration values are 10 bit
   //DEBUGMSG("Analog pin " + String(apin_tip) + ": " + String(new_state));
+#ifdef DEBUG_EXPR_TRACE
+  Serial.println(String(micros()) + "," + String(new_sum));
+#endif
 
   if (auto_calibrate) {
     if (new_state < expr_ped_min) expr_ped_min = new_state;
     if (new_state > expr_ped_max) expr_ped_max = new_state;
   }
-  else {
-    if (new_state < expr_ped_min) new_state = expr_ped_min;
-    if (new_state > expr_ped_max) new_state = expr_ped_max;
-  }
+  if (expr_ped_max - expr_ped_min < EXPR_MIN_CALIBRATION_RANGE) return false; // exit if we have not calibrated yet...
 
-  uint16_t new_value = map(new_state, expr_ped_min, expr_ped_max, 0, 137); // Map to 137 instead of 127, so we have five on either side, so we always reach min and max value.
-  if ((expr_ped_max - expr_ped_min < 137)) return false; // exit if we have not calibrated yet...
-  if (check_unique_tip_value(new_value) == false) return false; // exit if this is not a unique value
-  if (new_value > 132) new_value = 132;
-  if (new_value < 5) new_value = 5;
-  expr_value = new_value - 5; // Set the expression value variable
+  int32_t new_value = map(new_sum, expr_ped_min * EXPR_OVERSAMPLING, expr_ped_max * EXPR_OVERSAMPLING, -EXPR_DEAD_ZONE, EXPR_PEDAL_MAX_14BIT + EXPR_DEAD_ZONE);
+  new_value = constrain(new_value, 0, EXPR_PEDAL_MAX_14BIT);
+  new_value = filter.update(new_value, micros()) + 0.5;
+  if (check_new_value(new_value) == false) return false; // exit if the value has not changed enough
   State = 1; // we will also return state as one, to simulate pressing a button
   return true;
 }
 
-bool SwitchExt::check_unique_tip_value(uint16_t new_value) {
+uint16_t SwitchExt::read_oversampled() {
+  uint16_t sum = 0;
+  for (uint8_t i = 0; i < EXPR_OVERSAMPLING; i++) sum += analogRead(apin_tip);
+  return sum;
+}
 
-  for (uint8_t i = 0; i < NUMBER_OF_UNIQUE_READINGS; i++) { // Check if the new-value is in the reading array
-    if (reading_tip_values[i] == new_value) return false;
+bool SwitchExt::check_new_value(uint16_t new_value_14bit) {
+  if (high_resolution) {
+    if (abs(new_value_14bit - expr_value_14bit) < EXPR_HIGH_RES_HYSTERESIS) return false;
   }
-
-  reading_tip_values[read_index_tip] = new_value; // Add new unique value to reading array
-  read_index_tip++;
-  if (read_index_tip >= NUMBER_OF_UNIQUE_READINGS) read_index_tip = 0;
+  else { // Only change when we are clearly outside the current step
+    int32_t step_min = (expr_value << 7) - EXPR_HYSTERESIS;
+    int32_t step_max = (expr_value << 7) + 127 + EXPR_HYSTERESIS;
+    if ((new_value_14bit >= step_min) && (new_value_14bit <= step_max)) return false;
+  }
+  // Make sure we always reach min and max value
+  if (new_value_14bit < EXPR_HYSTERESIS) new_value_14bit = 0;
+  if (new_value_14bit > EXPR_PEDAL_MAX_14BIT - EXPR_HYSTERESIS) new_value_14bit = EXPR_PEDAL_MAX_14BIT;
+  if (new_value_14bit == expr_value_14bit) return false;
+  expr_value_14bit = new_value_14bit;
+  expr_value = new_value_14bit >> 7;
   return true;
 }
 
@@ -236,6 +309,15 @@ uint8_t SwitchExt::pedal_value() {
   }
 }
 
+uint16_t SwitchExt::pedal_value_14bit() {
+  if (switch_type == EXPRESSION_PEDAL) return expr_value_14bit;
+  return pedal_value() << 7;
+}
+
+void SwitchExt::set_high_resolution(bool state) {
+  high_resolution = state;
+}
+
 bool SwitchExt::update_switches() {
   if (millis() > bounceDelay + debounceTime) {
     // Read new state
@@ -19,41 +19,54 @@
 
 // Needs a global variable for interrupt routine
 uint8_t SwitchPadStatusColumnChanged = 0;
+uint32_t SwitchPadInterruptTime = 0; // Time of the first column interrupt since the last scan. Used as the time of the switch event.
+
+inline void SwitchPadStoreInterruptTime() {
+  if (SwitchPadStatusColumnChanged == 0) SwitchPadInterruptTime = micros();
+}
 
 // And it needs a global function for the interrupts
 void SwitchPadColumn1InterruptRoutine() {
+  SwitchPadStoreInterruptTime();
   SwitchPadStatusColumnChanged |= 1;
   //DEBUGMSG("Interrupt 1...");
 }
 
 void SwitchPadColumn2InterruptRoutine() {
+  SwitchPadStoreInterruptTime();
   SwitchPadStatusColumnChanged |= 2;
   //DEBUGMSG("Interrupt 2...");
 }
 
 void SwitchPadColumn3InterruptRoutine() {
+  SwitchPadStoreInterruptTime();
   SwitchPadStatusColumnChanged |= 4;
   //DEBUGMSG("Interrupt 3...");
 }
 
 void SwitchPadColumn4InterruptRoutine() {
+  SwitchPadStoreInterruptTime();
   SwitchPadStatusColumnChanged |= 8;
   //DEBUGMSG("Interrupt 4...");
 }
 
 void SwitchPadColumn5InterruptRoutine() {
+  SwitchPadStoreInterruptTime();
   SwitchPadStatusColumnChanged |= 16;
 }
 
 void SwitchPadColumn6InterruptRoutine() {
+  SwitchPadStoreInterruptTime();
   SwitchPadStatusColumnChanged |= 32;
 }
 
 void SwitchPadColumn7InterruptRoutine() {
+  SwitchPadStoreInterruptTime();
   SwitchPadStatusColumnChanged |= 64;
 }
 
 void SwitchPadColumn8InterruptRoutine() {
+  SwitchPadStoreInterruptTime();
   SwitchPadStatusColumnChanged |= 128;
 }
 
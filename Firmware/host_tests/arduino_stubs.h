@@ -0,0 +1,73 @@
+// Please read VController_v3.ino for information about the license and authors
+
+#ifndef ARDUINO_STUBS_H
+#define ARDUINO_STUBS_H
+
+// Minimal replacements for the Arduino and Teensy functions the firmware code under test uses.
+// The clock is simulated: tests set host_time_us and the firmware reads it through micros() and millis().
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+#include <string>
+
+#define PI 3.1415926535897932384626433832795
+#define INPUT 0
+#define INPUT_PULLUP 1
+#define OUTPUT 2
+#define HIGH 1
+#define LOW 0
+#define FLASHMEM
+#define PROGMEM
+
+uint32_t host_time_us = 0;
+
+inline uint32_t micros() { return host_time_us; }
+inline uint32_t millis() { return host_time_us / 1000; }
+inline void delay(uint32_t) {}
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int digitalRead(uint8_t) { return HIGH; }
+int analogRead(uint8_t pin); // Defined by the test that uses it
+inline void __disable_irq() {}
+inline void __enable_irq() {}
+
+inline long map(long x, long in_min, long in_max, long out_min, long out_max) {
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+template<class T> T constrain(T x, T low, T high) { return (x < low) ? low : ((x > high) ? high : x); }
+
+// String is used in debug messages and for the names of patches
+class String : public std::string {
+  public:
+    String(const char *s = "") : std::string(s) {}
+    String(const std::string &s) : std::string(s) {}
+    String(int value) : std::string(std::to_string(value)) {}
+    String(unsigned int value) : std::string(std::to_string(value)) {}
+    String(long value) : std::string(std::to_string(value)) {}
+    String(unsigned long value) : std::string(std::to_string(value)) {}
+    String &trim() { // Like the Teensy String, trim() changes the string itself
+      erase(find_last_not_of(' ') + 1);
+      erase(0, find_first_not_of(' '));
+      return *this;
+    }
+};
+inline String operator+(const String &a, const String &b) { return String(static_cast<const std::string &>(a) + static_cast<const std::string &>(b)); }
+inline String operator+(const String &a, const char *b) { return String(static_cast<const std::string &>(a) + b); }
+inline String operator+(const char *a, const String &b) { return String(a + static_cast<const std::string &>(b)); }
+
+// Test helpers
+int host_test_failures = 0;
+
+#define CHECK(condition, message) \
+  do { \
+    if (!(condition)) { \
+      printf("FAIL: %s (%s:%d)\n", message, __FILE__, __LINE__); \
+      host_test_failures++; \
+    } \
+  } while (0)
+
+#endif
@@ -0,0 +1,177 @@
+// Please read VController_v3.ino for information about the license and authors
+
+// Host test of the expression pedal pipeline in switchext_lib.h.
+// Every trace in traces/ is played back through SwitchExt in 7 bit and in high resolution mode.
+// For each run the number of output messages, the messages while the pedal is at rest and the lag while the pedal moves are reported.
+// The lag is measured against a reference: the calibrated readings smoothed with a centered moving average, which has no delay.
+// An output value has lag L when the reference had that value L ms earlier.
+
+#include "arduino_stubs.h"
+#include "../VController_v3/switchext_lib.h"
+
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+
+#define TIP_PIN 0
+#define RING_PIN 1
+#define REFERENCE_HALF_WINDOW 4 // Samples on either side for the reference value
+#define REST_HALF_WINDOW 30 // Samples on either side that may not move more than REST_MAX_MOVE for the pedal to be at rest
+#define REST_MAX_MOVE 128 // In 14 bit units - one 7 bit step
+#define MAX_LAG_SEARCH_US 500000
+#define CALIBRATED_RANGE 0.95 // The test starts when the pedal has covered this part of the range of the trace
+
+struct Sample_struct {
+  uint32_t time_us;
+  uint16_t sum;
+};
+
+std::vector<Sample_struct> trace;
+size_t trace_index = 0;
+uint8_t tip_read_count = 0;
+
+int analogRead(uint8_t pin) { // Returns the recorded sum spread over EXPR_OVERSAMPLING readings
+  if (pin == RING_PIN) return 500; // Resistance of the pot on the ring: expression pedal
+  uint16_t sum = trace[trace_index].sum;
+  uint16_t value = sum / EXPR_OVERSAMPLING;
+  if (tip_read_count < (sum % EXPR_OVERSAMPLING)) value++;
+  tip_read_count = (tip_read_count + 1) % EXPR_OVERSAMPLING;
+  return value;
+}
+
+bool read_trace(const char *file_name) {
+  std::ifstream file(file_name);
+  if (!file) return false;
+  trace.clear();
+  std::string line;
+  while (std::getline(file, line)) {
+    if ((line.empty()) || (line[0] == '#')) continue;
+    Sample_struct sample;
+    if (sscanf(line.c_str(), "%u,%hu", &sample.time_us, &sample.sum) == 2) trace.push_back(sample);
+  }
+  return trace.size() > 2 * REST_HALF_WINDOW;
+}
+
+struct Result_struct {
+  int messages;
+  int rest_messages;
+  double mean_lag_ms;
+  double p95_lag_ms;
+  uint16_t min_value;
+  uint16_t max_value;
+};
+
+Result_struct run_trace(bool high_resolution, const std::vector<int32_t> &reference, const std::vector<bool> &at_rest, size_t start) {
+  Result_struct result = { 0, 0, 0, 0, 0xFFFF, 0 };
+  std::vector<double> lags;
+  host_time_us = 0;
+  trace_index = 0;
+  tip_read_count = 0;
+  SwitchExt pedal(TIP_PIN, RING_PIN, TIP_PIN, RING_PIN, 900, 50, DETECT, true); // With pull up the type is only detected at init()
+  pedal.init();
+  pedal.set_high_resolution(high_resolution);
+
+  uint32_t end_time = trace.back().time_us;
+  for (host_time_us = 0; host_time_us <= end_time; host_time_us += 1000) {
+    while ((trace_index + 1 < trace.size()) && (trace[trace_index + 1].time_us <= host_time_us)) trace_index++;
+    if (!pedal.update()) continue;
+    if (trace_index < start) continue;
+
+    uint16_t value = high_resolution ? pedal.pedal_value_14bit() : pedal.pedal_value();
+    result.messages++;
+    if (value < result.min_value) result.min_value = value;
+    if (value > result.max_value) result.max_value = value;
+    if (at_rest[trace_index]) {
+      result.rest_messages++;
+      continue;
+    }
+
+    // Find the last time the reference crossed the output value
+    int32_t value_14bit = pedal.pedal_value_14bit();
+    for (size_t i = trace_index; (i > start) && (host_time_us - trace[i].time_us < MAX_LAG_SEARCH_US); i--) {
+      if ((reference[i] - value_14bit) * (reference[i - 1] - value_14bit) <= 0) {
+        lags.push_back((host_time_us - trace[i].time_us) / 1000.0);
+        break;
+      }
+    }
+  }
+  if (!lags.empty()) {
+    std::sort(lags.begin(), lags.end());
+    double total = 0;
+    for (double lag : lags) total += lag;
+    result.mean_lag_ms = total / lags.size();
+    result.p95_lag_ms = lags[(lags.size() * 95) / 100];
+  }
+  return result;
+}
+
+void test_trace(const char *file_name) {
+  if (!read_trace(file_name)) {
+    printf("FAIL: could not read %s\n", file_name);
+    host_test_failures++;
+    return;
+  }
+
+  // Calibrated reference, the same mapping as SwitchExt::update_expr_pedal() with the full range of the trace
+  uint16_t trace_min = 1023, trace_max = 0;
+  for (const Sample_struct &s : trace) {
+    trace_min = std::min<uint16_t>(trace_min, s.sum / EXPR_OVERSAMPLING);
+    trace_max = std::max<uint16_t>(trace_max, s.sum / EXPR_OVERSAMPLING);
+  }
+  std::vector<int32_t> mapped(trace.size()), reference(trace.size());
+  for (size_t i = 0; i < trace.size(); i++) {
+    int32_t value = map(trace[i].sum, trace_min * EXPR_OVERSAMPLING, trace_max * EXPR_OVERSAMPLING, -EXPR_DEAD_ZONE, EXPR_PEDAL_MAX_14BIT + EXPR_DEAD_ZONE);
+    mapped[i] = constrain(value, (int32_t)0, (int32_t)EXPR_PEDAL_MAX_14BIT);
+  }
+  for (size_t i = 0; i < trace.size(); i++) {
+    size_t first = (i > REFERENCE_HALF_WINDOW) ? i - REFERENCE_HALF_WINDOW : 0;
+    size_t last = std::min(trace.size() - 1, i + REFERENCE_HALF_WINDOW);
+    int32_t total = 0;
+    for (size_t j = first; j <= last; j++) total += mapped[j];
+    reference[i] = total / (int32_t)(last - first + 1);
+  }
+
+  // The pedal is at rest when the reference does not move more than one 7 bit step around the sample
+  std::vector<bool> at_rest(trace.size());
+  for (size_t i = 0; i < trace.size(); i++) {
+    size_t first = (i > REST_HALF_WINDOW) ? i - REST_HALF_WINDOW : 0;
+    size_t last = std::min(trace.size() - 1, i + REST_HALF_WINDOW);
+    auto range = std::minmax_element(reference.begin() + first, reference.begin() + last + 1);
+    at_rest[i] = (*range.second - *range.first) < REST_MAX_MOVE;
+  }
+
+  // Start when the pedal has been calibrated
+  size_t start = 0;
+  uint16_t seen_min = 1023, seen_max = 0;
+  for (; start < trace.size(); start++) {
+    seen_min = std::min<uint16_t>(seen_min, trace[start].sum / EXPR_OVERSAMPLING);
+    seen_max = std::max<uint16_t>(seen_max, trace[start].sum / EXPR_OVERSAMPLING);
+    if (seen_max - seen_min >= CALIBRATED_RANGE * (trace_max - trace_min)) break;
+  }
+  int32_t ref_min = *std::min_element(reference.begin() + start, reference.end());
+  int32_t ref_max = *std::max_element(reference.begin() + start, reference.end());
+
+  for (int high_resolution = 0; high_resolution <= 1; high_resolution++) {
+    Result_struct r = run_trace(high_resolution, reference, at_rest, start);
+    printf("%-22s %-9s %5d messages, %3d at rest, lag mean %5.1f ms p95 %5.1f ms, range %d - %d\n",
+           file_name, high_resolution ? "high res" : "7 bit", r.messages, r.rest_messages, r.mean_lag_ms, r.p95_lag_ms, r.min_value, r.max_value);
+
+    uint16_t full_scale = high_resolution ? EXPR_PEDAL_MAX_14BIT : 127;
+    if (!high_resolution) CHECK(r.rest_messages == 0, "7 bit output changes while the pedal is at rest");
+    else CHECK(r.rest_messages * 20 <= r.messages, "more than 5% of the high resolution messages are sent while the pedal is at rest");
+    CHECK(r.mean_lag_ms < 40, "mean lag is 40 ms or more");
+    if (ref_max == EXPR_PEDAL_MAX_14BIT) CHECK(r.max_value == full_scale, "full toe position does not give the maximum value");
+    if (ref_min == 0) CHECK(r.min_value == 0, "full heel position does not give the minimum value");
+  }
+}
+
+int main(int argc, char **argv) {
+  for (int i = 1; i < argc; i++) test_trace(argv[i]);
+  if (host_test_failures > 0) {
+    printf("expr_pedal_test: %d failure(s)\n", host_test_failures);
+    return 1;
+  }
+  printf("expr_pedal_test: passed\n");
+  return 0;
+}
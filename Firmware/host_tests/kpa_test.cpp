@@ -0,0 +1,414 @@
+// Please read VController_v3.ino for information about the license and authors
+
+// Host test of the bidirectional mode of the Kemper Profiler in MD_KPA.ino.
+// The Makefile copies the functions that handle the beacon, the mirror and the requests to kpa.inc.
+// A stand-in Kemper answers the requests of the VController. When the beacon is set, it sends its state, every change and its active sensing signal by itself.
+// The test counts the requests the VController sends and checks that the page and the patch name show the state of the Kemper.
+
+#include "arduino_stubs.h"
+#include "../VController_v3/debug.h"
+
+#include <vector>
+
+// Stand-ins for the firmware MD_KPA.ino uses
+#define REQUEST_PATCH_NAME 1
+#define REQUEST_PARAMETER_TYPE 2
+#define REFRESH_PAGE 1
+#define REFRESH_FX_ONLY 3
+#define REFRESH_PATCH_BANK_ONLY 4
+#define TOGGLE 1
+#define MOMENTARY 2
+#define UPDOWN 3
+#define ONE_SHOT 4
+#define FX_TYPE_OFF 0
+#define PAR_BANK 5
+#define MAIN_LCD_DISPLAY_SIZE 16
+#define ACTION_TIMER_LENGTH 1
+#define VC_NAME "VController"
+#define KPA_NUMBER_OF_FX_SLOTS 8
+#define KPA_RIG_BASE_NUMBER 200
+#define KPA_NAME_MIRROR_PERFORMANCE 0
+#define KPA_NAME_MIRROR_RIG 6
+#define KPA_NUMBER_OF_NAME_MIRRORS 7
+#define KPA_PORT MIDI1_PORT
+#define KPA_CHANNEL 1
+
+struct SP_struct {
+  uint8_t Type;
+  uint8_t State;
+  uint8_t Colour;
+  uint8_t Latch;
+  uint8_t Target_byte1;
+  String Label;
+};
+
+SP_struct SP[8];
+uint8_t update_page = 0;
+bool update_main_lcd = false;
+bool popup_patch_name = false;
+String current_patch_name;
+int next_switch_calls = 0;
+
+void PAGE_request_next_switch() { next_switch_calls++; }
+void LCD_set_SP_label(uint8_t sw, String msg) { SP[sw].Label = msg; }
+void LCD_clear_SP_label(uint8_t sw) { SP[sw].Label = ""; }
+bool LCD_check_popup_allowed(uint8_t) { return false; }
+void LCD_show_popup_label(String, uint16_t) {}
+
+std::vector<std::vector<uint8_t> > to_kemper; // The sysex messages the VController sends
+
+void MIDI_send_sysex(const unsigned char *sxdata, short unsigned int sxlength, uint8_t) { to_kemper.push_back(std::vector<uint8_t>(sxdata, sxdata + sxlength)); }
+
+class MD_KPA_class {
+  public:
+    bool connected = true;
+    uint8_t MIDI_in_port = KPA_PORT;
+    uint8_t MIDI_out_port = KPA_PORT;
+    uint8_t Current_MIDI_out_port = KPA_PORT;
+    uint8_t MIDI_channel = KPA_CHANNEL;
+    uint8_t my_LED_colour = 1;
+    uint8_t current_mode = 0;
+    uint16_t patch_number = 0;
+    uint8_t current_snapscene = 1;
+    uint8_t performance_on_kpa = 0;
+    uint16_t last_requested_sysex_address = 0;
+    uint8_t last_requested_sysex_type = 0;
+    uint8_t last_requested_sysex_switch = 0;
+    bool start_KPA_detection = true;
+    uint32_t pc_change_timeout = 0;
+    bool ready_to_read_rig_name = false;
+    String last_read_rig_name = "";
+    uint8_t last_checked_rig_number = 255;
+    bool patch_name_received = false;
+    String current_snapscene_label;
+    uint8_t effect_state[20];
+    uint8_t fx_type_mirror[KPA_NUMBER_OF_FX_SLOTS];
+    uint8_t fx_state_mirror[KPA_NUMBER_OF_FX_SLOTS];
+    uint16_t fx_mirror_valid = 0;
+    String name_mirror[KPA_NUMBER_OF_NAME_MIRRORS];
+    uint8_t name_mirror_valid = 0;
+    bool beacon_active = false;
+    uint32_t beacon_timer = 0;
+    uint32_t beacon_data_timer = 0;
+    bool request_pending = false;
+
+    // From MD_KPA.ino
+    void check_SYSEX_in(const unsigned char* sxdata, short unsigned int sxlength, uint8_t port);
+    void check_CC_in(uint8_t control, uint8_t value, uint8_t channel, uint8_t port);
+    void send_alternative_identity_request(uint8_t check_device_no);
+    void send_beacon(uint8_t setNum, uint8_t flags, uint8_t timeLease);
+    void beacon_timer_check();
+    void request_single_parameter(uint16_t address);
+    void request_current_rig_name();
+    void request_performance_name(uint8_t number);
+    void request_current_patch_name();
+    void show_rig_name(String rname, bool complete);
+    void show_performance_name(String pname);
+    void show_slot_name(uint8_t sw, uint8_t slot, String pname);
+    void update_fx_mirror(uint16_t address, uint16_t value, bool requested);
+    bool request_parameter(uint8_t sw, uint16_t number);
+
+    // Stand-ins
+    bool can_request_sysex_data() { return connected; }
+    void connect(uint8_t, uint8_t, uint8_t) { connected = true; }
+    void switch_mode(uint8_t mode) { current_mode = mode; }
+    void check_update_label(uint8_t, uint8_t) {}
+    void check_write_performance_name(uint16_t, String) {}
+    void clear_performance_name(uint16_t) {}
+    void check_sysex_delay() {}
+    void read_FX_type(uint8_t sw, uint8_t type) { SP[sw].Label = String(type); }
+    void set_FX_state(uint8_t index, bool state) { effect_state[index] = state ? 1 : 2; }
+};
+
+#include "kpa.inc"
+
+// The stand-in Kemper
+#define KEMPER_NAME_SIZE 24
+
+class Kemper_class {
+  public:
+    uint16_t type[KPA_NUMBER_OF_FX_SLOTS] = { 1, 32, 0, 65, 0, 0, 146, 193 };
+    uint8_t state[KPA_NUMBER_OF_FX_SLOTS] = { 1, 0, 0, 1, 0, 0, 1, 1 };
+    String rig_name = "Plexi Crunch";
+    String slot_name[6] = { "Live set", "Clean", "Crunch", "Slot", "Lead", "Ambient" }; // Slot 0 is the performance name
+    bool bidirectional = false;
+    int requests = 0;
+
+    Kemper_class(MD_KPA_class &vc) : vc(vc) {}
+
+    void process() { // Handle the messages from the VController
+      std::vector<std::vector<uint8_t> > messages;
+      messages.swap(to_kemper);
+      for (const std::vector<uint8_t> &m : messages) {
+        if (m[6] == KPA_FUNCTION_SYS_COMMUNICATION) {
+          bidirectional = (m[9] != 0);
+          if (m[10] & KPA_BEACON_FLAG_INIT) send_all();
+          if (bidirectional) send_active_sensing();
+        }
+        if (m[6] == KPA_FUNCTION_REQUEST_SINGLE_PARAMETER_VALUE) {
+          requests++;
+          uint16_t address = (m[8] << 8) | m[9];
+          for (uint8_t slot = 0; slot < KPA_NUMBER_OF_FX_SLOTS; slot++) {
+            if (address == (KPA_CC_types[slot].Address & 0xFF00)) send_parameter(address, type[slot]);
+            if (address == KPA_CC_types[slot].Address) send_parameter(address, state[slot]);
+          }
+        }
+        if (m[6] == KPA_FUNCTION_REQUEST_STRING_PARAMETER) {
+          requests++;
+          send_rig_name();
+        }
+        if (m[6] == KPA_FUNCTION_REQUEST_EXTENDED_STRING_PARAMETER) {
+          requests++;
+          send_slot_name(m[12]);
+        }
+      }
+    }
+
+    void send_all() { // The initial state after the beacon with KPA_BEACON_FLAG_INIT
+      for (uint8_t slot = 0; slot < KPA_NUMBER_OF_FX_SLOTS; slot++) send_stomp(slot);
+      send_rig_name();
+      for (uint8_t slot = 0; slot < 6; slot++) send_slot_name(slot);
+    }
+
+    void send_active_sensing() {
+      uint8_t m[] = { 0xF0, 0x00, 0x20, 0x33, 0x00, 0x00, KPA_FUNCTION_SYS_COMMUNICATION, 0x00, 0x7F, 0x7F, 0xF7 };
+      vc.check_SYSEX_in(m, sizeof(m), KPA_PORT);
+    }
+
+    void send_parameter(uint16_t address, uint16_t value) {
+      uint8_t m[] = { 0xF0, 0x00, 0x20, 0x33, 0x00, 0x00, KPA_FUNCTION_SINGLE_PARAMETER_CHANGE, 0x00, (uint8_t)(address >> 8), (uint8_t)(address & 0x7F),
+                      (uint8_t)(value >> 7), (uint8_t)(value & 0x7F), 0xF7
+                    };
+      vc.check_SYSEX_in(m, sizeof(m), KPA_PORT);
+    }
+
+    void send_stomp(uint8_t slot) {
+      send_parameter(KPA_CC_types[slot].Address & 0xFF00, type[slot]);
+      send_parameter(KPA_CC_types[slot].Address, state[slot]);
+    }
+
+    void send_rig_name() {
+      std::vector<uint8_t> m = { 0xF0, 0x00, 0x20, 0x33, 0x00, 0x00, KPA_FUNCTION_STRING_PARAMETER_CHANGE, 0x00, 0x00, 0x01 };
+      add_name(m, rig_name);
+      vc.check_SYSEX_in(m.data(), m.size(), KPA_PORT);
+    }
+
+    void send_slot_name(uint8_t slot) {
+      std::vector<uint8_t> m = { 0xF0, 0x00, 0x20, 0x33, 0x00, 0x00, KPA_FUNCTION_EXTENDED_STRING_PARAMETER_CHANGE, 0x00, 0x00, 0x00, 0x01, 0x00, slot };
+      add_name(m, slot_name[slot]);
+      vc.check_SYSEX_in(m.data(), m.size(), KPA_PORT);
+    }
+
+    // Changes made on the Kemper itself
+    void set_stomp(uint8_t slot, uint8_t new_state) {
+      state[slot] = new_state;
+      if (bidirectional) send_parameter(KPA_CC_types[slot].Address, new_state);
+    }
+
+    void set_rig_name(const char *name) {
+      rig_name = name;
+      if (bidirectional) send_rig_name();
+    }
+
+    void select_slot(uint8_t slot) { // Sends the CC and the new rig
+      vc.check_CC_in(49 + slot, 1, KPA_CHANNEL, KPA_PORT);
+      rig_name = slot_name[slot];
+      type[0]++;
+      if (bidirectional) {
+        for (uint8_t i = 0; i < KPA_NUMBER_OF_FX_SLOTS; i++) send_stomp(i);
+        send_rig_name();
+      }
+    }
+
+    void select_performance(uint8_t number, const char *name) { // Sends the CC and the names of the new performance
+      vc.check_CC_in(47, number, KPA_CHANNEL, KPA_PORT);
+      slot_name[0] = name;
+      if (bidirectional) {
+        for (uint8_t slot = 0; slot < 6; slot++) send_slot_name(slot);
+      }
+    }
+
+  private:
+    MD_KPA_class &vc;
+
+    void add_name(std::vector<uint8_t> &m, const String &name) {
+      for (uint8_t i = 0; i < KEMPER_NAME_SIZE; i++) m.push_back((i < name.size()) ? name[i] : 0x00);
+      m.push_back(0xF7);
+    }
+};
+
+int load_page(MD_KPA_class &vc, Kemper_class &kemper) { // Loads eight stomp switches like PAGE_request_next_switch() does and returns the number of requests
+  int requests = kemper.requests;
+  for (uint8_t sw = 0; sw < 8; sw++) {
+    if (!vc.request_parameter(sw, sw)) kemper.process();
+  }
+  return kemper.requests - requests;
+}
+
+bool page_shows_kemper(const Kemper_class &kemper) {
+  for (uint8_t slot = 0; slot < KPA_NUMBER_OF_FX_SLOTS; slot++) {
+    if (SP[slot].Label != String(kemper.type[slot])) return false;
+    if (SP[slot].State != ((kemper.state[slot] == 1) ? 1 : 2)) return false;
+  }
+  return true;
+}
+
+void start_bidirectional_mode(MD_KPA_class &vc, Kemper_class &kemper) { // As do_after_connect() does
+  vc.send_beacon(KPA_BEACON_SET, beaconFlags | KPA_BEACON_FLAG_INIT, KPA_BEACON_TIME_LEASE);
+  vc.beacon_timer = millis() + KPA_BEACON_RENEW_TIME;
+  kemper.process();
+}
+
+void test_polling() { // Without the bidirectional mode every stomp and name is requested
+  MD_KPA_class vc;
+  Kemper_class kemper(vc);
+  next_switch_calls = 0;
+  int requests = load_page(vc, kemper);
+  printf("polling: %d requests for 8 stomps\n", requests);
+  CHECK(requests == 16, "stomps are not requested without the bidirectional mode");
+  CHECK(next_switch_calls == 8, "page does not continue after the replies");
+  CHECK(page_shows_kemper(kemper), "page does not show the stomps of the Kemper");
+
+  requests = kemper.requests;
+  vc.request_current_patch_name();
+  kemper.process();
+  CHECK(kemper.requests - requests == 1, "rig name is not requested without the bidirectional mode");
+  CHECK(current_patch_name.trim() == "Plexi Crunch", "requested rig name not shown");
+}
+
+void test_bidirectional() {
+  MD_KPA_class vc;
+  Kemper_class kemper(vc);
+  start_bidirectional_mode(vc, kemper);
+  CHECK(vc.beacon_active, "active sensing signal not detected");
+  CHECK(vc.fx_mirror_valid == 0xFFFF, "initial stomps not mirrored");
+  CHECK(vc.name_mirror_valid == 0x7F, "initial names not mirrored");
+
+  // Page and names are read from the mirror
+  int requests = load_page(vc, kemper);
+  printf("bidirectional: %d requests for 8 stomps\n", requests);
+  CHECK(requests == 0, "stomps are requested in bidirectional mode");
+  CHECK(page_shows_kemper(kemper), "page does not show the mirrored stomps");
+
+  requests = kemper.requests;
+  current_patch_name = "";
+  vc.request_current_patch_name();
+  kemper.process();
+  CHECK(current_patch_name.trim() == "Plexi Crunch", "mirrored rig name not shown");
+
+  vc.current_mode = KPA_PERFORMANCE_MODE;
+  vc.request_current_patch_name();
+  kemper.process();
+  CHECK(current_patch_name.trim() == "Live set", "mirrored performance name not shown");
+
+  vc.current_snapscene = 2;
+  CHECK(vc.request_parameter(0, KPA_RIG_DOWN), "slot name is requested in bidirectional mode");
+  CHECK(vc.request_parameter(1, KPA_RIG_UP), "slot name is requested in bidirectional mode");
+  kemper.process();
+  CHECK(SP[0].Label == "Clean", "mirrored name of the previous slot not shown");
+  CHECK(SP[1].Label == "--", "empty slot not shown as empty");
+  printf("bidirectional: %d requests for the names\n", kemper.requests - requests);
+  CHECK(kemper.requests == requests, "names are requested in bidirectional mode");
+
+  // Changes on the Kemper appear without requests
+  update_page = 0;
+  next_switch_calls = 0;
+  kemper.set_stomp(2, 1);
+  CHECK(update_page == REFRESH_FX_ONLY, "stomp change on the Kemper does not refresh the page");
+  CHECK(next_switch_calls == 0, "stomp change on the Kemper is taken for a reply");
+  CHECK(load_page(vc, kemper) == 0, "stomps are requested after a change on the Kemper");
+  CHECK(page_shows_kemper(kemper), "stomp change on the Kemper not shown");
+
+  vc.current_mode = KPA_BROWSE_MODE;
+  kemper.set_rig_name("Bassman");
+  CHECK(current_patch_name.trim() == "Bassman", "rig name change on the Kemper not shown");
+
+  // A new slot only changes the rig and its name, the performance names stay in the mirror
+  vc.current_mode = KPA_PERFORMANCE_MODE;
+  requests = kemper.requests;
+  kemper.select_slot(2);
+  CHECK(vc.name_mirror[KPA_NAME_MIRROR_RIG].trim() == "Crunch", "rig name of the new slot not mirrored");
+  CHECK(load_page(vc, kemper) == 0, "stomps are requested after a new slot");
+  CHECK(page_shows_kemper(kemper), "stomps of the new slot not shown");
+  vc.request_current_patch_name();
+  kemper.process();
+  CHECK(kemper.requests == requests, "performance name is requested after a new slot");
+}
+
+void test_arbitration() { // Pushed messages may not be taken for the reply a switch waits for
+  MD_KPA_class vc;
+  Kemper_class kemper(vc);
+  start_bidirectional_mode(vc, kemper);
+
+  // Stomp request while the Kemper sends a change of another stomp
+  vc.fx_mirror_valid = 0;
+  next_switch_calls = 0;
+  CHECK(!vc.request_parameter(0, 0), "stomp read from an empty mirror");
+  kemper.set_stomp(5, 1);
+  CHECK(next_switch_calls == 0, "pushed stomp taken for the reply");
+  kemper.process();
+  CHECK(next_switch_calls == 1, "reply not taken");
+  kemper.set_stomp(0, 0);
+  CHECK(next_switch_calls == 1, "pushed stomp after the reply advanced the page");
+  CHECK(vc.fx_state_mirror[0] == 2, "pushed stomp after the reply not mirrored");
+
+  // Slot name request while the Kemper sends the names of a new performance
+  vc.current_mode = KPA_PERFORMANCE_MODE;
+  vc.current_snapscene = 2;
+  vc.check_CC_in(47, 0, KPA_CHANNEL, KPA_PORT);
+  CHECK(vc.name_mirror_valid == 0, "names of the old performance still mirrored");
+  next_switch_calls = 0;
+  int requests = kemper.requests;
+  CHECK(!vc.request_parameter(3, KPA_RIG_UP), "slot name read from an empty mirror");
+  kemper.slot_name[3] = "Drive";
+  kemper.send_slot_name(0);
+  kemper.send_slot_name(2);
+  CHECK(next_switch_calls == 0, "pushed name taken for the reply");
+  CHECK(SP[3].Label != "Drive", "pushed name shown before the reply");
+  kemper.process();
+  CHECK(kemper.requests - requests == 1, "slot name not requested");
+  CHECK(next_switch_calls == 1, "slot name reply not taken");
+  CHECK(SP[3].Label.trim() == "Drive", "requested slot name not shown");
+  CHECK(vc.name_mirror[3].trim() == "Drive", "requested slot name not mirrored");
+}
+
+void test_beacon_lost() { // Without the active sensing signal the VController polls again
+  MD_KPA_class vc;
+  Kemper_class kemper(vc);
+  host_time_us = 0;
+  start_bidirectional_mode(vc, kemper);
+
+  to_kemper.clear();
+  vc.send_alternative_identity_request(0);
+  CHECK(to_kemper.empty(), "mode is polled in bidirectional mode");
+
+  host_time_us = (KPA_BEACON_TIMEOUT + 1) * 1000;
+  vc.beacon_timer_check();
+  CHECK(!vc.beacon_active, "bidirectional mode not stopped without active sensing signal");
+  CHECK(to_kemper.empty(), "beacon renewed too early");
+  int requests = kemper.requests;
+  CHECK(load_page(vc, kemper) == 16, "stomps are not requested after the bidirectional mode stopped");
+  vc.request_current_patch_name();
+  kemper.process();
+  CHECK(kemper.requests - requests == 17, "rig name is not requested after the bidirectional mode stopped");
+
+  host_time_us = (KPA_BEACON_RENEW_TIME + 1) * 1000;
+  vc.beacon_timer_check();
+  CHECK(to_kemper.size() == 1, "beacon not renewed");
+  kemper.process();
+  CHECK(vc.beacon_active, "bidirectional mode not active after renewing the beacon");
+  host_time_us = 0;
+}
+
+int main() {
+  test_polling();
+  test_bidirectional();
+  test_arbitration();
+  test_beacon_lost();
+  if (host_test_failures > 0) {
+    printf("kpa_test: %d failure(s)\n", host_test_failures);
+    return 1;
+  }
+  printf("kpa_test: passed\n");
+  return 0;
+}
@@ -0,0 +1,358 @@
+// Please read VController_v3.ino for information about the license and authors
+
+// Host test of the modulation engine in Devices.ino.
+// The Makefile copies the engine section of Devices.ino to modulation_engine.inc, which is compiled here with stand-ins for the rest of the firmware.
+// The clock is simulated in steps of 1 ms: every step the modulation timer interrupt runs, followed by MOD_update() from the main loop.
+// Every message the engine sends is recorded with its time, so the step timing, the values and the port budget can be checked.
+
+#include "arduino_stubs.h"
+#include "../VController_v3/debug.h"
+
+#include <vector>
+
+// Stand-ins for the firmware the modulation engine uses
+#define NUMBER_OF_DEVICES 2
+#define PARAMETER 101
+#define RANGE 5
+#define TIME_2000 255
+#define TIME_1000 254
+#define TIME_500 253
+#define TIME_300 252
+#define RPT_600 251
+
+class IntervalTimer {
+  public:
+    bool begin(void (*function)(), uint32_t) {
+      callback = function;
+      return true;
+    }
+    void (*callback)() = nullptr;
+};
+
+struct Cmd_struct {
+  uint8_t Page;
+  uint8_t Switch;
+  uint8_t Type;
+  uint8_t Device;
+  uint8_t Data1;
+  uint8_t Data2;
+  uint8_t Value1;
+  uint8_t Value2;
+  uint8_t Value3;
+  uint8_t Value4;
+};
+
+struct SP_struct {
+  uint8_t Type;
+  uint8_t Device;
+  uint8_t Latch;
+  uint16_t PP_number;
+  uint8_t Target_byte1;
+  uint8_t Target_byte2;
+  bool Has_custom_label;
+};
+
+SP_struct SP[1];
+uint8_t update_page = 0;
+
+#define MSG_CC 0
+#define MSG_NRPN 1
+#define MSG_PARAMETER 2
+
+struct Message_struct {
+  uint32_t time_us;
+  uint8_t type;
+  uint16_t number;
+  uint16_t value;
+  uint8_t channel;
+  uint8_t port;
+};
+
+std::vector<Message_struct> sent;
+
+uint16_t SCO_find_max_value(uint8_t Max) { // Same as in SW_functions.ino
+  if (Max < 128) return Max;
+  switch (Max + 1) {
+    case TIME_2000: return 2000;
+    case TIME_1000: return 1000;
+    case TIME_500: return 500;
+    case TIME_300: return 300;
+    case RPT_600: return 600;
+  }
+  return 0;
+}
+
+class Device_class {
+  public:
+    uint8_t number_of_values(uint16_t) { return values; }
+    void parameter_press(uint8_t Sw, Cmd_struct *cmd, uint16_t number) {
+      // Records the value the same way the devices read it from the switch: dual byte when the maximum is 128 or more
+      uint16_t value = SP[Sw].Target_byte1;
+      if (SCO_find_max_value(values - 1) >= 128) value = (SP[Sw].Target_byte1 * 128) + SP[Sw].Target_byte2;
+      sent.push_back({ host_time_us, MSG_PARAMETER, number, value, cmd->Device, MIDI_out_port });
+      update_page = 1; // The engine must restore update_page
+    }
+    bool connected = true;
+    uint8_t MIDI_out_port = MIDI1_PORT;
+    uint8_t values = 128;
+};
+
+Device_class test_device[NUMBER_OF_DEVICES];
+Device_class *Device[NUMBER_OF_DEVICES] = { &test_device[0], &test_device[1] };
+
+void MIDI_send_CC(uint8_t Controller, uint8_t Value, uint8_t Channel, uint8_t Port) {
+  sent.push_back({ host_time_us, MSG_CC, Controller, Value, Channel, Port });
+}
+
+void MIDI_send_NRPN(uint16_t Number, uint8_t Value, uint8_t Channel, uint8_t Port) {
+  sent.push_back({ host_time_us, MSG_NRPN, Number, Value, Channel, Port });
+}
+
+// Simulated MIDI clock: the tempo the VController shows and the time between the beats that are received can differ
+uint16_t clock_bpm_x10 = 1200;
+uint32_t clock_beat_time_us = 500000;
+uint32_t clock_start_us = 0;
+
+uint16_t SCO_get_bpm_x10() { return clock_bpm_x10; }
+uint32_t SCO_get_clock_beat_number() { return (host_time_us - clock_start_us) / clock_beat_time_us; }
+
+uint8_t random_value = 0;
+uint8_t generate_random_number() {
+  random_value = (random_value + 37) % 128;
+  return random_value;
+}
+
+// The Arduino IDE makes prototypes for the functions in the .ino files. These are the ones the engine calls before they are defined.
+void MOD_set_target(uint8_t lane, uint8_t type, uint8_t dev, uint16_t number, uint8_t channel, uint8_t port);
+void MOD_calculate_increment(uint8_t lane);
+void MOD_timer_expired();
+uint16_t MOD_calculate_position(uint8_t l);
+void MOD_add_event(uint8_t lane, uint16_t position, uint32_t time);
+void MOD_read_event(uint8_t l, uint16_t position);
+uint16_t MOD_scale_to_target(uint8_t l, uint8_t value);
+void MOD_send_pending_value(uint8_t l, uint32_t now);
+bool MOD_use_port_budget(uint8_t port, uint8_t number_of_bytes, uint32_t now);
+void MOD_send_parameter(uint8_t dev, uint16_t parameter, uint16_t value);
+
+#include "modulation_engine.inc"
+
+// Test helpers
+
+void reset_engine() {
+  for (uint8_t l = 0; l < MOD_NUMBER_OF_LANES; l++) {
+    MOD_stop(l);
+    MOD_set_target(l, MOD_TARGET_OFF, 0, 0, 0, 0);
+    MOD_set_range(l, 0, 127);
+    MOD_set_phase(l, 0);
+    MOD_set_smoothing(l, 0);
+  }
+  MOD_event_head = 0;
+  MOD_event_tail = 0;
+  MOD_events_lost = 0;
+  memset(MOD_port_budget_time, 0, sizeof(MOD_port_budget_time));
+  clock_bpm_x10 = 1200;
+  clock_beat_time_us = 500000;
+  clock_start_us = host_time_us;
+  MOD_update(); // Reads the tempo
+  sent.clear();
+}
+
+void run_ms(uint32_t ms) {
+  for (uint32_t i = 0; i < ms; i++) {
+    host_time_us += MOD_TIMER_INTERVAL;
+    Modulation_timer.callback();
+    MOD_update();
+  }
+}
+
+void set_ramp(uint8_t lane, uint8_t number_of_steps) { // Every step has a different value
+  uint8_t steps[MOD_MAX_NUMBER_OF_STEPS];
+  for (uint8_t s = 0; s < number_of_steps; s++) steps[s] = (s * 127) / (number_of_steps - 1);
+  MOD_set_pattern(lane, steps, number_of_steps);
+}
+
+uint8_t ramp_step(uint16_t value, uint8_t number_of_steps) { // Inverse of set_ramp()
+  for (uint8_t s = 0; s < number_of_steps; s++) if (((s * 127) / (number_of_steps - 1)) == value) return s;
+  return 0xFF;
+}
+
+// Tests
+
+void test_tempo_steps() {
+  // 120 bpm, one beat per cycle and 24 steps: 48 steps per second, one every 20.833 ms
+  reset_engine();
+  MOD_set_target_CC(0, 20, 1, USBMIDI_PORT);
+  set_ramp(0, 24);
+  MOD_set_rate(0, MOD_SYNC_TEMPO, 1);
+  MOD_start(0);
+  uint32_t start_us = host_time_us;
+  run_ms(2000);
+  CHECK(sent.size() == 96, "120 bpm with 24 steps per beat does not give 48 steps per second");
+  uint32_t max_error_us = 0;
+  for (size_t i = 0; i < sent.size(); i++) {
+    CHECK(sent[i].value == ((i % 24) * 127) / 23, "steps are not sent in order");
+    uint32_t expected_us = start_us + MOD_TIMER_INTERVAL + (i * 500000) / 24;
+    uint32_t error_us = (sent[i].time_us > expected_us) ? sent[i].time_us - expected_us : expected_us - sent[i].time_us;
+    if (error_us > max_error_us) max_error_us = error_us;
+  }
+  printf("tempo: %zu steps in 2 s at 120 bpm, max timing error %u us\n", sent.size(), max_error_us);
+  CHECK(max_error_us <= MOD_TIMER_INTERVAL, "a step is more than one timer interval late");
+
+  // The lane follows a change of tempo
+  clock_bpm_x10 = 600;
+  sent.clear();
+  run_ms(2000);
+  CHECK((sent.size() >= 47) && (sent.size() <= 49), "60 bpm with 24 steps per beat does not give 24 steps per second");
+}
+
+void test_phase() {
+  reset_engine();
+  MOD_set_target_CC(0, 20, 1, USBMIDI_PORT);
+  set_ramp(0, 24);
+  MOD_set_rate(0, MOD_SYNC_TEMPO, 1);
+  MOD_set_phase(0, 64); // Half a cycle
+  MOD_start(0);
+  run_ms(1);
+  CHECK((sent.size() == 1) && (ramp_step(sent[0].value, 24) == 12), "a lane with phase 64 does not start halfway the pattern");
+}
+
+void test_free_running() {
+  reset_engine();
+  MOD_set_target_CC(0, 20, 1, USBMIDI_PORT);
+  set_ramp(0, 10);
+  MOD_set_rate(0, MOD_SYNC_FREE, 1000); // 1 s per cycle
+  clock_bpm_x10 = 900; // Does not change a free running lane
+  MOD_start(0);
+  run_ms(3000);
+  CHECK(sent.size() == 30, "a free running lane of 1000 ms with 10 steps does not give 10 steps per second");
+}
+
+void test_beat_sync(uint32_t beat_time_us) {
+  // Rate 2: a cycle of 24 steps takes two beats. The received clock runs faster or slower than the tempo the lane uses.
+  reset_engine();
+  clock_beat_time_us = beat_time_us;
+  MOD_set_target_CC(0, 20, 1, USBMIDI_PORT);
+  set_ramp(0, 24);
+  MOD_set_rate(0, MOD_SYNC_BEAT, 2);
+  MOD_start(0);
+  run_ms(beat_time_us / 2000);
+  CHECK(sent.empty(), "a beat synced lane does not wait for the next beat");
+  run_ms((beat_time_us * 20) / 1000);
+
+  uint16_t steps_out_of_sync = 0;
+  uint16_t steps_skipped = 0;
+  uint16_t cycles = 0;
+  for (size_t i = 0; i < sent.size(); i++) {
+    const Message_struct &m = sent[i];
+    uint8_t step = ramp_step(m.value, 24);
+    if ((i > 0) && (step != (ramp_step(sent[i - 1].value, 24) + 1) % 24)) steps_skipped++;
+    if (step == 0) cycles++;
+    if ((step == 0) || (step == 12)) { // The steps that start a beat must be sent on the beat
+      uint32_t time_in_beat = (m.time_us - clock_start_us) % beat_time_us;
+      if (time_in_beat >= MOD_TIMER_INTERVAL) steps_out_of_sync++;
+    }
+  }
+  printf("beat sync: beat of %u ms, %zu steps, %u cycles\n", beat_time_us / 1000, sent.size(), cycles);
+  CHECK(steps_out_of_sync == 0, "a beat synced lane does not start the beat on the received clock");
+  CHECK(cycles == 10, "a beat synced lane does not do one cycle per two beats");
+  CHECK((sent.size() > 0) && (ramp_step(sent[0].value, 24) == 0), "a beat synced lane does not start at the first step");
+  CHECK(steps_skipped == 0, "a beat synced lane skips or repeats steps");
+}
+
+void test_smoothing() {
+  // Two steps with 50% smoothing: half of every step glides from the previous value in four substeps
+  reset_engine();
+  MOD_set_target_CC(0, 20, 1, USBMIDI_PORT);
+  uint8_t steps[2] = { 0, 127 };
+  MOD_set_pattern(0, steps, 2);
+  MOD_set_rate(0, MOD_SYNC_FREE, 160); // 10 ms per substep
+  MOD_set_smoothing(0, 50);
+  MOD_start(0);
+  run_ms(320);
+  const uint16_t expected[] = { 96, 64, 32, 0, 31, 63, 95, 127 };
+  CHECK(sent.size() == 16, "smoothing does not send the glide values once per substep");
+  for (size_t i = 0; i < sent.size(); i++) CHECK(sent[i].value == expected[i % 8], "wrong value while gliding");
+}
+
+void test_nrpn() {
+  reset_engine();
+  MOD_set_target_NRPN(1, (3 << 7) + 21, 5, MIDI2_PORT);
+  set_ramp(1, 4);
+  MOD_set_range(1, 20, 40);
+  MOD_set_rate(1, MOD_SYNC_FREE, 400);
+  MOD_start(1);
+  run_ms(400);
+  CHECK(sent.size() == 4, "an NRPN lane does not send every step");
+  const uint16_t expected[] = { 20, 26, 33, 40 };
+  for (size_t i = 0; i < sent.size(); i++) {
+    CHECK(sent[i].type == MSG_NRPN, "an NRPN lane does not send NRPN messages");
+    CHECK((sent[i].number == (3 << 7) + 21) && (sent[i].channel == 5) && (sent[i].port == MIDI2_PORT), "an NRPN lane sends to the wrong target");
+    CHECK(sent[i].value == expected[i], "an NRPN lane does not scale to its range");
+  }
+}
+
+void check_parameter(uint8_t number_of_values, const std::vector<uint16_t> &expected, const char *message) {
+  reset_engine();
+  test_device[1].values = number_of_values;
+  MOD_set_target_parameter(2, 1, 7);
+  uint8_t steps[4] = { 0, 64, 127, 64 };
+  MOD_set_pattern(2, steps, 4);
+  MOD_set_rate(2, MOD_SYNC_FREE, 400);
+  MOD_start(2);
+  SP[0].Type = 42;
+  run_ms(400);
+  bool match = (sent.size() == expected.size());
+  for (size_t i = 0; match && (i < sent.size()); i++) match = (sent[i].type == MSG_PARAMETER) && (sent[i].number == 7) && (sent[i].value == expected[i]);
+  CHECK(match, message);
+  CHECK((SP[0].Type == 42) && (update_page == 0), "setting a parameter changes the switch or the page");
+}
+
+void test_parameter() {
+  check_parameter(128, { 0, 64, 127, 64 }, "a parameter with 128 values does not get the step values");
+  check_parameter(3, { 0, 1, 2, 1 }, "a parameter with 3 values is not scaled to its number of values");
+  check_parameter(TIME_2000, { 0, 1007, 2000, 1007 }, "a TIME_2000 parameter is not scaled to 0 - 2000 ms");
+  check_parameter(RPT_600, { 40, 322, 600, 322 }, "an RPT_600 parameter is not scaled to 40 - 600 ms");
+  test_device[1].values = 128;
+}
+
+void test_port_budget() {
+  // Four lanes of 320 steps per second: 3840 bytes per second of CC messages
+  for (uint8_t port_number = 0; port_number < 2; port_number++) {
+    uint8_t port = (port_number == 0) ? MIDI1_PORT : USBMIDI_PORT;
+    reset_engine();
+    for (uint8_t l = 0; l < MOD_NUMBER_OF_LANES; l++) {
+      MOD_set_target_CC(l, 20 + l, 1, port);
+      set_ramp(l, 32);
+      MOD_set_rate(l, MOD_SYNC_FREE, 100);
+      MOD_start(l);
+    }
+    run_ms(1000);
+    uint32_t bytes = sent.size() * MOD_CC_MESSAGE_SIZE;
+    printf("port budget: %s port, %u bytes in 1 s, %u events lost\n", (port == MIDI1_PORT) ? "serial" : "USB", bytes, MOD_events_lost);
+    CHECK(MOD_events_lost == 0, "the event queue overflows");
+    if (port == MIDI1_PORT) {
+      CHECK(bytes <= 1000000 / MOD_SERIAL_US_PER_BYTE + (MOD_MAX_BURST_TIME / MOD_SERIAL_US_PER_BYTE) + MOD_CC_MESSAGE_SIZE, "modulation uses more than its budget of a serial port");
+      CHECK(bytes >= 900, "modulation does not use its budget of a serial port");
+    }
+    else CHECK(sent.size() >= 4 * 319, "modulation on a USB port drops steps");
+  }
+}
+
+int main() {
+  setup_modulation();
+  test_tempo_steps();
+  test_phase();
+  test_free_running();
+  test_beat_sync(490000);
+  test_beat_sync(510000);
+  test_smoothing();
+  test_nrpn();
+  test_parameter();
+  test_port_budget();
+  if (host_test_failures > 0) {
+    printf("modulation_test: %d failure(s)\n", host_test_failures);
+    return 1;
+  }
+  printf("modulation_test: passed\n");
+  return 0;
+}
@@ -0,0 +1,269 @@
+// Please read VController_v3.ino for information about the license and authors
+
+// Host test of the patch change echo learner in H_MIDI.ino and its storage in H_MEMORY.ino.
+// The Makefile copies both sections to pc_echo.inc, which is compiled here with a simulated external EEPROM and MIDI ports.
+// A simulated device needs LOAD_TIME ms to load a patch and then sends its messages. A forwarding rule sends everything from the
+// device port (MIDI1) to MIDI2, where a second device is connected. The gap is the time until the second device has its final state.
+
+#include "arduino_stubs.h"
+#include "../VController_v3/debug.h"
+
+#include <vector>
+
+// Stand-ins for the firmware the learner uses
+#define NUMBER_OF_DEVICES 3
+#define PATCH_INDEX_NOT_FOUND 0xFFFF
+#define EXT_EEP_PC_ECHO_BASE_ADDRESS 64000
+#define EXT_MAX_NUMBER_OF_PC_ECHO_RECORDS 80
+#define EXT_EEP_PC_ECHO_DATA_VERSION_ADDR 9
+#define CURRENT_EXT_EEPROM_PC_ECHO_DATA_VERSION 1
+
+uint8_t eeprom[65536];
+int eeprom_writes = 0;
+
+void EEP_read_ext_data(uint32_t address, uint8_t *data, uint16_t data_size) { memcpy(data, &eeprom[address], data_size); }
+void EEP_write_ext_data(uint32_t address, const uint8_t *data, uint16_t data_size) {
+  memcpy(&eeprom[address], data, data_size);
+  eeprom_writes++;
+}
+void write_ext_EEPROM(uint32_t address, uint8_t data) { eeprom[address] = data; }
+void LED_show_initializing_data() {}
+
+struct Message_struct {
+  uint32_t time_ms;
+  uint8_t port;
+  uint8_t status;
+  uint8_t data1;
+  uint8_t data2;
+};
+
+std::vector<Message_struct> sent;
+
+void MIDI_send_PC(uint8_t Program, uint8_t Channel, uint8_t Port) { sent.push_back({ millis(), Port, (uint8_t)(0xC0 | (Channel - 1)), Program, 0 }); }
+void MIDI_send_CC(uint8_t Controller, uint8_t Value, uint8_t Channel, uint8_t Port) { sent.push_back({ millis(), Port, (uint8_t)(0xB0 | (Channel - 1)), Controller, Value }); }
+
+const uint8_t test_port[3] = { MIDI1_PORT, MIDI2_PORT, MIDI3_PORT };
+
+void MIDI_forward_PC_to_all_ports_but_mine(uint8_t Program, uint8_t Channel, uint8_t exclude_port) {
+  for (uint8_t port : test_port) if (port != exclude_port) MIDI_send_PC(Program, Channel, port);
+}
+
+void MIDI_forward_CC_to_all_ports_but_mine(uint8_t Controller, uint8_t Value, uint8_t Channel, uint8_t exclude_port) {
+  for (uint8_t port : test_port) if (port != exclude_port) MIDI_send_CC(Controller, Value, Channel, port);
+}
+
+uint8_t MIDI_set_port_number_from_menu(uint8_t port) { return (port < 3) ? test_port[port] : ALL_MIDI_PORTS; }
+
+class MD_base_class {
+  public:
+    uint8_t MIDI_in_port = MIDI1_PORT;
+    uint8_t MIDI_out_port = MIDI1_PORT;
+    uint8_t MIDI_channel = 1;
+    uint8_t PC_echo_port = 0;
+};
+
+MD_base_class test_device[NUMBER_OF_DEVICES];
+MD_base_class *Device[NUMBER_OF_DEVICES] = { &test_device[0], &test_device[1], &test_device[2] };
+
+// The Arduino IDE makes prototypes for the functions in the .ino files. These are the ones that are called before they are defined.
+uint16_t EEPROM_find_PC_echo_record(uint8_t dev, uint16_t patch);
+uint8_t EEPROM_load_PC_echo(uint8_t dev, uint16_t patch, uint8_t *data);
+void EEPROM_store_PC_echo(uint8_t dev, uint16_t patch, const uint8_t *data, uint8_t length);
+uint8_t PC_echo_target_port(uint8_t dev);
+void PC_echo_send(uint8_t dev, const uint8_t *data, uint8_t length, uint8_t port);
+void PC_echo_check_message_in(uint8_t status, uint8_t data1, uint8_t data2, uint8_t port);
+uint8_t PC_echo_find_message(const uint8_t *data, uint8_t length, uint8_t status, uint8_t data1);
+
+#include "pc_echo.inc"
+
+// The simulated device
+
+#define LOAD_TIME 120 // Time the device needs to load a patch before it sends its messages (in ms)
+#define MESSAGE_INTERVAL 2 // Time between the messages of the device (in ms)
+#define RUN_TIME 300 // Time that is simulated after every patch change (in ms)
+
+struct Device_message_struct {
+  uint8_t status;
+  uint8_t data1;
+  uint8_t data2;
+};
+
+std::vector<Device_message_struct> patch_messages[4];
+
+void device_message_in(uint8_t status, uint8_t data1, uint8_t data2, bool learner) { // Like OnProgramChange() and OnControlChange() in H_MIDI.ino
+  if (learner) {
+    if ((status & 0xF0) == 0xC0) PC_echo_check_PC_in(data1, (status & 0x0F) + 1, MIDI1_PORT);
+    else PC_echo_check_CC_in(data1, data2, (status & 0x0F) + 1, MIDI1_PORT);
+  }
+  if ((!learner) || (!PC_echo_already_sent(MIDI2_PORT))) { // Forwarding rule MIDI1 -> MIDI2
+    if ((status & 0xF0) == 0xC0) MIDI_send_PC(data1, (status & 0x0F) + 1, MIDI2_PORT);
+    else MIDI_send_CC(data1, data2, (status & 0x0F) + 1, MIDI2_PORT);
+  }
+}
+
+void run_ms(uint32_t ms) {
+  for (uint32_t t = 0; t < ms; t++) {
+    host_time_us += 1000;
+    PC_echo_check_timers();
+  }
+}
+
+struct Result_struct {
+  uint32_t gap;
+  int messages;
+  bool state_ok;
+};
+
+Result_struct patch_change(uint16_t patch, bool learner) {
+  sent.clear();
+  uint32_t start = millis();
+  if (learner) PC_echo_patch_change(0, patch); // From MD_base_class::set_patch_number()
+  const std::vector<Device_message_struct> &messages = patch_messages[patch];
+  for (uint32_t t = 1; t <= RUN_TIME; t++) {
+    host_time_us += 1000;
+    for (size_t i = 0; i < messages.size(); i++) {
+      if (t == LOAD_TIME + (MESSAGE_INTERVAL * i)) device_message_in(messages[i].status, messages[i].data1, messages[i].data2, learner);
+    }
+    PC_echo_check_timers();
+  }
+
+  // The second device has its final state when the last message for every PC channel and CC number has arrived on MIDI2
+  Result_struct result = { 0, 0, true };
+  for (size_t i = 0; i < messages.size(); i++) {
+    const Device_message_struct &m = messages[i];
+    bool is_pc = ((m.status & 0xF0) == 0xC0);
+    bool is_last = true;
+    for (size_t j = i + 1; j < messages.size(); j++) {
+      if ((messages[j].status == m.status) && ((is_pc) || (messages[j].data1 == m.data1))) is_last = false;
+    }
+    if (!is_last) continue;
+    const Message_struct *last = nullptr;
+    for (const Message_struct &s : sent) {
+      if ((s.port == MIDI2_PORT) && (s.status == m.status) && ((is_pc) || (s.data1 == m.data1))) last = &s;
+    }
+    if ((last == nullptr) || (last->data1 != m.data1) || ((!is_pc) && (last->data2 != m.data2))) {
+      result.state_ok = false;
+      continue;
+    }
+    if (last->time_ms - start > result.gap) result.gap = last->time_ms - start;
+  }
+  for (const Message_struct &s : sent) if (s.port == MIDI2_PORT) result.messages++;
+  run_ms(500);
+  return result;
+}
+
+// Tests
+
+void test_gap() {
+  // The first visit of a patch is learned while the messages come in, later visits have no gap. A patch that is edited on the device is learned again.
+  const uint16_t sequence[] = { 1, 2, 1, 2, 3, 1, 3 };
+  uint32_t total_without = 0, total_with = 0;
+  uint8_t visits[4] = { 0 };
+  for (uint8_t n = 0; n < sizeof(sequence) / sizeof(sequence[0]); n++) {
+    uint16_t patch = sequence[n];
+    if (n == 5) patch_messages[1][1].data2 = 64; // Patch 1 is edited on the device: CC 20 127 -> 64
+    Result_struct without = patch_change(patch, false);
+    int writes_before = eeprom_writes;
+    Result_struct with = patch_change(patch, true);
+    printf("patch %u: without learner gap %3u ms, %d messages - with learner gap %3u ms, %d messages, %d EEPROM writes\n",
+           patch, without.gap, without.messages, with.gap, with.messages, eeprom_writes - writes_before);
+    CHECK(without.state_ok && with.state_ok, "the second device does not get the final state of the patch");
+    // Patch 3 sends CC 20 twice, so the second device only gets the final value when the device sends it
+    if ((visits[patch] > 0) && (n != 5) && (patch != 3)) CHECK(with.gap == 0, "a learned patch still has a gap");
+    if ((visits[patch] > 0) && (n != 5)) CHECK(eeprom_writes == writes_before, "a patch that did not change is written to EEPROM again");
+    visits[patch]++;
+    total_without += without.gap;
+    total_with += with.gap;
+  }
+  printf("average gap: %u ms without, %u ms with learner\n", total_without / 7, total_with / 7);
+
+  uint8_t data[PC_ECHO_DATA_SIZE];
+  uint8_t length = EEPROM_load_PC_echo(0, 3, data);
+  CHECK((length == 3) && (data[0] == 0xB1) && (data[1] == 20) && (data[2] == 90), "a CC that is sent twice is not stored once with the last value");
+  length = EEPROM_load_PC_echo(0, 1, data);
+  CHECK((length == 8) && (data[4] == 64), "an edited patch is not learned again");
+}
+
+void test_restart() {
+  // After a restart the index is rebuilt from EEPROM
+  memset(PC_echo_index, 0, sizeof(PC_echo_index));
+  EEPROM_create_PC_echo_index();
+  Result_struct result = patch_change(2, true);
+  CHECK((result.gap == 0) && (result.messages == 4), "the learned messages are lost after a restart");
+}
+
+uint8_t replayed_messages(uint8_t dev, uint16_t patch, const std::vector<Device_message_struct> &messages) {
+  // Patch change of a device, followed by the messages of the device. Returns the number of messages that are sent from memory.
+  sent.clear();
+  PC_echo_patch_change(dev, patch);
+  size_t replayed = sent.size();
+  run_ms(LOAD_TIME);
+  for (const Device_message_struct &m : messages) {
+    if ((m.status & 0xF0) == 0xC0) PC_echo_check_PC_in(m.data1, (m.status & 0x0F) + 1, Device[dev]->MIDI_in_port);
+    else PC_echo_check_CC_in(m.data1, m.data2, (m.status & 0x0F) + 1, Device[dev]->MIDI_in_port);
+    run_ms(MESSAGE_INTERVAL);
+  }
+  run_ms(RUN_TIME);
+  return replayed;
+}
+
+void test_repeated_patch_change() {
+  // A patch change that is reported again does not send the messages again, also when another device changes patch in between
+  test_device[1].MIDI_in_port = MIDI3_PORT;
+  test_device[1].MIDI_out_port = MIDI3_PORT;
+  test_device[1].MIDI_channel = 4;
+  test_device[1].PC_echo_port = 2; // MIDI2
+  const std::vector<Device_message_struct> messages_b = { { 0xB4, 30, 1 } };
+
+  CHECK(replayed_messages(1, 3, messages_b) == 0, "messages are sent for a patch that has not been learned");
+  replayed_messages(1, 4, messages_b);
+  CHECK(replayed_messages(0, 1, patch_messages[1]) == 3, "the learned messages are not sent on a patch change");
+  CHECK(replayed_messages(1, 3, messages_b) == 1, "the learned messages of a second device are not sent");
+  CHECK(replayed_messages(0, 1, patch_messages[1]) == 0, "a repeated patch change is sent again after a patch change of another device"); // A:1, B:3, A:1 and B:3, A:1, B:3
+  CHECK(replayed_messages(1, 3, messages_b) == 0, "a repeated patch change is sent again after a patch change of another device");
+  CHECK(replayed_messages(0, 2, patch_messages[2]) == 4, "the learned messages are not sent after a repeated patch change");
+  CHECK(replayed_messages(0, 1, patch_messages[1]) == 3, "going back to the previous patch does not send its messages"); // A:1, A:2, A:1
+  test_device[1].PC_echo_port = 0;
+}
+
+void test_memory() {
+  // A patch change that cuts learning short: the unfinished messages are not stored
+  int writes_before = eeprom_writes;
+  PC_echo_patch_change(0, 7);
+  run_ms(50);
+  patch_change(1, true);
+  CHECK((eeprom_writes == writes_before) && (EEPROM_find_PC_echo_record(0, 7) == PATCH_INDEX_NOT_FOUND), "learning that was cut short is stored");
+
+  // A patch that stops sending messages: the record is deleted
+  patch_messages[3].clear();
+  patch_change(3, true);
+  CHECK(EEPROM_find_PC_echo_record(0, 3) == PATCH_INDEX_NOT_FOUND, "the record of a patch without messages is not deleted");
+
+  // Full memory: records are overwritten in turn
+  for (uint16_t p = 100; p < 100 + EXT_MAX_NUMBER_OF_PC_ECHO_RECORDS + 5; p++) {
+    uint8_t data[2] = { 0xC1, (uint8_t)p };
+    EEPROM_store_PC_echo(0, p, data, 2);
+  }
+  CHECK(EEPROM_find_PC_echo_record(0, 100 + EXT_MAX_NUMBER_OF_PC_ECHO_RECORDS + 4) != PATCH_INDEX_NOT_FOUND, "a new record is not stored when the memory is full");
+}
+
+int main() {
+  memset(eeprom, 0xFF, sizeof(eeprom));
+  EEP_initialize_PC_echo_data();
+  EEPROM_create_PC_echo_index();
+  patch_messages[1] = { { 0xC1, 5, 0 }, { 0xB1, 20, 127 }, { 0xB1, 21, 0 } };
+  patch_messages[2] = { { 0xC1, 9, 0 }, { 0xB1, 20, 0 }, { 0xB1, 21, 127 }, { 0xB2, 7, 100 } };
+  patch_messages[3] = { { 0xB1, 20, 64 }, { 0xB1, 20, 90 } };
+  test_device[0].PC_echo_port = 2; // MIDI2
+
+  test_gap();
+  test_restart();
+  test_repeated_patch_change();
+  test_memory();
+  if (host_test_failures > 0) {
+    printf("pc_echo_test: %d failure(s)\n", host_test_failures);
+    return 1;
+  }
+  printf("pc_echo_test: passed\n");
+  return 0;
+}
@@ -0,0 +1,52 @@
+#!/usr/bin/env python3
+# Please read VController_v3.ino for information about the license and authors
+
+# Writes the expression pedal traces used by expr_pedal_test.
+# The traces have the same format as the output of DEBUG_EXPR_TRACE in switchext_lib.h:
+# one line per pedal update with the time in us and the sum of the EXPR_OVERSAMPLING tip readings.
+# These traces are made with a model of a 10 bit ADC with noise, so the test can run without hardware.
+# Traces recorded on a VController with DEBUG_EXPR_TRACE can be added to this folder in the same format.
+
+import random
+
+UPDATE_TIME_US = 5000 # EXPR_PEDAL_UPDATE_TIME in switchext_lib.h
+OVERSAMPLING = 4 # EXPR_OVERSAMPLING in switchext_lib.h
+
+
+def write_trace(file_name, description, segments, adc_min, adc_max, noise, seed):
+    # segments: list of (duration in s, start position, end position), positions from 0 (heel) to 1 (toe)
+    rng = random.Random(seed)
+    t = 0
+    with open(file_name, "w") as f:
+        f.write("# " + description + "\n")
+        f.write("# time_us,sum\n")
+        for duration, start, end in segments:
+            steps = int(duration * 1000000 / UPDATE_TIME_US)
+            for i in range(steps):
+                position = start + (end - start) * i / steps
+                total = 0
+                for _ in range(OVERSAMPLING):
+                    reading = round(adc_min + position * (adc_max - adc_min) + rng.gauss(0, noise))
+                    total += min(1023, max(0, reading))
+                f.write("%d,%d\n" % (t, total))
+                t += UPDATE_TIME_US
+
+
+# Calibration sweep, then the pedal at rest and sweeps at different speeds
+write_trace("sweeps.csv", "Calibration sweep, rest, fast sweep to toe, rest, slow sweep to heel, rest, very fast sweep to toe, rest",
+            [(1.0, 0.0, 1.0), (1.0, 1.0, 0.0), (2.0, 0.5, 0.5), (0.3, 0.5, 1.0), (1.7, 1.0, 1.0),
+             (3.0, 1.0, 0.0), (2.0, 0.0, 0.0), (0.15, 0.0, 1.0), (2.85, 1.0, 1.0)],
+            adc_min=100, adc_max=900, noise=4.0, seed=1)
+
+# A pedal with a small range and a long cable: less ADC steps and more noise
+write_trace("noisy.csv", "Small range and high noise: calibration sweep, long rests between slow moves",
+            [(1.0, 0.0, 1.0), (1.0, 1.0, 0.0), (3.0, 0.2, 0.2), (1.0, 0.2, 0.6), (3.0, 0.6, 0.6), (0.5, 0.6, 0.1), (3.0, 0.1, 0.1)],
+            adc_min=300, adc_max=700, noise=8.0, seed=2)
+
+# Wah style playing: the pedal keeps moving between heel and toe
+segments = [(1.0, 0.0, 1.0), (1.0, 1.0, 0.0)]
+for _ in range(12):
+    segments += [(0.25, 0.1, 0.9), (0.25, 0.9, 0.1)]
+segments += [(2.0, 0.1, 0.1)]
+write_trace("wah.csv", "Calibration sweep, twelve heel-toe-heel moves of 0.5 s, rest",
+            segments, adc_min=100, adc_max=900, noise=4.0, seed=3)